@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/reboot.h>
+
+#include <tenstorrent/bh_arc.h>
+#include <tenstorrent/bh_chip.h>
+#include <tenstorrent/event.h>
+#include <tenstorrent/fan_ctrl.h>
+#include <tenstorrent/jtag_bootrom.h>
+#include <tenstorrent/tt_smbus_regs.h>
+
+#include "chip_service.h"
+
+LOG_MODULE_REGISTER(chip_service, CONFIG_TT_APP_LOG_LEVEL);
+
+static K_MUTEX_DEFINE(board_lock);
+static atomic_t board_input_power;
+static atomic_t board_fan_rpm;
+static uint8_t board_fan_speed;
+
+static struct gpio_dt_spec board_fault_led;
+static dmStaticInfo static_info;
+static uint16_t max_power;
+
+/* Sources without an interrupt are polled when their deadline expires */
+static struct tt_event_deadline deadlines[] = {
+	TT_EVENT_DEADLINE_INIT(TT_EVENT_CM2DM, CONFIG_DMC_CM2DM_POLL_PERIOD_MS),
+	TT_EVENT_DEADLINE_INIT(TT_EVENT_POWER_SAMPLE, 0),
+	TT_EVENT_DEADLINE_INIT(TT_EVENT_FAN_SAMPLE, 0),
+};
+
+void board_set_input_power(uint16_t power)
+{
+	atomic_set(&board_input_power, power);
+}
+
+uint16_t board_get_input_power(void)
+{
+	return atomic_get(&board_input_power);
+}
+
+void board_set_fan_rpm(uint16_t rpm)
+{
+	atomic_set(&board_fan_rpm, rpm);
+}
+
+uint16_t board_get_fan_rpm(void)
+{
+	return atomic_get(&board_fan_rpm);
+}
+
+void board_set_fan_speed(uint8_t speed)
+{
+	k_mutex_lock(&board_lock, K_FOREVER);
+	board_fan_speed = speed;
+	if (IS_ENABLED(CONFIG_TT_FAN_CTRL)) {
+		set_fan_speed(speed);
+	}
+	k_mutex_unlock(&board_lock);
+}
+
+uint8_t board_get_fan_speed(void)
+{
+	uint8_t speed;
+
+	k_mutex_lock(&board_lock, K_FOREVER);
+	speed = board_fan_speed;
+	k_mutex_unlock(&board_lock);
+
+	return speed;
+}
+
+void chip_service_init(const dmStaticInfo *info, uint16_t power_limit,
+		       const struct gpio_dt_spec *fault_led, uint32_t board_samples)
+{
+	static_info = *info;
+	max_power = power_limit;
+	board_fault_led = *fault_led;
+
+	ARRAY_FOR_EACH_PTR(deadlines, deadline) {
+		deadline->next_ms = 0;
+		if (deadline->events == TT_EVENT_POWER_SAMPLE) {
+			deadline->period_ms = (board_samples & TT_EVENT_POWER_SAMPLE)
+						      ? CONFIG_DMC_POWER_SAMPLE_PERIOD_MS
+						      : 0;
+		} else if (deadline->events == TT_EVENT_FAN_SAMPLE) {
+			deadline->period_ms = (board_samples & TT_EVENT_FAN_SAMPLE)
+						      ? CONFIG_DMC_FAN_SAMPLE_PERIOD_MS
+						      : 0;
+		}
+	}
+}
+
+uint32_t chip_service_wait(void)
+{
+	uint32_t events = tt_event_wait_deadlines(TT_EVENT_MASK, deadlines, ARRAY_SIZE(deadlines));
+
+	/* A generic wake runs every handler that is driven by a flag */
+	if (events & TT_EVENT_WAKE) {
+		events |= TT_EVENT_THERM_TRIP | TT_EVENT_PERST | TT_EVENT_PGOOD;
+	}
+
+	return events;
+}
+
+bool process_cm2dm_message(struct bh_chip *chip)
+{
+	cm2dmMessageRet msg = bh_chip_get_cm2dm_message(chip);
+
+	if (msg.ret == 0) {
+		cm2dmMessage message = msg.msg;
+
+		switch (message.msg_id) {
+		case kCm2DmMsgIdResetReq:
+			switch (message.data) {
+			case 0x0:
+				/* Applied by service_chip(), once the bus is no longer in use */
+				chip->data.reset_requested = true;
+				break;
+			case 0x3:
+				/* Trigger reboot; will reset asic and reload dmfw
+				 */
+				if (IS_ENABLED(CONFIG_REBOOT)) {
+					sys_reboot(SYS_REBOOT_COLD);
+				}
+				break;
+			}
+			break;
+		case kCm2DmMsgIdPing:
+			/* Respond to ping request from CMFW */
+			bharc_smbus_word_data_write(&chip->config.arc, CMFW_SMBUS_PING, 0xA5A5);
+			break;
+		case kCm2DmMsgIdFanSpeedUpdate:
+			board_set_fan_speed((uint8_t)message.data & 0xFF);
+			break;
+		case kCm2DmMsgIdReady:
+			chip->data.arc_needs_init_msg = true;
+			break;
+		}
+	}
+
+	return msg.ret == 0 && msg.msg.msg_id != kCm2DmMsgIdNull;
+}
+
+/*
+ * Runs a series of SMBUS tests when `CONFIG_DMC_RUN_SMBUS_TESTS` is enabled.
+ * These tests aren't intended to be run on production firmware.
+ */
+static int bh_chip_run_smbus_tests(struct bh_chip *chip)
+{
+#ifdef CONFIG_DMC_RUN_SMBUS_TESTS
+	int ret;
+	int pass_val = 0xFEEDFACE;
+	uint8_t count;
+	uint8_t data[32]; /* Max size of SMBUS block read */
+
+	/* Test SMBUS telemetry by selecting TAG_DM_APP_FW_VERSION and reading it back */
+	ret = bharc_smbus_byte_data_write(&chip->config.arc, CMFW_SMBUS_TELEMETRY_REG, 26);
+	if (ret < 0) {
+		LOG_ERR("Failed to write to SMBUS telemetry register");
+		return ret;
+	}
+	ret = bharc_smbus_block_read(&chip->config.arc, CMFW_SMBUS_TELEMETRY_DATA, &count, data);
+	if (ret < 0) {
+		LOG_ERR("Failed to read from SMBUS telemetry register");
+		return ret;
+	}
+	if (count != 4) {
+		LOG_ERR("SMBUS telemetry read returned unexpected count: %d", count);
+		return -EIO;
+	}
+	if ((*(uint32_t *)data) != static_info.app_version) {
+		LOG_ERR("SMBUS telemetry read returned unexpected value: %08x", *(uint32_t *)data);
+		return -EIO;
+	}
+
+	/* Test bulk SMBUS telemetry by reading TAG_DM_APP_FW_VERSION twice in one transaction */
+	static const uint8_t tags[] = {26, 26};
+	uint32_t values[ARRAY_SIZE(tags)];
+
+	ret = bh_chip_set_telemetry_list(chip, tags, ARRAY_SIZE(tags));
+	if (ret < 0) {
+		LOG_ERR("Failed to write to SMBUS telemetry list register");
+		return ret;
+	}
+	ret = bh_chip_get_telemetry(chip, values, ARRAY_SIZE(tags));
+	if (ret < 0) {
+		LOG_ERR("Failed to read from SMBUS bulk telemetry register");
+		return ret;
+	}
+	if (values[0] != static_info.app_version || values[1] != static_info.app_version) {
+		LOG_ERR("SMBUS bulk telemetry read returned unexpected values: %08x %08x",
+			values[0], values[1]);
+		return -EIO;
+	}
+
+	/* Record test status into scratch register */
+	ret = bharc_smbus_block_write(&chip->config.arc, 0xDD, sizeof(pass_val),
+				      (uint8_t *)&pass_val);
+	if (ret < 0) {
+		LOG_ERR("Failed to write to SMBUS scratch register");
+		return ret;
+	}
+	printk("SMBUS tests passed\n");
+#endif
+	return 0;
+}
+
+uint32_t service_chip(struct bh_chip *chip, uint32_t events)
+{
+	uint32_t repost = 0;
+
+	/* handler for therm trip */
+	if ((events & TT_EVENT_THERM_TRIP) && chip->data.therm_trip_triggered) {
+		chip->data.therm_trip_triggered = false;
+
+		if (board_fault_led.port != NULL) {
+			gpio_pin_set_dt(&board_fault_led, 1);
+		}
+		board_set_fan_speed(100);
+		bh_chip_reset_chip(chip, true);
+		bh_chip_cancel_bus_transfer_clear(chip);
+
+		chip->data.therm_trip_count++;
+	}
+
+	/* handler for PERST */
+	if ((events & TT_EVENT_PERST) && chip->data.trigger_reset) {
+		chip->data.trigger_reset = false;
+		if (chip->data.workaround_applied) {
+			jtag_bootrom_reset_asic(chip);
+			jtag_bootrom_soft_reset_arc(chip);
+			jtag_bootrom_teardown(chip);
+			chip->data.needs_reset = false;
+		} else {
+			chip->data.needs_reset = true;
+		}
+		chip->data.therm_trip_count = 0;
+		bh_chip_cancel_bus_transfer_clear(chip);
+	}
+
+	/* handler for PGOOD */
+	if (events & TT_EVENT_PGOOD) {
+		handle_pgood_event(chip, board_fault_led);
+	}
+
+	/* The periodic SMBus traffic to the chip shares one bus enable */
+	const bool smbus_events =
+		events & (TT_EVENT_CM2DM | TT_EVENT_POWER_SAMPLE | TT_EVENT_FAN_SAMPLE);
+
+	if (!smbus_events) {
+		return repost;
+	}
+
+	bh_chip_bus_session_begin(chip);
+
+	if (events & TT_EVENT_CM2DM) {
+		/* Handle a whole batch, which takes at most one bus read */
+		int i = 0;
+
+		while (i < CMFW_SMBUS_REQ_BATCH_MAX && !chip->data.reset_requested &&
+		       process_cm2dm_message(chip)) {
+			i++;
+		}
+
+		if (i == CMFW_SMBUS_REQ_BATCH_MAX) {
+			/* Drain the queue without waiting for the next poll */
+			repost |= TT_EVENT_CM2DM;
+		}
+
+		/* TODO(drosen): Turn this into a task which will re-arm until static data
+		 * is sent
+		 */
+		if (chip->data.arc_needs_init_msg) {
+			if (bh_chip_set_static_info(chip, &static_info) == 0 &&
+			    bh_chip_set_input_power_lim(chip, max_power) == 0 &&
+			    bh_chip_set_therm_trip_count(chip, chip->data.therm_trip_count) == 0 &&
+			    bh_chip_run_smbus_tests(chip) == 0) {
+				chip->data.arc_needs_init_msg = false;
+			}
+		}
+	}
+
+	/* The samples are only due on boards with the sensors, see chip_service_init() */
+	if (events & TT_EVENT_POWER_SAMPLE) {
+		bh_chip_set_input_power(chip, board_get_input_power());
+	}
+
+	if (events & TT_EVENT_FAN_SAMPLE) {
+		bh_chip_set_fan_rpm(chip, board_get_fan_rpm());
+	}
+
+	bh_chip_bus_session_end(chip);
+
+	if (chip->data.reset_requested) {
+		chip->data.reset_requested = false;
+		jtag_bootrom_reset_sequence(chip, true);
+	}
+
+	return repost;
+}
+
+#ifdef CONFIG_TT_BH_CHIP_WORKQUEUE
+void chip_event_handler(struct bh_chip *chip, uint32_t events)
+{
+	uint32_t repost = service_chip(chip, events);
+
+	if (repost != 0) {
+		bh_chip_workq_post(chip, repost);
+	}
+}
+#endif
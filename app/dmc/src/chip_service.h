@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DMC_CHIP_SERVICE_H_
+#define DMC_CHIP_SERVICE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/drivers/gpio.h>
+
+#include <tenstorrent/bh_arc.h>
+#include <tenstorrent/bh_chip.h>
+
+/*
+ * Board level state shared by every chip. It is sampled once by the main loop, and protected so
+ * that chips serviced from their own work queues can use it concurrently.
+ */
+void board_set_input_power(uint16_t power);
+uint16_t board_get_input_power(void);
+void board_set_fan_rpm(uint16_t rpm);
+uint16_t board_get_fan_rpm(void);
+/* Also applies the speed to the fan controller, when there is one */
+void board_set_fan_speed(uint8_t speed);
+uint8_t board_get_fan_speed(void);
+
+/*
+ * Sets what is sent to a chip once its ARC firmware is ready, the board fault LED, and which of
+ * TT_EVENT_POWER_SAMPLE and TT_EVENT_FAN_SAMPLE the board has sensors for.
+ */
+void chip_service_init(const dmStaticInfo *static_info, uint16_t max_power,
+		       const struct gpio_dt_spec *board_fault_led, uint32_t board_samples);
+
+/* Waits until an event is posted or a polled source is due, see tt_event_wait_deadlines() */
+uint32_t chip_service_wait(void);
+
+/* Returns true if a message was received, in which case more may be pending */
+bool process_cm2dm_message(struct bh_chip *chip);
+
+/* Returns the events that have to be handled again without waiting for their source */
+uint32_t service_chip(struct bh_chip *chip, uint32_t events);
+
+/* Work queue handler of a chip, see bh_chip_workq_start() */
+void chip_event_handler(struct bh_chip *chip, uint32_t events);
+
+#endif
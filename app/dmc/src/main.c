@@ -5,6 +5,7 @@
  */
 
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #include <app_version.h>
@@ -28,6 +29,8 @@
 #include <tenstorrent/jtag_bootrom.h>
 #include <tenstorrent/tt_smbus_regs.h>
 
+#include "chip_service.h"
+
 LOG_MODULE_REGISTER(main, CONFIG_TT_APP_LOG_LEVEL);
 
 struct bh_chip BH_CHIPS[BH_CHIP_COUNT] = {DT_FOREACH_PROP_ELEM(DT_PATH(chips), chips, INIT_CHIP)};
@@ -40,6 +43,9 @@ static const struct gpio_dt_spec board_fault_led =
 	GPIO_DT_SPEC_GET_OR(DT_PATH(board_fault_led), gpios, {0});
 static const struct device *const ina228 = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(ina228));
 
+/* No mechanism for getting bl version... yet */
+static const dmStaticInfo static_info = {.version = 1, .bl_version = 0, .app_version = APPVERSION};
+
 int update_fw(void)
 {
 	/* To get here we are already running known good fw */
@@ -90,43 +96,6 @@ int update_fw(void)
 	return ret;
 }
 
-void process_cm2dm_message(struct bh_chip *chip)
-{
-	cm2dmMessageRet msg = bh_chip_get_cm2dm_message(chip);
-
-	if (msg.ret == 0) {
-		cm2dmMessage message = msg.msg;
-
-		switch (message.msg_id) {
-		case kCm2DmMsgIdResetReq:
-			switch (message.data) {
-			case 0x0:
-				jtag_bootrom_reset_sequence(chip, true);
-				break;
-			case 0x3:
-				/* Trigger reboot; will reset asic and reload dmfw
-				 */
-				if (IS_ENABLED(CONFIG_REBOOT)) {
-					sys_reboot(SYS_REBOOT_COLD);
-				}
-				break;
-			}
-			break;
-		case kCm2DmMsgIdPing:
-			/* Respond to ping request from CMFW */
-			bharc_smbus_word_data_write(&chip->config.arc, CMFW_SMBUS_PING, 0xA5A5);
-			break;
-		case kCm2DmMsgIdFanSpeedUpdate:
-			if (IS_ENABLED(CONFIG_TT_FAN_CTRL)) {
-				set_fan_speed((uint8_t)message.data & 0xFF);
-			}
-			break;
-		case kCm2DmMsgIdReady:
-			chip->data.arc_needs_init_msg = true;
-			break;
-		}
-	}
-}
 
 void ina228_power_update(void)
 {
@@ -136,11 +105,7 @@ void ina228_power_update(void)
 	sensor_channel_get(ina228, SENSOR_CHAN_POWER, &sensor_val);
 
 	/* Only use integer part of sensor value */
-	int16_t power = sensor_val.val1 & 0xFFFF;
-
-	ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-		bh_chip_set_input_power(chip, power);
-	}
+	board_set_input_power(sensor_val.val1 & 0xFFFF);
 }
 
 uint16_t detect_max_power(void)
@@ -180,49 +145,6 @@ uint16_t detect_max_power(void)
 	return psu_power;
 }
 
-/*
- * Runs a series of SMBUS tests when `CONFIG_DMC_RUN_SMBUS_TESTS` is enabled.
- * These tests aren't intended to be run on production firmware.
- */
-static int bh_chip_run_smbus_tests(struct bh_chip *chip)
-{
-#ifdef CONFIG_DMC_RUN_SMBUS_TESTS
-	int ret;
-	int pass_val = 0xFEEDFACE;
-	uint8_t count;
-	uint8_t data[32]; /* Max size of SMBUS block read */
-
-	/* Test SMBUS telemetry by selecting TAG_DM_APP_FW_VERSION and reading it back */
-	ret = bharc_smbus_byte_data_write(&chip->config.arc, 0x26, 26);
-	if (ret < 0) {
-		LOG_ERR("Failed to write to SMBUS telemetry register");
-		return ret;
-	}
-	ret = bharc_smbus_block_read(&chip->config.arc, 0x27, &count, data);
-	if (ret < 0) {
-		LOG_ERR("Failed to read from SMBUS telemetry register");
-		return ret;
-	}
-	if (count != 4) {
-		LOG_ERR("SMBUS telemetry read returned unexpected count: %d", count);
-		return -EIO;
-	}
-	if ((*(uint32_t *)data) != APPVERSION) {
-		LOG_ERR("SMBUS telemetry read returned unexpected value: %08x", *(uint32_t *)data);
-		return -EIO;
-	}
-
-	/* Record test status into scratch register */
-	ret = bharc_smbus_block_write(&chip->config.arc, 0xDD, sizeof(pass_val),
-				      (uint8_t *)&pass_val);
-	if (ret < 0) {
-		LOG_ERR("Failed to write to SMBUS scratch register");
-		return ret;
-	}
-	printk("SMBUS tests passed\n");
-#endif
-	return 0;
-}
 
 int main(void)
 {
@@ -259,7 +181,7 @@ int main(void)
 
 	if (IS_ENABLED(CONFIG_TT_FAN_CTRL)) {
 		ret = init_fan();
-		set_fan_speed(100); /* Set fan speed to 100 by default */
+		board_set_fan_speed(100); /* Set fan speed to 100 by default */
 		if (ret != 0) {
 			LOG_ERR("%s() failed: %d", "init_fan", ret);
 			return ret;
@@ -329,12 +251,13 @@ int main(void)
 				LOG_ERR("%s() failed: %d", "jtag_bootrom_init", ret);
 				return ret;
 			}
+		}
 
-			ret = jtag_bootrom_reset_sequence(chip, false);
-			if (ret != 0) {
-				LOG_ERR("%s() failed: %d", "jtag_bootrom_reset", ret);
-				return ret;
-			}
+		/* All chips are reset and patched together */
+		ret = jtag_bootrom_reset_sequence_chips(BH_CHIPS, BH_CHIP_COUNT, false);
+		if (ret != 0) {
+			LOG_ERR("%s() failed: %d", "jtag_bootrom_reset", ret);
+			return ret;
 		}
 
 		LOG_DBG("Bootrom workaround successfully applied");
@@ -346,92 +269,42 @@ int main(void)
 		gpio_pin_set_dt(&board_fault_led, 1);
 	}
 
-	/* No mechanism for getting bl version... yet */
-	dmStaticInfo static_info =
-		(dmStaticInfo){.version = 1, .bl_version = 0, .app_version = APPVERSION};
+	chip_service_init(&static_info, detect_max_power(), &board_fault_led,
+			  (IS_ENABLED(CONFIG_INA228) ? TT_EVENT_POWER_SAMPLE : 0) |
+				  (IS_ENABLED(CONFIG_TT_FAN_CTRL) ? TT_EVENT_FAN_SAMPLE : 0));
 
-	uint16_t max_power = detect_max_power();
-
-	while (true) {
-		tt_event_wait(TT_EVENT_WAKE, K_MSEC(20));
-
-		/* handler for therm trip */
-		ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-			if (chip->data.therm_trip_triggered) {
-				chip->data.therm_trip_triggered = false;
-
-				if (board_fault_led.port != NULL) {
-					gpio_pin_set_dt(&board_fault_led, 1);
-				}
+#ifdef CONFIG_TT_BH_CHIP_WORKQUEUE
+	ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
+		char name[sizeof("bh_chipNN")];
 
-				if (IS_ENABLED(CONFIG_TT_FAN_CTRL)) {
-					set_fan_speed(100);
-				}
-				bh_chip_reset_chip(chip, true);
-				bh_chip_cancel_bus_transfer_clear(chip);
+		snprintf(name, sizeof(name), "bh_chip%d", (int)(chip - BH_CHIPS));
+		bh_chip_workq_start(chip, chip_event_handler, name);
+	}
+#endif
 
-				chip->data.therm_trip_count++;
-			}
-		}
+	while (true) {
+		uint32_t events = chip_service_wait();
 
-		/* handler for PERST */
-		ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-			if (chip->data.trigger_reset) {
-				chip->data.trigger_reset = false;
-				if (chip->data.workaround_applied) {
-					jtag_bootrom_reset_asic(chip);
-					jtag_bootrom_soft_reset_arc(chip);
-					jtag_bootrom_teardown(chip);
-					chip->data.needs_reset = false;
-				} else {
-					chip->data.needs_reset = true;
-				}
-				chip->data.therm_trip_count = 0;
-				bh_chip_cancel_bus_transfer_clear(chip);
-			}
+		/* Board level samples are taken once, and then reported to every chip */
+		if (IS_ENABLED(CONFIG_INA228) && (events & TT_EVENT_POWER_SAMPLE)) {
+			ina228_power_update();
 		}
 
-		/* handler for PGOOD */
-		ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-			handle_pgood_event(chip, board_fault_led);
+		if (IS_ENABLED(CONFIG_TT_FAN_CTRL) && (events & TT_EVENT_FAN_SAMPLE)) {
+			board_set_fan_rpm(get_fan_rpm());
 		}
 
-		/* TODO(drosen): Turn this into a task which will re-arm until static data is sent
-		 */
 		ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-			if (chip->data.arc_needs_init_msg) {
-				if (bh_chip_set_static_info(chip, &static_info) == 0 &&
-				    bh_chip_set_input_power_lim(chip, max_power) == 0 &&
-				    bh_chip_set_therm_trip_count(
-					    chip, chip->data.therm_trip_count) == 0 &&
-				    bh_chip_run_smbus_tests(chip) == 0) {
-					chip->data.arc_needs_init_msg = false;
-				}
-			}
-		}
-
-		if (IS_ENABLED(CONFIG_INA228)) {
-			ina228_power_update();
-		}
-
-		if (IS_ENABLED(CONFIG_TT_FAN_CTRL)) {
-			uint16_t rpm = get_fan_rpm();
+#ifdef CONFIG_TT_BH_CHIP_WORKQUEUE
+			bh_chip_workq_post(chip, events);
+#else
+			uint32_t repost = service_chip(chip, events);
 
-			ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-				bh_chip_set_fan_rpm(chip, rpm);
+			if (repost != 0) {
+				tt_event_post(repost);
 			}
+#endif
 		}
-
-		ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-			process_cm2dm_message(chip);
-		}
-
-		/*
-		 * Really only matters if running without security... but
-		 * cm should register that it is on the pcie bus and therefore can be an update
-		 * candidate. If chips that are on the bus see that an update has been requested
-		 * they can update?
-		 */
 	}
 
 	return EXIT_SUCCESS;
@@ -12,6 +12,7 @@ function(add_bootfs_and_fwbundle bundle_version bootfs_yaml output_bootfs output
     ${bootfs_yaml}
     ${output_bootfs}
     --build-dir ${CMAKE_BINARY_DIR}
+    --index
     DEPENDS ${bootfs_deps})
 
   # Generate firmware bundle that can be used to flash this build on a board
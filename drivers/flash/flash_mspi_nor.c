@@ -12,6 +12,7 @@
 #include <zephyr/pm/device_runtime.h>
 
 #include "flash_mspi_nor.h"
+#include "flash_mspi_nor_erase.h"
 #include "flash_mspi_nor_quirks.h"
 
 
@@ -117,6 +118,23 @@ static inline uint16_t dev_page_size(const struct device *dev)
 	return SPI_NOR_PAGE_SIZE;
 }
 
+/* Sizes of the erase units supported by the chip, see flash_mspi_nor_erase_unit(). */
+static uint32_t dev_erase_units(const struct device *dev)
+{
+	const struct flash_mspi_nor_cmds *cmds = FLASH_DATA(dev).jedec_cmds;
+	uint32_t units = SPI_NOR_SECTOR_SIZE;
+
+	if (cmds->block_erase_32k.cmd_length != 0) {
+		units |= KB(32);
+	}
+
+	if (cmds->block_erase_64k.cmd_length != 0) {
+		units |= KB(64);
+	}
+
+	return units;
+}
+
 static int api_read(const struct device *dev, off_t addr, void *dest,
 		    size_t size)
 {
@@ -198,11 +216,23 @@ static int status_get(const struct device *dev, uint8_t *status)
 	return rc;
 }
 
-static int wait_until_ready(const struct device *dev, k_timeout_t poll_period)
+/* Polls the status register until the operation in progress is finished.
+ * An operation expected to take no longer than FLASH_MSPI_NOR_BUSY_POLL_MAX_US
+ * is busy-polled for its typical duration `typical_us`. After that, or right
+ * away for longer operations, the thread sleeps between polls, doubling the
+ * interval each time up to FLASH_MSPI_NOR_POLL_INTERVAL_MAX_US.
+ */
+static int wait_until_ready(const struct device *dev, uint32_t typical_us)
 {
+	uint32_t interval_us = CONFIG_FLASH_MSPI_NOR_POLL_INTERVAL_US;
+	uint32_t busy_us = 0;
 	int rc;
 	uint8_t status_reg;
 
+	if (typical_us <= CONFIG_FLASH_MSPI_NOR_BUSY_POLL_MAX_US) {
+		busy_us = typical_us;
+	}
+
 	while (true) {
 		rc = status_get(dev, &status_reg);
 
@@ -215,7 +245,16 @@ static int wait_until_ready(const struct device *dev, k_timeout_t poll_period)
 			break;
 		}
 
-		k_sleep(poll_period);
+		if (busy_us > 0) {
+			uint32_t wait_us = MIN(interval_us, busy_us);
+
+			k_busy_wait(wait_us);
+			busy_us -= wait_us;
+		} else {
+			k_sleep(K_USEC(interval_us));
+			interval_us = MIN(2 * interval_us,
+					  CONFIG_FLASH_MSPI_NOR_POLL_INTERVAL_MAX_US);
+		}
 	}
 
 	return 0;
@@ -299,7 +338,7 @@ static int api_write(const struct device *dev, off_t addr, const void *src,
 		src   = (const uint8_t *)src + to_write;
 		size -= to_write;
 
-		rc = wait_until_ready(dev, K_MSEC(1));
+		rc = wait_until_ready(dev, FLASH_DATA(dev).timing->page_program_us);
 		if (rc < 0) {
 			break;
 		}
@@ -315,6 +354,7 @@ static int api_erase(const struct device *dev, off_t addr, size_t size)
 	const struct flash_mspi_nor_config *dev_config = dev->config;
 	struct flash_mspi_nor_data *dev_data = dev->data;
 	const uint32_t flash_size = dev_flash_size(dev);
+	uint32_t typical_us;
 	int rc = 0;
 
 	if ((addr < 0) || ((addr + size) > flash_size)) {
@@ -355,9 +395,26 @@ static int api_erase(const struct device *dev, off_t addr, size_t size)
 
 			flash_mspi_command_set(dev, &FLASH_DATA(dev).jedec_cmds->chip_erase);
 			size -= flash_size;
+			/* Takes seconds, never worth busy-polling. */
+			typical_us = UINT32_MAX;
 		} else {
-			/* Sector erase. */
-			if (FLASH_DATA(dev).jedec_cmds->sector_erase.force_single) {
+			/* Largest block or sector erase that fits the range. */
+			const struct flash_mspi_nor_cmd *cmd;
+			uint32_t unit = flash_mspi_nor_erase_unit(addr, size,
+								  dev_erase_units(dev));
+
+			if (unit == KB(64)) {
+				cmd = &FLASH_DATA(dev).jedec_cmds->block_erase_64k;
+				typical_us = FLASH_DATA(dev).timing->block_erase_64k_us;
+			} else if (unit == KB(32)) {
+				cmd = &FLASH_DATA(dev).jedec_cmds->block_erase_32k;
+				typical_us = FLASH_DATA(dev).timing->block_erase_32k_us;
+			} else {
+				cmd = &FLASH_DATA(dev).jedec_cmds->sector_erase;
+				typical_us = FLASH_DATA(dev).timing->sector_erase_us;
+			}
+
+			if (cmd->force_single) {
 				rc = dev_cfg_apply(dev, &dev_config->mspi_nor_init_cfg);
 			} else {
 				rc = dev_cfg_apply(dev, &FLASH_DATA(dev).dev_cfg);
@@ -367,10 +424,10 @@ static int api_erase(const struct device *dev, off_t addr, size_t size)
 				return rc;
 			}
 
-			flash_mspi_command_set(dev, &FLASH_DATA(dev).jedec_cmds->sector_erase);
+			flash_mspi_command_set(dev, cmd);
 			dev_data->packet.address = addr;
-			addr += SPI_NOR_SECTOR_SIZE;
-			size -= SPI_NOR_SECTOR_SIZE;
+			addr += unit;
+			size -= unit;
 		}
 		rc = mspi_transceive(dev_config->bus, &dev_config->mspi_id,
 				     &dev_data->xfer);
@@ -380,7 +437,7 @@ static int api_erase(const struct device *dev, off_t addr, size_t size)
 			break;
 		}
 
-		rc = wait_until_ready(dev, K_MSEC(1));
+		rc = wait_until_ready(dev, typical_us);
 		if (rc < 0) {
 			break;
 		}
@@ -559,7 +616,7 @@ static int quad_enable_set(const struct device *dev, bool enable)
 		return -ENOTSUP;
 	}
 
-	rc = wait_until_ready(dev, K_USEC(1));
+	rc = wait_until_ready(dev, 0);
 
 	if (rc < 0) {
 		LOG_ERR("Failed waiting until device ready after enabling quad: %d", rc);
@@ -664,7 +721,7 @@ static int flash_chip_init(const struct device *dev)
 			return rc;
 		}
 
-		rc = wait_until_ready(dev, K_USEC(1));
+		rc = wait_until_ready(dev, 0);
 
 		if (rc < 0) {
 			LOG_ERR("Failed waiting for device after switch to single line: %d", rc);
@@ -718,6 +775,7 @@ static int flash_chip_init(const struct device *dev)
 			 sizeof(id)) == 0) {
 			FLASH_DATA(dev).jedec_cmds = &mspi_nor_devs[i].jedec_cmds;
 			FLASH_DATA(dev).quirks = &mspi_nor_devs[i].quirks;
+			FLASH_DATA(dev).timing = &mspi_nor_devs[i].timing;
 			FLASH_DATA(dev).dw15_qer = mspi_nor_devs[i].dw15_qer;
 			FLASH_DATA(dev).dev_cfg.io_mode = mspi_nor_devs[i].dev_cfg.io_mode;
 			FLASH_DATA(dev).dev_cfg.data_rate = mspi_nor_devs[i].dev_cfg.data_rate;
@@ -898,6 +956,7 @@ BUILD_ASSERT((FLASH_SIZE_INST(inst) % CONFIG_FLASH_MSPI_NOR_LAYOUT_PAGE_SIZE) ==
 	.flash_data = {								\
 		.jedec_cmds = FLASH_CMDS(inst),					\
 		.quirks = FLASH_QUIRKS(inst),					\
+		.timing = &timing_default,					\
 		.dev_cfg = MSPI_DEVICE_CONFIG_DT_INST(inst),			\
 		.jedec_id = DT_INST_PROP_OR(inst, jedec_id, {0}),		\
 		.dw15_qer = FLASH_DW15_QER(inst),				\
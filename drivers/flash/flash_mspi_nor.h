@@ -21,10 +21,21 @@ extern "C" {
 #define WITH_RESET_GPIO 1
 #endif
 
+/* Typical durations, in microseconds, of operations that keep the chip busy.
+ * These are used to pace the polling of the WIP bit.
+ */
+struct flash_mspi_nor_timing {
+	uint32_t page_program_us;
+	uint32_t sector_erase_us;
+	uint32_t block_erase_32k_us;
+	uint32_t block_erase_64k_us;
+};
+
 /* Flash data. Stored in ROM unless CONFIG_FLASH_MSPI_NOR_RUNTIME_PROBE is enabled */
 struct flash_mspi_device_data {
 	const struct flash_mspi_nor_cmds *jedec_cmds;
 	const struct flash_mspi_nor_quirks *quirks;
+	const struct flash_mspi_nor_timing *timing;
 	struct mspi_dev_cfg dev_cfg;
 	uint8_t jedec_id[SPI_NOR_MAX_ID_LEN];
 	uint8_t dw15_qer;
@@ -80,6 +91,9 @@ struct flash_mspi_nor_cmds {
 	struct flash_mspi_nor_cmd config;
 	struct flash_mspi_nor_cmd page_program;
 	struct flash_mspi_nor_cmd sector_erase;
+	/* Optional, unsupported if cmd_length is 0 */
+	struct flash_mspi_nor_cmd block_erase_32k;
+	struct flash_mspi_nor_cmd block_erase_64k;
 	struct flash_mspi_nor_cmd chip_erase;
 	struct flash_mspi_nor_cmd sfdp;
 };
@@ -89,6 +103,7 @@ struct flash_mspi_nor_devs {
 	const struct mspi_dev_cfg dev_cfg;
 	const struct flash_mspi_nor_cmds jedec_cmds;
 	const struct flash_mspi_nor_quirks quirks;
+	const struct flash_mspi_nor_timing timing;
 	uint8_t dw15_qer;
 	uint32_t flash_size;
 	uint32_t page_size;
@@ -99,6 +114,7 @@ extern const uint32_t mspi_nor_devs_count;
 extern const struct flash_mspi_nor_cmds commands_single;
 extern const struct flash_mspi_nor_cmds commands_quad;
 extern const struct flash_mspi_nor_cmds commands_octal;
+extern const struct flash_mspi_nor_timing timing_default;
 
 void flash_mspi_command_set(const struct device *dev, const struct flash_mspi_nor_cmd *cmd);
 
@@ -15,6 +15,11 @@ struct flash_mspi_nor_devs mspi_nor_devs[] = {
 		.jedec_id = {0x2C, 0x5B, 0x1A}, /* MT35XU02GCBA */
 		.page_size = 4096,
 		.flash_size = 0x4000000,
+		.timing = {
+			.page_program_us = 150,
+			.sector_erase_us = 40000,
+			.block_erase_32k_us = 150000,
+		},
 		.dev_cfg = {
 			.io_mode = MSPI_IO_MODE_OCTAL_1_8_8,
 			.data_rate = MSPI_DATA_RATE_SINGLE,
@@ -65,6 +70,14 @@ struct flash_mspi_nor_devs mspi_nor_devs[] = {
 				.addr_length = 4,
 				.force_single = true,
 			},
+			/* There are no 64K blocks, the sectors are 128K */
+			.block_erase_32k = {
+				.dir = MSPI_TX,
+				.cmd = 0x5C,
+				.cmd_length = 1,
+				.addr_length = 4,
+				.force_single = true,
+			},
 			.chip_erase = {
 				.dir = MSPI_TX,
 				.cmd = 0xC4,
@@ -84,6 +97,12 @@ struct flash_mspi_nor_devs mspi_nor_devs[] = {
 		.jedec_id = {0x20, 0xBB, 0x20}, /* MT25QU512ABB */
 		.page_size = 4096,
 		.flash_size = 0x4000000,
+		.timing = {
+			.page_program_us = 120,
+			.sector_erase_us = 50000,
+			.block_erase_32k_us = 100000,
+			.block_erase_64k_us = 150000,
+		},
 		.dev_cfg = {
 			.io_mode = MSPI_IO_MODE_QUAD_1_4_4,
 			.data_rate = MSPI_DATA_RATE_SINGLE,
@@ -133,6 +152,20 @@ struct flash_mspi_nor_devs mspi_nor_devs[] = {
 				.addr_length = 4,
 				.force_single = true,
 			},
+			.block_erase_32k = {
+				.dir = MSPI_TX,
+				.cmd = 0x5C,
+				.cmd_length = 1,
+				.addr_length = 4,
+				.force_single = true,
+			},
+			.block_erase_64k = {
+				.dir = MSPI_TX,
+				.cmd = 0xDC,
+				.cmd_length = 1,
+				.addr_length = 4,
+				.force_single = true,
+			},
 			.chip_erase = {
 				.dir = MSPI_TX,
 				.cmd = 0xC7,
@@ -190,6 +223,18 @@ const struct flash_mspi_nor_cmds commands_single = {
 		.cmd_length = 1,
 		.addr_length = 3,
 	},
+	.block_erase_32k = {
+		.dir = MSPI_TX,
+		.cmd = SPI_NOR_CMD_BE_32K,
+		.cmd_length = 1,
+		.addr_length = 3,
+	},
+	.block_erase_64k = {
+		.dir = MSPI_TX,
+		.cmd = SPI_NOR_CMD_BE,
+		.cmd_length = 1,
+		.addr_length = 3,
+	},
 	.chip_erase = {
 		.dir = MSPI_TX,
 		.cmd = SPI_NOR_CMD_CE,
@@ -206,6 +251,14 @@ const struct flash_mspi_nor_cmds commands_single = {
 
 const uint32_t mspi_nor_devs_count = ARRAY_SIZE(mspi_nor_devs);
 
+/* Used for chips not listed above, on the slow side of common NOR parts */
+const struct flash_mspi_nor_timing timing_default = {
+	.page_program_us = 500,
+	.sector_erase_us = 50000,
+	.block_erase_32k_us = 150000,
+	.block_erase_64k_us = 250000,
+};
+
 const struct flash_mspi_nor_cmds commands_quad_1_4_4 = {
 	.id = {
 		.dir = MSPI_RX,
@@ -250,6 +303,20 @@ const struct flash_mspi_nor_cmds commands_quad_1_4_4 = {
 		.addr_length = 3,
 		.force_single = true,
 	},
+	.block_erase_32k = {
+		.dir = MSPI_TX,
+		.cmd = SPI_NOR_CMD_BE_32K,
+		.cmd_length = 1,
+		.addr_length = 3,
+		.force_single = true,
+	},
+	.block_erase_64k = {
+		.dir = MSPI_TX,
+		.cmd = SPI_NOR_CMD_BE,
+		.cmd_length = 1,
+		.addr_length = 3,
+		.force_single = true,
+	},
 	.chip_erase = {
 		.dir = MSPI_TX,
 		.cmd = SPI_NOR_CMD_CE,
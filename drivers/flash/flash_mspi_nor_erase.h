@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __FLASH_MSPI_NOR_ERASE_H__
+#define __FLASH_MSPI_NOR_ERASE_H__
+
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+/**
+ * @brief Pick the erase unit to use at the start of a range.
+ *
+ * @param addr Start of the range still to be erased.
+ * @param size Size of the range still to be erased.
+ * @param units Bitwise OR of the supported erase unit sizes, all powers of two.
+ *
+ * @return The largest supported unit that is aligned at @p addr and fits in @p size,
+ *	   or 0 if there is none.
+ */
+static inline uint32_t flash_mspi_nor_erase_unit(uint32_t addr, uint32_t size, uint32_t units)
+{
+	while (units != 0) {
+		uint32_t unit = BIT(31 - __builtin_clz(units));
+
+		if ((addr & (unit - 1)) == 0 && size >= unit) {
+			return unit;
+		}
+
+		units &= ~unit;
+	}
+
+	return 0;
+}
+
+#endif /*__FLASH_MSPI_NOR_ERASE_H__*/
@@ -397,6 +397,16 @@ static int tt_stm32_i2c_init(const struct device *dev)
 	data->is_configured = false;
 	data->mode = I2CSTM32MODE_I2C;
 
+#ifdef CONFIG_TT_I2C_STM32_DMA
+	k_sem_init(&data->dma.done, 0, 1);
+
+	if ((cfg->dma_tx.dev != NULL && !device_is_ready(cfg->dma_tx.dev)) ||
+	    (cfg->dma_rx.dev != NULL && !device_is_ready(cfg->dma_rx.dev))) {
+		LOG_ERR("DMA controller not ready");
+		return -ENODEV;
+	}
+#endif
+
 	/*
 	 * initialize mutex used when multiple transfers
 	 * are taking place to guarantee that each one is
@@ -585,6 +595,21 @@ void tt_stm32_i2c_smbalert_disable(const struct device *dev)
 
 #endif /* CONFIG_I2C_STM32_INTERRUPT */
 
+#ifdef CONFIG_TT_I2C_STM32_DMA
+#define STM32_I2C_DMA_CHANNEL(index, name)                                                         \
+	COND_CODE_1(DT_INST_DMAS_HAS_NAME(index, name),                                            \
+		    ({                                                                             \
+			    .dev = DEVICE_DT_GET(DT_INST_DMAS_CTLR_BY_NAME(index, name)),          \
+			    .channel = DT_INST_DMAS_CELL_BY_NAME(index, name, channel),            \
+			    .slot = DT_INST_DMAS_CELL_BY_NAME_OR(index, name, slot, 0),            \
+		    }),                                                                            \
+		    ({0}))
+#define STM32_I2C_DMA_CHANNELS(index)                                                              \
+	.dma_tx = STM32_I2C_DMA_CHANNEL(index, tx), .dma_rx = STM32_I2C_DMA_CHANNEL(index, rx),
+#else
+#define STM32_I2C_DMA_CHANNELS(index)
+#endif
+
 #define STM32_I2C_INIT(index)                                                                      \
 	STM32_I2C_IRQ_HANDLER_DECL(index);                                                         \
                                                                                                    \
@@ -607,6 +632,7 @@ void tt_stm32_i2c_smbalert_disable(const struct device *dev)
 						    (const struct tt_i2c_config_timing *)          \
 							    i2c_timings_##index,                   \
 				    .n_timings = ARRAY_SIZE(i2c_timings_##index),                  \
+		STM32_I2C_DMA_CHANNELS(index)                                                      \
 	};                                                                                         \
                                                                                                    \
 	static struct tt_stm32_i2c_data i2c_stm32_dev_data_##index;                                \
@@ -15,6 +15,14 @@
 
 typedef void (*irq_config_func_t)(const struct device *port);
 
+#ifdef CONFIG_TT_I2C_STM32_DMA
+struct tt_stm32_i2c_dma_channel {
+	const struct device *dev;
+	uint32_t channel;
+	uint32_t slot;
+};
+#endif
+
 /* TODO: @drosen @cfriedt HAX, please fix when possible */
 /* #if DT_HAS_COMPAT_STATUS_OKAY(st_tt_stm32_i2c) */
 struct tt_i2c_config_timing {
@@ -46,6 +54,10 @@ struct tt_stm32_i2c_config {
 	const struct pinctrl_dev_config *pcfg;
 	const struct tt_i2c_config_timing *timings;
 	size_t n_timings;
+#ifdef CONFIG_TT_I2C_STM32_DMA
+	struct tt_stm32_i2c_dma_channel dma_tx;
+	struct tt_stm32_i2c_dma_channel dma_rx;
+#endif
 };
 
 struct tt_i2c_bitbang_io {
@@ -73,6 +85,12 @@ struct tt_stm32_i2c_data {
 
 #ifdef CONFIG_TT_I2C_STM32_BYTE_POLL
 	struct tt_i2c_bitbang ctx;
+#endif
+#ifdef CONFIG_TT_I2C_STM32_DMA
+	struct {
+		struct k_sem done;
+		int status;
+	} dma;
 #endif
 	struct k_sem bus_mutex;
 	uint32_t dev_config;
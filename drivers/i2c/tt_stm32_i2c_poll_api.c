@@ -21,6 +21,10 @@
 #include "stm32g0xx_ll_i2c.h"
 #include "zephyr/sys_clock.h"
 
+#ifdef CONFIG_TT_I2C_STM32_DMA
+#include <zephyr/drivers/dma.h>
+#endif
+
 #define LOG_LEVEL CONFIG_I2C_LOG_LEVEL
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(tt_stm32_i2c_api);
@@ -238,6 +242,169 @@ static void tt_stm32_i2c_msg_setup(const struct device *dev, uint16_t slave, boo
 	LL_I2C_DisableAutoEndMode(i2c);
 }
 
+#ifdef CONFIG_TT_I2C_STM32_DMA
+static const struct tt_stm32_i2c_dma_channel *tt_stm32_i2c_dma_channel(const struct device *dev,
+								      bool write)
+{
+	const struct tt_stm32_i2c_config *cfg = dev->config;
+
+	return write ? &cfg->dma_tx : &cfg->dma_rx;
+}
+
+static void tt_stm32_i2c_dma_callback(const struct device *dma_dev, void *user_data,
+				      uint32_t channel, int status)
+{
+	const struct device *dev = user_data;
+	struct tt_stm32_i2c_data *data = dev->data;
+
+	ARG_UNUSED(dma_dev);
+	ARG_UNUSED(channel);
+
+	/* Only the end of the block, or an error, ends the wait */
+	if (status == DMA_STATUS_BLOCK) {
+		return;
+	}
+
+	data->dma.status = status;
+	k_sem_give(&data->dma.done);
+}
+
+static int tt_stm32_i2c_dma_start(const struct device *dev, uint8_t *buf, size_t len, bool write)
+{
+	const struct tt_stm32_i2c_config *cfg = dev->config;
+	struct tt_stm32_i2c_data *data = dev->data;
+	const struct tt_stm32_i2c_dma_channel *dma = tt_stm32_i2c_dma_channel(dev, write);
+	I2C_TypeDef *i2c = cfg->i2c;
+	struct dma_block_config block = {
+		.block_size = len,
+	};
+	struct dma_config dma_cfg = {
+		.dma_slot = dma->slot,
+		.channel_direction = write ? MEMORY_TO_PERIPHERAL : PERIPHERAL_TO_MEMORY,
+		.source_data_size = 1,
+		.dest_data_size = 1,
+		.source_burst_length = 1,
+		.dest_burst_length = 1,
+		.block_count = 1,
+		.head_block = &block,
+		.dma_callback = tt_stm32_i2c_dma_callback,
+		.user_data = (void *)dev,
+	};
+	int ret;
+
+	if (write) {
+		block.source_address = (uintptr_t)buf;
+		block.dest_address = LL_I2C_DMA_GetRegAddr(i2c, LL_I2C_DMA_REG_DATA_TRANSMIT);
+		block.dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+	} else {
+		block.source_address = LL_I2C_DMA_GetRegAddr(i2c, LL_I2C_DMA_REG_DATA_RECEIVE);
+		block.source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+		block.dest_address = (uintptr_t)buf;
+	}
+
+	data->dma.status = 0;
+	k_sem_reset(&data->dma.done);
+
+	ret = dma_config(dma->dev, dma->channel, &dma_cfg);
+	if (ret < 0) {
+		LOG_ERR("Failed to configure DMA channel %u (%d)", dma->channel, ret);
+		return ret;
+	}
+
+	ret = dma_start(dma->dev, dma->channel);
+	if (ret < 0) {
+		LOG_ERR("Failed to start DMA channel %u (%d)", dma->channel, ret);
+		return ret;
+	}
+
+	/* The controller only issues requests once they are enabled */
+	if (write) {
+		LL_I2C_EnableDMAReq_TX(i2c);
+	} else {
+		LL_I2C_EnableDMAReq_RX(i2c);
+	}
+
+	return 0;
+}
+
+static void tt_stm32_i2c_dma_stop(const struct device *dev, bool write)
+{
+	const struct tt_stm32_i2c_config *cfg = dev->config;
+	const struct tt_stm32_i2c_dma_channel *dma = tt_stm32_i2c_dma_channel(dev, write);
+
+	LL_I2C_DisableDMAReq_TX(cfg->i2c);
+	LL_I2C_DisableDMAReq_RX(cfg->i2c);
+	(void)dma_stop(dma->dev, dma->channel);
+}
+
+/* Time the bus takes to move @p len bytes, each followed by its acknowledge bit */
+static k_timeout_t tt_stm32_i2c_bus_time(const struct device *dev, size_t len)
+{
+	struct tt_stm32_i2c_data *data = dev->data;
+	uint32_t bitrate;
+
+	switch (I2C_SPEED_GET(data->dev_config)) {
+	case I2C_SPEED_STANDARD:
+		bitrate = I2C_BITRATE_STANDARD;
+		break;
+	case I2C_SPEED_FAST:
+		bitrate = I2C_BITRATE_FAST;
+		break;
+	default:
+		bitrate = I2C_BITRATE_FAST_PLUS;
+		break;
+	}
+
+	return K_USEC(DIV_ROUND_UP(len * 9 * USEC_PER_SEC, bitrate));
+}
+
+/*
+ * Moves a whole NBYTES block with DMA, leaving the calling thread asleep until the DMA callback
+ * reports that the block is done. A NACK or a bus error stops the DMA requests instead, so the
+ * controller is checked whenever the block has taken longer than the bus needs to move it.
+ */
+static int tt_stm32_i2c_dma_block(const struct device *dev, uint8_t *buf, size_t len, bool write)
+{
+	struct tt_stm32_i2c_data *data = dev->data;
+	const struct tt_stm32_i2c_dma_channel *dma = tt_stm32_i2c_dma_channel(dev, write);
+	const k_timeout_t bus_time = tt_stm32_i2c_bus_time(dev, len);
+	k_timepoint_t timeout = sys_timepoint_calc(K_MSEC(CONFIG_TT_I2C_STM32_TIMEOUT));
+	uint32_t last_pending = len;
+	struct dma_status stat;
+	int ret;
+
+	ret = tt_stm32_i2c_dma_start(dev, buf, len, write);
+
+	while (ret == 0) {
+		bool done = k_sem_take(&data->dma.done, bus_time) == 0;
+
+		if (data->dma.status < 0) {
+			LOG_ERR("DMA transfer failed (%d)", data->dma.status);
+			ret = -EIO;
+		} else if (check_errors(dev, __func__)) {
+			ret = -EIO;
+		} else if (done) {
+			break;
+		} else if (data->current.abort != NULL && *data->current.abort) {
+			ret = -ECANCELED;
+		} else if (dma_get_status(dma->dev, dma->channel, &stat) < 0) {
+			ret = -EIO;
+		} else if (stat.pending_length < last_pending) {
+			/* The timeout only runs while the target holds up the bus */
+			last_pending = stat.pending_length;
+			timeout = sys_timepoint_calc(K_MSEC(CONFIG_TT_I2C_STM32_TIMEOUT));
+		} else if (sys_timepoint_expired(timeout)) {
+			LOG_ERR("dma: TIMEOUT");
+			ret = -ETIMEDOUT;
+		}
+	}
+
+	tt_stm32_i2c_dma_stop(dev, write);
+
+	return ret;
+}
+#endif /* CONFIG_TT_I2C_STM32_DMA */
+
 static int tt_stm32_i2c_msg_loop(const struct device *dev, struct i2c_msg *msg, bool force_reload)
 {
 	const struct tt_stm32_i2c_config *cfg = dev->config;
@@ -252,6 +419,30 @@ static int tt_stm32_i2c_msg_loop(const struct device *dev, struct i2c_msg *msg,
 
 	len = msg->len;
 	while (1) {
+#ifdef CONFIG_TT_I2C_STM32_DMA
+		/* Bytes left in the current NBYTES block; msg->len only drops once a block ends */
+		unsigned int block_len =
+			len - (msg->len - MIN(msg->len, STM32_I2C_MAX_TRANSFER_SIZE));
+
+		if (block_len >= CONFIG_TT_I2C_STM32_DMA_MIN_BYTES &&
+		    tt_stm32_i2c_dma_channel(dev, write)->dev != NULL) {
+			int ret = tt_stm32_i2c_dma_block(dev, buf, block_len, write);
+
+			if (ret < 0) {
+				LOG_ERR("dma: %d", ret);
+				if (LL_I2C_IsEnabledReloadMode(i2c)) {
+					LL_I2C_DisableReloadMode(i2c);
+				}
+				return ret;
+			}
+
+			/* TC or TCR is handled below, once the last byte is on the bus */
+			buf += block_len;
+			len -= block_len;
+			timeout = sys_timepoint_calc(K_MSEC(CONFIG_TT_I2C_STM32_TIMEOUT));
+			continue;
+		}
+#endif
 		bool buffer_overflow = false;
 		bool write_waiting = write && LL_I2C_IsActiveFlag_TXIS(i2c);
 		bool read_waiting = !write && LL_I2C_IsActiveFlag_RXNE(i2c);
@@ -357,6 +548,18 @@ static int tt_stm32_i2c_msg_loop(const struct device *dev, struct i2c_msg *msg,
 	return 0;
 }
 
+int tt_stm32_i2c_enable(const struct device *dev)
+{
+	const struct tt_stm32_i2c_config *cfg = dev->config;
+	struct tt_stm32_i2c_data *data = dev->data;
+
+	/* Latch the abort flag for the whole transfer */
+	data->current.abort = data->abort;
+	LL_I2C_Enable(cfg->i2c);
+
+	return 0;
+}
+
 void tt_stm32_i2c_disable(const struct device *dev)
 {
 	const struct tt_stm32_i2c_config *cfg = dev->config;
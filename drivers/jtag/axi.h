@@ -11,6 +11,16 @@
 #define AXI_CNTL_READ  BIT(31)
 #define AXI_CNTL_WRITE (BIT(31) | BIT(8) | BIT_MASK(4))
 
+/* Post-increment the AXI address by one word after every data TDR update */
+#define AXI_CNTL_AUTO_INC BIT(30)
+
+#define AXI_STATUS_DONE      BIT_MASK(4)
+#define AXI_STATUS_WRITE_ERR BIT(16)
+
+/* Length of the TDR select (SIB) and of a TDR, behind the Tensix SM RTAP */
+#define TENSIX_SM_SIBLEN (4)
+#define TENSIX_SM_TDRLEN (32)
+
 #define ARC_AXI_ADDR_TDR           (2)
 #define ARC_AXI_DATA_TDR           (3)
 #define ARC_AXI_CONTROL_STATUS_TDR (4)
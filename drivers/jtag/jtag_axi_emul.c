@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Transaction-level JTAG emulator.
+ *
+ * Implements the JTAG API directly over a sparse model of AXI memory, without going through
+ * GPIOs, so that tests can load full-size images. IR and DR scans are decoded at the TDR level,
+ * i.e. a TDR select followed by a TDR update, as the bit-bang driver issues them. The TAP state
+ * machine is only modelled by the gpio-emul based emulator in jtag_emul.c.
+ */
+
+#include "axi.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/jtag.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#define DT_DRV_COMPAT zephyr_jtag_axi_emul
+
+LOG_MODULE_REGISTER(jtag_axi_emul, CONFIG_JTAG_LOG_LEVEL);
+
+/* What jtag_bootrom waits for after reset */
+#define JTAG_AXI_EMUL_ID 0x138A5
+
+#define PAGE_SIZE  4096
+#define PAGE_WORDS (PAGE_SIZE / sizeof(uint32_t))
+#define NUM_PAGES  (CONFIG_JTAG_AXI_EMUL_MEM_SIZE * 1024 / PAGE_SIZE)
+#define NUM_SLOTS  (2 * NUM_PAGES)
+
+#define TDR_SELECT_LEN (TENSIX_SM_SIBLEN + 1)
+#define TDR_LEN        (1 + TENSIX_SM_TDRLEN + TENSIX_SM_SIBLEN)
+
+#define NO_TDR -1
+
+struct jtag_axi_emul_page {
+	uint32_t addr;
+	uint32_t words[PAGE_WORDS];
+};
+
+struct jtag_axi_emul_data {
+	struct jtag_axi_emul_page pages[NUM_PAGES];
+	/* Open addressing hash of pages by address, holding page index + 1, or 0 if free */
+	uint16_t slots[NUM_SLOTS];
+	size_t num_pages;
+	/* Most accesses are sequential, so the last page is checked first */
+	struct jtag_axi_emul_page *last;
+
+	/* TDR selected by the previous DR scan */
+	int tdr;
+	uint32_t ir;
+	uint32_t axi_addr;
+	uint32_t axi_data;
+	uint32_t axi_ctrl;
+	uint32_t axi_status;
+};
+
+BUILD_ASSERT(NUM_PAGES < UINT16_MAX, "Too many emulated AXI pages");
+
+static uint32_t *jtag_axi_emul_word(struct jtag_axi_emul_data *data, uint32_t addr, bool alloc)
+{
+	uint32_t base = ROUND_DOWN(addr, PAGE_SIZE);
+	uint32_t slot = ((base / PAGE_SIZE) * 2654435761U) % NUM_SLOTS;
+	struct jtag_axi_emul_page *page = data->last;
+
+	if (page == NULL || page->addr != base) {
+		page = NULL;
+
+		for (; data->slots[slot] != 0; slot = (slot + 1) % NUM_SLOTS) {
+			if (data->pages[data->slots[slot] - 1].addr == base) {
+				page = &data->pages[data->slots[slot] - 1];
+				break;
+			}
+		}
+
+		if (page == NULL) {
+			if (!alloc) {
+				return NULL;
+			}
+
+			if (data->num_pages == NUM_PAGES) {
+				LOG_ERR("Out of emulated AXI memory at %08x", addr);
+				return NULL;
+			}
+
+			page = &data->pages[data->num_pages++];
+			memset(page, 0, sizeof(*page));
+			page->addr = base;
+			data->slots[slot] = data->num_pages;
+		}
+
+		data->last = page;
+	}
+
+	return &page->words[(addr - base) / sizeof(uint32_t)];
+}
+
+static int jtag_axi_emul_read32(const struct device *dev, uint32_t addr, uint32_t *value)
+{
+	struct jtag_axi_emul_data *data = dev->data;
+	const uint32_t *word;
+
+	if (addr % sizeof(uint32_t) != 0) {
+		return -EINVAL;
+	}
+
+	/* Memory that was never written reads as zero */
+	word = jtag_axi_emul_word(data, addr, false);
+	*value = (word != NULL) ? *word : 0;
+
+	return 0;
+}
+
+static int jtag_axi_emul_write32(const struct device *dev, uint32_t addr, uint32_t value)
+{
+	struct jtag_axi_emul_data *data = dev->data;
+	uint32_t *word;
+
+	if (addr % sizeof(uint32_t) != 0) {
+		return -EINVAL;
+	}
+
+	word = jtag_axi_emul_word(data, addr, true);
+	if (word == NULL) {
+		return -ENOMEM;
+	}
+
+	*word = value;
+
+	return 0;
+}
+
+static int jtag_axi_emul_block_write(const struct device *dev, uint32_t addr,
+				     const uint32_t *value, uint32_t len)
+{
+	struct jtag_axi_emul_data *data = dev->data;
+
+	if (addr % sizeof(uint32_t) != 0) {
+		return -EINVAL;
+	}
+
+	/* One page at a time */
+	while (len > 0) {
+		uint32_t n = MIN(len, (ROUND_DOWN(addr, PAGE_SIZE) + PAGE_SIZE - addr) /
+					      sizeof(uint32_t));
+		uint32_t *word = jtag_axi_emul_word(data, addr, true);
+
+		if (word == NULL) {
+			return -ENOMEM;
+		}
+
+		memcpy(word, value, n * sizeof(uint32_t));
+		addr += n * sizeof(uint32_t);
+		value += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+static int jtag_axi_emul_block_read(const struct device *dev, uint32_t addr, uint32_t *value,
+				    uint32_t len)
+{
+	struct jtag_axi_emul_data *data = dev->data;
+
+	if (addr % sizeof(uint32_t) != 0) {
+		return -EINVAL;
+	}
+
+	/* One page at a time */
+	while (len > 0) {
+		uint32_t n = MIN(len, (ROUND_DOWN(addr, PAGE_SIZE) + PAGE_SIZE - addr) /
+					      sizeof(uint32_t));
+		const uint32_t *word = jtag_axi_emul_word(data, addr, false);
+
+		if (word != NULL) {
+			memcpy(value, word, n * sizeof(uint32_t));
+		} else {
+			memset(value, 0, n * sizeof(uint32_t));
+		}
+		addr += n * sizeof(uint32_t);
+		value += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+static bool jtag_axi_emul_reading(uint32_t ctrl)
+{
+	return (ctrl & AXI_CNTL_READ) && (ctrl & AXI_CNTL_WRITE) != AXI_CNTL_WRITE;
+}
+
+/* The last bits of a scan, which are what is left in a register of len bits */
+static uint64_t jtag_axi_emul_scan_tail(uint32_t count, const uint8_t *scan, uint32_t len)
+{
+	uint32_t first = (count > len) ? (count - len) : 0;
+	uint64_t bits = 0;
+
+	for (uint32_t i = first; i < count; ++i) {
+		if (scan[i / 8] & BIT(i % 8)) {
+			bits |= BIT64(i - first);
+		}
+	}
+
+	return bits;
+}
+
+static uint32_t jtag_axi_emul_tdr_read(struct jtag_axi_emul_data *data, int tdr)
+{
+	switch (tdr) {
+	case ARC_AXI_ADDR_TDR:
+		return data->axi_addr;
+	case ARC_AXI_DATA_TDR:
+		return data->axi_data;
+	case ARC_AXI_CONTROL_STATUS_TDR:
+		return data->axi_status;
+	default:
+		return 0;
+	}
+}
+
+static void jtag_axi_emul_tdr_write(const struct device *dev, int tdr, uint32_t value)
+{
+	struct jtag_axi_emul_data *data = dev->data;
+	int ret;
+
+	switch (tdr) {
+	case ARC_AXI_ADDR_TDR:
+		data->axi_addr = value;
+		break;
+	case ARC_AXI_DATA_TDR:
+		if (jtag_axi_emul_reading(data->axi_ctrl)) {
+			/* Reads with auto-increment start the next read once the data is captured */
+			if (data->axi_ctrl & AXI_CNTL_AUTO_INC) {
+				data->axi_addr += sizeof(uint32_t);
+				(void)jtag_axi_emul_read32(dev, data->axi_addr, &data->axi_data);
+			}
+			break;
+		}
+
+		data->axi_data = value;
+		if ((data->axi_ctrl & AXI_CNTL_AUTO_INC) &&
+		    (data->axi_ctrl & AXI_CNTL_WRITE) == AXI_CNTL_WRITE) {
+			ret = jtag_axi_emul_write32(dev, data->axi_addr, value);
+			data->axi_status = AXI_STATUS_DONE | (ret ? AXI_STATUS_WRITE_ERR : 0);
+			data->axi_addr += sizeof(uint32_t);
+		}
+		break;
+	case ARC_AXI_CONTROL_STATUS_TDR:
+		data->axi_ctrl = value;
+		if (jtag_axi_emul_reading(value)) {
+			(void)jtag_axi_emul_read32(dev, data->axi_addr, &data->axi_data);
+			data->axi_status = AXI_STATUS_DONE;
+		} else if (value & AXI_CNTL_AUTO_INC) {
+			/* Armed, writes happen on data TDR updates */
+		} else if ((value & AXI_CNTL_WRITE) == AXI_CNTL_WRITE) {
+			ret = jtag_axi_emul_write32(dev, data->axi_addr, data->axi_data);
+			data->axi_status = AXI_STATUS_DONE | (ret ? AXI_STATUS_WRITE_ERR : 0);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static int jtag_axi_emul_update_ir(const struct device *dev, uint32_t count, const uint8_t *scan)
+{
+	struct jtag_axi_emul_data *data = dev->data;
+
+	data->ir = jtag_axi_emul_scan_tail(count, scan, 32);
+	data->tdr = NO_TDR;
+
+	return 0;
+}
+
+/* A TDR select, or an update of the TDR selected by the previous scan */
+static int jtag_axi_emul_update_dr(const struct device *dev, bool idle, uint32_t count,
+				   const uint8_t *data_in, uint8_t *data_out)
+{
+	struct jtag_axi_emul_data *data = dev->data;
+	int tdr = data->tdr;
+	uint64_t out = 0;
+
+	ARG_UNUSED(idle);
+
+	if (tdr == NO_TDR) {
+		data->tdr = (int)jtag_axi_emul_scan_tail(count, data_in, TDR_SELECT_LEN) - 1;
+	} else {
+		data->tdr = NO_TDR;
+		out = (uint64_t)jtag_axi_emul_tdr_read(data, tdr) << TENSIX_SM_SIBLEN;
+		jtag_axi_emul_tdr_write(
+			dev, tdr, jtag_axi_emul_scan_tail(count, data_in, TDR_LEN) >> TENSIX_SM_SIBLEN);
+	}
+
+	if (data_out != NULL) {
+		memset(data_out, 0, DIV_ROUND_UP(count, 8));
+		for (uint32_t i = 0; i < MIN(count, 64); ++i) {
+			if (out & BIT64(i)) {
+				data_out[i / 8] |= BIT(i % 8);
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int jtag_axi_emul_reset(const struct device *dev)
+{
+	struct jtag_axi_emul_data *data = dev->data;
+
+	data->tdr = NO_TDR;
+
+	return 0;
+}
+
+static int jtag_axi_emul_read_id(const struct device *dev, uint32_t *id)
+{
+	*id = JTAG_AXI_EMUL_ID;
+
+	return 0;
+}
+
+static int jtag_axi_emul_nop(const struct device *dev)
+{
+	return 0;
+}
+
+static int jtag_axi_emul_tick(const struct device *dev, uint32_t count)
+{
+	return 0;
+}
+
+static const struct jtag_api jtag_axi_emul_api = {
+	.setup = jtag_axi_emul_nop,
+	.teardown = jtag_axi_emul_nop,
+	.tick = jtag_axi_emul_tick,
+	.reset = jtag_axi_emul_reset,
+	.read_id = jtag_axi_emul_read_id,
+	.update_ir = jtag_axi_emul_update_ir,
+	.update_dr = jtag_axi_emul_update_dr,
+	.axi_read32 = jtag_axi_emul_read32,
+	.axi_write32 = jtag_axi_emul_write32,
+	.axi_block_write = jtag_axi_emul_block_write,
+	.axi_block_read = jtag_axi_emul_block_read,
+};
+
+static int jtag_axi_emul_init(const struct device *dev)
+{
+	return jtag_axi_emul_reset(dev);
+}
+
+#define JTAG_AXI_EMUL_DEVICE_DEFINE(n)                                                             \
+	static struct jtag_axi_emul_data jtag_axi_emul_data_##n;                                   \
+                                                                                                   \
+	DEVICE_DT_INST_DEFINE(n, jtag_axi_emul_init, NULL, &jtag_axi_emul_data_##n, NULL,          \
+			      POST_KERNEL, CONFIG_JTAG_INIT_PRIO, &jtag_axi_emul_api);
+
+DT_INST_FOREACH_STATUS_OKAY(JTAG_AXI_EMUL_DEVICE_DEFINE)
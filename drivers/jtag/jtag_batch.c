@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "jtag_batch.h"
+
+#include <string.h>
+
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+/* TMS values, first cycle in bit 0, that take the TAP from one state to another */
+struct jtag_tms_path {
+	uint8_t tms;
+	uint8_t len;
+};
+
+/*
+ * Paths between the states a batch leaves the TAP in and the states scans start from.
+ *
+ * Scans that do not end in Run-Test/Idle are left in Exit1, so that the next scan goes through
+ * Update straight to Select-DR. IR scans start clocking in data at Capture-IR and DR scans at
+ * Shift-DR, which is the cycle timing the driver has always used with these TAPs.
+ */
+static const struct jtag_tms_path tms_path[EXIT1_IR + 1][SHIFT_DR + 1] = {
+	[JTAG_RESET] = {
+			[IDLE] = {0b0, 1},
+			[SCAN_DR] = {0b10, 2},
+			[CAPTURE_IR] = {0b0110, 4},
+			[SHIFT_DR] = {0b0010, 4},
+		},
+	[IDLE] = {
+			[SCAN_DR] = {0b1, 1},
+			[CAPTURE_IR] = {0b011, 3},
+			[SHIFT_DR] = {0b001, 3},
+		},
+	[SCAN_DR] = {
+			[CAPTURE_IR] = {0b01, 2},
+			[SHIFT_DR] = {0b00, 2},
+		},
+	[EXIT1_DR] = {
+			[IDLE] = {0b01, 2},
+			[SCAN_DR] = {0b11, 2},
+			[CAPTURE_IR] = {0b0111, 4},
+			[SHIFT_DR] = {0b0011, 4},
+		},
+	[EXIT1_IR] = {
+			[IDLE] = {0b01, 2},
+			[SCAN_DR] = {0b11, 2},
+			[CAPTURE_IR] = {0b0111, 4},
+			[SHIFT_DR] = {0b0011, 4},
+		},
+};
+
+static void jtag_batch_append(struct jtag_batch *batch, bool tms, bool tdi, bool capture)
+{
+	uint32_t word = batch->bits / 32;
+	uint32_t bit = BIT(batch->bits % 32);
+
+	__ASSERT_NO_MSG(batch->bits < CONFIG_JTAG_BATCH_BITS);
+
+	if (tms) {
+		batch->tms[word] |= bit;
+	}
+	if (tdi) {
+		batch->tdi[word] |= bit;
+	}
+	if (capture) {
+		batch->capture[word] |= bit;
+	}
+
+	batch->tdi_level = tdi;
+	++batch->bits;
+}
+
+void jtag_batch_init(struct jtag_batch *batch, enum jtag_state state)
+{
+	memset(batch, 0, sizeof(*batch));
+	batch->state = state;
+}
+
+void jtag_batch_clear(struct jtag_batch *batch)
+{
+	size_t words = DIV_ROUND_UP(batch->bits, 32);
+
+	memset(batch->tms, 0, words * sizeof(uint32_t));
+	memset(batch->tdi, 0, words * sizeof(uint32_t));
+	memset(batch->capture, 0, words * sizeof(uint32_t));
+	memset(batch->tdo, 0, words * sizeof(uint32_t));
+	batch->bits = 0;
+	batch->num_captures = 0;
+}
+
+/* Room is always left for the path that completes a pending update when the batch is flushed */
+bool jtag_batch_fits(const struct jtag_batch *batch, uint32_t bits, uint32_t captures)
+{
+	return (batch->bits + bits + JTAG_TMS_PATH_MAX <= CONFIG_JTAG_BATCH_BITS) &&
+	       (batch->num_captures + captures <= CONFIG_JTAG_BATCH_CAPTURES);
+}
+
+void jtag_batch_reset(struct jtag_batch *batch)
+{
+	for (int i = 0; i < 5; ++i) {
+		jtag_batch_append(batch, true, false, false);
+	}
+
+	batch->state = JTAG_RESET;
+}
+
+void jtag_batch_goto(struct jtag_batch *batch, enum jtag_state state)
+{
+	struct jtag_tms_path path = {0};
+
+	if (batch->state <= EXIT1_IR && state <= SHIFT_DR) {
+		path = tms_path[batch->state][state];
+	}
+
+	__ASSERT(path.len > 0 || batch->state == state, "no TMS path from %d to %d", batch->state,
+		 state);
+
+	for (uint8_t i = 0; i < path.len; ++i) {
+		jtag_batch_append(batch, path.tms & BIT(i), batch->tdi_level, false);
+	}
+
+	batch->state = state;
+}
+
+/*
+ * Shifts count bits of tdi, LSB first, and samples TDO into tdo if it is not NULL. The last
+ * shift of a scan moves the TAP to Exit1, otherwise it stays in Shift.
+ */
+void jtag_batch_shift(struct jtag_batch *batch, uint32_t count, uint64_t tdi, bool last,
+		      uint8_t *tdo)
+{
+	__ASSERT_NO_MSG(count > 0 && count <= JTAG_SHIFT_MAX);
+	__ASSERT_NO_MSG(batch->state == CAPTURE_IR || batch->state == SHIFT_IR ||
+			batch->state == SHIFT_DR);
+
+	if (tdo != NULL) {
+		__ASSERT_NO_MSG(batch->num_captures < CONFIG_JTAG_BATCH_CAPTURES);
+
+		batch->captures[batch->num_captures++] = (struct jtag_capture){
+			.data = tdo,
+			.offset = batch->bits,
+			.count = count,
+		};
+	}
+
+	for (uint32_t i = 0; i < count; ++i) {
+		jtag_batch_append(batch, last && (i == count - 1), (tdi >> i) & 1, tdo != NULL);
+	}
+
+	if (last) {
+		batch->state = (batch->state == SHIFT_DR) ? EXIT1_DR : EXIT1_IR;
+	} else if (batch->state == CAPTURE_IR) {
+		batch->state = SHIFT_IR;
+	}
+}
+
+void jtag_batch_ir(struct jtag_batch *batch, uint32_t count, uint64_t tdi)
+{
+	jtag_batch_goto(batch, CAPTURE_IR);
+	jtag_batch_shift(batch, count, tdi, true, NULL);
+}
+
+void jtag_batch_dr(struct jtag_batch *batch, uint32_t count, uint64_t tdi, uint8_t *tdo)
+{
+	jtag_batch_goto(batch, SHIFT_DR);
+	jtag_batch_shift(batch, count, tdi, true, tdo);
+}
+
+void jtag_batch_deliver(struct jtag_batch *batch)
+{
+	for (uint8_t i = 0; i < batch->num_captures; ++i) {
+		const struct jtag_capture *capture = &batch->captures[i];
+
+		memset(capture->data, 0, DIV_ROUND_UP(capture->count, 8));
+		for (uint32_t j = 0; j < capture->count; ++j) {
+			uint32_t bit = capture->offset + j;
+
+			if (batch->tdo[bit / 32] & BIT(bit % 32)) {
+				capture->data[j / 8] |= BIT(j % 8);
+			}
+		}
+	}
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_JTAG_JTAG_BATCH_H_
+#define ZEPHYR_DRIVERS_JTAG_JTAG_BATCH_H_
+
+#include "jtag_priv.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Longest TMS path jtag_batch_goto() queues */
+#define JTAG_TMS_PATH_MAX 5
+
+/* Longest shift queued by jtag_batch_shift() */
+#define JTAG_SHIFT_MAX 64
+
+void jtag_batch_init(struct jtag_batch *batch, enum jtag_state state);
+void jtag_batch_clear(struct jtag_batch *batch);
+bool jtag_batch_fits(const struct jtag_batch *batch, uint32_t bits, uint32_t captures);
+
+/* Test-Logic-Reset, by holding TMS high for 5 cycles */
+void jtag_batch_reset(struct jtag_batch *batch);
+void jtag_batch_goto(struct jtag_batch *batch, enum jtag_state state);
+void jtag_batch_shift(struct jtag_batch *batch, uint32_t count, uint64_t tdi, bool last,
+		      uint8_t *tdo);
+void jtag_batch_ir(struct jtag_batch *batch, uint32_t count, uint64_t tdi);
+void jtag_batch_dr(struct jtag_batch *batch, uint32_t count, uint64_t tdi, uint8_t *tdo);
+
+/* Stores the sampled TDO bits of all captured scans */
+void jtag_batch_deliver(struct jtag_batch *batch);
+
+#endif
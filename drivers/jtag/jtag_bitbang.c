@@ -6,11 +6,12 @@
 
 #include "axi.h"
 #include "jtag_profile_functions.h"
-#include "tenstorrent/bitrev.h"
 
+#include "jtag_batch.h"
 #include "jtag_priv.h"
 
 #include <stdint.h>
+#include <string.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/gpio/gpio_emul.h>
@@ -25,8 +26,6 @@
 #define MST_TAP_OP_ISCAN_SEL (2)
 #define MST_TAP_OP_DEVID_SEL (6)
 #define TENSIX_SM_RTAP       (0x19e)
-#define TENSIX_SM_SIBLEN     (4)
-#define TENSIX_SM_TDRLEN     (32)
 
 #define TENSIX_SIBLEN_PLUS_1_OR_0   ((TENSIX_SM_SIBLEN > 0) ? (TENSIX_SM_SIBLEN + 1) : 0)
 #define TENSIX_TDRLEN_SIBLEN_PLUS_1 (1 + TENSIX_SM_TDRLEN + TENSIX_SM_SIBLEN)
@@ -58,6 +57,10 @@ static uint32_t io_ops;
 
 LOG_MODULE_REGISTER(jtag_bitbang, CONFIG_JTAG_LOG_LEVEL);
 
+/*
+ * TCK, TMS and TDI are written through the pin masks in struct jtag_data, so that the pins of
+ * ganged devices on the same ports change with a single port write.
+ */
 #ifdef CONFIG_JTAG_USE_MMAPPED_IO
 
 #define TCK_BSSR(config) (config->tck_reg + 6)
@@ -67,34 +70,34 @@ LOG_MODULE_REGISTER(jtag_bitbang, CONFIG_JTAG_LOG_LEVEL);
 
 #define TDO_IN(config) (config->tdo_reg + 4)
 
-#define TCK_HIGH(config) (1 << config->tck.pin)
-#define TCK_LOW(config)  (1 << (config->tck.pin + 16))
-#define SET_TCK(config)  (*TCK_BSSR(config) = TCK_HIGH(config))
-#define CLR_TCK(config)  (*TCK_BSSR(config) = TCK_LOW(config))
+#define TCK_HIGH(data)        (data->tck_pins)
+#define TCK_LOW(data)         (data->tck_pins << 16)
+#define SET_TCK(config, data) (*TCK_BSSR(config) = TCK_HIGH(data))
+#define CLR_TCK(config, data) (*TCK_BSSR(config) = TCK_LOW(data))
 
-#define TDI_HIGH(dev)        (1 << config->tdi.pin)
-#define TDI_LOW(config)      (1 << (config->tdi.pin + 16))
-#define SET_TDI(config)      (*TDI_BSSR(config) = TDI_HIGH(config))
-#define CLR_TDI(config)      (*TDI_BSSR(config) = TDI_LOW(config))
-#define IF_TDI(config, stmt) (*TDI_BSSR(config) = stmt ? TDI_HIGH(config) : TDI_LOW(config))
+#define TDI_HIGH(data)             (data->tdi_pins)
+#define TDI_LOW(data)              (data->tdi_pins << 16)
+#define SET_TDI(config, data)      (*TDI_BSSR(config) = TDI_HIGH(data))
+#define CLR_TDI(config, data)      (*TDI_BSSR(config) = TDI_LOW(data))
+#define IF_TDI(config, data, stmt) (*TDI_BSSR(config) = stmt ? TDI_HIGH(data) : TDI_LOW(data))
 
 #define TDO_MSK(config) (1 << config->tdo.pin)
 #define GET_TDO(config) ((*TDO_IN(config) & TDO_MSK(config)) != 0)
 
-#define TMS_HIGH(config) (1 << config->tms.pin)
-#define TMS_LOW(config)  (1 << (config->tms.pin + 16))
-#define SET_TMS(config)  (*TMS_BSSR(config) = TMS_HIGH(config))
-#define CLR_TMS(config)  (*TMS_BSSR(config) = TMS_LOW(config))
+#define TMS_HIGH(data)        (data->tms_pins)
+#define TMS_LOW(data)         (data->tms_pins << 16)
+#define SET_TMS(config, data) (*TMS_BSSR(config) = TMS_HIGH(data))
+#define CLR_TMS(config, data) (*TMS_BSSR(config) = TMS_LOW(data))
 
 #else /* CONFIG_JTAG_USE_MMAPPED_IO */
 
 #ifdef CONFIG_JTAG_PROFILE_FUNCTIONS
 
-#define SET_TCK(x) IO_OPS_INC()
-#define CLR_TCK(x) IO_OPS_INC()
+#define SET_TCK(x, y) IO_OPS_INC()
+#define CLR_TCK(x, y) IO_OPS_INC()
 
-#define SET_TDI(x) IO_OPS_INC()
-#define CLR_CLR(x) IO_OPS_INC()
+#define SET_TDI(x, y) IO_OPS_INC()
+#define CLR_TDI(x, y) IO_OPS_INC()
 
 static bool GET_TDO(const struct jtag_config *config)
 {
@@ -102,27 +105,27 @@ static bool GET_TDO(const struct jtag_config *config)
 	return true;
 }
 
-#define SET_TMS(x) IO_OPS_INC()
-#define CLR_TMS(x) IO_OPS_INC()
+#define SET_TMS(x, y) IO_OPS_INC()
+#define CLR_TMS(x, y) IO_OPS_INC()
 
 #else
 
-static void SET_TCK(const struct jtag_config *config)
+static void SET_TCK(const struct jtag_config *config, const struct jtag_data *data)
 {
-	gpio_pin_set_dt(&config->tck, 1);
+	gpio_port_set_bits(config->tck.port, data->tck_pins);
 }
-static void CLR_TCK(const struct jtag_config *config)
+static void CLR_TCK(const struct jtag_config *config, const struct jtag_data *data)
 {
-	gpio_pin_set_dt(&config->tck, 0);
+	gpio_port_clear_bits(config->tck.port, data->tck_pins);
 }
 
-static void SET_TDI(const struct jtag_config *config)
+static void SET_TDI(const struct jtag_config *config, const struct jtag_data *data)
 {
-	gpio_pin_set_dt(&config->tdi, 1);
+	gpio_port_set_bits(config->tdi.port, data->tdi_pins);
 }
-static void CLR_TDI(const struct jtag_config *config)
+static void CLR_TDI(const struct jtag_config *config, const struct jtag_data *data)
 {
-	gpio_pin_set_dt(&config->tdi, 0);
+	gpio_port_clear_bits(config->tdi.port, data->tdi_pins);
 }
 
 static bool GET_TDO(const struct jtag_config *config)
@@ -130,185 +133,187 @@ static bool GET_TDO(const struct jtag_config *config)
 	return gpio_pin_get_dt(&config->tdo);
 }
 
-static void SET_TMS(const struct jtag_config *config)
+static void SET_TMS(const struct jtag_config *config, const struct jtag_data *data)
 {
-	gpio_pin_set_dt(&config->tms, 1);
+	gpio_port_set_bits(config->tms.port, data->tms_pins);
 }
-static void CLR_TMS(const struct jtag_config *config)
+static void CLR_TMS(const struct jtag_config *config, const struct jtag_data *data)
 {
-	gpio_pin_set_dt(&config->tms, 0);
+	gpio_port_clear_bits(config->tms.port, data->tms_pins);
 }
 
 #endif /* CONFIG_JTAG_PROFILE_FUNCTIONS */
 
-#define IF_TDI(config, stmt)                                                                       \
+#define IF_TDI(config, data, stmt)                                                                 \
 	do {                                                                                       \
 		if (stmt) {                                                                        \
-			SET_TDI(config);                                                           \
+			SET_TDI(config, data);                                                     \
 		} else {                                                                           \
-			CLR_TDI(config);                                                           \
+			CLR_TDI(config, data);                                                     \
 		}                                                                                  \
 	} while (0)
 
 #endif /* CONFIG_JTAG_USE_MMAPPED_IO */
 
-static ALWAYS_INLINE void jtag_bitbang_tick(const struct device *dev, uint32_t count)
+/*
+ * Clocks out the queued scans, one TCK cycle per bit. TMS and TDI are only written when they
+ * change, and TDO is only sampled on cycles that capture it.
+ */
+static void jtag_bitbang_flush(const struct device *dev)
 {
 	const struct jtag_config *config = dev->config;
+	struct jtag_data *data = dev->data;
+	struct jtag_batch *batch = &data->batch;
+	bool tms = data->tms_level;
+	bool tdi = data->tdi_level;
+
+	/* A scan left in Exit1 still has to be updated */
+	if (batch->state == EXIT1_DR || batch->state == EXIT1_IR) {
+		jtag_batch_goto(batch, SCAN_DR);
+	}
+
+	for (uint32_t i = 0; i < batch->bits; ++i) {
+		uint32_t word = i / 32;
+		uint32_t bit = BIT(i % 32);
+
+		if (((batch->tms[word] & bit) != 0) != tms) {
+			tms = !tms;
+			if (tms) {
+				SET_TMS(config, data);
+			} else {
+				CLR_TMS(config, data);
+			}
+		}
+
+		if (((batch->tdi[word] & bit) != 0) != tdi) {
+			tdi = !tdi;
+			IF_TDI(config, data, tdi);
+		}
+
+		if ((batch->capture[word] & bit) && GET_TDO(config)) {
+			batch->tdo[word] |= bit;
+		}
+
+		SET_TCK(config, data);
+		CLR_TCK(config, data);
+	}
+
+	data->tms_level = tms;
+	data->tdi_level = tdi;
+
+	jtag_batch_deliver(batch);
+	jtag_batch_clear(batch);
+}
+
+/* Makes room in the batch, clocking out what is already queued if needed */
+static void jtag_bitbang_reserve(const struct device *dev, uint32_t bits, uint32_t captures)
+{
+	struct jtag_data *data = dev->data;
 
-	for (; count > 0; --count) {
-		CLR_TCK(config);
-		SET_TCK(config);
+	if (!jtag_batch_fits(&data->batch, bits, captures)) {
+		jtag_bitbang_flush(dev);
 	}
-	CLR_TCK(config);
 }
 
 int jtag_bitbang_reset(const struct device *dev)
 {
 	const struct jtag_config *config = dev->config;
+	struct jtag_data *data = dev->data;
 
 	if (config->trst.port != NULL) {
 		gpio_pin_set_dt(&config->trst, 1);
 		k_busy_wait(100);
 		gpio_pin_set_dt(&config->trst, 0);
 	}
-	CLR_TDI(config);
-	SET_TMS(config);
-
-	jtag_bitbang_tick(dev, 5);
-
-	CLR_TMS(config);
 
-	jtag_bitbang_tick(dev, 1);
+	jtag_bitbang_flush(dev);
+	jtag_batch_reset(&data->batch);
+	jtag_batch_goto(&data->batch, IDLE);
+	jtag_bitbang_flush(dev);
 
 	return 0;
 }
 
-static ALWAYS_INLINE void jtag_bitbang_update_ir(const struct device *dev, uint32_t count,
-						 uint64_t data)
+static ALWAYS_INLINE void jtag_bitbang_queue_ir(const struct device *dev, uint32_t count,
+						uint64_t data_in)
 {
-	const struct jtag_config *config = dev->config;
-
-	/* Select IR scan */
-	SET_TMS(config);
-	jtag_bitbang_tick(dev, 2);
-
-	/* Capture IR */
-	CLR_TMS(config);
-	jtag_bitbang_tick(dev, 1);
-
-	/* Shift IR */
-	for (; count > 1; --count, data >>= 1) {
-		IF_TDI(config, data & 0x1);
-		jtag_bitbang_tick(dev, 1);
-	}
+	struct jtag_data *data = dev->data;
 
-	/* Exit IR */
-	SET_TMS(config);
-	IF_TDI(config, data & 0x1);
-	jtag_bitbang_tick(dev, 1);
-
-	/* Select DR scan */
-	SET_TMS(config);
-	jtag_bitbang_tick(dev, 2);
+	jtag_bitbang_reserve(dev, JTAG_TMS_PATH_MAX + count, 0);
+	jtag_batch_ir(&data->batch, count, data_in);
 }
 
-static ALWAYS_INLINE uint64_t jtag_bitbang_xfer_dr(const struct device *dev, uint32_t count,
-						   uint64_t data_in, bool idle, bool capture)
+/* Queues a DR scan of up to 64 bits, capturing TDO into data_out if it is not NULL */
+static ALWAYS_INLINE void jtag_bitbang_queue_dr(const struct device *dev, uint32_t count,
+						uint64_t data_in, bool idle, uint8_t *data_out)
 {
-	if (count == 0) {
-		return 0;
-	}
-
-	const struct jtag_config *config = dev->config;
+	struct jtag_data *data = dev->data;
 
-	uint64_t starting_count = count;
-	uint64_t data_out = 0;
+	jtag_bitbang_reserve(dev, 2 * JTAG_TMS_PATH_MAX + count, data_out != NULL);
+	jtag_batch_dr(&data->batch, count, data_in, data_out);
 
-	/* DR Scan */
-	CLR_TMS(config);
-	jtag_bitbang_tick(dev, 1);
-
-	/* Capture DR */
-	jtag_bitbang_tick(dev, 1);
-
-	/* Shift DR */
-	for (; count > 1; --count, data_in >>= 1) {
-		IF_TDI(config, data_in & 0x1);
-		if (capture) {
-			data_out |= GET_TDO(config);
-			data_out <<= 1;
-		}
-		jtag_bitbang_tick(dev, 1);
-	}
-	SET_TMS(config);
-	IF_TDI(config, data_in & 0x1);
-	if (capture) {
-		data_out |= GET_TDO(config);
+	if (idle) {
+		jtag_batch_goto(&data->batch, IDLE);
 	}
-	jtag_bitbang_tick(dev, 1);
+}
 
-	/* Exit DR */
-	jtag_bitbang_tick(dev, 1);
+/* A scan of any length, split into shifts of up to 64 bits */
+static int jtag_bitbang_scan(const struct device *dev, bool ir, bool idle, uint32_t count,
+			     const uint8_t *data_in, uint8_t *data_out)
+{
+	struct jtag_data *data = dev->data;
 
-	if (idle) {
-		/* Update DR */
-		CLR_TMS(config);
-		jtag_bitbang_tick(dev, 1);
+	jtag_bitbang_reserve(dev, JTAG_TMS_PATH_MAX, 0);
+	jtag_batch_goto(&data->batch, ir ? CAPTURE_IR : SHIFT_DR);
 
-		/* Idle */
-	} else {
-		/* Update DR */
-		jtag_bitbang_tick(dev, 1);
+	for (uint32_t i = 0; i < count; i += JTAG_SHIFT_MAX) {
+		uint32_t n = MIN(count - i, JTAG_SHIFT_MAX);
+		uint64_t bits = 0;
 
-		/* DR scan */
+		memcpy(&bits, &data_in[i / 8], DIV_ROUND_UP(n, 8));
+		jtag_bitbang_reserve(dev, JTAG_TMS_PATH_MAX + n, data_out != NULL);
+		jtag_batch_shift(&data->batch, n, sys_le64_to_cpu(bits), i + n == count,
+				 (data_out != NULL) ? &data_out[i / 8] : NULL);
 	}
 
-	if (capture) {
-		data_out <<= 64 - starting_count;
-		data_out = bitrev64(data_out);
+	if (idle) {
+		jtag_batch_goto(&data->batch, IDLE);
 	}
+	jtag_bitbang_flush(dev);
 
-	return data_out;
-}
-
-static ALWAYS_INLINE uint64_t jtag_bitbang_capture_dr_idle(const struct device *dev, uint32_t count,
-							   uint64_t data_in)
-{
-	return jtag_bitbang_xfer_dr(dev, count, data_in, true, true);
-}
-
-static ALWAYS_INLINE uint64_t jtag_bitbang_capture_dr(const struct device *dev, uint32_t count,
-						      uint64_t data_in)
-{
-	return jtag_bitbang_xfer_dr(dev, count, data_in, false, true);
+	return 0;
 }
 
-static ALWAYS_INLINE void jtag_bitbang_update_dr_idle(const struct device *dev, uint32_t count,
-						      uint64_t data_in)
+static int jtag_bitbang_update_ir(const struct device *dev, uint32_t count, const uint8_t *data)
 {
-	(void)jtag_bitbang_xfer_dr(dev, count, data_in, true, false);
+	return jtag_bitbang_scan(dev, true, false, count, data, NULL);
 }
 
-static ALWAYS_INLINE void jtag_bitbang_update_dr(const struct device *dev, uint32_t count,
-						 uint64_t data_in)
+static int jtag_bitbang_update_dr(const struct device *dev, bool idle, uint32_t count,
+				  const uint8_t *data_in, uint8_t *data_out)
 {
-	(void)jtag_bitbang_xfer_dr(dev, count, data_in, false, false);
+	return jtag_bitbang_scan(dev, false, idle, count, data_in, data_out);
 }
 
 int jtag_bitbang_read_id(const struct device *dev, uint32_t *id)
 {
 	uint32_t tap_addr = 6;
+	uint8_t data_out[sizeof(uint32_t)];
+
+	jtag_bitbang_queue_ir(dev, 24, tap_addr);
+	jtag_bitbang_queue_dr(dev, 32, 0, true, data_out);
+	jtag_bitbang_flush(dev);
 
-	jtag_bitbang_update_ir(dev, 24, tap_addr);
-	*id = jtag_bitbang_capture_dr_idle(dev, 32, 0);
+	*id = sys_get_le32(data_out);
 	return 0;
 }
 
 int jtag_bitbang_setup(const struct device *dev)
 {
 	const struct jtag_config *config = dev->config;
-	int ret = gpio_pin_configure_dt(&config->tck, GPIO_OUTPUT_ACTIVE) ||
+	struct jtag_data *data = dev->data;
+	/* TCK idles low, so that every queued cycle is a rising then a falling edge */
+	int ret = gpio_pin_configure_dt(&config->tck, GPIO_OUTPUT_INACTIVE) ||
 		  gpio_pin_configure_dt(&config->tdi, GPIO_OUTPUT_ACTIVE) ||
 		  gpio_pin_configure_dt(&config->tdo, GPIO_INPUT) ||
 		  gpio_pin_configure_dt(&config->tms, GPIO_OUTPUT_ACTIVE);
@@ -320,6 +325,9 @@ int jtag_bitbang_setup(const struct device *dev)
 		return ret;
 	}
 
+	data->tms_level = true;
+	data->tdi_level = true;
+
 #ifdef CONFIG_JTAG_USE_MMAPPED_IO
 	volatile uint32_t *TCK_SPEED = (volatile uint32_t *)config->tck_reg + 2;
 	volatile uint32_t *TDI_SPEED = (volatile uint32_t *)config->tdi_reg + 2;
@@ -375,126 +383,352 @@ static ALWAYS_INLINE void jtag_setup_access(const struct device *dev, uint32_t r
 		(rtap_addr >> (INSTR_REG_BISTEN_SEL_END_0 - INSTR_REG_BISTEN_SEL_START_0 + 1)) &
 		INSTR_REG_BISTEN_SEL_MASK_1;
 
-	jtag_bitbang_update_ir(dev, 24, instrn.val);
+	jtag_bitbang_queue_ir(dev, 24, instrn.val);
 }
 
-static ALWAYS_INLINE uint32_t jtag_access_rtap_tdr_idle(const struct device *dev,
-							uint32_t rtap_addr, uint32_t tdr_addr,
-							uint32_t wrdata)
-{
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	return SIBSHIFT(jtag_bitbang_capture_dr_idle(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1,
-						     SIBSHIFTUP((uint64_t)wrdata)));
-}
-
-static ALWAYS_INLINE uint32_t jtag_access_rtap_tdr(const struct device *dev, uint32_t rtap_addr,
-						   uint32_t tdr_addr, uint32_t wrdata)
+/*
+ * Queues a TDR select and write. The previous TDR value is captured into rddata if it is not
+ * NULL, and can be read with jtag_tdr_value() once the batch is flushed.
+ */
+static ALWAYS_INLINE void jtag_access_rtap_tdr(const struct device *dev, uint32_t tdr_addr,
+						uint32_t wrdata, bool idle, uint8_t *rddata)
 {
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	return SIBSHIFT(jtag_bitbang_capture_dr(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1,
-						SIBSHIFTUP((uint64_t)wrdata)));
+	jtag_bitbang_queue_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1, false, NULL);
+	jtag_bitbang_queue_dr(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1, SIBSHIFTUP((uint64_t)wrdata), idle,
+			      rddata);
 }
 
-static ALWAYS_INLINE void jtag_wr_tensix_sm_rtap_tdr_idle(const struct device *dev,
-							  uint32_t tdr_addr, uint32_t wrvalue)
+static ALWAYS_INLINE uint32_t jtag_tdr_value(const uint8_t *rddata)
 {
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	jtag_bitbang_update_dr_idle(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1,
-				    SIBSHIFTUP((uint64_t)wrvalue));
+	return SIBSHIFT(sys_get_le64(rddata));
 }
 
 static ALWAYS_INLINE void jtag_wr_tensix_sm_rtap_tdr(const struct device *dev, uint32_t tdr_addr,
-						     uint32_t wrvalue)
+						     uint32_t wrvalue, bool idle)
 {
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	jtag_bitbang_update_dr(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1, SIBSHIFTUP((uint64_t)wrvalue));
+	jtag_access_rtap_tdr(dev, tdr_addr, wrvalue, idle, NULL);
 }
 
-static ALWAYS_INLINE uint32_t jtag_rd_tensix_sm_rtap_tdr_idle(const struct device *dev,
-							      uint32_t tdr_addr)
+static ALWAYS_INLINE void jtag_rd_tensix_sm_rtap_tdr(const struct device *dev, uint32_t tdr_addr,
+						     bool idle, uint8_t *rddata)
 {
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	return SIBSHIFT(jtag_bitbang_capture_dr_idle(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1, 0));
-}
-
-static ALWAYS_INLINE uint32_t jtag_rd_tensix_sm_rtap_tdr(const struct device *dev,
-							 uint32_t tdr_addr)
-{
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	return SIBSHIFT(jtag_bitbang_capture_dr(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1, 0));
+	jtag_access_rtap_tdr(dev, tdr_addr, 0, idle, rddata);
 }
 
 void jtag_req_clear(const struct device *dev)
 {
 	jtag_setup_access(dev, TENSIX_SM_RTAP);
-
-	jtag_wr_tensix_sm_rtap_tdr_idle(dev, 2, AXI_CNTL_CLEAR);
+	jtag_wr_tensix_sm_rtap_tdr(dev, 2, AXI_CNTL_CLEAR, true);
+	jtag_bitbang_flush(dev);
 }
 
 int jtag_axiread(const struct device *dev, uint32_t addr, uint32_t *result)
 {
-	jtag_setup_access(dev, TENSIX_SM_RTAP);
+	uint8_t rddata[sizeof(uint64_t)] = {0};
+	uint32_t axi_status = 1;
 
-	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_ADDR_TDR, addr);
+	jtag_setup_access(dev, TENSIX_SM_RTAP);
 
-	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_READ);
+	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_ADDR_TDR, addr, false);
 
-	uint32_t axi_status = 1;
+	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_READ, false);
 
+	/* The first status read goes out in the same batch as the request */
 	for (int i = 0; i < 1000; ++i) {
-		axi_status = jtag_rd_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR);
+		jtag_rd_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, false, rddata);
+		jtag_bitbang_flush(dev);
+
+		axi_status = jtag_tdr_value(rddata);
 		if ((axi_status & 0xF) != 0) {
 			break;
 		}
 	}
 
 	/* Read data */
-	uint32_t axi_rddata = jtag_rd_tensix_sm_rtap_tdr_idle(dev, ARC_AXI_DATA_TDR);
+	jtag_rd_tensix_sm_rtap_tdr(dev, ARC_AXI_DATA_TDR, true, rddata);
+	jtag_bitbang_flush(dev);
 
-	*result = axi_rddata;
+	*result = jtag_tdr_value(rddata);
 	return (axi_status & 0xF) != 0 ? 0 : -1;
 }
 
 int jtag_axiwrite(const struct device *dev, uint32_t addr, uint32_t value)
 {
+	uint8_t rddata[sizeof(uint64_t)] = {0};
+
+	/* The whole write, including the status read, is clocked out as one batch */
 	jtag_setup_access(dev, TENSIX_SM_RTAP);
 
-	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_ADDR_TDR, addr);
-	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_DATA_TDR, value);
+	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_ADDR_TDR, addr, false);
+	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_DATA_TDR, value, false);
 
-	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_WRITE);
+	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_WRITE, false);
+
+	jtag_rd_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, true, rddata);
+	jtag_bitbang_flush(dev);
 
 	/* Upper 16 bits contain write status; if first bit 1 then we passed otherwsie */
 	/* fail */
-	return ((jtag_rd_tensix_sm_rtap_tdr_idle(dev, ARC_AXI_CONTROL_STATUS_TDR) >> 16) & 1) != 1
-		       ? 0
-		       : -1;
+	return ((jtag_tdr_value(rddata) >> 16) & 1) != 1 ? 0 : -1;
 }
 
+static ALWAYS_INLINE int jtag_axi_write_status(uint32_t axi_status)
+{
+	return (axi_status & AXI_STATUS_WRITE_ERR) ? -EIO : 0;
+}
+
+/*
+ * Start an auto-increment run at addr. The control TDR update only arms the bridge, the
+ * transfers themselves are started by the data TDR updates that follow.
+ */
+static ALWAYS_INLINE void jtag_axi_auto_inc_start(const struct device *dev, uint32_t addr,
+						  uint32_t cntl)
+{
+	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_ADDR_TDR, addr, false);
+	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, cntl | AXI_CNTL_AUTO_INC, false);
+}
+
+/*
+ * Stream a block of words over AXI.
+ *
+ * The TAP is selected once for the whole block and the write status is only read back every
+ * CONFIG_JTAG_AXI_BLOCK_STATUS_INTERVAL words and at the end of the block. With
+ * CONFIG_JTAG_AXI_AUTO_INCREMENT, the address is also only shifted once per run of words and
+ * each word costs a single data TDR update. Words are clocked out whenever the batch fills up.
+ *
+ * Capturing the status also updates the control TDR. The status reads shift in
+ * AXI_CNTL_CLEAR, which is known not to start a transaction (see jtag_req_clear()), rather than
+ * shifting the armed control value back in. That ends the auto-increment run, so the next run
+ * starts with its own address and control updates, exactly like the start of the block.
+ */
 int jtag_axi_blockwrite(const struct device *dev, uint32_t addr, const uint32_t *value,
 			uint32_t len)
 {
 	int result = 0;
+	uint8_t rddata[sizeof(uint64_t)] = {0};
+
+	if (len == 0) {
+		return 0;
+	}
+
+	CYCLES_ENTRY();
+	jtag_setup_access(dev, TENSIX_SM_RTAP);
+
+	if (IS_ENABLED(CONFIG_JTAG_AXI_AUTO_INCREMENT)) {
+		jtag_axi_auto_inc_start(dev, addr, AXI_CNTL_WRITE);
+	}
+
+	for (uint32_t i = 0; i < len; ++i) {
+		if (!IS_ENABLED(CONFIG_JTAG_AXI_AUTO_INCREMENT)) {
+			jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_ADDR_TDR, addr + (4 * i), false);
+		}
+
+		jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_DATA_TDR, value[i], false);
+
+		if (!IS_ENABLED(CONFIG_JTAG_AXI_AUTO_INCREMENT)) {
+			jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_WRITE,
+						   false);
+		}
+
+		if ((CONFIG_JTAG_AXI_BLOCK_STATUS_INTERVAL > 0) && (i + 1 < len) &&
+		    ((i + 1) % MAX(CONFIG_JTAG_AXI_BLOCK_STATUS_INTERVAL, 1) == 0)) {
+			jtag_access_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_CLEAR, false,
+					     rddata);
+			jtag_bitbang_flush(dev);
+			result |= jtag_axi_write_status(jtag_tdr_value(rddata));
+
+			if (IS_ENABLED(CONFIG_JTAG_AXI_AUTO_INCREMENT)) {
+				jtag_axi_auto_inc_start(dev, addr + (4 * (i + 1)), AXI_CNTL_WRITE);
+			}
+		}
+	}
+
+	/* Final status check, which also disarms auto-increment */
+	jtag_access_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_CLEAR, true, rddata);
+	jtag_bitbang_flush(dev);
+	result |= jtag_axi_write_status(jtag_tdr_value(rddata));
+	CYCLES_EXIT();
+
+	return result;
+}
+
+static ALWAYS_INLINE int jtag_axi_read_status(uint32_t axi_status)
+{
+	return (axi_status & AXI_STATUS_DONE) ? 0 : -EIO;
+}
+
+/*
+ * Read a block of words over AXI.
+ *
+ * Rather than polling the status of every read, the reads are queued back to back, with the
+ * data TDR of each word captured two TDR scans after its read is started. The control TDR
+ * update that starts each read captures the status of the read before it, so a word whose read
+ * had not completed still fails the block. With CONFIG_JTAG_AXI_AUTO_INCREMENT, the address is
+ * also only shifted once and each word costs a single data TDR read, which starts the read of
+ * the next, and only the status at the end of the block is checked. Words are clocked out
+ * whenever CONFIG_JTAG_BATCH_CAPTURES of their captures are queued.
+ *
+ * The last word is read without auto-increment, so that capturing it does not start a read
+ * past the end of the block.
+ */
+int jtag_axi_blockread(const struct device *dev, uint32_t addr, uint32_t *value, uint32_t len)
+{
+	uint8_t rddata[CONFIG_JTAG_BATCH_CAPTURES][sizeof(uint64_t)] = {0};
+	/* Status of the previous word's read, captured when the next one is started */
+	uint8_t prev_status[CONFIG_JTAG_BATCH_CAPTURES][sizeof(uint64_t)] = {0};
+	uint8_t status[sizeof(uint64_t)] = {0};
+	const bool auto_inc = IS_ENABLED(CONFIG_JTAG_AXI_AUTO_INCREMENT) && (len > 1);
+	/* Without auto-increment, each word captures its data and a status */
+	const uint32_t words = auto_inc ? ARRAY_SIZE(rddata) : MAX(ARRAY_SIZE(rddata) / 2, 1);
+	uint32_t queued = 0;
+	int result = 0;
+
+	if (len == 0) {
+		return 0;
+	}
 
 	CYCLES_ENTRY();
-	for (int i = 0; i < len; ++i) {
-		result |= jtag_axiwrite(dev, addr + (4 * i), value[i]);
+	jtag_setup_access(dev, TENSIX_SM_RTAP);
+
+	if (auto_inc) {
+		jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_ADDR_TDR, addr, false);
+		jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR,
+					   AXI_CNTL_READ | AXI_CNTL_AUTO_INC, false);
+	}
+
+	for (uint32_t i = 0; i < len; ++i) {
+		if (!auto_inc || (i + 1 == len)) {
+			jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_ADDR_TDR, addr + (4 * i), false);
+			jtag_access_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_READ,
+					     false, auto_inc ? NULL : prev_status[queued]);
+		}
+
+		jtag_rd_tensix_sm_rtap_tdr(dev, ARC_AXI_DATA_TDR, false, rddata[queued++]);
+
+		if (queued == words || i + 1 == len) {
+			jtag_bitbang_flush(dev);
+			for (uint32_t k = 0; k < queued; ++k) {
+				uint32_t word = i + 1 - queued + k;
+
+				value[word] = jtag_tdr_value(rddata[k]);
+				/* The status captured before the first read predates the block */
+				if (!auto_inc && word > 0) {
+					result |= jtag_axi_read_status(
+						jtag_tdr_value(prev_status[k]));
+				}
+			}
+			queued = 0;
+		}
 	}
+
+	/* Final status check, for the last read */
+	jtag_access_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_CLEAR, true, status);
+	jtag_bitbang_flush(dev);
+	result |= jtag_axi_read_status(jtag_tdr_value(status));
 	CYCLES_EXIT();
 
 	return result;
 }
 
+static void jtag_bitbang_ungang(const struct device *dev)
+{
+	const struct jtag_config *config = dev->config;
+	struct jtag_data *data = dev->data;
+	const struct device *other = data->gang_next;
+
+	while (other != NULL) {
+		struct jtag_data *other_data = other->data;
+
+		/* The follower's TAP went through everything the leader clocked out */
+		jtag_batch_init(&other_data->batch, data->batch.state);
+		other_data->tms_level = data->tms_level;
+		other_data->tdi_level = data->tdi_level;
+		other_data->gang_follower = false;
+
+		other = other_data->gang_next;
+		other_data->gang_next = NULL;
+	}
+
+	data->gang_next = NULL;
+	data->tck_pins = BIT(config->tck.pin);
+	data->tms_pins = BIT(config->tms.pin);
+	data->tdi_pins = BIT(config->tdi.pin);
+}
+
+/*
+ * Adds the pins of other to the ones written by dev. Both TAPs are reset so that they start from
+ * the same state, and the TMS and TDI pins of other are brought to the levels of dev's, since
+ * the emitter only writes them when they change.
+ */
+static int jtag_bitbang_gang(const struct device *dev, const struct device *other)
+{
+	const struct jtag_config *config = dev->config;
+	struct jtag_data *data = dev->data;
+	const struct jtag_config *other_config;
+	struct jtag_data *other_data;
+
+	if (data->gang_follower) {
+		return -EINVAL;
+	}
+
+	jtag_bitbang_flush(dev);
+
+	if (other == NULL) {
+		jtag_bitbang_ungang(dev);
+		return 0;
+	}
+
+	if (other == dev || other->api != dev->api) {
+		return -EINVAL;
+	}
+
+	other_config = other->config;
+	other_data = other->data;
+	if (other_data->gang_follower || other_data->gang_next != NULL) {
+		return -EBUSY;
+	}
+
+	if (other_config->tck.port != config->tck.port ||
+	    other_config->tms.port != config->tms.port ||
+	    other_config->tdi.port != config->tdi.port) {
+		return -ENOTSUP;
+	}
+
+	jtag_bitbang_reset(other);
+	jtag_bitbang_reset(dev);
+
+	gpio_pin_set_dt(&other_config->tms, data->tms_level);
+	gpio_pin_set_dt(&other_config->tdi, data->tdi_level);
+
+	other_data->gang_follower = true;
+	other_data->gang_next = data->gang_next;
+	data->gang_next = other;
+	data->tck_pins |= BIT(other_config->tck.pin);
+	data->tms_pins |= BIT(other_config->tms.pin);
+	data->tdi_pins |= BIT(other_config->tdi.pin);
+
+	return 0;
+}
+
 static struct jtag_api jtag_bitbang_api = {.setup = jtag_bitbang_setup,
 					   .teardown = jtag_bitbang_teardown,
 					   .read_id = jtag_bitbang_read_id,
 					   .reset = jtag_bitbang_reset,
+					   .update_ir = jtag_bitbang_update_ir,
+					   .update_dr = jtag_bitbang_update_dr,
 					   .axi_read32 = jtag_axiread,
 					   .axi_write32 = jtag_axiwrite,
-					   .axi_block_write = jtag_axi_blockwrite};
+					   .axi_block_write = jtag_axi_blockwrite,
+					   .axi_block_read = jtag_axi_blockread,
+					   .gang = jtag_bitbang_gang};
 
 static int jtag_bitbang_init(const struct device *dev)
 {
+	struct jtag_data *data = dev->data;
+
+	jtag_batch_init(&data->batch, IDLE);
+	jtag_bitbang_ungang(dev);
+
 	return 0;
 }
 
@@ -82,8 +82,12 @@ static void gpio_emul_callback(const struct device *port, struct gpio_callback *
 	struct jtag_data *data = CONTAINER_OF(cb, struct jtag_data, gpio_emul_cb);
 	struct jtag_emul_data *edata = &data->emul_data;
 
-	/* This function should _only_ be called when the TCK pin changes */
-	__ASSERT_NO_MSG(pins & BIT(data->tck.pin));
+	/* Every write of TCK, TMS or TDI, whether or not the level changes */
+	edata->io_count += POPCOUNT(pins & cb->pin_mask);
+
+	if (!(pins & BIT(data->tck.pin))) {
+		return;
+	}
 
 	bool _tck = tck(data);
 	bool _tms = tms(data);
@@ -96,6 +100,12 @@ static void gpio_emul_callback(const struct device *port, struct gpio_callback *
 			on_tck_falling(data, _tdi);
 			edata->state = next_state[_tms][edata->state];
 
+			/* TDO changes on the falling edge, for the driver to sample before the next */
+			if ((edata->tdo_reg & 1) != edata->tdo_level) {
+				edata->tdo_level = edata->tdo_reg & 1;
+				gpio_emul_input_set(data->tdo.port, data->tdo.pin, edata->tdo_level);
+			}
+
 			/*
 			 * LOG_DBG("%5zu\t%u\t%u\t%s\t%x\t%x\t%x\t%x", edata->tck_count, _tms, _tdi,
 			 * jtag_state_to_str[edata->state],
@@ -109,6 +119,60 @@ static void gpio_emul_callback(const struct device *port, struct gpio_callback *
 	}
 }
 
+static uint32_t *jtag_emul_word(struct jtag_data *data, uint32_t addr)
+{
+	size_t i = addr >> LOG2(sizeof(uint32_t));
+
+	return (i < data->buf_len) ? &data->buf[i] : NULL;
+}
+
+static void jtag_emul_axi_write(struct jtag_data *data)
+{
+	struct jtag_emul_data *edata = &data->emul_data;
+	uint32_t *word = jtag_emul_word(data, edata->axi_addr_tdr);
+
+	if (word != NULL) {
+		*word = edata->axi_data_tdr;
+		LOG_DBG("W: addr: %03x data: %08x", edata->axi_addr_tdr, edata->axi_data_tdr);
+	}
+}
+
+/* Memory outside of the buffer reads as zero */
+static void jtag_emul_axi_read(struct jtag_data *data)
+{
+	struct jtag_emul_data *edata = &data->emul_data;
+	const uint32_t *word = jtag_emul_word(data, edata->axi_addr_tdr);
+
+	edata->axi_data_tdr = (word != NULL) ? *word : 0;
+	edata->axi_last_read = edata->axi_addr_tdr;
+	edata->axi_read_pending = (edata->axi_addr_tdr == edata->axi_pending_addr);
+	LOG_DBG("R: addr: %03x data: %08x", edata->axi_addr_tdr, edata->axi_data_tdr);
+}
+
+static bool jtag_emul_axi_reading(const struct jtag_emul_data *edata)
+{
+	return (edata->axi_ctrl_tdr & AXI_CNTL_READ) &&
+	       (edata->axi_ctrl_tdr & AXI_CNTL_WRITE) != AXI_CNTL_WRITE;
+}
+
+/* The value a TDR update shifts out, with the TDR selected by the previous update */
+static uint32_t jtag_emul_tdr_capture(const struct jtag_emul_data *edata)
+{
+	if (edata->have_axi_addr_tdr) {
+		return edata->axi_addr_tdr;
+	} else if (edata->have_axi_data_tdr) {
+		return edata->axi_data_tdr;
+	} else if (edata->have_axi_ctrl_tdr) {
+		/*
+		 * Every AXI access completes before it can be polled, see jtag_emul_set_axi_status(),
+		 * except for a read of the pending address, see jtag_emul_set_axi_pending_read()
+		 */
+		return edata->axi_read_pending ? 0 : edata->axi_status;
+	}
+
+	return 0;
+}
+
 static void on_update_reg(struct jtag_data *data)
 {
 	struct jtag_emul_data *edata = &data->emul_data;
@@ -119,24 +183,40 @@ static void on_update_reg(struct jtag_data *data)
 		edata->hold_reg[DR] =
 			bitrev32(edata->shift_reg[DR]) >> (REG_BITS - edata->shift_bits[DR]);
 
-		if (edata->hold_reg[DR] - 1 == ARC_AXI_ADDR_TDR) {
-			edata->have_axi_addr_tdr = true;
-		} else if (edata->have_axi_addr_tdr) {
+		if (edata->have_axi_addr_tdr) {
 			edata->have_axi_addr_tdr = false;
 			edata->axi_addr_tdr = edata->hold_reg[DR];
-		} else if (edata->hold_reg[DR] - 1 == ARC_AXI_DATA_TDR) {
-			edata->have_axi_data_tdr = true;
+		} else if (edata->have_axi_ctrl_tdr) {
+			edata->have_axi_ctrl_tdr = false;
+			edata->axi_ctrl_tdr = edata->hold_reg[DR];
+
+			if (jtag_emul_axi_reading(edata)) {
+				jtag_emul_axi_read(data);
+			} else if ((edata->axi_ctrl_tdr & AXI_CNTL_WRITE) == AXI_CNTL_WRITE &&
+				   !(edata->axi_ctrl_tdr & AXI_CNTL_AUTO_INC)) {
+				jtag_emul_axi_write(data);
+			}
 		} else if (edata->have_axi_data_tdr) {
 			edata->have_axi_data_tdr = false;
-			edata->axi_data_tdr = edata->hold_reg[DR];
-
-			size_t i = edata->axi_addr_tdr >> LOG2(sizeof(uint32_t));
 
-			if (i < data->buf_len) {
-				data->buf[i] = edata->axi_data_tdr;
-				LOG_DBG("W: addr: %03x data: %08x", edata->axi_addr_tdr,
-					edata->axi_data_tdr);
+			if (!(edata->axi_ctrl_tdr & AXI_CNTL_AUTO_INC)) {
+				/* The write, or read, is started by the next control TDR update */
+				edata->axi_data_tdr = edata->hold_reg[DR];
+			} else if (jtag_emul_axi_reading(edata)) {
+				/* The data has been captured, so start the read of the next word */
+				edata->axi_addr_tdr += sizeof(uint32_t);
+				jtag_emul_axi_read(data);
+			} else if ((edata->axi_ctrl_tdr & AXI_CNTL_WRITE) == AXI_CNTL_WRITE) {
+				edata->axi_data_tdr = edata->hold_reg[DR];
+				jtag_emul_axi_write(data);
+				edata->axi_addr_tdr += sizeof(uint32_t);
 			}
+		} else if (edata->hold_reg[DR] - 1 == ARC_AXI_ADDR_TDR) {
+			edata->have_axi_addr_tdr = true;
+		} else if (edata->hold_reg[DR] - 1 == ARC_AXI_DATA_TDR) {
+			edata->have_axi_data_tdr = true;
+		} else if (edata->hold_reg[DR] - 1 == ARC_AXI_CONTROL_STATUS_TDR) {
+			edata->have_axi_ctrl_tdr = true;
 		}
 	} break;
 	case IR:
@@ -162,6 +242,14 @@ static void on_tck_falling(struct jtag_data *data, bool _tdi)
 	case CAPTURE_DR:
 	case CAPTURE_IR:
 		edata->shift_bits[edata->selected_reg] = 0;
+		/* The TDR value is shifted out after the select bits, as it is shifted in */
+		edata->tdo_reg = (edata->state == CAPTURE_DR)
+					 ? (uint64_t)jtag_emul_tdr_capture(edata) << TENSIX_SM_SIBLEN
+					 : 0;
+		/* A pending read has completed by the next time its status is captured */
+		if (edata->state == CAPTURE_DR && edata->have_axi_ctrl_tdr) {
+			edata->axi_read_pending = false;
+		}
 		break;
 	case SHIFT_DR:
 	case SHIFT_IR:
@@ -170,6 +258,7 @@ static void on_tck_falling(struct jtag_data *data, bool _tdi)
 			edata->shift_reg[edata->selected_reg] |= _tdi;
 			++edata->shift_bits[edata->selected_reg];
 		}
+		edata->tdo_reg >>= 1;
 		break;
 	case UPDATE_DR:
 	case UPDATE_IR:
@@ -202,13 +291,14 @@ static inline bool trst(struct jtag_data *data)
 
 void jtag_emul_setup(const struct device *dev, uint32_t *buf, size_t buf_len)
 {
-	const struct jtag_data *cfg = dev->config;
+	const struct jtag_config *cfg = dev->config;
 	struct jtag_data *data = dev->data;
 
 	data->buf = buf;
 	data->buf_len = buf_len;
 
 	data->tck = cfg->tck;
+	data->tdo = cfg->tdo;
 	data->tdi = cfg->tdi;
 	data->tms = cfg->tms;
 	data->trst = cfg->trst;
@@ -217,9 +307,22 @@ void jtag_emul_setup(const struct device *dev, uint32_t *buf, size_t buf_len)
 		.state = IDLE,
 		.selected_reg = BR,
 		.tck_old = true,
+		.axi_status = AXI_STATUS_DONE,
+		.axi_pending_addr = UINT32_MAX,
 	};
+	(void)gpio_emul_input_set(data->tdo.port, data->tdo.pin, 0);
+
+	/* gpio_emul calls back on every output write, TMS and TDI are counted on the TCK port */
+	gpio_port_pins_t pins = BIT(cfg->tck.pin);
 
-	gpio_init_callback(&data->gpio_emul_cb, gpio_emul_callback, BIT(cfg->tck.pin));
+	if (cfg->tms.port == cfg->tck.port) {
+		pins |= BIT(cfg->tms.pin);
+	}
+	if (cfg->tdi.port == cfg->tck.port) {
+		pins |= BIT(cfg->tdi.pin);
+	}
+
+	gpio_init_callback(&data->gpio_emul_cb, gpio_emul_callback, pins);
 	gpio_add_callback(cfg->tck.port, &data->gpio_emul_cb);
 }
 
@@ -239,3 +342,38 @@ int jtag_emul_axi_read32(const struct device *dev, uint32_t addr, uint32_t *valu
 
 	return 0;
 }
+
+void jtag_emul_set_axi_status(const struct device *dev, uint32_t status)
+{
+	struct jtag_data *data = dev->data;
+
+	data->emul_data.axi_status = status;
+}
+
+void jtag_emul_set_axi_pending_read(const struct device *dev, uint32_t addr)
+{
+	struct jtag_data *data = dev->data;
+
+	data->emul_data.axi_pending_addr = addr;
+}
+
+uint32_t jtag_emul_axi_last_read(const struct device *dev)
+{
+	struct jtag_data *data = dev->data;
+
+	return data->emul_data.axi_last_read;
+}
+
+size_t jtag_emul_tck_count(const struct device *dev)
+{
+	struct jtag_data *data = dev->data;
+
+	return data->emul_data.tck_count;
+}
+
+size_t jtag_emul_io_count(const struct device *dev)
+{
+	struct jtag_data *data = dev->data;
+
+	return data->emul_data.io_count;
+}
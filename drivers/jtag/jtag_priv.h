@@ -7,9 +7,12 @@
 #ifndef ZEPHYR_DRIVERS_JTAG_JTAG_PRIV_H_
 #define ZEPHYR_DRIVERS_JTAG_JTAG_PRIV_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include <zephyr/device.h>
 #include <zephyr/drivers/gpio.h>
+#include <zephyr/sys/util.h>
 
 typedef uint32_t jtag_reg_t;
 
@@ -51,8 +54,50 @@ struct jtag_emul_data {
 	uint32_t axi_addr_tdr;
 	bool have_axi_data_tdr;
 	uint32_t axi_data_tdr;
+	bool have_axi_ctrl_tdr;
+	uint32_t axi_ctrl_tdr;
+	/* captured from the control TDR, and address of the last AXI read started */
+	uint32_t axi_status;
+	uint32_t axi_last_read;
+	/* reads of this address are not done when their status is first captured */
+	uint32_t axi_pending_addr;
+	bool axi_read_pending;
+	/* bits left to shift out on TDO, and the level TDO is driven to */
+	uint64_t tdo_reg;
+	bool tdo_level;
 	uint32_t *sram;
 	size_t sram_len;
+	/* TCK, TMS and TDI writes seen by the emulated GPIO port */
+	size_t io_count;
+};
+
+#define JTAG_BATCH_WORDS DIV_ROUND_UP(CONFIG_JTAG_BATCH_BITS, 32)
+
+/* Where the TDO bits sampled for part of a scan are stored once the batch is clocked out */
+struct jtag_capture {
+	uint8_t *data;
+	uint16_t offset;
+	uint8_t count;
+};
+
+/*
+ * Queued IR and DR scans as one TMS/TDI bit stream, one bit per TCK cycle.
+ *
+ * Bit n of the stream is bit n % 32 of word n / 32.
+ */
+struct jtag_batch {
+	uint32_t tms[JTAG_BATCH_WORDS];
+	uint32_t tdi[JTAG_BATCH_WORDS];
+	/* cycles at which TDO is sampled, and the sampled values */
+	uint32_t capture[JTAG_BATCH_WORDS];
+	uint32_t tdo[JTAG_BATCH_WORDS];
+	struct jtag_capture captures[CONFIG_JTAG_BATCH_CAPTURES];
+	uint16_t bits;
+	uint8_t num_captures;
+	/* TDI of the last queued cycle, repeated on cycles where TDI does not matter */
+	bool tdi_level;
+	/* state the TAP is in once all queued cycles are clocked out */
+	enum jtag_state state;
 };
 
 struct jtag_config {
@@ -73,6 +118,18 @@ struct jtag_config {
 };
 
 struct jtag_data {
+	struct jtag_batch batch;
+	/* levels last written to the TMS and TDI pins */
+	bool tms_level;
+	bool tdi_level;
+	/* pins written for TCK, TMS and TDI, which include those of ganged devices */
+	gpio_port_pins_t tck_pins;
+	gpio_port_pins_t tms_pins;
+	gpio_port_pins_t tdi_pins;
+	/* next device in the gang led by this device, or by the device this one follows */
+	const struct device *gang_next;
+	bool gang_follower;
+
 #ifdef CONFIG_JTAG_EMUL
 	struct gpio_dt_spec tck;
 	struct gpio_dt_spec tdo;
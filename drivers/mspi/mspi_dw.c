@@ -7,6 +7,9 @@
 #define DT_DRV_COMPAT snps_designware_ssi
 
 #include <zephyr/drivers/mspi.h>
+#if defined(CONFIG_MSPI_DW_DMA)
+#include <zephyr/drivers/dma.h>
+#endif
 #include <zephyr/drivers/gpio.h>
 #if defined(CONFIG_PINCTRL)
 #include <zephyr/drivers/pinctrl.h>
@@ -65,6 +68,10 @@ struct mspi_dw_data {
 	uint8_t bytes_per_frame_exp;
 	bool standard_spi;
 	bool suspended;
+#if defined(CONFIG_MSPI_DW_DMA)
+	bool dma_in_use;
+#endif
+	int packet_status;
 
 	struct k_sem finished;
 	/* For synchronization of API calls made from different contexts. */
@@ -72,8 +79,26 @@ struct mspi_dw_data {
 	/* For locking of controller configuration. */
 	struct k_sem cfg_lock;
 	struct mspi_xfer xfer;
+
+#if defined(CONFIG_MSPI_ASYNC)
+	/* Guards the packet in flight of an asynchronous transfer. */
+	struct k_timer async_timer;
+	/* Set while a packet is in flight, until its deadline in ticks. */
+	bool async_in_flight;
+	int64_t async_deadline;
+	mspi_callback_handler_t cbs[MSPI_BUS_EVENT_MAX];
+	struct mspi_callback_context *cb_ctxs[MSPI_BUS_EVENT_MAX];
+#endif
 };
 
+#if defined(CONFIG_MSPI_DW_DMA)
+struct mspi_dw_dma_channel {
+	const struct device *dev;
+	uint32_t channel;
+	uint32_t slot;
+};
+#endif
+
 struct mspi_dw_config {
 	DEVICE_MMIO_ROM;
 	void (*irq_config)(void);
@@ -88,9 +113,15 @@ struct mspi_dw_config {
 	uint8_t rx_fifo_threshold;
 	DECLARE_REG_ACCESS();
 	bool sw_multi_periph;
+#if defined(CONFIG_MSPI_DW_DMA)
+	struct mspi_dw_dma_channel dma_tx;
+	struct mspi_dw_dma_channel dma_rx;
+#endif
 };
 
 /* Register access helpers. */
+#define DR_OFFSET 0x60
+
 #define DEFINE_MM_REG_RD_WR(reg, off) \
 	DEFINE_MM_REG_RD(reg, off) \
 	DEFINE_MM_REG_WR(reg, off)
@@ -108,7 +139,10 @@ DEFINE_MM_REG_RD(sr,		0x28)
 DEFINE_MM_REG_WR(imr,		0x2c)
 DEFINE_MM_REG_RD(isr,		0x30)
 DEFINE_MM_REG_RD(icr,		0x48)
-DEFINE_MM_REG_RD_WR(dr,		0x60)
+DEFINE_MM_REG_WR(dmacr,		0x4c)
+DEFINE_MM_REG_WR(dmatdlr,	0x50)
+DEFINE_MM_REG_WR(dmardlr,	0x54)
+DEFINE_MM_REG_RD_WR(dr,		DR_OFFSET)
 DEFINE_MM_REG_WR(rx_sample_dly,	0xf0)
 DEFINE_MM_REG_WR(spi_ctrlr0,	0xf4)
 DEFINE_MM_REG_WR(txd_drive_edge, 0xf8)
@@ -249,12 +283,33 @@ static void read_rx_fifo(const struct device *dev,
 	dev_data->buf_pos = buf_pos;
 }
 
+#if defined(CONFIG_MSPI_ASYNC)
+static void async_packet_done(const struct device *dev, int status);
+#endif
+
+/* Called from interrupt context when the packet in flight is done. */
+static void packet_finished(const struct device *dev, int status)
+{
+	struct mspi_dw_data *dev_data = dev->data;
+
+#if defined(CONFIG_MSPI_ASYNC)
+	if (dev_data->xfer.async) {
+		async_packet_done(dev, status);
+		return;
+	}
+#endif
+
+	dev_data->packet_status = status;
+	k_sem_give(&dev_data->finished);
+}
+
 static void mspi_dw_isr(const struct device *dev)
 {
 	struct mspi_dw_data *dev_data = dev->data;
 	const struct mspi_xfer_packet *packet =
 		&dev_data->xfer.packets[dev_data->packets_done];
 	uint32_t int_status = read_isr(dev);
+	bool finished = false;
 
 	if (int_status & ISR_RXFIS_BIT) {
 		read_rx_fifo(dev, packet);
@@ -269,7 +324,7 @@ static void mspi_dw_isr(const struct device *dev)
 		while (read_sr(dev) & SR_BUSY_BIT) {
 		}
 
-		k_sem_give(&dev_data->finished);
+		finished = true;
 	} else {
 		if (int_status & ISR_TXEIS_BIT) {
 			if (dev_data->dummy_bytes) {
@@ -285,6 +340,12 @@ static void mspi_dw_isr(const struct device *dev)
 	read_icr(dev);
 	vendor_specific_irq_clear(dev);
 
+	/* This may already start the next packet of an asynchronous
+	 * transfer, so it must be done after the interrupts are cleared.
+	 */
+	if (finished) {
+		packet_finished(dev, 0);
+	}
 }
 
 static int api_config(const struct mspi_dt_spec *spec)
@@ -749,7 +810,143 @@ static void tx_control_field(const struct device *dev,
 	} while (shift);
 }
 
-static int start_next_packet(const struct device *dev, k_timeout_t timeout)
+static bool packet_is_empty(const struct mspi_dw_data *dev_data,
+			    const struct mspi_xfer_packet *packet)
+{
+	return packet->num_bytes == 0 &&
+	       dev_data->xfer.cmd_length == 0 &&
+	       dev_data->xfer.addr_length == 0;
+}
+
+#if defined(CONFIG_MSPI_DW_DMA)
+static bool packet_uses_dma(const struct device *dev,
+			    const struct mspi_xfer_packet *packet)
+{
+	const struct mspi_dw_config *dev_config = dev->config;
+	struct mspi_dw_data *dev_data = dev->data;
+
+	if (packet->num_bytes < CONFIG_MSPI_DW_DMA_MIN_BYTES) {
+		return false;
+	}
+
+	if (packet->dir == MSPI_TX) {
+		return dev_config->dma_tx.dev != NULL;
+	}
+
+	/* RX packets with command or address fields in Standard SPI mode
+	 * need dummy bytes to be transmitted for every received one (see
+	 * start_packet()), so they are left to the interrupt handler.
+	 */
+	return dev_config->dma_rx.dev != NULL &&
+	       !(dev_data->standard_spi &&
+		 (dev_data->xfer.cmd_length != 0 ||
+		  dev_data->xfer.addr_length != 0));
+}
+
+static void dma_callback(const struct device *dma_dev, void *user_data,
+			 uint32_t channel, int status)
+{
+	const struct device *dev = user_data;
+	struct mspi_dw_data *dev_data = dev->data;
+	const struct mspi_xfer_packet *packet =
+		&dev_data->xfer.packets[dev_data->packets_done];
+
+	ARG_UNUSED(dma_dev);
+	ARG_UNUSED(channel);
+
+	if (status < 0) {
+		LOG_ERR("DMA transfer failed (%d)", status);
+		packet_finished(dev, -EIO);
+		return;
+	}
+
+	dev_data->buf_pos = (uint8_t *)dev_data->buf_end;
+
+	if (packet->dir == MSPI_TX) {
+		/* All data is in the TX FIFO now, let the interrupt handler
+		 * finish the packet once it is shifted out.
+		 */
+		write_txftlr(dev, 0);
+		write_imr(dev, IMR_TXEIM_BIT);
+	} else {
+		packet_finished(dev, 0);
+	}
+}
+
+static int start_dma(const struct device *dev,
+		     const struct mspi_xfer_packet *packet)
+{
+	const struct mspi_dw_config *dev_config = dev->config;
+	bool tx = (packet->dir == MSPI_TX);
+	const struct mspi_dw_dma_channel *dma = tx ? &dev_config->dma_tx
+						   : &dev_config->dma_rx;
+	uintptr_t dr_addr = (uintptr_t)BASE_ADDR(dev) + DR_OFFSET;
+	struct dma_block_config block = {
+		.block_size = packet->num_bytes,
+	};
+	/* Only 1-byte frames are used with DMA, see start_packet(). */
+	struct dma_config cfg = {
+		.dma_slot = dma->slot,
+		.channel_direction = tx ? MEMORY_TO_PERIPHERAL
+					: PERIPHERAL_TO_MEMORY,
+		.source_data_size = 1,
+		.dest_data_size = 1,
+		.source_burst_length = 1,
+		.dest_burst_length = 1,
+		.block_count = 1,
+		.head_block = &block,
+		.dma_callback = dma_callback,
+		.user_data = (void *)dev,
+	};
+	int rc;
+
+	if (tx) {
+		block.source_address = (uintptr_t)packet->data_buf;
+		block.dest_address = dr_addr;
+		block.dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+	} else {
+		block.source_address = dr_addr;
+		block.source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+		block.dest_address = (uintptr_t)packet->data_buf;
+	}
+
+	rc = dma_config(dma->dev, dma->channel, &cfg);
+	if (rc < 0) {
+		LOG_ERR("Failed to configure DMA channel %u (%d)",
+			dma->channel, rc);
+		return rc;
+	}
+
+	rc = dma_start(dma->dev, dma->channel);
+	if (rc < 0) {
+		LOG_ERR("Failed to start DMA channel %u (%d)",
+			dma->channel, rc);
+		return rc;
+	}
+
+	return 0;
+}
+
+static void stop_dma(const struct device *dev,
+		     const struct mspi_xfer_packet *packet)
+{
+	const struct mspi_dw_config *dev_config = dev->config;
+	struct mspi_dw_data *dev_data = dev->data;
+	const struct mspi_dw_dma_channel *dma =
+		(packet->dir == MSPI_TX) ? &dev_config->dma_tx
+					 : &dev_config->dma_rx;
+
+	write_dmacr(dev, 0);
+	(void)dma_stop(dma->dev, dma->channel);
+	dev_data->dma_in_use = false;
+}
+#endif /* defined(CONFIG_MSPI_DW_DMA) */
+
+/* Programs the controller for the current packet and starts it. The packet
+ * is then completed by the interrupt handler (or the DMA callback), which
+ * calls packet_finished().
+ */
+static int start_packet(const struct device *dev)
 {
 	const struct mspi_dw_config *dev_config = dev->config;
 	struct mspi_dw_data *dev_data = dev->data;
@@ -758,22 +955,17 @@ static int start_next_packet(const struct device *dev, k_timeout_t timeout)
 	bool xip_enabled = COND_CODE_1(CONFIG_MSPI_XIP,
 				       (dev_data->xip_enabled != 0),
 				       (false));
+	bool dma = COND_CODE_1(CONFIG_MSPI_DW_DMA,
+			       (packet_uses_dma(dev, packet)),
+			       (false));
 	unsigned int key;
 	uint8_t tx_fifo_threshold;
 	uint32_t packet_frames;
 	uint32_t imr;
 	int rc = 0;
 
-	/* Make sure controller is disabled. */
-	write_ssienr(dev, 0);
-
-	if (packet->num_bytes == 0 &&
-	    dev_data->xfer.cmd_length == 0 &&
-	    dev_data->xfer.addr_length == 0) {
-		return 0;
-	}
-
 	dev_data->dummy_bytes = 0;
+	dev_data->packet_status = 0;
 
 	dev_data->ctrlr0 &= ~CTRLR0_TMOD_MASK
 			 &  ~CTRLR0_DFS_MASK
@@ -781,9 +973,13 @@ static int start_next_packet(const struct device *dev, k_timeout_t timeout)
 
 	dev_data->spi_ctrlr0 &= ~SPI_CTRLR0_WAIT_CYCLES_MASK;
 
-	if (dev_data->standard_spi &&
-	    (dev_data->xfer.cmd_length != 0 ||
-	     dev_data->xfer.addr_length != 0)) {
+	/* With DMA, data is moved to/from the FIFOs as is, so only 1-byte
+	 * frames can be used to preserve the order of bytes in the buffer.
+	 */
+	if (dma ||
+	    (dev_data->standard_spi &&
+	     (dev_data->xfer.cmd_length != 0 ||
+	      dev_data->xfer.addr_length != 0))) {
 		dev_data->bytes_per_frame_exp = 0;
 		dev_data->ctrlr0 |= FIELD_PREP(CTRLR0_DFS_MASK, 7);
 		dev_data->ctrlr0 |= FIELD_PREP(CTRLR0_DFS32_MASK, 7);
@@ -866,10 +1062,32 @@ static int start_next_packet(const struct device *dev, k_timeout_t timeout)
 					     rx_fifo_threshold));
 	}
 
+#if defined(CONFIG_MSPI_DW_DMA)
+	if (dma) {
+		/* The DMA channel is started first, the controller will only
+		 * issue requests when they are enabled in DMACR below.
+		 */
+		rc = start_dma(dev, packet);
+		if (rc < 0) {
+			return rc;
+		}
+
+		dev_data->dma_in_use = true;
+		imr = 0;
+		write_dmatdlr(dev, tx_fifo_threshold);
+		write_dmardlr(dev, 0);
+	}
+#endif
+
 	if (dev_data->dev_id->ce.port) {
 		rc = gpio_pin_set_dt(&dev_data->dev_id->ce, 1);
 		if (rc < 0) {
 			LOG_ERR("Failed to activate CE line (%d)", rc);
+#if defined(CONFIG_MSPI_DW_DMA)
+			if (dma) {
+				stop_dma(dev, packet);
+			}
+#endif
 			return rc;
 		}
 	}
@@ -904,7 +1122,8 @@ static int start_next_packet(const struct device *dev, k_timeout_t timeout)
 	dev_data->buf_pos = packet->data_buf;
 	dev_data->buf_end = &packet->data_buf[packet->num_bytes];
 
-	if ((imr & IMR_TXEIM_BIT) && dev_data->buf_pos < dev_data->buf_end) {
+	if (((imr & IMR_TXEIM_BIT) || (dma && packet->dir == MSPI_TX)) &&
+	    dev_data->buf_pos < dev_data->buf_end) {
 		uint32_t start_level = tx_fifo_threshold;
 
 		if (dev_data->dummy_bytes) {
@@ -952,20 +1171,36 @@ static int start_next_packet(const struct device *dev, k_timeout_t timeout)
 		if (make_rx_cycles(dev)) {
 			imr = IMR_RXFIM_BIT;
 		}
+	} else if (dma) {
+		write_dmacr(dev, packet->dir == MSPI_TX ? DMACR_TDMAE_BIT
+							 : DMACR_RDMAE_BIT);
 	} else if (packet->dir == MSPI_TX && packet->num_bytes) {
 		tx_data(dev, packet);
 	}
 
-	/* Enable interrupts now and wait until the packet is done. */
+	/* Enable interrupts now. */
 	write_imr(dev, imr);
 
 	/* Set SER to start transfer */
 	write_ser(dev, BIT(dev_data->dev_id->dev_idx));
 
-	rc = k_sem_take(&dev_data->finished, timeout);
-	if (rc < 0) {
-		rc = -ETIMEDOUT;
+	return 0;
+}
+
+/* Stops the controller after the current packet, `rc` is its result. */
+static int end_packet(const struct device *dev, int rc)
+{
+	struct mspi_dw_data *dev_data = dev->data;
+	bool xip_enabled = COND_CODE_1(CONFIG_MSPI_XIP,
+				       (dev_data->xip_enabled != 0),
+				       (false));
+	unsigned int key;
+
+#if defined(CONFIG_MSPI_DW_DMA)
+	if (dev_data->dma_in_use) {
+		stop_dma(dev, &dev_data->xfer.packets[dev_data->packets_done]);
 	}
+#endif
 
 	/* Disable the controller. This will immediately halt the transfer
 	 * if it hasn't finished yet.
@@ -1004,6 +1239,196 @@ static int start_next_packet(const struct device *dev, k_timeout_t timeout)
 	return rc;
 }
 
+static int start_next_packet(const struct device *dev, k_timeout_t timeout)
+{
+	struct mspi_dw_data *dev_data = dev->data;
+	const struct mspi_xfer_packet *packet =
+		&dev_data->xfer.packets[dev_data->packets_done];
+	int rc;
+
+	/* Make sure controller is disabled. */
+	write_ssienr(dev, 0);
+
+	if (packet_is_empty(dev_data, packet)) {
+		return 0;
+	}
+
+	rc = start_packet(dev);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* Wait until the packet is done. */
+	rc = k_sem_take(&dev_data->finished, timeout);
+	if (rc < 0) {
+		rc = -ETIMEDOUT;
+	} else {
+		rc = dev_data->packet_status;
+	}
+
+	return end_packet(dev, rc);
+}
+
+#if defined(CONFIG_MSPI_ASYNC)
+static void async_notify(const struct device *dev, int status)
+{
+	struct mspi_dw_data *dev_data = dev->data;
+	const struct mspi_xfer_packet *packet =
+		&dev_data->xfer.packets[dev_data->packets_done];
+	mspi_callback_handler_t cb = dev_data->cbs[MSPI_BUS_XFER_COMPLETE];
+	struct mspi_callback_context *cb_ctx =
+		dev_data->cb_ctxs[MSPI_BUS_XFER_COMPLETE];
+
+	if (!(packet->cb_mask & MSPI_BUS_XFER_COMPLETE_CB) || !cb) {
+		return;
+	}
+
+	cb_ctx->mspi_evt.evt_type = MSPI_BUS_XFER_COMPLETE;
+	cb_ctx->mspi_evt.evt_data.controller = dev;
+	cb_ctx->mspi_evt.evt_data.dev_id = dev_data->dev_id;
+	cb_ctx->mspi_evt.evt_data.packet = packet;
+	cb_ctx->mspi_evt.evt_data.packet_idx = dev_data->packets_done;
+	cb_ctx->mspi_evt.evt_data.status = status;
+
+	cb(cb_ctx);
+}
+
+static void async_xfer_end(const struct device *dev)
+{
+	struct mspi_dw_data *dev_data = dev->data;
+	int rc;
+
+	/* Release what api_transceive() acquired for the transfer. */
+	k_sem_give(&dev_data->ctx_lock);
+
+	rc = pm_device_runtime_put_async(dev, K_NO_WAIT);
+	if (rc < 0) {
+		LOG_ERR("pm_device_runtime_put_async() failed: %d", rc);
+	}
+}
+
+/* Starts the current packet of an asynchronous transfer, or the first one
+ * after it that actually needs to be transferred. Packets that do not, or
+ * that cannot be started, are reported right away.
+ */
+static void async_start_packets(const struct device *dev)
+{
+	struct mspi_dw_data *dev_data = dev->data;
+	int rc;
+
+	for (; dev_data->packets_done < dev_data->xfer.num_packet;
+	     dev_data->packets_done++) {
+		const struct mspi_xfer_packet *packet =
+			&dev_data->xfer.packets[dev_data->packets_done];
+
+		/* Make sure controller is disabled. */
+		write_ssienr(dev, 0);
+
+		if (packet_is_empty(dev_data, packet)) {
+			async_notify(dev, 0);
+			continue;
+		}
+
+		/* Started before the packet, as it may be completed by
+		 * the interrupt handler before start_packet() returns.
+		 */
+		dev_data->async_deadline = k_uptime_ticks() +
+			k_ms_to_ticks_ceil64(dev_data->xfer.timeout);
+		dev_data->async_in_flight = true;
+		k_timer_start(&dev_data->async_timer,
+			      K_MSEC(dev_data->xfer.timeout), K_NO_WAIT);
+
+		rc = start_packet(dev);
+		if (rc == 0) {
+			return;
+		}
+
+		dev_data->async_in_flight = false;
+		k_timer_stop(&dev_data->async_timer);
+		async_notify(dev, rc);
+		break;
+	}
+
+	async_xfer_end(dev);
+}
+
+static void async_packet_done(const struct device *dev, int status)
+{
+	struct mspi_dw_data *dev_data = dev->data;
+
+	/* A packet is only done once, by its completion or its timeout. */
+	if (!dev_data->async_in_flight) {
+		return;
+	}
+
+	dev_data->async_in_flight = false;
+	k_timer_stop(&dev_data->async_timer);
+
+	status = end_packet(dev, status);
+	async_notify(dev, status);
+
+	if (status < 0) {
+		/* Remaining packets of a failed transfer are dropped. */
+		async_xfer_end(dev);
+		return;
+	}
+
+	dev_data->packets_done++;
+	async_start_packets(dev);
+}
+
+static void async_timeout(struct k_timer *timer)
+{
+	const struct device *dev = k_timer_user_data_get(timer);
+	struct mspi_dw_data *dev_data = dev->data;
+	unsigned int key = irq_lock();
+
+	/* Do nothing if the packet was completed in the meantime, and
+	 * possibly the next one started, before the lock was taken.
+	 */
+	if (dev_data->async_in_flight &&
+	    k_uptime_ticks() >= dev_data->async_deadline) {
+		LOG_ERR("Asynchronous transfer timed out");
+		write_imr(dev, 0);
+		async_packet_done(dev, -ETIMEDOUT);
+	}
+
+	irq_unlock(key);
+}
+
+static int api_register_callback(const struct device *dev,
+				 const struct mspi_dev_id *dev_id,
+				 const enum mspi_bus_event evt_type,
+				 mspi_callback_handler_t cb,
+				 struct mspi_callback_context *ctx)
+{
+	struct mspi_dw_data *dev_data = dev->data;
+
+	if (dev_id != dev_data->dev_id) {
+		LOG_ERR("Controller is not configured for this device");
+		return -EINVAL;
+	}
+
+	if (evt_type != MSPI_BUS_XFER_COMPLETE) {
+		LOG_ERR("Callback type %d not supported", evt_type);
+		return -ENOTSUP;
+	}
+
+	if (cb && !ctx) {
+		return -EINVAL;
+	}
+
+	(void)k_sem_take(&dev_data->ctx_lock, K_FOREVER);
+
+	dev_data->cbs[evt_type] = cb;
+	dev_data->cb_ctxs[evt_type] = ctx;
+
+	k_sem_give(&dev_data->ctx_lock);
+
+	return 0;
+}
+#endif /* defined(CONFIG_MSPI_ASYNC) */
+
 static int _api_transceive(const struct device *dev,
 			   const struct mspi_xfer *req)
 {
@@ -1032,6 +1457,14 @@ static int _api_transceive(const struct device *dev,
 
 	dev_data->xfer = *req;
 
+#if defined(CONFIG_MSPI_ASYNC)
+	if (req->async) {
+		dev_data->packets_done = 0;
+		async_start_packets(dev);
+		return 0;
+	}
+#endif
+
 	for (dev_data->packets_done = 0;
 	     dev_data->packets_done < dev_data->xfer.num_packet;
 	     dev_data->packets_done++) {
@@ -1056,8 +1489,7 @@ static int api_transceive(const struct device *dev,
 		return -EINVAL;
 	}
 
-	/* TODO: add support for asynchronous transfers */
-	if (req->async) {
+	if (req->async && !IS_ENABLED(CONFIG_MSPI_ASYNC)) {
 		LOG_ERR("Asynchronous transfers are not supported");
 		return -ENOTSUP;
 	}
@@ -1076,6 +1508,13 @@ static int api_transceive(const struct device *dev,
 		rc = _api_transceive(dev, req);
 	}
 
+	/* A started asynchronous transfer keeps the controller locked and
+	 * resumed until its last packet is done, see async_xfer_end().
+	 */
+	if (req->async && rc == 0) {
+		return 0;
+	}
+
 	k_sem_give(&dev_data->ctx_lock);
 
 	rc2 = pm_device_runtime_put(dev);
@@ -1316,6 +1755,21 @@ static int dev_init(const struct device *dev)
 	k_sem_init(&dev_data->cfg_lock, 1, 1);
 	k_sem_init(&dev_data->ctx_lock, 1, 1);
 
+#if defined(CONFIG_MSPI_ASYNC)
+	k_timer_init(&dev_data->async_timer, async_timeout, NULL);
+	k_timer_user_data_set(&dev_data->async_timer, (void *)dev);
+#endif
+
+#if defined(CONFIG_MSPI_DW_DMA)
+	if ((dev_config->dma_tx.dev &&
+	     !device_is_ready(dev_config->dma_tx.dev)) ||
+	    (dev_config->dma_rx.dev &&
+	     !device_is_ready(dev_config->dma_rx.dev))) {
+		LOG_ERR("DMA controller is not ready");
+		return -ENODEV;
+	}
+#endif
+
 	for (ce_gpio = dev_config->ce_gpios;
 	     ce_gpio < &dev_config->ce_gpios[dev_config->ce_gpios_len];
 	     ce_gpio++) {
@@ -1350,6 +1804,9 @@ static DEVICE_API(mspi, drv_api) = {
 	.get_channel_status = api_get_channel_status,
 	.transceive         = api_transceive,
 	.timing_config      = api_timing_config,
+#if defined(CONFIG_MSPI_ASYNC)
+	.register_callback  = api_register_callback,
+#endif
 #if defined(CONFIG_MSPI_XIP)
 	.xip_config         = api_xip_config,
 #endif
@@ -1395,6 +1852,21 @@ static DEVICE_API(mspi, drv_api) = {
 		DT_INST_PROP_OR(inst, rx_fifo_threshold,		\
 				1 * RX_FIFO_DEPTH(inst) / 8 - 1)
 
+#define MSPI_DW_DMA_CHANNEL(inst, name)					\
+	COND_CODE_1(DT_INST_DMAS_HAS_NAME(inst, name),			\
+		({							\
+			.dev = DEVICE_DT_GET(				\
+				DT_INST_DMAS_CTLR_BY_NAME(inst, name)),	\
+			.channel = DT_INST_DMAS_CELL_BY_NAME(inst, name,	\
+							     channel),	\
+			.slot = DT_INST_DMAS_CELL_BY_NAME_OR(inst, name,	\
+							     slot, 0),	\
+		}),							\
+		({ 0 }))
+#define MSPI_DW_DMA_PROPS(inst)						\
+	.dma_tx = MSPI_DW_DMA_CHANNEL(inst, tx),			\
+	.dma_rx = MSPI_DW_DMA_CHANNEL(inst, rx),
+
 #define MSPI_DW_INST(inst)						\
 	PM_DEVICE_DT_INST_DEFINE(inst, dev_pm_action_cb);		\
 	IF_ENABLED(CONFIG_PINCTRL, (PINCTRL_DT_INST_DEFINE(inst);))	\
@@ -1416,6 +1888,7 @@ static DEVICE_API(mspi, drv_api) = {
 		DEFINE_REG_ACCESS(inst)					\
 		.sw_multi_periph =					\
 			DT_INST_PROP(inst, software_multiperipheral),	\
+	IF_ENABLED(CONFIG_MSPI_DW_DMA, (MSPI_DW_DMA_PROPS(inst)))	\
 	};								\
 	DEVICE_DT_INST_DEFINE(inst,					\
 		dev_init, PM_DEVICE_DT_INST_GET(inst),			\
@@ -48,6 +48,10 @@
 /* RXFLR - Receive FIFO Level Register */
 #define RXFLR_RXTFL_MASK	GENMASK(7, 0)
 
+/* DMACR - DMA Control Register */
+#define DMACR_RDMAE_BIT		BIT(0)
+#define DMACR_TDMAE_BIT		BIT(1)
+
 /* SR - Status Register */
 #define SR_BUSY_BIT	        BIT(0)
 
@@ -181,7 +185,20 @@ static void aux_reg_write(uint32_t data, const struct device *dev, uint32_t off)
 }
 #endif
 
-#if AUX_REG_INSTANCES != DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT)
+#if defined(CONFIG_MSPI_DW_EMUL)
+/* Provided by the test application, which emulates the controller registers. */
+uint32_t mspi_dw_emul_reg_read(const struct device *dev, uint32_t off);
+void mspi_dw_emul_reg_write(const struct device *dev, uint32_t off, uint32_t data);
+
+static uint32_t reg_read(const struct device *dev, uint32_t off)
+{
+	return mspi_dw_emul_reg_read(dev, off);
+}
+static void reg_write(uint32_t data, const struct device *dev, uint32_t off)
+{
+	mspi_dw_emul_reg_write(dev, off, data);
+}
+#elif AUX_REG_INSTANCES != DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT)
 static uint32_t reg_read(const struct device *dev, uint32_t off)
 {
 	return sys_read32(BASE_ADDR(dev) + off);
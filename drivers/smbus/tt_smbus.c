@@ -6,6 +6,7 @@
 #include "smbus_utils.h"
 
 #include <soc.h>
+#include <tenstorrent/smbus_pec.h>
 #include <tenstorrent/tt_stm32.h>
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
@@ -14,7 +15,6 @@
 #include <zephyr/drivers/smbus.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/byteorder.h>
-#include <zephyr/sys/crc.h>
 
 LOG_MODULE_REGISTER(tt_stm32_smbus, CONFIG_SMBUS_LOG_LEVEL);
 
@@ -182,7 +182,7 @@ static int tt_smbus_stm32_byte_data_write(const struct device *dev, uint16_t per
 	/* Address byte needs to be included */
 	uint8_t pec_src[] = {periph_addr << 1 | 0, /* I2C_WRITE_BIT */
 			     command, byte};
-	uint8_t pec = crc8(pec_src, sizeof(pec_src), 0x07, 0, false);
+	uint8_t pec = smbus_pec(0, pec_src, sizeof(pec_src));
 
 	const struct tt_smbus_stm32_config *config = dev->config;
 
@@ -212,7 +212,7 @@ static int tt_smbus_stm32_word_data_write(const struct device *dev, uint16_t per
 	/* Address byte needs to be included */
 	uint8_t pec_src[] = {periph_addr << 1 | 0, /* I2C_WRITE_BIT */
 			     command, (uint8_t)word & 0xFF, (uint8_t)(word >> 8) & 0xFF};
-	uint8_t pec = crc8(pec_src, sizeof(pec_src), 0x07, 0, false);
+	uint8_t pec = smbus_pec(0, pec_src, sizeof(pec_src));
 
 	const struct tt_smbus_stm32_config *config = dev->config;
 	uint8_t buffer[sizeof(command) + sizeof(word) + sizeof(pec)];
@@ -260,9 +260,9 @@ static int tt_smbus_stm32_block_write(const struct device *dev, uint16_t periph_
 	uint8_t pec_src[] = {                      /* Address byte needs to be included */
 			     periph_addr << 1 | 0, /* I2C_WRITE_BIT */
 			     command, count};
-	uint8_t pec = crc8(pec_src, sizeof(pec_src), 0x07, 0, false);
+	uint8_t pec = smbus_pec(0, pec_src, sizeof(pec_src));
 
-	pec = crc8(buf, count, 0x07, pec, false);
+	pec = smbus_pec(pec, buf, count);
 
 	const struct tt_smbus_stm32_config *config = dev->config;
 	struct i2c_msg messages[] = {
@@ -297,7 +297,7 @@ static int tt_smbus_stm32_block_read(const struct device *dev, uint16_t periph_a
 	int ret;
 	uint8_t pec_src[] = {periph_addr << 1 | 1, /* I2C_READ_BIT */
 			     command};
-	uint8_t pec = crc8(pec_src, sizeof(pec_src), 0x07, 0, false);
+	uint8_t pec = smbus_pec(0, pec_src, sizeof(pec_src));
 
 	const struct tt_smbus_stm32_config *config = dev->config;
 	uint8_t pec_value = 0;
@@ -356,8 +356,8 @@ end_transfer:
 	 */
 
 	if (!ret) {
-		pec = crc8(count, sizeof(*count), 0x07, pec, false);
-		pec = crc8(buf, *count, 0x07, pec, false);
+		pec = smbus_pec(pec, count, sizeof(*count));
+		pec = smbus_pec(pec, buf, *count);
 
 		if (pec != pec_value) {
 			return -EINVAL;
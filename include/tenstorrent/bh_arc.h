@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 
+#include <zephyr/kernel.h>
 #include <zephyr/drivers/smbus.h>
 #include <zephyr/drivers/gpio.h>
 
@@ -46,9 +47,24 @@ union cm2dmAckWire {
 	uint16_t val;
 };
 
+/* Bus session state, see bharc_bus_session_begin() */
+struct bh_arc_data {
+	const struct bh_arc *dev;
+	bool initialized;
+
+	/* Number of open sessions, including the ones around single transactions */
+	unsigned int session_count;
+	/* Whether the bus enable GPIO is currently asserted */
+	bool bus_enabled;
+	/* Releases the bus once it has been idle for CONFIG_TT_BH_CHIP_BUS_IDLE_TIMEOUT_MS */
+	struct k_work_delayable idle_work;
+};
+
 struct bh_arc {
 	const struct smbus_dt_spec smbus;
 	const struct gpio_dt_spec enable;
+	/* Optional, without it the bus is enabled and disabled around every transaction */
+	struct bh_arc_data *data;
 };
 
 typedef struct cm2dmMessageRet {
@@ -59,13 +75,55 @@ typedef struct cm2dmMessageRet {
 	int ack_ret;
 } cm2dmMessageRet;
 
+/**
+ * @brief Keep the SMBus to the ARC enabled across several transactions
+ *
+ * Sessions are reference counted, and every transaction runs in its own short session. The
+ * bus is enabled by the first session and disabled once the last one has ended and the bus
+ * has been idle for CONFIG_TT_BH_CHIP_BUS_IDLE_TIMEOUT_MS.
+ *
+ * Every call must be paired with a call to @ref bharc_bus_session_end, even when it fails.
+ *
+ * @param dev The ARC to talk to.
+ *
+ * @return 0 on success, or a negative error code if the bus could not be enabled.
+ */
+int bharc_bus_session_begin(const struct bh_arc *dev);
+
+/**
+ * @brief End a session started with @ref bharc_bus_session_begin
+ *
+ * @param dev The ARC to talk to.
+ *
+ * @return 0 on success, or a negative error code if the bus could not be disabled.
+ */
+int bharc_bus_session_end(const struct bh_arc *dev);
+
+/**
+ * @brief Disable the SMBus to the ARC now, instead of once it has been idle
+ *
+ * Used before the chip is reset, when the bus must not be left enabled.
+ *
+ * @param dev The ARC to talk to.
+ *
+ * @return 0 on success, -EBUSY if a session still holds the bus, or a negative error code if
+ * the bus could not be disabled.
+ */
+int bharc_bus_release(const struct bh_arc *dev);
+
 int bharc_smbus_block_read(const struct bh_arc *dev, uint8_t cmd, uint8_t *count, uint8_t *output);
 int bharc_smbus_block_write(const struct bh_arc *dev, uint8_t cmd, uint8_t count, uint8_t *input);
 int bharc_smbus_word_data_write(const struct bh_arc *dev, uint16_t cmd, uint16_t word);
 int bharc_smbus_byte_data_write(const struct bh_arc *dev, uint8_t cmd, uint8_t word);
 
+#define BH_ARC_DATA_NAME(n)    _CONCAT(bh_arc_data_, DT_DEP_ORD(n))
+#define BH_ARC_DATA_DECLARE(n) extern struct bh_arc_data BH_ARC_DATA_NAME(n);
+
+DT_FOREACH_STATUS_OKAY(tenstorrent_bh_arc, BH_ARC_DATA_DECLARE)
+
 #define BH_ARC_INIT(n)                                                                             \
 	{.smbus = SMBUS_DT_SPEC_GET(n),                                                            \
+	 .data = &BH_ARC_DATA_NAME(n),                                                             \
 	 .enable = COND_CODE_1(DT_PROP_HAS_IDX(n, gpios, 0),	({	\
 			.port = DEVICE_DT_GET(DT_GPIO_CTLR_BY_IDX(n, gpios, 0)),                   \
 			.pin = DT_GPIO_PIN_BY_IDX(n, gpios, 0),                                    \
@@ -9,6 +9,8 @@
 
 #include "bh_arc.h"
 
+#include <tenstorrent/tt_smbus_regs.h>
+
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/gpio.h>
@@ -17,6 +19,12 @@
 extern "C" {
 #endif
 
+/*
+ * Number of times in a row the CMFW has to NACK the cm2dm batch register, while single messages
+ * are read without error, before batches are no longer tried.
+ */
+#define BH_CHIP_CM2DM_BATCH_NACK_LIMIT 3
+
 struct bh_straps {
 	struct gpio_dt_spec gpio6;
 };
@@ -35,6 +43,11 @@ struct bh_chip_config {
 	struct bh_arc arc;
 };
 
+struct bh_chip;
+
+/* Handles the events posted to a chip with bh_chip_workq_post() */
+typedef void (*bh_chip_event_handler_t)(struct bh_chip *chip, uint32_t events);
+
 struct bh_chip_data {
 	/* Flag set when we need to apply the reset regardless of preset state. */
 	bool needs_reset;
@@ -48,6 +61,9 @@ struct bh_chip_data {
 	 */
 	bool arc_needs_init_msg;
 
+	/* Flag set when the CMFW requested a reset, applied once the bus session has ended */
+	bool reset_requested;
+
 	unsigned int bus_cancel_flag;
 
 	/* notify the main thread to apply reset sequence */
@@ -62,6 +78,25 @@ struct bh_chip_data {
 	volatile bool pgood_rise_triggered;
 	bool pgood_severe_fault;
 	int64_t pgood_last_trip_ms;
+
+	/* cm2dm messages read in one batch and not yet returned to the caller */
+	cm2dmMessage cm2dm_batch[CMFW_SMBUS_REQ_BATCH_MAX];
+	uint8_t cm2dm_batch_len;
+	uint8_t cm2dm_batch_index;
+
+	/* Set when the CMFW only supports one cm2dm message per transaction */
+	bool cm2dm_batch_unsupported;
+	/* Batch reads NACKed in a row, see BH_CHIP_CM2DM_BATCH_NACK_LIMIT */
+	uint8_t cm2dm_batch_nacks;
+
+#ifdef CONFIG_TT_BH_CHIP_WORKQUEUE
+	/* Work queue servicing this chip only, so a slow chip does not hold up the others */
+	struct k_work_q workq;
+	struct k_work event_work;
+	atomic_t events;
+	bh_chip_event_handler_t event_handler;
+	K_KERNEL_STACK_MEMBER(workq_stack, CONFIG_TT_BH_CHIP_WORKQUEUE_STACK_SIZE);
+#endif
 };
 
 struct bh_chip {
@@ -118,17 +153,126 @@ extern struct bh_chip BH_CHIPS[BH_CHIP_COUNT];
 #define BH_CHIP_PRIMARY_INDEX DT_PROP(DT_PATH(chips), primary)
 
 int jtag_bootrom_reset_sequence(struct bh_chip *chip, bool force_reset);
+/* Resets and loads the bootrom patch into several chips at once, see jtag_bootrom_reset_asics() */
+int jtag_bootrom_reset_sequence_chips(struct bh_chip *chips, size_t num_chips, bool force_reset);
 
 void bh_chip_cancel_bus_transfer_set(struct bh_chip *chip);
 void bh_chip_cancel_bus_transfer_clear(struct bh_chip *chip);
 
+/**
+ * @brief Keep the SMBus to the chip enabled across several transactions
+ *
+ * Must be paired with @ref bh_chip_bus_session_end, even when it fails.
+ * See @ref bharc_bus_session_begin.
+ *
+ * @param chip The chip to talk to.
+ *
+ * @return 0 on success, or a negative error code if the bus could not be enabled.
+ */
+static inline int bh_chip_bus_session_begin(struct bh_chip *chip)
+{
+	return bharc_bus_session_begin(&chip->config.arc);
+}
+
+/**
+ * @brief End a session started with @ref bh_chip_bus_session_begin
+ *
+ * @param chip The chip to talk to.
+ *
+ * @return 0 on success, or a negative error code if the bus could not be disabled.
+ */
+static inline int bh_chip_bus_session_end(struct bh_chip *chip)
+{
+	return bharc_bus_session_end(&chip->config.arc);
+}
+
+/**
+ * @brief Disable the SMBus to the chip now, instead of once it has been idle
+ *
+ * Must not be called within a session. See @ref bharc_bus_release.
+ *
+ * @param chip The chip to release the bus of.
+ *
+ * @return 0 on success, or a negative error code if the bus could not be disabled.
+ */
+static inline int bh_chip_bus_release(struct bh_chip *chip)
+{
+	return bharc_bus_release(&chip->config.arc);
+}
+
+/**
+ * @brief Get the next message sent by the CMFW
+ *
+ * Messages are read from the CMFW in batches of up to CMFW_SMBUS_REQ_BATCH_MAX, so most
+ * calls return a buffered message without any bus traffic. CMFW versions that reject the
+ * batch register are read one message at a time, until the CMFW reports that it restarted.
+ * Other bus errors are returned, and batches are tried again on the next call.
+ *
+ * @param chip The chip to read from.
+ *
+ * @return The message, or a kCm2DmMsgIdNull message if there is none pending.
+ */
 cm2dmMessageRet bh_chip_get_cm2dm_message(struct bh_chip *chip);
+
+/**
+ * @brief Drop the cm2dm messages buffered from a CMFW that is being restarted
+ *
+ * @param chip The chip being reset.
+ */
+void bh_chip_discard_cm2dm_messages(struct bh_chip *chip);
+
+#ifdef CONFIG_TT_BH_CHIP_WORKQUEUE
+/**
+ * @brief Start the work queue of a chip
+ *
+ * @param chip The chip to service.
+ * @param handler Called from the work queue with the events posted to the chip.
+ * @param name Name of the work queue thread.
+ */
+void bh_chip_workq_start(struct bh_chip *chip, bh_chip_event_handler_t handler, const char *name);
+
+/**
+ * @brief Post events to the work queue of a chip
+ *
+ * Events posted while the handler is already pending are combined, and handled in a single
+ * call.
+ *
+ * @param chip The chip to post to.
+ * @param events The events to post.
+ */
+void bh_chip_workq_post(struct bh_chip *chip, uint32_t events);
+#endif
 int bh_chip_set_static_info(struct bh_chip *chip, dmStaticInfo *info);
 int bh_chip_set_input_power(struct bh_chip *chip, uint16_t power);
 int bh_chip_set_input_power_lim(struct bh_chip *chip, uint16_t max_power);
 int bh_chip_set_fan_rpm(struct bh_chip *chip, uint16_t rpm);
 int bh_chip_set_therm_trip_count(struct bh_chip *chip, uint16_t therm_trip_count);
 
+/**
+ * @brief Select the telemetry tags read by @ref bh_chip_get_telemetry
+ *
+ * @param chip The chip to configure.
+ * @param tags The telemetry tags to read.
+ * @param num_tags The number of tags, at most CMFW_SMBUS_TELEMETRY_LIST_MAX.
+ *
+ * @return 0 on success, or a negative error code.
+ */
+int bh_chip_set_telemetry_list(struct bh_chip *chip, const uint8_t *tags, uint8_t num_tags);
+
+/**
+ * @brief Read the telemetry tags selected with @ref bh_chip_set_telemetry_list
+ *
+ * All values are read in a single SMBus transaction.
+ *
+ * @param chip The chip to read from.
+ * @param values Filled in with the value of each tag, in the order they were selected.
+ * @param num_tags The number of tags that were selected.
+ *
+ * @return 0 on success, -EIO if the chip returned a different number of tags, or another negative
+ *	   error code.
+ */
+int bh_chip_get_telemetry(struct bh_chip *chip, uint32_t *values, uint8_t num_tags);
+
 void bh_chip_assert_asic_reset(const struct bh_chip *chip);
 void bh_chip_deassert_asic_reset(const struct bh_chip *chip);
 
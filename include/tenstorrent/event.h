@@ -23,11 +23,45 @@ extern "C" {
  * system. Multiple events may be posted and receieved simultaneously, as they form a bitmask.
  */
 enum tt_event {
-	TT_EVENT_WAKE = BIT(31), /**< @brief Wake firmware for a generic reason */
+	TT_EVENT_CM2DM = BIT(0),        /**< @brief A chip may have a cm2dm message pending */
+	TT_EVENT_POWER_SAMPLE = BIT(1), /**< @brief Input power should be sampled */
+	TT_EVENT_FAN_SAMPLE = BIT(2),   /**< @brief Fan speed should be sampled */
+	TT_EVENT_PERST = BIT(3),        /**< @brief PERST was asserted */
+	TT_EVENT_THERM_TRIP = BIT(4),   /**< @brief A chip signalled a thermal trip */
+	TT_EVENT_PGOOD = BIT(5),        /**< @brief The power good signal of a chip changed */
+	TT_EVENT_WAKE = BIT(31),        /**< @brief Wake firmware for a generic reason */
 };
 
 /** @brief Bitmask of all Tenstorrent firmware events */
-#define TT_EVENT_MASK (TT_EVENT_WAKE)
+#define TT_EVENT_MASK                                                                              \
+	(TT_EVENT_CM2DM | TT_EVENT_POWER_SAMPLE | TT_EVENT_FAN_SAMPLE | TT_EVENT_PERST |           \
+	 TT_EVENT_THERM_TRIP | TT_EVENT_PGOOD | TT_EVENT_WAKE)
+
+/**
+ * @brief A periodic deadline for one or more events.
+ *
+ * Deadlines are used with @ref tt_event_wait_deadlines to generate events for sources that must
+ * be polled, such as sensors, without waking up more often than any of them is due.
+ */
+struct tt_event_deadline {
+	/** @brief The events generated when the deadline expires */
+	uint32_t events;
+	/** @brief The period of the deadline in milliseconds, or 0 if it is disabled */
+	uint32_t period_ms;
+	/** @brief Uptime in milliseconds at which the deadline next expires */
+	int64_t next_ms;
+};
+
+/**
+ * @brief Initialize a @ref tt_event_deadline that first expires immediately.
+ *
+ * @param _events The events generated when the deadline expires.
+ * @param _period_ms The period of the deadline in milliseconds, or 0 to disable it.
+ */
+#define TT_EVENT_DEADLINE_INIT(_events, _period_ms)                                                \
+	{                                                                                          \
+		.events = (_events), .period_ms = (_period_ms), .next_ms = 0,                      \
+	}
 
 /**
  * @brief Post an event to Tenstorrent firmware.
@@ -67,6 +101,25 @@ uint32_t tt_event_post(uint32_t events);
  */
 uint32_t tt_event_wait(uint32_t events, k_timeout_t timeout);
 
+/**
+ * @brief Wait for events to be posted, or for the earliest of a set of deadlines to expire.
+ *
+ * Block until at least one of @a events is posted, or until the earliest enabled deadline in
+ * @a deadlines expires. If no deadline is enabled, block until an event is posted.
+ *
+ * The events of every deadline that has expired are added to the returned events, and the
+ * deadline is re-armed one period later. A deadline is also re-armed a full period from now when
+ * its events were posted, so a source that is signalled is not polled again until it is due.
+ *
+ * @param events The events to wait for as a bitmask of @ref tt_event values.
+ * @param deadlines The deadlines to wait for.
+ * @param num_deadlines The number of entries in @a deadlines.
+ *
+ * @return A bitmask of the received events and the events of the expired deadlines.
+ */
+uint32_t tt_event_wait_deadlines(uint32_t events, struct tt_event_deadline *deadlines,
+				 size_t num_deadlines);
+
 #ifdef __cplusplus
 }
 #endif
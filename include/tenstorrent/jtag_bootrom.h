@@ -21,14 +21,45 @@ extern "C" {
 
 const uint8_t *get_bootcode(void);
 const size_t get_bootcode_len(void);
+const uint32_t *get_bootcode_rle(void);
+size_t get_bootcode_rle_len(void);
+
+/*
+ * Run-length encoded patches, as made by scripts/bootrom_rle.py. The stream starts with the magic
+ * and the decoded length in words, followed by records that each start with one of the headers
+ * below.
+ */
+#define JTAG_BOOTROM_RLE_MAGIC      0x454C5254
+#define JTAG_BOOTROM_RLE_OP_SHIFT   30
+#define JTAG_BOOTROM_RLE_COUNT_MASK GENMASK(29, 0)
+/* count words follow */
+#define JTAG_BOOTROM_RLE_OP_LITERAL 0
+/* one word follows, repeated count times */
+#define JTAG_BOOTROM_RLE_OP_REPEAT  1
+/* count zero words */
+#define JTAG_BOOTROM_RLE_OP_ZERO    2
+
+#define JTAG_BOOTROM_RLE_HEADER(op, count) (((op) << JTAG_BOOTROM_RLE_OP_SHIFT) | (count))
+
+int jtag_bootrom_rle_len(const uint32_t *rle, size_t rle_len);
 
 int jtag_bootrom_init(struct bh_chip *chip);
 
 int jtag_bootrom_reset_asic(struct bh_chip *chip);
+int jtag_bootrom_reset_asics(struct bh_chip *chips, size_t num_chips);
 
 int jtag_bootrom_patch_offset(struct bh_chip *chip, const uint32_t *patch, size_t patch_len,
 			      const uint32_t start_addr);
+int jtag_bootrom_patch_chips_offset(struct bh_chip *chips, size_t num_chips, const uint32_t *patch,
+				    size_t patch_len, const uint32_t start_addr);
+int jtag_bootrom_patch_chips_rle_offset(struct bh_chip *chips, size_t num_chips, const uint32_t *rle,
+					size_t rle_len, const uint32_t start_addr);
 int jtag_bootrom_verify(const struct device *dev, const uint32_t *patch, size_t patch_len);
+int jtag_bootrom_verify_rle(const struct device *dev, const uint32_t *rle, size_t rle_len);
+uint32_t jtag_bootrom_crc(const uint32_t *patch, size_t patch_len);
+int jtag_bootrom_crc_arm(const struct device *dev, uint32_t crc_addr, uint32_t crc);
+int jtag_bootrom_verify_crc(const struct device *dev, uint32_t crc_addr, uint32_t crc,
+			    uint32_t timeout_ms);
 void jtag_bootrom_soft_reset_arc(struct bh_chip *chip);
 void jtag_bootrom_teardown(const struct bh_chip *chip);
 
@@ -53,9 +53,24 @@ struct response {
 typedef uint8_t (*msgqueue_request_handler_t)(uint32_t msg_code, const struct request *req,
 					      struct response *rsp);
 
+/* Identifies an outstanding asynchronous message, see msgqueue_complete() */
+typedef uint32_t msgqueue_token_t;
+
+/*
+ * Asynchronous handlers either return an exit code, in which case rsp is sent immediately, or
+ * -EINPROGRESS, in which case the response is sent later via msgqueue_complete(token, ...). A
+ * handler that calls msgqueue_complete() itself is answered once, whatever it returns.
+ *
+ * While a message is outstanding, no further messages are taken from the same queue, but other
+ * queues continue to be serviced.
+ */
+typedef int (*msgqueue_async_request_handler_t)(uint32_t msg_code, const struct request *req,
+						struct response *rsp, msgqueue_token_t token);
+
 struct msgqueue_handler {
 	uint32_t msg_type;
 	msgqueue_request_handler_t handler;
+	msgqueue_async_request_handler_t async_handler;
 };
 
 #define REGISTER_MESSAGE(msg, func)                                                                \
@@ -64,8 +79,16 @@ struct msgqueue_handler {
 		.handler = func,                                                                   \
 	}
 
+#define REGISTER_ASYNC_MESSAGE(msg, func)                                                          \
+	const STRUCT_SECTION_ITERABLE(msgqueue_handler, registration_for_##msg) = {                \
+		.msg_type = msg,                                                                   \
+		.async_handler = func,                                                             \
+	}
+
 void process_message_queues(void);
 void msgqueue_register_handler(uint32_t msg_code, msgqueue_request_handler_t handler);
+void msgqueue_register_async_handler(uint32_t msg_code, msgqueue_async_request_handler_t handler);
+int msgqueue_complete(msgqueue_token_t token, struct response *response, uint8_t exit_code);
 
 int msgqueue_request_push(uint32_t msgqueue_id, const struct request *request);
 int msgqueue_request_pop(uint32_t msgqueue_id, struct request *request);
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef INCLUDE_TENSTORRENT_SMBUS_PEC_H_
+#define INCLUDE_TENSTORRENT_SMBUS_PEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util_macro.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* CRC-8 polynomial x^8 + x^2 + x + 1 used for the SMBus packet error code */
+#define SMBUS_PEC_POLY 0x07
+
+/*
+ * The implementations below all compute the same CRC-8, with different speed / size trade-offs.
+ * Each takes the PEC of the bytes so far (0 at the start of a transaction) and returns it
+ * updated with @p len bytes from @p buf.
+ */
+
+/* Eight shift and xor steps per byte, no table */
+uint8_t smbus_pec_bitwise(uint8_t pec, const uint8_t *buf, size_t len);
+/* Two lookups per byte in a 16 byte table */
+uint8_t smbus_pec_nibble(uint8_t pec, const uint8_t *buf, size_t len);
+/* One lookup per byte in a 256 byte table */
+uint8_t smbus_pec_table(uint8_t pec, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Update an SMBus packet error code
+ *
+ * Uses the implementation selected with CONFIG_TT_SMBUS_PEC_IMPL.
+ *
+ * @param pec The PEC of the preceding bytes of the transaction, or 0 at the start.
+ * @param buf The bytes to add.
+ * @param len The number of bytes to add.
+ *
+ * @return The updated PEC.
+ */
+static inline uint8_t smbus_pec(uint8_t pec, const uint8_t *buf, size_t len)
+{
+	if (IS_ENABLED(CONFIG_TT_SMBUS_PEC_TABLE)) {
+		return smbus_pec_table(pec, buf, len);
+	} else if (IS_ENABLED(CONFIG_TT_SMBUS_PEC_NIBBLE)) {
+		return smbus_pec_nibble(pec, buf, len);
+	}
+
+	return smbus_pec_bitwise(pec, buf, len);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INCLUDE_TENSTORRENT_SMBUS_PEC_H_ */
@@ -21,6 +21,17 @@ extern "C" {
 #define TT_BOOT_FS_FAILOVER_HEAD_ADDR      (0x4000)
 #define TT_BOOT_FS_IMAGE_TAG_SIZE          8
 
+/*
+ * Optional descriptor index written by `tt_boot_fs.py mkfs --index`. It lives in the unused tail
+ * of the descriptor region and maps a hash of each image tag to the descriptor slot holding it,
+ * using open addressing with linear probing. Images without a valid index are searched linearly.
+ */
+#define TT_BOOT_FS_INDEX_ADDR        (0x3E00)
+#define TT_BOOT_FS_INDEX_MAGIC       (0x58495454) /* "TTIX" */
+#define TT_BOOT_FS_INDEX_VERSION     1
+#define TT_BOOT_FS_INDEX_BUCKETS_MAX 128
+#define TT_BOOT_FS_INDEX_EMPTY       (0xFFFF)
+
 typedef struct {
 	uint32_t image_size: 24;
 	uint32_t invalid: 1;
@@ -54,10 +65,37 @@ typedef struct {
 	uint32_t fd_crc;
 } tt_boot_fs_fd;
 
+/* Regular descriptors end where the index starts, whether or not there is an index */
+#define TT_BOOT_FS_NUM_FDS_MAX                                                                     \
+	((TT_BOOT_FS_INDEX_ADDR - TT_BOOT_FS_FD_HEAD_ADDR) / sizeof(tt_boot_fs_fd))
+
+/* Descriptor index header, followed by num_buckets 16-bit descriptor slots */
+typedef struct {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t num_buckets; /* power of two, at most TT_BOOT_FS_INDEX_BUCKETS_MAX */
+	uint16_t num_fds;
+	uint16_t reserved;
+	uint32_t index_crc; /* tt_boot_fs_cksum() of the fields above and all buckets */
+} tt_boot_fs_index_hdr;
+
 typedef int (*tt_boot_fs_read)(uint32_t addr, uint32_t size, uint8_t *dst);
 typedef int (*tt_boot_fs_write)(uint32_t addr, uint32_t size, const uint8_t *src);
 typedef int (*tt_boot_fs_erase)(uint32_t addr, uint32_t size);
 
+/**
+ * @brief Consumer of one chunk of a file read by @ref tt_boot_fs_read_file
+ *
+ * @param chunk chunk data, only valid for the duration of the call
+ * @param offset offset of the chunk within the file, in bytes
+ * @param len length of the chunk, in bytes
+ * @param user_data opaque pointer passed to @ref tt_boot_fs_read_file
+ *
+ * @return 0 to continue reading, or a negative value to stop
+ */
+typedef int (*tt_boot_fs_chunk_cb)(const uint8_t *chunk, size_t offset, size_t len,
+				   void *user_data);
+
 typedef struct {
 	tt_boot_fs_read hal_spi_read_f;
 	tt_boot_fs_write hal_spi_write_f;
@@ -87,9 +125,37 @@ int tt_boot_fs_add_file(const tt_boot_fs *tt_boot_fs, tt_boot_fs_fd fd_data,
 
 uint32_t tt_boot_fs_cksum(uint32_t cksum, const uint8_t *data, size_t size);
 
+uint32_t tt_boot_fs_tag_hash(const uint8_t *tag);
+
 int tt_boot_fs_get_file(const tt_boot_fs *tt_boot_fs, const uint8_t *tag, uint8_t *buf,
 			size_t buf_size, size_t *file_size);
 
+/**
+ * @brief Read a file in chunks of at most @p buf_size bytes
+ *
+ * Each chunk is read into @p buf, added to the running checksum, and passed to @p chunk_cb, so
+ * that files larger than @p buf can be loaded directly to their destination. Every chunk but the
+ * last is a multiple of 4 bytes long.
+ *
+ * The checksum is only known once the last chunk has been consumed, so the consumer must not
+ * act on the file contents (e.g. release a core from reset) unless this function succeeds.
+ *
+ * @param tt_boot_fs mounted filesystem
+ * @param tag image tag of the file
+ * @param buf 4-byte aligned chunk buffer
+ * @param buf_size size of @p buf, at least 4 bytes
+ * @param chunk_cb chunk consumer
+ * @param user_data opaque pointer passed to @p chunk_cb
+ * @param file_size if not NULL, set to the file size on success
+ *
+ * @retval TT_BOOT_FS_OK on success
+ * @retval TT_BOOT_FS_ERR on invalid arguments, a missing file, a read error or a checksum mismatch
+ * @return the negative value returned by @p chunk_cb, if it stopped the read
+ */
+int tt_boot_fs_read_file(const tt_boot_fs *tt_boot_fs, const uint8_t *tag, uint8_t *buf,
+			 size_t buf_size, tt_boot_fs_chunk_cb chunk_cb, void *user_data,
+			 size_t *file_size);
+
 #ifdef __cplusplus
 }
 #endif
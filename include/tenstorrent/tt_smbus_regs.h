@@ -18,6 +18,14 @@ enum CMFWSMBusReg {
 	CMFW_SMBUS_REQ = 0x10,
 	/* WO, 16 bits. Write with sequence number and message ID to ack cm2dmMessage */
 	CMFW_SMBUS_ACK = 0x11,
+	/* RO, 48 bits per message. Read up to CMFW_SMBUS_REQ_BATCH_MAX cm2dmMessage structs, oldest
+	 * first. Messages stay pending until acked, an empty batch is a single all zero message
+	 */
+	CMFW_SMBUS_REQ_BATCH = 0x12,
+	/* WO, 16 bits. Write with sequence number and message ID of a cm2dmMessage read with
+	 * CMFW_SMBUS_REQ_BATCH to ack it and all the messages before it
+	 */
+	CMFW_SMBUS_ACK_BATCH = 0x13,
 	/* WO, 96 bits. Write with dmStaticInfo struct including DMFW version */
 	CMFW_SMBUS_DM_FW_VERSION = 0x20,
 	/* WO, 16 bits. Write with 0xA5A5 to respond to CMFW request `kCm2DmMsgIdPing` */
@@ -30,8 +38,20 @@ enum CMFWSMBusReg {
 	CMFW_SMBUS_POWER_LIMIT = 0x24,
 	/* WO, 16 bits. Write with current input power for board */
 	CMFW_SMBUS_POWER_INSTANT = 0x25,
+	/* WO, 8 bits. Select the telemetry tag read by CMFW_SMBUS_TELEMETRY_DATA */
+	CMFW_SMBUS_TELEMETRY_REG = 0x26,
+	/* RO, 32 bits. Read the telemetry tag selected with CMFW_SMBUS_TELEMETRY_REG */
+	CMFW_SMBUS_TELEMETRY_DATA = 0x27,
 	/* WO, 16 bits. Write with therm trip count */
 	CMFW_SMBUS_THERM_TRIP_COUNT = 0x28,
+	/* WO, 8 bits per tag. Write with up to CMFW_SMBUS_TELEMETRY_LIST_MAX telemetry tags to be
+	 * read by CMFW_SMBUS_TELEMETRY_BULK
+	 */
+	CMFW_SMBUS_TELEMETRY_LIST = 0x29,
+	/* RO, 32 bits per tag. Read the telemetry tags selected with CMFW_SMBUS_TELEMETRY_LIST,
+	 * in the same order
+	 */
+	CMFW_SMBUS_TELEMETRY_BULK = 0x2A,
 	/* RO, 8 bits. Issue a test read from CMFW scratch register */
 	CMFW_SMBUS_TEST_READ = 0xD8,
 	/* WO, 8 bits. Write to CMFW scratch register */
@@ -47,6 +67,12 @@ enum CMFWSMBusReg {
 	CMFW_SMBUS_MSG_MAX,
 };
 
+/* Maximum number of messages read at once, limited by the 32 byte maximum SMBus block size */
+#define CMFW_SMBUS_REQ_BATCH_MAX 5
+
+/* Maximum number of tags read at once, limited by the 32 byte maximum SMBus block size */
+#define CMFW_SMBUS_TELEMETRY_LIST_MAX 8
+
 /* Request IDs that the CMFW can issue within the */
 
 #endif /* TT_SMBUS_MSGS_H_ */
@@ -21,6 +21,16 @@ extern "C" {
 #ifdef CONFIG_JTAG_EMUL
 int jtag_emul_setup(const struct device *dev, uint32_t *buf, size_t buf_len);
 int jtag_emul_axi_read32(const struct device *dev, uint32_t addr, uint32_t *value);
+/* number of TCK falling edges seen by the emulator since jtag_emul_setup() */
+size_t jtag_emul_tck_count(const struct device *dev);
+/* number of TCK, TMS and TDI writes seen by the GPIO emulator since jtag_emul_setup() */
+size_t jtag_emul_io_count(const struct device *dev);
+/* AXI status captured from the control TDR, AXI_STATUS_DONE after jtag_emul_setup() */
+void jtag_emul_set_axi_status(const struct device *dev, uint32_t status);
+/* reads of addr are not done until their status has been captured once, UINT32_MAX for none */
+void jtag_emul_set_axi_pending_read(const struct device *dev, uint32_t addr);
+/* address of the last AXI read started by the driver through the TDRs */
+uint32_t jtag_emul_axi_last_read(const struct device *dev);
 #endif
 
 typedef int (*jtag_setup_api_t)(const struct device *dev);
@@ -38,6 +48,10 @@ typedef int (*jtag_axi_read32_api_t)(const struct device *dev, uint32_t addr, ui
 typedef int (*jtag_axi_write32_api_t)(const struct device *dev, uint32_t addr, uint32_t value);
 typedef int (*jtag_axi_block_write_api_t)(const struct device *dev, uint32_t addr,
 					  const uint32_t *value, uint32_t len);
+typedef int (*jtag_axi_block_read_api_t)(const struct device *dev, uint32_t addr, uint32_t *value,
+					 uint32_t len);
+
+typedef int (*jtag_gang_api_t)(const struct device *dev, const struct device *other);
 
 struct jtag_api {
 	jtag_setup_api_t setup;
@@ -53,6 +67,9 @@ struct jtag_api {
 	jtag_axi_read32_api_t axi_read32;
 	jtag_axi_write32_api_t axi_write32;
 	jtag_axi_block_write_api_t axi_block_write;
+	jtag_axi_block_read_api_t axi_block_read;
+
+	jtag_gang_api_t gang;
 };
 
 static inline int jtag_tick(const struct device *dev, uint32_t count)
@@ -176,6 +193,58 @@ static inline int jtag_axi_block_write(const struct device *dev, uint32_t addr,
 	return api->axi_block_write(dev, addr, value, len);
 }
 
+/*
+ * Reads len words starting at addr. Drivers can queue the reads back to back and only check the
+ * status at the end of the block, so a failed read may only be reported as an error for the
+ * block as a whole. Falls back to one jtag_axi_read32() per word if the driver has no block read.
+ */
+static inline int jtag_axi_block_read(const struct device *dev, uint32_t addr, uint32_t *value,
+				      uint32_t len)
+{
+	const struct jtag_api *api = dev->api;
+	int ret = 0;
+
+	if (dev == NULL) {
+		return -EINVAL;
+	}
+
+	if (api->axi_block_read != NULL) {
+		return api->axi_block_read(dev, addr, value, len);
+	}
+
+	for (uint32_t i = 0; i < len && ret == 0; ++i) {
+		ret = api->axi_read32(dev, addr + i * sizeof(uint32_t), &value[i]);
+	}
+
+	return ret;
+}
+
+/*
+ * Clocks everything dev shifts out into the TAP of other as well, so that several chips can be
+ * loaded with the same data in one pass. Both TAPs are reset first. Only the TDO of dev is
+ * sampled, so reads and status checks only reflect dev's TAP.
+ *
+ * With other NULL, all devices ganged with dev are released, and left in the same TAP state as
+ * dev.
+ *
+ * Returns -ENOTSUP if the two devices cannot be driven together, e.g. if their pins are on
+ * different ports, and -ENOSYS if the driver does not support ganging at all.
+ */
+static inline int jtag_gang(const struct device *dev, const struct device *other)
+{
+	const struct jtag_api *api = dev->api;
+
+	if (dev == NULL) {
+		return -EINVAL;
+	}
+
+	if (api->gang == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->gang(dev, other);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -86,29 +86,13 @@ void IncreaseAiclk(void)
 	}
 }
 
-/* TODO: Write a Zephyr unit test for this function */
 uint32_t GetMaxAiclkForVoltage(uint32_t voltage)
 {
-	/* Assume monotonically increasing relationship between frequency and voltage */
-	/* and conduct binary search. */
-	/* Note this function doesn't work if you would need lower than fmin to achieve the voltage
-	 */
-
-	/* starting high_freq at fmax + 1 solves the case where the Max AICLK is fmax */
-	uint32_t high_freq = aiclk_ppm.fmax + 1;
-	uint32_t low_freq = aiclk_ppm.fmin;
-
-	while (low_freq < high_freq) {
-		uint32_t mid_freq = (low_freq + high_freq) / 2;
-
-		if (VFCurve(mid_freq) > voltage) {
-			high_freq = mid_freq;
-		} else {
-			low_freq = mid_freq + 1;
-		}
-	}
+	/* Assume monotonically increasing relationship between frequency and voltage. */
+	/* Returns fmin - 1 if you would need lower than fmin to achieve the voltage */
+	uint32_t freq = VFCurveMaxFreq(voltage);
 
-	return low_freq - 1;
+	return CLAMP(freq, aiclk_ppm.fmin - 1, aiclk_ppm.fmax);
 }
 
 void InitArbMaxVoltage(void)
@@ -149,6 +133,7 @@ uint8_t ForceAiclk(uint32_t freq)
 	if (dvfs_enabled) {
 		aiclk_ppm.forced_freq = freq;
 		DVFSChange();
+		WakeDVFS();
 	} else {
 		/* restore to boot frequency */
 		if (freq == 0) {
@@ -168,6 +153,7 @@ static uint8_t AiclkBusyHandler(uint32_t msg_code, const struct request *request
 	} else {
 		SetAiclkArbMin(kAiclkArbMinBusy, aiclk_ppm.fmin);
 	}
+	WakeDVFS();
 	return 0;
 }
 
@@ -15,6 +15,7 @@
 #include <zephyr/sys/byteorder.h>
 #include <tenstorrent/msg_type.h>
 #include <tenstorrent/msgqueue.h>
+#include <tenstorrent/tt_smbus_regs.h>
 
 #include "cm2dm_msg.h"
 #include "asic_state.h"
@@ -22,16 +23,20 @@
 #include "telemetry.h"
 
 typedef struct {
-	uint8_t curr_msg_valid;
+	uint8_t num_inflight;
 	uint8_t next_seq_num;
-	cm2dmMessage curr_msg;
+	/* Messages sent to DMFW and not acknowledged yet, oldest first */
+	cm2dmMessage inflight[CMFW_SMBUS_REQ_BATCH_MAX];
 } Cm2DmMsgState;
 
 static Cm2DmMsgState cm2dm_msg_state;
 static bool dmfw_ping_valid;
 static uint16_t power;
 static uint16_t telemetry_reg;
-K_MSGQ_DEFINE(cm2dm_msg_q, sizeof(Cm2DmMsg), 4, _Alignof(Cm2DmMsg));
+static uint8_t telemetry_list[CMFW_SMBUS_TELEMETRY_LIST_MAX];
+static uint8_t telemetry_list_len;
+K_MSGQ_DEFINE(cm2dm_msg_q, sizeof(Cm2DmMsg), CONFIG_TT_BH_ARC_CM2DM_MSG_QUEUE_SIZE,
+	      _Alignof(Cm2DmMsg));
 
 int32_t EnqueueCm2DmMsg(const Cm2DmMsg *msg)
 {
@@ -39,30 +44,44 @@ int32_t EnqueueCm2DmMsg(const Cm2DmMsg *msg)
 	return k_msgq_put(&cm2dm_msg_q, msg, K_NO_WAIT);
 }
 
-int32_t Cm2DmMsgReqSmbusHandler(uint8_t *data, uint8_t size)
+/* Move queued messages in flight until there are count of them, or the queue is empty */
+static void FillInflight(uint8_t count)
 {
-	BUILD_ASSERT(sizeof(cm2dm_msg_state.curr_msg) == 6,
-		     "Unexpected size of cm2dm_msg_state.curr_msg");
-	if (size != sizeof(cm2dm_msg_state.curr_msg)) {
-		return -1;
+	Cm2DmMsg msg;
+
+	while (cm2dm_msg_state.num_inflight < count &&
+	       k_msgq_get(&cm2dm_msg_q, &msg, K_NO_WAIT) == 0) {
+		cm2dmMessage *curr_msg = &cm2dm_msg_state.inflight[cm2dm_msg_state.num_inflight++];
+
+		curr_msg->msg_id = msg.msg_id;
+		curr_msg->seq_num = cm2dm_msg_state.next_seq_num++;
+		curr_msg->data = msg.data;
 	}
+}
 
-	if (!cm2dm_msg_state.curr_msg_valid) {
-		/* See if there is a message in the queue */
-		Cm2DmMsg msg;
+/* Remove the count oldest messages in flight */
+static void RetireInflight(uint8_t count)
+{
+	cm2dm_msg_state.num_inflight -= count;
+	memmove(&cm2dm_msg_state.inflight[0], &cm2dm_msg_state.inflight[count],
+		cm2dm_msg_state.num_inflight * sizeof(cm2dmMessage));
+}
 
-		if (k_msgq_get(&cm2dm_msg_q, &msg, K_NO_WAIT) != 0) {
-			/* Send the all zero message if the message queue is empty */
-			memset(data, 0, sizeof(cm2dm_msg_state.curr_msg));
-			return 0;
-		}
+int32_t Cm2DmMsgReqSmbusHandler(uint8_t *data, uint8_t size)
+{
+	BUILD_ASSERT(sizeof(cm2dmMessage) == 6, "Unexpected size of cm2dmMessage");
+	if (size != sizeof(cm2dmMessage)) {
+		return -1;
+	}
 
-		cm2dm_msg_state.curr_msg_valid = 1;
-		cm2dm_msg_state.curr_msg.msg_id = msg.msg_id;
-		cm2dm_msg_state.curr_msg.seq_num = cm2dm_msg_state.next_seq_num++;
-		cm2dm_msg_state.curr_msg.data = msg.data;
+	FillInflight(1);
+	if (cm2dm_msg_state.num_inflight == 0) {
+		/* Send the all zero message if the message queue is empty */
+		memset(data, 0, sizeof(cm2dmMessage));
+		return 0;
 	}
-	memcpy(data, &cm2dm_msg_state.curr_msg, sizeof(cm2dm_msg_state.curr_msg));
+
+	memcpy(data, &cm2dm_msg_state.inflight[0], sizeof(cm2dmMessage));
 	return 0;
 }
 
@@ -75,16 +94,55 @@ int32_t Cm2DmMsgAckSmbusHandler(const uint8_t *data, uint8_t size)
 
 	cm2dmAck *ack = (cm2dmAck *)data;
 
-	if (cm2dm_msg_state.curr_msg_valid && ack->msg_id == cm2dm_msg_state.curr_msg.msg_id &&
-	    ack->seq_num == cm2dm_msg_state.curr_msg.seq_num) {
+	if (cm2dm_msg_state.num_inflight > 0 &&
+	    ack->msg_id == cm2dm_msg_state.inflight[0].msg_id &&
+	    ack->seq_num == cm2dm_msg_state.inflight[0].seq_num) {
 		/* Message handled when msg_id and seq_num match the current valid message */
-		cm2dm_msg_state.curr_msg_valid = 0;
+		RetireInflight(1);
 		return 0;
 	} else {
 		return -1;
 	}
 }
 
+int32_t Cm2DmMsgReqBatchSmbusHandler(uint8_t *data, uint8_t size)
+{
+	if (size < sizeof(cm2dmMessage)) {
+		return -1;
+	}
+
+	FillInflight(MIN(size / sizeof(cm2dmMessage), ARRAY_SIZE(cm2dm_msg_state.inflight)));
+	if (cm2dm_msg_state.num_inflight == 0) {
+		/* Send a single all zero message if the message queue is empty */
+		memset(data, 0, sizeof(cm2dmMessage));
+		return sizeof(cm2dmMessage);
+	}
+
+	/* Unacknowledged messages are sent again, followed by newly queued ones */
+	memcpy(data, cm2dm_msg_state.inflight, cm2dm_msg_state.num_inflight * sizeof(cm2dmMessage));
+	return cm2dm_msg_state.num_inflight * sizeof(cm2dmMessage);
+}
+
+int32_t Cm2DmMsgAckBatchSmbusHandler(const uint8_t *data, uint8_t size)
+{
+	if (size != sizeof(cm2dmAck)) {
+		return -1;
+	}
+
+	cm2dmAck *ack = (cm2dmAck *)data;
+
+	/* The ack covers the acked message and all the ones sent before it */
+	for (uint8_t i = 0; i < cm2dm_msg_state.num_inflight; i++) {
+		if (ack->msg_id == cm2dm_msg_state.inflight[i].msg_id &&
+		    ack->seq_num == cm2dm_msg_state.inflight[i].seq_num) {
+			RetireInflight(i + 1);
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
 void IssueChipReset(uint32_t reset_level)
 {
 	lock_down_for_reset();
@@ -131,26 +189,17 @@ int32_t ResetBoardByte(uint8_t *data, uint8_t size)
 {
 	memset(data, 0, size);
 
-	if (!cm2dm_msg_state.curr_msg_valid) {
-		/* See if there is a message in the queue */
-		Cm2DmMsg msg;
-
-		if (k_msgq_get(&cm2dm_msg_q, &msg, K_NO_WAIT) != 0) {
-			/* Send the all zero message if the message queue is empty */
-			*data = 0;
-			return 0;
-		}
-
-		/* If there is a valid message, copy it over to the current message */
-		cm2dm_msg_state.curr_msg_valid = 1;
-		cm2dm_msg_state.curr_msg.msg_id = msg.msg_id;
-		cm2dm_msg_state.curr_msg.seq_num = cm2dm_msg_state.next_seq_num++;
-		cm2dm_msg_state.curr_msg.data = msg.data;
+	FillInflight(1);
+	if (cm2dm_msg_state.num_inflight == 0) {
+		/* Send the all zero message if the message queue is empty */
+		*data = 0;
+		return 0;
 	}
-	*data = cm2dm_msg_state.curr_msg.msg_id;
+
+	*data = cm2dm_msg_state.inflight[0].msg_id;
 
 	/* Because there's no acknowledgment coming, remove the message. */
-	cm2dm_msg_state.curr_msg_valid = 0;
+	RetireInflight(1);
 
 	return 0;
 }
@@ -178,25 +227,57 @@ static uint8_t reset_dm_handler(uint32_t msg_code, const struct request *request
 
 REGISTER_MESSAGE(MSG_TYPE_TRIGGER_RESET, reset_dm_handler);
 
-static uint8_t ping_dm_handler(uint32_t msg_code, const struct request *request,
-			       struct response *response)
+/* Outstanding MSG_TYPE_PING_DM requests, at most one per message queue */
+static msgqueue_token_t ping_dm_tokens[NUM_MSG_QUEUES];
+
+static void ping_dm_work_handler(struct k_work *work)
+{
+	struct response response = {0};
+
+	/* Encode response from DMFW */
+	response.data[1] = dmfw_ping_valid;
+
+	ARRAY_FOR_EACH(ping_dm_tokens, i) {
+		if (ping_dm_tokens[i] != 0) {
+			msgqueue_complete(ping_dm_tokens[i], &response, 0);
+			ping_dm_tokens[i] = 0;
+		}
+	}
+}
+
+static K_WORK_DELAYABLE_DEFINE(ping_dm_work, ping_dm_work_handler);
+
+static int ping_dm_handler(uint32_t msg_code, const struct request *request,
+			   struct response *response, msgqueue_token_t token)
 {
 	/* Send a ping to the dmfw */
 	Cm2DmMsg msg = {
 		.msg_id = kCm2DmMsgIdPing,
 	};
+	/* Runs on the system work queue, like ping_dm_work, so it cannot complete meanwhile */
+	bool in_flight = k_work_delayable_is_pending(&ping_dm_work);
+
+	ARRAY_FOR_EACH(ping_dm_tokens, i) {
+		if (ping_dm_tokens[i] == 0) {
+			ping_dm_tokens[i] = token;
+			break;
+		}
+	}
+
+	/* Share the answer to a ping already in flight, rather than delaying it */
+	if (in_flight) {
+		return -EINPROGRESS;
+	}
 
 	dmfw_ping_valid = false;
 	EnqueueCm2DmMsg(&msg);
-	/* Delay to allow DMFW to respond */
-	k_msleep(50);
+	/* Allow DMFW 50 ms to respond, without blocking the other message queues */
+	k_work_schedule(&ping_dm_work, K_MSEC(50));
 
-	/* Encode response from DMFW */
-	response->data[1] = dmfw_ping_valid;
-	return 0;
+	return -EINPROGRESS;
 }
 
-REGISTER_MESSAGE(MSG_TYPE_PING_DM, ping_dm_handler);
+REGISTER_ASYNC_MESSAGE(MSG_TYPE_PING_DM, ping_dm_handler);
 
 int32_t Dm2CmSendDataHandler(const uint8_t *data, uint8_t size)
 {
@@ -229,6 +310,11 @@ int32_t Dm2CmPingHandler(const uint8_t *data, uint8_t size)
 		return -1;
 	}
 	dmfw_ping_valid = true;
+
+	/* Answer any outstanding MSG_TYPE_PING_DM right away rather than waiting out the delay */
+	if (k_work_delayable_is_pending(&ping_dm_work)) {
+		k_work_reschedule(&ping_dm_work, K_NO_WAIT);
+	}
 	return 0;
 }
 
@@ -289,6 +375,31 @@ int32_t SMBusTelemDataHandler(uint8_t *data, uint8_t size)
 	return 0;
 }
 
+int32_t SMBusTelemListHandler(const uint8_t *data, uint8_t size)
+{
+	if (size == 0 || size > ARRAY_SIZE(telemetry_list)) {
+		return -1;
+	}
+
+	memcpy(telemetry_list, data, size);
+	telemetry_list_len = size;
+	return 0;
+}
+
+/* Tags are read one at a time, include TAG_TELEMETRY_GENERATION to detect a torn read */
+int32_t SMBusTelemBulkDataHandler(uint8_t *data, uint8_t size)
+{
+	if (telemetry_list_len == 0 || size < telemetry_list_len * sizeof(uint32_t)) {
+		return -1;
+	}
+
+	for (uint8_t i = 0; i < telemetry_list_len; i++) {
+		sys_put_le32(GetTelemetryTag(telemetry_list[i]), &data[i * sizeof(uint32_t)]);
+	}
+
+	return telemetry_list_len * sizeof(uint32_t);
+}
+
 int32_t Dm2CmSendThermTripCountHandler(const uint8_t *data, uint8_t size)
 {
 	if (size != 2) {
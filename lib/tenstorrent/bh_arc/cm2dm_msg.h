@@ -18,6 +18,8 @@ typedef struct {
 int32_t EnqueueCm2DmMsg(const Cm2DmMsg *msg);
 int32_t Cm2DmMsgReqSmbusHandler(uint8_t *data, uint8_t size);
 int32_t Cm2DmMsgAckSmbusHandler(const uint8_t *data, uint8_t size);
+int32_t Cm2DmMsgReqBatchSmbusHandler(uint8_t *data, uint8_t size);
+int32_t Cm2DmMsgAckBatchSmbusHandler(const uint8_t *data, uint8_t size);
 int32_t ResetBoardByte(uint8_t *data, uint8_t size);
 
 void ChipResetRequest(void *arg);
@@ -33,6 +35,8 @@ uint16_t GetInputPower(void);
 int32_t Dm2CmSendFanRPMHandler(const uint8_t *data, uint8_t size);
 int32_t SMBusTelemRegHandler(const uint8_t *data, uint8_t size);
 int32_t SMBusTelemDataHandler(uint8_t *data, uint8_t size);
+int32_t SMBusTelemListHandler(const uint8_t *data, uint8_t size);
+int32_t SMBusTelemBulkDataHandler(uint8_t *data, uint8_t size);
 int32_t Dm2CmSendThermTripCountHandler(const uint8_t *data, uint8_t size);
 
 #endif
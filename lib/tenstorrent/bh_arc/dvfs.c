@@ -6,6 +6,7 @@
 
 #include <zephyr/kernel.h>
 #include "vf_curve.h"
+#include "dvfs_sched.h"
 #include "throttler.h"
 #include "aiclk_ppm.h"
 #include "voltage.h"
@@ -28,17 +29,14 @@ void DVFSChange(void)
 	IncreaseAiclk();
 }
 
-static void dvfs_work_handler(struct k_work *work)
+static bool DVFSUpdate(void)
 {
+	uint32_t prev_targ_freq = aiclk_ppm.targ_freq;
+
 	DVFSChange();
-}
-static K_WORK_DEFINE(dvfs_worker, dvfs_work_handler);
 
-static void dvfs_timer_handler(struct k_timer *timer)
-{
-	k_work_submit(&dvfs_worker);
+	return aiclk_ppm.targ_freq != prev_targ_freq || ThrottlersActive();
 }
-static K_TIMER_DEFINE(dvfs_timer, dvfs_timer_handler, NULL);
 
 void InitDVFS(void)
 {
@@ -46,10 +44,18 @@ void InitDVFS(void)
 	InitVoltagePPM();
 	InitArbMaxVoltage();
 	InitThrottlers();
+	InitDVFSScheduler(DVFSUpdate);
 	dvfs_enabled = true;
 }
 
 void StartDVFSTimer(void)
 {
-	k_timer_start(&dvfs_timer, K_MSEC(1), K_MSEC(1));
+	StartDVFSScheduler();
+}
+
+void WakeDVFS(void)
+{
+	if (dvfs_enabled) {
+		WakeDVFSScheduler();
+	}
 }
@@ -13,5 +13,6 @@ extern bool dvfs_enabled;
 void InitDVFS(void);
 void StartDVFSTimer(void);
 void DVFSChange(void);
+void WakeDVFS(void);
 
 #endif
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "dvfs_sched.h"
+
+#define DVFS_PERIOD_MS 1
+
+static DVFSUpdateFn dvfs_update;
+static bool dvfs_started;
+
+#ifdef CONFIG_TT_BH_ARC_DVFS_ADAPTIVE
+static atomic_t dvfs_woken;
+/* Only used from the work handler */
+static uint32_t quiet_updates;
+static bool dvfs_idle;
+#endif
+
+static void dvfs_timer_handler(struct k_timer *timer);
+static K_TIMER_DEFINE(dvfs_timer, dvfs_timer_handler, NULL);
+
+#ifdef CONFIG_TT_BH_ARC_DVFS_ADAPTIVE
+static void UpdateDVFSPeriod(bool busy)
+{
+	if (busy) {
+		quiet_updates = 0;
+		if (dvfs_idle) {
+			dvfs_idle = false;
+			k_timer_start(&dvfs_timer, K_MSEC(DVFS_PERIOD_MS), K_MSEC(DVFS_PERIOD_MS));
+		}
+	} else if (!dvfs_idle && ++quiet_updates >= CONFIG_TT_BH_ARC_DVFS_SETTLE_UPDATES) {
+		dvfs_idle = true;
+		k_timer_start(&dvfs_timer, K_MSEC(CONFIG_TT_BH_ARC_DVFS_IDLE_PERIOD_MS),
+			      K_MSEC(CONFIG_TT_BH_ARC_DVFS_IDLE_PERIOD_MS));
+	}
+}
+#endif
+
+static void dvfs_work_handler(struct k_work *work)
+{
+	bool busy = dvfs_update();
+
+#ifdef CONFIG_TT_BH_ARC_DVFS_ADAPTIVE
+	/* Clear the flag even when busy, a wake-up only needs one update to be seen */
+	if (atomic_clear(&dvfs_woken)) {
+		busy = true;
+	}
+
+	UpdateDVFSPeriod(busy);
+#else
+	ARG_UNUSED(busy);
+#endif
+}
+static K_WORK_DEFINE(dvfs_worker, dvfs_work_handler);
+
+static void dvfs_timer_handler(struct k_timer *timer)
+{
+	k_work_submit(&dvfs_worker);
+}
+
+void InitDVFSScheduler(DVFSUpdateFn update)
+{
+	k_timer_stop(&dvfs_timer);
+	dvfs_started = false;
+	dvfs_update = update;
+
+#ifdef CONFIG_TT_BH_ARC_DVFS_ADAPTIVE
+	atomic_clear(&dvfs_woken);
+	quiet_updates = 0;
+	dvfs_idle = false;
+#endif
+}
+
+void StartDVFSScheduler(void)
+{
+	dvfs_started = true;
+	k_timer_start(&dvfs_timer, K_MSEC(DVFS_PERIOD_MS), K_MSEC(DVFS_PERIOD_MS));
+}
+
+/**
+ * @brief Run a DVFS update now and go back to the fast update rate
+ *
+ * For requests that should not wait for the next update while DVFS is idle. Does nothing
+ * until the scheduler is started.
+ */
+void WakeDVFSScheduler(void)
+{
+#ifdef CONFIG_TT_BH_ARC_DVFS_ADAPTIVE
+	if (dvfs_started) {
+		atomic_set(&dvfs_woken, 1);
+		k_work_submit(&dvfs_worker);
+	}
+#endif
+}
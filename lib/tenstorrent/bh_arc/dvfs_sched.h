@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DVFS_SCHED_H
+#define DVFS_SCHED_H
+
+#include <stdbool.h>
+
+/* Runs one DVFS update, returns true while the inputs or the target frequency are moving */
+typedef bool (*DVFSUpdateFn)(void);
+
+void InitDVFSScheduler(DVFSUpdateFn update);
+void StartDVFSScheduler(void);
+void WakeDVFSScheduler(void);
+
+#endif
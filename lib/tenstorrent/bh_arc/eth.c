@@ -173,16 +173,18 @@ void ReleaseEthReset(uint32_t eth_inst, uint32_t ring)
 	*soft_reset_0 &= ~(1 << 11); /* Clear bit for RISC0 reset, leave RISC1 in reset still */
 }
 
-int LoadEthFw(uint32_t eth_inst, uint32_t ring, uint8_t *fw_image, uint32_t fw_size)
+/* Load chunk_size bytes of ETH FW at offset into the FW image */
+int LoadEthFw(uint32_t eth_inst, uint32_t ring, uint32_t offset, const uint8_t *fw_chunk,
+	      uint32_t chunk_size)
 {
 	/* The shifting is to align the address to the lowest 16 bytes */
 	/* uint32_t fw_load_addr = ((ETH_PARAM_ADDR - fw_size) >> 2) << 2; */
 	uint32_t fw_load_addr = 0x00072000;
 
-	SetupEthTlb(eth_inst, ring, fw_load_addr);
-	volatile uint32_t *eth_tlb = GetTlbWindowAddr(ring, ETH_SETUP_TLB, fw_load_addr);
+	SetupEthTlb(eth_inst, ring, fw_load_addr + offset);
+	volatile uint32_t *eth_tlb = GetTlbWindowAddr(ring, ETH_SETUP_TLB, fw_load_addr + offset);
 
-	bool dma_pass = ArcDmaTransfer(fw_image, (void *)eth_tlb, fw_size);
+	bool dma_pass = ArcDmaTransfer(fw_chunk, (void *)eth_tlb, chunk_size);
 
 	if (!dma_pass) {
 		return -1;
@@ -128,11 +128,12 @@ void SetAxiEnable(uint8_t gddr_inst, uint8_t noc2axi_port, bool axi_enable)
 	}
 }
 
-int LoadMriscFw(uint8_t gddr_inst, uint8_t *fw_image, uint32_t fw_size)
+/* Load chunk_size bytes of MRISC FW at offset into the FW image */
+int LoadMriscFw(uint8_t gddr_inst, uint32_t offset, const uint8_t *fw_chunk, uint32_t chunk_size)
 {
-	volatile uint32_t *mrisc_l1 = SetupMriscL1Tlb(gddr_inst);
+	volatile uint8_t *mrisc_l1 = SetupMriscL1Tlb(gddr_inst);
 
-	bool dma_pass = ArcDmaTransfer(fw_image, (void *)mrisc_l1, fw_size);
+	bool dma_pass = ArcDmaTransfer(fw_chunk, (void *)(mrisc_l1 + offset), chunk_size);
 
 	return dma_pass ? 0 : -1;
 }
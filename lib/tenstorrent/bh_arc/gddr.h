@@ -39,7 +39,7 @@
 
 int read_gddr_telemetry_table(uint8_t gddr_inst, gddr_telemetry_table_t *gddr_telemetry);
 void SetAxiEnable(uint8_t gddr_inst, uint8_t noc2axi_port, bool axi_enable);
-int LoadMriscFw(uint8_t gddr_inst, uint8_t *fw_image, uint32_t fw_size);
+int LoadMriscFw(uint8_t gddr_inst, uint32_t offset, const uint8_t *fw_chunk, uint32_t chunk_size);
 int LoadMriscFwCfg(uint8_t gddr_inst, uint8_t *fw_cfg_image, uint32_t fw_cfg_size);
 void ReleaseMriscReset(uint8_t gddr_inst);
 static inline uint32_t GetGddrSpeedFromCfg(uint8_t *fw_cfg_image)
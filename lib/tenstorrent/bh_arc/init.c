@@ -43,6 +43,8 @@
 LOG_MODULE_REGISTER(InitHW, CONFIG_TT_APP_LOG_LEVEL);
 
 static uint8_t large_sram_buffer[SCRATCHPAD_SIZE] __aligned(4);
+/* Firmware images are streamed through this, config tables are decoded from large_sram_buffer */
+static uint8_t fw_chunk_buffer[CONFIG_TT_BH_ARC_FW_CHUNK_SIZE] __aligned(4);
 
 /* Assert soft reset for all RISC-V cores */
 /* L2CPU is skipped due to JIRA issues BH-25 and BH-28 */
@@ -191,6 +193,25 @@ static int CheckGddrHwTest(void)
 	return any_error;
 }
 
+/* Stream one chunk of MRISC FW into the L1 of every enabled GDDR instance */
+static int LoadMriscFwChunk(const uint8_t *chunk, size_t offset, size_t len, void *user_data)
+{
+	uint32_t dram_mask = *(const uint32_t *)user_data;
+
+	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+		if (IS_BIT_SET(dram_mask, gddr_inst)) {
+			if (LoadMriscFw(gddr_inst, offset, chunk, len)) {
+				LOG_ERR("Failed to load MRISC FW to MRISC from ARC."
+					"Failed on GDDR instance %d.\n",
+					gddr_inst);
+				return -EIO;
+			}
+		}
+	}
+
+	return 0;
+}
+
 static int InitMrisc(void)
 {
 	static const char kMriscFwCfgTag[TT_BOOT_FS_IMAGE_TAG_SIZE] = "memfwcfg";
@@ -203,22 +224,13 @@ static int InitMrisc(void)
 		}
 	}
 
-	if (tt_boot_fs_get_file(&boot_fs_data, kMriscFwTag, large_sram_buffer, SCRATCHPAD_SIZE,
-				&fw_size) != TT_BOOT_FS_OK) {
-		LOG_ERR("Failed to load MRISC FW from file system to ARC.\n");
-		return -EIO;
-	}
 	uint32_t dram_mask = GetDramMask();
 
-	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
-		if (IS_BIT_SET(dram_mask, gddr_inst)) {
-			if (LoadMriscFw(gddr_inst, large_sram_buffer, fw_size)) {
-				LOG_ERR("Failed to load MRISC FW to MRISC from ARC."
-					"Failed on GDDR instance %d.\n",
-					gddr_inst);
-				return -EIO;
-			}
-		}
+	if (tt_boot_fs_read_file(&boot_fs_data, kMriscFwTag, fw_chunk_buffer,
+				 sizeof(fw_chunk_buffer), LoadMriscFwChunk, &dram_mask,
+				 NULL) != TT_BOOT_FS_OK) {
+		LOG_ERR("Failed to load MRISC FW from file system to MRISC.\n");
+		return -EIO;
 	}
 
 	if (tt_boot_fs_get_file(&boot_fs_data, kMriscFwCfgTag, large_sram_buffer, SCRATCHPAD_SIZE,
@@ -315,6 +327,28 @@ static void SerdesEthInit(void)
 	}
 }
 
+/*
+ * Stream one chunk of ETH FW into the L1 of every enabled ETH instance. The cores stay in reset
+ * until the FW config is loaded, which only happens once the whole FW has been verified.
+ */
+static int LoadEthFwChunk(const uint8_t *chunk, size_t offset, size_t len, void *user_data)
+{
+	uint32_t ring = *(const uint32_t *)user_data;
+
+	for (uint8_t eth_inst = 0; eth_inst < MAX_ETH_INSTANCES; eth_inst++) {
+		if (tile_enable.eth_enabled & BIT(eth_inst)) {
+			if (LoadEthFw(eth_inst, ring, offset, chunk, len)) {
+				LOG_ERR("Failed to load ETH FW to ETH from ARC."
+					"Failed on ETH instance %d.\n",
+					eth_inst);
+				return -EIO;
+			}
+		}
+	}
+
+	return 0;
+}
+
 static void EthInit(void)
 {
 	uint32_t ring = 0;
@@ -328,19 +362,13 @@ static void EthInit(void)
 	static const char kEthFwTag[TT_BOOT_FS_IMAGE_TAG_SIZE] = "ethfw";
 	size_t fw_size = 0;
 
-	if (tt_boot_fs_get_file(&boot_fs_data, kEthFwTag, large_sram_buffer, SCRATCHPAD_SIZE,
-				&fw_size) != TT_BOOT_FS_OK) {
+	if (tt_boot_fs_read_file(&boot_fs_data, kEthFwTag, fw_chunk_buffer, sizeof(fw_chunk_buffer),
+				 LoadEthFwChunk, &ring, NULL) != TT_BOOT_FS_OK) {
 		/* Error */
 		/* TODO: Handle more gracefully */
 		return;
 	}
 
-	for (uint8_t eth_inst = 0; eth_inst < MAX_ETH_INSTANCES; eth_inst++) {
-		if (tile_enable.eth_enabled & BIT(eth_inst)) {
-			LoadEthFw(eth_inst, ring, large_sram_buffer, fw_size);
-		}
-	}
-
 	/* Load param table */
 	static const char kEthFwCfgTag[TT_BOOT_FS_IMAGE_TAG_SIZE] = "ethfwcfg";
 
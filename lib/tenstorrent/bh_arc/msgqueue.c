@@ -10,6 +10,7 @@
 #include <stdatomic.h>
 #include <zephyr/init.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 
 #include <tenstorrent/msgqueue.h>
 #include <tenstorrent/post_code.h>
@@ -22,6 +23,13 @@
 
 #define MSG_ERROR_REPLY 0xff
 
+/* Tokens carry the queue id in the low byte and a non-zero sequence number above it */
+#define MSGQUEUE_TOKEN_QUEUE_MASK  0xff
+#define MSGQUEUE_TOKEN_SEQ_SHIFT   8
+#define MSGQUEUE_TOKEN(queue, seq) (((seq) << MSGQUEUE_TOKEN_SEQ_SHIFT) | (queue))
+/* Never issued, held in pending_tokens while a token is being completed */
+#define MSGQUEUE_TOKEN_COMPLETING  MSGQUEUE_TOKEN_QUEUE_MASK
+
 /* this should probably be pulled from Devicetree */
 #define POST_CODE_REG_ADDR 0x0060
 
@@ -91,6 +99,12 @@ static struct message_queue message_queues[NUM_MSG_QUEUES];
 
 /* All message handlers */
 static void *message_handlers[CONFIG_TT_BH_ARC_NUM_MSG_CODES];
+/* Message codes whose handler is a msgqueue_async_request_handler_t */
+static ATOMIC_DEFINE(async_message_handlers, CONFIG_TT_BH_ARC_NUM_MSG_CODES);
+
+/* Token of the outstanding asynchronous message in each queue, or 0 if there is none */
+static atomic_t pending_tokens[NUM_MSG_QUEUES];
+static uint32_t next_token_seq[NUM_MSG_QUEUES];
 
 __attribute__((used)) static const uintptr_t message_queue_info[] = {
 	(uintptr_t)&message_queues, MSG_QUEUE_SIZE | (NUM_MSG_QUEUES << 8), 0, 0};
@@ -196,6 +210,10 @@ int msgqueue_response_pop(uint32_t msgqueue_id, struct response *response)
 		return -1;
 	}
 
+	if (queue->header.response_queue_rptr == queue->header.response_queue_wptr) {
+		return -1;
+	}
+
 	*response = *response_entry(queue, queue->header.response_queue_rptr);
 	atomic_thread_fence(memory_order_seq_cst);
 	queue->header.response_queue_rptr += 1;
@@ -250,20 +268,67 @@ static void advance_serial(struct message_queue *queue, const struct request *re
 	}
 }
 
+static msgqueue_token_t next_token(uint32_t msgqueue_id)
+{
+	next_token_seq[msgqueue_id] =
+		(next_token_seq[msgqueue_id] + 1) & (UINT32_MAX >> MSGQUEUE_TOKEN_SEQ_SHIFT);
+	if (next_token_seq[msgqueue_id] == 0) {
+		next_token_seq[msgqueue_id] = 1;
+	}
+
+	return MSGQUEUE_TOKEN(msgqueue_id, next_token_seq[msgqueue_id]);
+}
+
+/*
+ * Run an asynchronous handler. Returns false if the response will be sent by msgqueue_complete().
+ */
+static bool process_async_message(struct message_queue *queue, uint32_t msg_code,
+				  const struct request *request, struct response *response)
+{
+	uint32_t msgqueue_id = queue - message_queues;
+	msgqueue_token_t token = next_token(msgqueue_id);
+	msgqueue_async_request_handler_t handler = message_handlers[msg_code];
+
+	/* Mark the queue busy first, the handler may complete before it returns */
+	atomic_set(&pending_tokens[msgqueue_id], token);
+
+	int ret = handler(msg_code, request, response, token);
+
+	if (ret == -EINPROGRESS) {
+		return false;
+	}
+
+	/* A handler that completed its token itself has been answered already */
+	if (!atomic_cas(&pending_tokens[msgqueue_id], token, 0)) {
+		return false;
+	}
+
+	response->data[0] |= (ret < 0) ? MSG_ERROR_REPLY : (uint8_t)ret;
+
+	return true;
+}
+
 /* Forward to process_l2_message. Nearly every message takes this path. */
-static void process_l2_message_queue(const struct request *request, struct response *response)
+static bool process_l2_message_queue(struct message_queue *queue, const struct request *request,
+				     struct response *response)
 {
 	uint32_t msg_code = command_code(request);
 
 	if (msg_code >= CONFIG_TT_BH_ARC_NUM_MSG_CODES || message_handlers[msg_code] == NULL) {
 		response->data[0] = MSG_ERROR_REPLY;
-		return;
+		return true;
+	}
+
+	if (atomic_test_bit(async_message_handlers, msg_code)) {
+		return process_async_message(queue, msg_code, request, response);
 	}
 
 	msgqueue_request_handler_t handler = message_handlers[msg_code];
 	uint8_t exit_code = handler(msg_code, request, response);
 
 	response->data[0] |= exit_code;
+
+	return true;
 }
 
 static void handle_set_last_serial(struct message_queue *queue, const struct request *request)
@@ -285,8 +350,8 @@ static void report_scratch_only_message(struct response *response)
 	response->data[0] = MESSAGE_QUEUE_STATUS_SCRATCH_ONLY;
 }
 
-/* Run a single message. */
-static void process_queued_message(struct message_queue *queue, const struct request *request,
+/* Run a single message. Returns false if the response has been deferred. */
+static bool process_queued_message(struct message_queue *queue, const struct request *request,
 				   struct response *response)
 {
 	switch (command_code(request)) {
@@ -300,9 +365,10 @@ static void process_queued_message(struct message_queue *queue, const struct req
 		report_scratch_only_message(response);
 		break;
 	default:
-		process_l2_message_queue(request, response);
-		break;
+		return process_l2_message_queue(queue, request, response);
 	}
+
+	return true;
 }
 
 /* Run all the outstanding messages in a single queue. */
@@ -312,12 +378,16 @@ static void process_message_queue(struct message_queue *queue)
 	uint32_t request_rptr;
 	uint32_t response_wptr;
 
-	while (start_next_message(queue, &request_rptr, &response_wptr)) {
+	/* Messages are answered in order, so stop at an outstanding asynchronous message */
+	while (atomic_get(&pending_tokens[queue - message_queues]) == 0 &&
+	       start_next_message(queue, &request_rptr, &response_wptr)) {
 		struct request request = (struct request){0};
 		struct response response = (struct response){0};
 
 		msgqueue_request_pop(queue - message_queues, &request);
-		process_queued_message(queue, &request, &response);
+		if (!process_queued_message(queue, &request, &response)) {
+			continue;
+		}
 		msgqueue_response_push(queue - message_queues, &response);
 
 		advance_serial(queue, &request);
@@ -351,6 +421,17 @@ void msgqueue_register_handler(uint32_t msg_code, msgqueue_request_handler_t han
 		return;
 	}
 
+	atomic_clear_bit(async_message_handlers, msg_code);
+	message_handlers[msg_code] = handler;
+}
+
+void msgqueue_register_async_handler(uint32_t msg_code, msgqueue_async_request_handler_t handler)
+{
+	if (msg_code >= CONFIG_TT_BH_ARC_NUM_MSG_CODES) {
+		return;
+	}
+
+	atomic_set_bit(async_message_handlers, msg_code);
 	message_handlers[msg_code] = handler;
 }
 
@@ -369,7 +450,11 @@ static void prepare_msg_queue(void)
 static int register_interrupt_handlers(void)
 {
 	STRUCT_SECTION_FOREACH(msgqueue_handler, item) {
-		msgqueue_register_handler(item->msg_type, item->handler);
+		if (item->async_handler != NULL) {
+			msgqueue_register_async_handler(item->msg_type, item->async_handler);
+		} else {
+			msgqueue_register_handler(item->msg_type, item->handler);
+		}
 	}
 	return 0;
 }
@@ -439,6 +524,39 @@ static void msgqueue_msi_overflow_handler(void *arg)
 }
 #endif
 
+/*
+ * Send the response for an asynchronous message and resume servicing its queue. May be called
+ * from any context. Only the first call for a token sends a response, later ones fail.
+ */
+int msgqueue_complete(msgqueue_token_t token, struct response *response, uint8_t exit_code)
+{
+	uint32_t msgqueue_id = token & MSGQUEUE_TOKEN_QUEUE_MASK;
+
+	if (msgqueue_id >= NUM_MSG_QUEUES || response == NULL) {
+		return -EINVAL;
+	}
+
+	/* Claim the token, so that concurrent calls cannot both send a response */
+	if (token == 0 ||
+	    !atomic_cas(&pending_tokens[msgqueue_id], token, MSGQUEUE_TOKEN_COMPLETING)) {
+		return -EALREADY;
+	}
+
+	response->data[0] |= exit_code;
+	msgqueue_response_push(msgqueue_id, response);
+	/* MSG_TYPE_SET_LAST_SERIAL is never asynchronous */
+	message_queues[msgqueue_id].header.last_serial++;
+
+	atomic_set(&pending_tokens[msgqueue_id], 0);
+
+#ifdef CONFIG_BOARD_TT_BLACKHOLE
+	/* Pick up anything that arrived on this queue in the meantime */
+	k_work_submit(&msgqueue_work);
+#endif
+
+	return 0;
+}
+
 void init_msgqueue(void)
 {
 	prepare_msg_queue();
@@ -14,6 +14,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/i2c.h>
+#include <tenstorrent/smbus_pec.h>
 #include <tenstorrent/tt_smbus_regs.h>
 
 /* DMFW to CMFW i2c interface is on I2C0 of tensix_sm */
@@ -51,6 +52,9 @@ typedef enum {
 	kSmbusTransReadWord,
 	kSmbusTransBlockWrite,
 	kSmbusTransBlockRead,
+	/* Variable size blocks, of up to expected_blocksize bytes */
+	kSmbusTransBlockWriteVar,
+	kSmbusTransBlockReadVar,
 } SmbusTransType;
 
 /* SMBus receive handler will get the received data passed by reference */
@@ -59,12 +63,16 @@ typedef int32_t (*SmbusRcvHandler)(const uint8_t *data, uint8_t size);
 /* SMBus transmit handler will get a pointer to fill in data to send, up to size bytes */
 /* Returns 0 on success, any other value on failure */
 typedef int32_t (*SmbusSendHandler)(uint8_t *data, uint8_t size);
+/* SMBus variable size transmit handler will get a pointer to fill in data to send, up to size */
+/* bytes. Returns the number of bytes filled in on success, a negative value on failure */
+typedef int32_t (*SmbusVarSendHandler)(uint8_t *data, uint8_t size);
 
 /* Write commands will have a receive handler, */
 /* Read commands will have a send handler */
 typedef union {
 	SmbusRcvHandler rcv_handler;
 	SmbusSendHandler send_handler;
+	SmbusVarSendHandler var_send_handler;
 } SmbusHandleData;
 
 typedef struct {
@@ -162,6 +170,13 @@ static SmbusConfig smbus_config = {
 		[CMFW_SMBUS_ACK] = {.valid = 1,
 			  .trans_type = kSmbusTransWriteWord,
 			  .handler = {.rcv_handler = &Cm2DmMsgAckSmbusHandler}},
+		[CMFW_SMBUS_REQ_BATCH] = {.valid = 1,
+			  .trans_type = kSmbusTransBlockReadVar,
+			  .expected_blocksize = CMFW_SMBUS_REQ_BATCH_MAX * sizeof(cm2dmMessage),
+			  .handler = {.var_send_handler = &Cm2DmMsgReqBatchSmbusHandler}},
+		[CMFW_SMBUS_ACK_BATCH] = {.valid = 1,
+			  .trans_type = kSmbusTransWriteWord,
+			  .handler = {.rcv_handler = &Cm2DmMsgAckBatchSmbusHandler}},
 		[CMFW_SMBUS_DM_FW_VERSION] = {.valid = 1,
 			  .trans_type = kSmbusTransBlockWrite,
 			  .expected_blocksize = sizeof(dmStaticInfo),
@@ -179,13 +194,21 @@ static SmbusConfig smbus_config = {
 		[CMFW_SMBUS_POWER_INSTANT] = {.valid = 1,
 			  .trans_type = kSmbusTransWriteWord,
 			  .handler = {.rcv_handler = &Dm2CmSendPowerHandler}},
-		[0x26] = {.valid = 1,
+		[CMFW_SMBUS_TELEMETRY_REG] = {.valid = 1,
 			  .trans_type = kSmbusTransWriteByte,
 			  .handler = {.rcv_handler = &SMBusTelemRegHandler}},
-		[0x27] = {.valid = 1,
+		[CMFW_SMBUS_TELEMETRY_DATA] = {.valid = 1,
 			  .trans_type = kSmbusTransBlockRead,
 			  .expected_blocksize = sizeof(uint32_t),
 			  .handler = {.send_handler = &SMBusTelemDataHandler}},
+		[CMFW_SMBUS_TELEMETRY_LIST] = {.valid = 1,
+			  .trans_type = kSmbusTransBlockWriteVar,
+			  .expected_blocksize = CMFW_SMBUS_TELEMETRY_LIST_MAX,
+			  .handler = {.rcv_handler = &SMBusTelemListHandler}},
+		[CMFW_SMBUS_TELEMETRY_BULK] = {.valid = 1,
+			  .trans_type = kSmbusTransBlockReadVar,
+			  .expected_blocksize = CMFW_SMBUS_TELEMETRY_LIST_MAX * sizeof(uint32_t),
+			  .handler = {.var_send_handler = &SMBusTelemBulkDataHandler}},
 		[CMFW_SMBUS_THERM_TRIP_COUNT] = {.valid = 1,
 			  .trans_type = kSmbusTransWriteWord,
 			  .handler = {.rcv_handler = &Dm2CmSendThermTripCountHandler}},
@@ -217,19 +240,36 @@ static SmbusCmdDef *GetCmdDef(uint8_t cmd)
 	return &smbus_config.cmd_defs[cmd];
 }
 
-static uint8_t Crc8(uint8_t crc, uint8_t data)
+/* The debug state registers only exist on the chip */
+static void SetDebugState(uint32_t state)
 {
-	uint8_t i;
-
-	crc ^= data;
-	for (i = 0; i < 8; i++) {
-		if (crc & 0x80) {
-			crc = (crc << 1) ^ 0x07;
-		} else {
-			crc <<= 1;
-		}
+	if (IS_ENABLED(CONFIG_ARC)) {
+		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, state);
+	}
+}
+
+/* Records the error or stop in the top half, keeping the last state in the bottom half */
+static void SetDebugStateFlags(uint32_t flags)
+{
+	if (IS_ENABLED(CONFIG_ARC)) {
+		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR,
+			 flags | ReadReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR));
 	}
-	return crc;
+}
+
+static bool IsBlockTrans(SmbusTransType trans_type)
+{
+	return trans_type == kSmbusTransBlockWrite || trans_type == kSmbusTransBlockRead ||
+	       trans_type == kSmbusTransBlockWriteVar || trans_type == kSmbusTransBlockReadVar;
+}
+
+/* PEC of the address, command and, for block transactions, byte count fields */
+static uint8_t HeaderPec(SmbusCmdDef *curr_cmd, uint8_t rw_bit)
+{
+	/* Address byte needs to be included */
+	uint8_t hdr[] = {I2C_TARGET_ADDR << 1 | rw_bit, smbus_data.command, smbus_data.blocksize};
+
+	return smbus_pec(0, hdr, IsBlockTrans(curr_cmd->trans_type) ? 3 : 2);
 }
 
 static int I2CWriteHandler(struct i2c_target_config *config, uint8_t val)
@@ -237,7 +277,7 @@ static int I2CWriteHandler(struct i2c_target_config *config, uint8_t val)
 	SmbusCmdDef *curr_cmd = GetCmdDef(smbus_data.command);
 
 	if (smbus_data.state == kSmbusStateIdle) {
-		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, 0xc0de1030);
+		SetDebugState(0xc0de1030);
 		smbus_data.command = val;
 		curr_cmd = GetCmdDef(smbus_data.command);
 		if (!curr_cmd->valid) {
@@ -247,7 +287,7 @@ static int I2CWriteHandler(struct i2c_target_config *config, uint8_t val)
 		}
 		smbus_data.state = kSmbusStateCmd;
 	} else if (smbus_data.state == kSmbusStateCmd) {
-		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, 0xc0de1040);
+		SetDebugState(0xc0de1040);
 		switch (curr_cmd->trans_type) {
 		case kSmbusTransBlockWrite:
 			smbus_data.blocksize = val;
@@ -257,6 +297,15 @@ static int I2CWriteHandler(struct i2c_target_config *config, uint8_t val)
 			}
 			smbus_data.state = kSmbusStateRcvData;
 			break;
+		case kSmbusTransBlockWriteVar:
+			smbus_data.blocksize = val;
+			if (smbus_data.blocksize == 0 ||
+			    smbus_data.blocksize > curr_cmd->expected_blocksize) {
+				smbus_data.state = kSmbusStateWaitIdle;
+				return -1;
+			}
+			smbus_data.state = kSmbusStateRcvData;
+			break;
 		case kSmbusTransWriteByte:
 			smbus_data.blocksize = 1;
 			smbus_data.received_data[smbus_data.rcv_index++] = val;
@@ -273,27 +322,19 @@ static int I2CWriteHandler(struct i2c_target_config *config, uint8_t val)
 			return -1;
 		}
 	} else if (smbus_data.state == kSmbusStateRcvData) {
-		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, 0xc0de1050);
+		SetDebugState(0xc0de1050);
 		smbus_data.received_data[smbus_data.rcv_index++] = val;
 		if (smbus_data.rcv_index == smbus_data.blocksize) {
 			smbus_data.state = kSmbusStateRcvPec;
 		}
 	} else if (smbus_data.state == kSmbusStateRcvPec) {
-		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, 0xc0de1060);
+		SetDebugState(0xc0de1060);
 		uint8_t rcv_pec = val;
 
 		/* Calculate the PEC */
-		uint8_t pec = 0;
+		uint8_t pec = HeaderPec(curr_cmd, I2C_WRITE_BIT);
 
-		pec = Crc8(pec, I2C_TARGET_ADDR << 1 |
-					I2C_WRITE_BIT); /* Address byte needs to be included */
-		pec = Crc8(pec, smbus_data.command);
-		if (curr_cmd->trans_type == kSmbusTransBlockWrite) {
-			pec = Crc8(pec, smbus_data.blocksize);
-		}
-		for (int i = 0; i < smbus_data.blocksize; i++) {
-			pec = Crc8(pec, smbus_data.received_data[i]);
-		}
+		pec = smbus_pec(pec, smbus_data.received_data, smbus_data.blocksize);
 
 		if (pec != rcv_pec) {
 			smbus_data.state = kSmbusStateWaitIdle;
@@ -304,8 +345,7 @@ static int I2CWriteHandler(struct i2c_target_config *config, uint8_t val)
 		smbus_data.state = kSmbusStateWaitIdle;
 		return ret;
 	} else {
-		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR,
-			 0xc2de0000 | ReadReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR));
+		SetDebugStateFlags(0xc2de0000);
 		smbus_data.state = kSmbusStateWaitIdle;
 		return -1;
 	}
@@ -317,7 +357,7 @@ static int I2CReadHandler(struct i2c_target_config *config, uint8_t *val)
 	SmbusCmdDef *curr_cmd = GetCmdDef(smbus_data.command);
 
 	if (smbus_data.state == kSmbusStateCmd) {
-		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, 0xc0de0010);
+		SetDebugState(0xc0de0010);
 		/* Calculate blocksize for different types of commands */
 		switch (curr_cmd->trans_type) {
 		case kSmbusTransBlockRead:
@@ -329,6 +369,20 @@ static int I2CReadHandler(struct i2c_target_config *config, uint8_t *val)
 		case kSmbusTransReadWord:
 			smbus_data.blocksize = 2;
 			break;
+		case kSmbusTransBlockReadVar: {
+			/* The send handler decides how much data to send */
+			int32_t size = curr_cmd->handler.var_send_handler(
+				smbus_data.send_data, curr_cmd->expected_blocksize);
+
+			if (size <= 0 || size > curr_cmd->expected_blocksize) {
+				SetDebugState(0xc0de0020);
+				smbus_data.state = kSmbusStateWaitIdle;
+				*val = 0xFF;
+				return -1;
+			}
+			smbus_data.blocksize = size;
+			break;
+		}
 		default:
 			/* Error, invalid command for read */
 			smbus_data.state = kSmbusStateWaitIdle;
@@ -336,8 +390,9 @@ static int I2CReadHandler(struct i2c_target_config *config, uint8_t *val)
 			return -1;
 		}
 		/* Call the send handler to get the data */
-		if (curr_cmd->handler.send_handler(smbus_data.send_data, smbus_data.blocksize)) {
-			WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, 0xc0de0020);
+		if (curr_cmd->trans_type != kSmbusTransBlockReadVar &&
+		    curr_cmd->handler.send_handler(smbus_data.send_data, smbus_data.blocksize)) {
+			SetDebugState(0xc0de0020);
 			/* Send handler returned error */
 			smbus_data.state = kSmbusStateWaitIdle;
 			*val = 0xFF;
@@ -346,7 +401,8 @@ static int I2CReadHandler(struct i2c_target_config *config, uint8_t *val)
 		/* Send the correct data for different types of commands */
 		switch (curr_cmd->trans_type) {
 		case kSmbusTransBlockRead:
-			WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, 0xc0de0030);
+		case kSmbusTransBlockReadVar:
+			SetDebugState(0xc0de0030);
 			*val = smbus_data.blocksize;
 			smbus_data.state = kSmbusStateSendData;
 			break;
@@ -359,37 +415,27 @@ static int I2CReadHandler(struct i2c_target_config *config, uint8_t *val)
 			smbus_data.state = kSmbusStateSendData;
 			break;
 		default:
-			WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, 0xc0de0040);
+			SetDebugState(0xc0de0040);
 			/* Error, invalid command for read */
 			smbus_data.state = kSmbusStateWaitIdle;
 			*val = 0xFF;
 			return -1;
 		}
 	} else if (smbus_data.state == kSmbusStateSendData) {
-		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, 0xc0de0050);
+		SetDebugState(0xc0de0050);
 		*val = smbus_data.send_data[smbus_data.send_index++];
 		if (smbus_data.send_index == smbus_data.blocksize) {
 			smbus_data.state = kSmbusStateSendPec;
 		}
 	} else if (smbus_data.state == kSmbusStateSendPec) {
-		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR, 0xc0de0060);
+		SetDebugState(0xc0de0060);
 		/* Calculate PEC then send it */
-		uint8_t pec = 0;
+		uint8_t pec = HeaderPec(curr_cmd, I2C_READ_BIT);
 
-		pec = Crc8(pec, I2C_TARGET_ADDR << 1 |
-					I2C_READ_BIT); /* Address byte needs to be included */
-		pec = Crc8(pec, smbus_data.command);
-		if (curr_cmd->trans_type == kSmbusTransBlockRead) {
-			pec = Crc8(pec, smbus_data.blocksize);
-		}
-		for (int i = 0; i < smbus_data.blocksize; i++) {
-			pec = Crc8(pec, smbus_data.send_data[i]);
-		}
-		*val = pec;
+		*val = smbus_pec(pec, smbus_data.send_data, smbus_data.blocksize);
 		smbus_data.state = kSmbusStateWaitIdle;
 	} else {
-		WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR,
-			 0xc1de0000 | ReadReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR));
+		SetDebugStateFlags(0xc1de0000);
 		smbus_data.state = kSmbusStateWaitIdle;
 		*val = 0xFF;
 		return -1;
@@ -404,8 +450,7 @@ static int I2CStopHandler(struct i2c_target_config *config)
 	smbus_data.blocksize = 0;
 	smbus_data.rcv_index = 0;
 	smbus_data.send_index = 0;
-	WriteReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR,
-		 0xc3de0000 | ReadReg(I2C0_TARGET_DEBUG_STATE_REG_ADDR));
+	SetDebugStateFlags(0xc3de0000);
 	/* Don't erase data buffers for efficiency */
 	return 0;
 }
@@ -37,6 +37,7 @@
 #define PCIE_INIT_CPL_TIME_REG_ADDR          RESET_UNIT_SCRATCH_RAM_REG_ADDR(14)
 #define I2C0_TARGET_DEBUG_STATE_REG_ADDR     RESET_UNIT_SCRATCH_RAM_REG_ADDR(19)
 #define I2C0_TARGET_DEBUG_STATE_2_REG_ADDR   RESET_UNIT_SCRATCH_RAM_REG_ADDR(20)
+/* SCRATCH_RAM_21 is reserved for the CRC of the bootrom patch loaded by DMC over JTAG */
 
 #define STATUS_FW_VUART_REG_ADDR(n)          RESET_UNIT_SCRATCH_RAM_REG_ADDR(40 + (n))
 /* SCRATCH_RAM_40 - SCRATCH_RAM_41 reserved for virtual uarts */
@@ -17,10 +17,13 @@
 #include "status_reg.h"
 #include "telemetry.h"
 #include "telemetry_internal.h"
+#include "telemetry_history.h"
+#include "timer.h"
 #include "gddr.h"
 
 #include <float.h> /* for FLT_MAX */
 #include <math.h>  /* for floor */
+#include <stdatomic.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -102,15 +105,51 @@ static struct telemetry_table telemetry_table = {
 		[53] = {TAG_ASIC_ID_LOW, TELEM_OFFSET(TAG_ASIC_ID_LOW)},
         [54] = {TAG_THERM_TRIP_COUNT, TELEM_OFFSET(TAG_THERM_TRIP_COUNT)},
 		[55] = {TAG_TELEM_ENUM_COUNT, TELEM_OFFSET(TAG_TELEM_ENUM_COUNT)},
+		[56] = {TAG_TELEMETRY_HISTORY, TELEM_OFFSET(TAG_TELEMETRY_HISTORY)},
+		[57] = {TAG_TELEMETRY_GENERATION, TELEM_OFFSET(TAG_TELEMETRY_GENERATION)},
 	},
 };
 static uint32_t *telemetry = &telemetry_table.telemetry[0];
 
 static struct k_timer telem_update_timer;
 static struct k_work telem_update_worker;
+#ifdef CONFIG_TT_BH_ARC_TELEMETRY_HISTORY
+/* Updated at least as often as the history is sampled */
+static int telem_update_interval = MIN(100, CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_PERIOD_MS);
+#else
 static int telem_update_interval = 100;
+#endif
 
+/* Protects the generation counter, updates may nest (e.g. SMBus handlers preempting the worker) */
+static struct k_spinlock telem_write_lock;
+static unsigned int telem_writers;
 
+/* Start a group of telemetry updates that the host must see all or none of */
+void TelemetryWriteBegin(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&telem_write_lock);
+
+	if (telem_writers++ == 0) {
+		/* Odd generation: update in progress */
+		telemetry[TAG_TELEMETRY_GENERATION]++;
+		atomic_thread_fence(memory_order_seq_cst);
+	}
+
+	k_spin_unlock(&telem_write_lock, key);
+}
+
+void TelemetryWriteEnd(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&telem_write_lock);
+
+	if (--telem_writers == 0) {
+		/* Even generation: telemetry is stable */
+		atomic_thread_fence(memory_order_seq_cst);
+		telemetry[TAG_TELEMETRY_GENERATION]++;
+	}
+
+	k_spin_unlock(&telem_write_lock, key);
+}
 
 uint32_t ConvertFloatToTelemetry(float value)
 {
@@ -280,6 +319,14 @@ static void write_static_telemetry(uint32_t app_version)
 	 * UpdateTelemetryNocTranslation.
 	 */
 
+	/* Address of the telemetry history ring, or 0 if it is not available */
+	if (IS_ENABLED(CONFIG_TT_BH_ARC_TELEMETRY_HISTORY)) {
+		InitTelemetryHistory();
+		telemetry[TAG_TELEMETRY_HISTORY] = (uint32_t)GetTelemetryHistory();
+	} else {
+		telemetry[TAG_TELEMETRY_HISTORY] = 0;
+	}
+
 	if (get_pcb_type() == PcbTypeP300) {
 		/* For the p300 a value of 1 is the left asic and 0 is the right */
 		telemetry[TAG_ASIC_LOCATION] =
@@ -290,6 +337,20 @@ static void write_static_telemetry(uint32_t app_version)
 	}
 }
 
+#ifdef CONFIG_TT_BH_ARC_TELEMETRY_HISTORY
+/* Called at every update, history periods longer than the update interval skip some */
+static void record_telemetry_history(void)
+{
+	static unsigned int updates;
+	int updates_per_sample =
+		MAX(1, CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_PERIOD_MS / telem_update_interval);
+
+	if (updates++ % updates_per_sample == 0) {
+		TelemetryHistoryRecord(telemetry, TimerTimestamp());
+	}
+}
+#endif
+
 static void update_telemetry(void)
 {
 	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_TELEMETRY_START);
@@ -297,6 +358,8 @@ static void update_telemetry(void)
 
 	ReadTelemetryInternal(telem_update_interval, &telemetry_internal_data);
 
+	TelemetryWriteBegin();
+
 	/* Get all dynamically updated values */
 	telemetry[TAG_VCORE] =
 		telemetry_internal_data
@@ -332,6 +395,12 @@ static void update_telemetry(void)
 	telemetry[TAG_MAX_GDDR_TEMP] = GetMaxGDDRTemp();
 	telemetry[TAG_INPUT_POWER] = GetInputPower(); /* Input power - reported in W */
 	telemetry[TAG_TIMER_HEARTBEAT]++; /* Incremented every time the timer is called */
+
+	TelemetryWriteEnd();
+
+#ifdef CONFIG_TT_BH_ARC_TELEMETRY_HISTORY
+	record_telemetry_history();
+#endif
 	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_TELEMETRY_END);
 }
 
@@ -379,8 +448,10 @@ void StartTelemetryTimer(void)
 
 void UpdateDmFwVersion(uint32_t bl_version, uint32_t app_version)
 {
+	TelemetryWriteBegin();
 	telemetry[TAG_DM_BL_FW_VERSION] = bl_version;
 	telemetry[TAG_DM_APP_FW_VERSION] = app_version;
+	TelemetryWriteEnd();
 }
 
 void UpdateTelemetryNocTranslation(bool translation_enabled)
@@ -72,14 +72,28 @@
 #define TAG_ASIC_ID_HIGH         55
 #define TAG_ASIC_ID_LOW          56
 #define TAG_THERM_TRIP_COUNT	 57
+#define TAG_TELEMETRY_HISTORY    58
+#define TAG_TELEMETRY_GENERATION 59
 /* Not a real tag, signifies the last tag in the list.
  * MUST be incremented if new tags are defined
  */
-#define TAG_COUNT                58
+#define TAG_COUNT                60
 
 /* Telemetry tags are at offset `tag` in the telemetry buffer */
 #define TELEM_OFFSET(tag) (tag)
 
+/*
+ * TAG_TELEMETRY_GENERATION is odd while telemetry is being updated and even when it is stable.
+ * To get a consistent snapshot of the telemetry buffer, the host:
+ *
+ * 1. reads the generation, retrying while it is odd
+ * 2. reads the whole telemetry buffer in one bulk read
+ * 3. reads the generation again, and retries from 1. if it changed
+ *
+ * Values that are updated together (e.g. VCORE/TDP/TDC, or the DM FW versions) are then
+ * guaranteed to come from the same update.
+ */
+
 void init_telemetry(uint32_t app_version);
 uint32_t ConvertFloatToTelemetry(float value);
 float ConvertTelemetryToFloat(int32_t value);
@@ -90,5 +104,7 @@ void UpdateTelemetryNocTranslation(bool translation_enabled);
 void UpdateTelemetryBoardPowerLimit(uint32_t power_limit);
 void UpdateTelemetryThermTripCount(uint16_t therm_trip_count);
 uint32_t GetTelemetryTag(uint16_t tag);
+void TelemetryWriteBegin(void);
+void TelemetryWriteEnd(void);
 
 #endif
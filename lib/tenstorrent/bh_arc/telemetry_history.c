@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "telemetry.h"
+#include "telemetry_history.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/toolchain.h>
+
+static const uint16_t history_tags[TELEMETRY_HISTORY_TAG_COUNT] = {TELEMETRY_HISTORY_TAGS};
+
+static struct telemetry_history telemetry_history;
+
+void InitTelemetryHistory(void)
+{
+	memset(&telemetry_history, 0, sizeof(telemetry_history));
+
+	telemetry_history.version = TELEMETRY_HISTORY_VERSION;
+	telemetry_history.tag_count = TELEMETRY_HISTORY_TAG_COUNT;
+	telemetry_history.depth = CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_DEPTH;
+	telemetry_history.period_ms = CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_PERIOD_MS;
+	memcpy(telemetry_history.tags, history_tags, sizeof(history_tags));
+}
+
+void TelemetryHistoryRecord(const uint32_t *telemetry, uint64_t timestamp)
+{
+	uint32_t head = telemetry_history.head;
+	struct telemetry_history_sample *sample =
+		&telemetry_history.samples[head % CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_DEPTH];
+
+	sample->timestamp_lo = (uint32_t)timestamp;
+	sample->timestamp_hi = (uint32_t)(timestamp >> 32);
+	for (int i = 0; i < TELEMETRY_HISTORY_TAG_COUNT; i++) {
+		sample->values[i] = telemetry[history_tags[i]];
+	}
+
+	/* Publish the sample only once it is complete */
+	atomic_thread_fence(memory_order_release);
+	telemetry_history.head = head + 1;
+}
+
+const struct telemetry_history *GetTelemetryHistory(void)
+{
+	return &telemetry_history;
+}
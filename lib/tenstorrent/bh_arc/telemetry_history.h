@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TELEMETRY_HISTORY_H
+#define TELEMETRY_HISTORY_H
+
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+#define TELEMETRY_HISTORY_VERSION 0x00000200 /* v0.2.0 */
+
+#ifdef CONFIG_TT_BH_ARC_TELEMETRY_HISTORY
+/*
+ * Tags recorded in each history sample, in order. TELEMETRY_HISTORY_TAGS is the comma separated
+ * CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_TAGS, defined by the build system without quotes.
+ */
+#define TELEMETRY_HISTORY_TAG_COUNT NUM_VA_ARGS_LESS_1(_, TELEMETRY_HISTORY_TAGS)
+
+struct telemetry_history_sample {
+	uint32_t timestamp_lo; /* refclk TimerTimestamp() at the time of the sample */
+	uint32_t timestamp_hi;
+	uint32_t values[TELEMETRY_HISTORY_TAG_COUNT];
+};
+
+/*
+ * Published through TAG_TELEMETRY_HISTORY so that the host can fetch the whole history in one
+ * read. `head` counts samples ever written; the newest sample is at (head - 1) % depth and the
+ * ring holds MIN(head, depth) valid samples.
+ */
+struct telemetry_history {
+	uint32_t version;
+	uint32_t tag_count;
+	uint32_t depth;
+	uint32_t period_ms; /* nominal time between samples */
+	uint32_t head;
+	uint16_t tags[ROUND_UP(TELEMETRY_HISTORY_TAG_COUNT, 2)];
+	struct telemetry_history_sample samples[CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_DEPTH];
+};
+#endif
+
+void InitTelemetryHistory(void);
+void TelemetryHistoryRecord(const uint32_t *telemetry, uint64_t timestamp);
+const struct telemetry_history *GetTelemetryHistory(void);
+
+#endif
@@ -8,26 +8,17 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/byteorder.h>
 #include "throttler.h"
+#include "throttler_pd.h"
+#include "throttler_params.h"
 #include "aiclk_ppm.h"
 #include "cm2dm_msg.h"
 #include "fw_table.h"
 #include "telemetry_internal.h"
 #include "telemetry.h"
 
-#define kThrottlerAiclkScaleFactor 500.0F
-#define DEFAULT_BOARD_POWER_LIMIT  150
+#define DEFAULT_BOARD_POWER_LIMIT 150
 
 LOG_MODULE_REGISTER(throttler);
-typedef enum {
-	kThrottlerTDP,
-	kThrottlerFastTDC,
-	kThrottlerTDC,
-	kThrottlerThm,
-	kThrottlerBoardPower,
-	kThrottlerGDDRThm,
-	kThrottlerCount,
-} ThrottlerId;
-
 typedef struct {
 	float min;
 	float max;
@@ -61,83 +52,27 @@ static const ThrottlerLimitRange throttler_limit_ranges[kThrottlerCount] = {
 		.max = 100,
 	}};
 
-typedef struct {
-	float alpha_filter;
-	float p_gain;
-	float d_gain;
-} ThrottlerParams;
-
 typedef struct {
 	const AiclkArbMax arb_max; /* The arbiter associated with this throttler */
 
+#ifdef CONFIG_TT_BH_ARC_THROTTLER_FIXED_POINT
+	const ThrottlerParamsFixed params;
+	ThrottlerPDFixed pd;
+	/* The arbiter with its fraction, which accumulates small outputs */
+	q16_16_t arb;
+#else
 	const ThrottlerParams params;
-	float limit;
-	float value;
-	float error;
-	float prev_error;
-	float output;
+	ThrottlerPD pd;
+#endif
 } Throttler;
 
-static Throttler throttler[kThrottlerCount] = {
-	[kThrottlerTDP] = {
-
-			.arb_max = kAiclkArbMaxTDP,
-			.params = {
-
-					.alpha_filter = 1.0,
-					.p_gain = 0.2,
-					.d_gain = 0,
-				},
-		},
-	[kThrottlerFastTDC] = {
-
-			.arb_max = kAiclkArbMaxFastTDC,
-			.params = {
-
-					.alpha_filter = 1.0,
-					.p_gain = 0.5,
-					.d_gain = 0,
-				},
-		},
-	[kThrottlerTDC] = {
-
-			.arb_max = kAiclkArbMaxTDC,
-			.params = {
-
-					.alpha_filter = 0.1,
-					.p_gain = 0.2,
-					.d_gain = 0,
-				},
-		},
-	[kThrottlerThm] = {
-
-			.arb_max = kAiclkArbMaxThm,
-			.params = {
-
-					.alpha_filter = 1.0,
-					.p_gain = 0.2,
-					.d_gain = 0,
-				},
-		},
-	[kThrottlerBoardPower] = {
-			.arb_max = kAiclkArbMaxBoardPower,
-			.params = {
-
-					.alpha_filter = 1.0,
-					.p_gain = 0.1,
-					.d_gain = 0.1,
-			}
+#define THROTTLER_INIT(_id, _arb_max, _alpha_filter, _p_gain, _d_gain)                             \
+	[_id] = {                                                                                  \
+		.arb_max = _arb_max,                                                               \
+		.params = THROTTLER_PARAMS(_alpha_filter, _p_gain, _d_gain),                       \
 	},
-	[kThrottlerGDDRThm] = {
-			.arb_max = kAiclkArbMaxGDDRThm,
-			.params = {
 
-					.alpha_filter = 1.0,
-					.p_gain = 0.2,
-					.d_gain = 0,
-				},
-	}
-};
+static Throttler throttler[kThrottlerCount] = {THROTTLER_LIST(THROTTLER_INIT)};
 
 static void SetThrottlerLimit(ThrottlerId id, float limit)
 {
@@ -145,7 +80,11 @@ static void SetThrottlerLimit(ThrottlerId id, float limit)
 		CLAMP(limit, throttler_limit_ranges[id].min, throttler_limit_ranges[id].max);
 
 	LOG_INF("Throttler %d limit set to %d\n", id, (uint32_t)clamped_limit);
-	throttler[id].limit = clamped_limit;
+#ifdef CONFIG_TT_BH_ARC_THROTTLER_FIXED_POINT
+	ThrottlerPDFixedSetLimit(&throttler[id].pd, q16_16_from_float(clamped_limit));
+#else
+	ThrottlerPDSetLimit(&throttler[id].pd, clamped_limit);
+#endif
 }
 
 void InitThrottlers(void)
@@ -156,28 +95,44 @@ void InitThrottlers(void)
 	SetThrottlerLimit(kThrottlerThm, get_fw_table()->chip_limits.thm_limit);
 	SetThrottlerLimit(kThrottlerBoardPower, DEFAULT_BOARD_POWER_LIMIT);
 	SetThrottlerLimit(kThrottlerGDDRThm, get_fw_table()->chip_limits.gddr_thm_limit);
+
+#ifdef CONFIG_TT_BH_ARC_THROTTLER_FIXED_POINT
+	for (ThrottlerId i = 0; i < kThrottlerCount; i++) {
+		throttler[i].arb = q16_16_from_float(aiclk_ppm.arbiter_max[throttler[i].arb_max]);
+	}
+#endif
 }
 
-static void UpdateThrottler(ThrottlerId id, float value)
+#ifdef CONFIG_TT_BH_ARC_THROTTLER_FIXED_POINT
+static void UpdateThrottler(ThrottlerId id, q16_16_t value)
 {
-	Throttler *t = &throttler[id];
-
-	t->value = t->params.alpha_filter * value + (1 - t->params.alpha_filter) * t->value;
-	t->error = (t->limit - t->value) / t->limit;
-	t->output = t->params.p_gain * t->error + t->params.d_gain * (t->error - t->prev_error);
-	t->prev_error = t->error;
+	ThrottlerPDFixedUpdate(&throttler[id].pd, &throttler[id].params, value);
 }
 
 static void UpdateThrottlerArb(ThrottlerId id)
 {
 	Throttler *t = &throttler[id];
 
-	float arb_val = aiclk_ppm.arbiter_max[t->arb_max];
+	t->arb = ThrottlerPDFixedArbUpdate(&t->pd, t->arb, q16_16_from_int(aiclk_ppm.fmin),
+					   q16_16_from_int(aiclk_ppm.fmax));
+
+	/* Only whole MHz matter to the arbiter */
+	SetAiclkArbMax(t->arb_max, q16_16_to_int(t->arb));
+}
+#else
+static void UpdateThrottler(ThrottlerId id, float value)
+{
+	ThrottlerPDUpdate(&throttler[id].pd, &throttler[id].params, value);
+}
 
-	arb_val += t->output * kThrottlerAiclkScaleFactor;
+static void UpdateThrottlerArb(ThrottlerId id)
+{
+	Throttler *t = &throttler[id];
 
-	SetAiclkArbMax(t->arb_max, arb_val);
+	SetAiclkArbMax(t->arb_max, ThrottlerPDArbUpdate(&t->pd, aiclk_ppm.arbiter_max[t->arb_max],
+						       aiclk_ppm.fmin, aiclk_ppm.fmax));
 }
+#endif
 
 void CalculateThrottlers(void)
 {
@@ -185,18 +140,43 @@ void CalculateThrottlers(void)
 
 	ReadTelemetryInternal(1, &telemetry_internal_data);
 
+#ifdef CONFIG_TT_BH_ARC_THROTTLER_FIXED_POINT
+	q16_16_t vcore_current = q16_16_from_float(telemetry_internal_data.vcore_current);
+
+	UpdateThrottler(kThrottlerTDP, q16_16_from_float(telemetry_internal_data.vcore_power));
+	UpdateThrottler(kThrottlerFastTDC, vcore_current);
+	UpdateThrottler(kThrottlerTDC, vcore_current);
+	UpdateThrottler(kThrottlerThm, q16_16_from_float(telemetry_internal_data.asic_temperature));
+	UpdateThrottler(kThrottlerBoardPower, q16_16_from_int(GetInputPower()));
+	UpdateThrottler(kThrottlerGDDRThm, q16_16_from_int(GetMaxGDDRTemp()));
+#else
 	UpdateThrottler(kThrottlerTDP, telemetry_internal_data.vcore_power);
 	UpdateThrottler(kThrottlerFastTDC, telemetry_internal_data.vcore_current);
 	UpdateThrottler(kThrottlerTDC, telemetry_internal_data.vcore_current);
 	UpdateThrottler(kThrottlerThm, telemetry_internal_data.asic_temperature);
 	UpdateThrottler(kThrottlerBoardPower, GetInputPower());
 	UpdateThrottler(kThrottlerGDDRThm, GetMaxGDDRTemp());
+#endif
 
 	for (ThrottlerId i = 0; i < kThrottlerCount; i++) {
 		UpdateThrottlerArb(i);
 	}
 }
 
+bool ThrottlersActive(void)
+{
+	for (ThrottlerId i = 0; i < kThrottlerCount; i++) {
+		const Throttler *t = &throttler[i];
+
+		/* Also active while the arbiter recovers after the input dropped */
+		if (t->pd.active || aiclk_ppm.arbiter_max[t->arb_max] < aiclk_ppm.fmax) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 int32_t Dm2CmSetBoardPowerLimit(const uint8_t *data, uint8_t size)
 {
 	if (size != 2) {
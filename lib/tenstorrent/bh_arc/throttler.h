@@ -6,8 +6,12 @@
 #ifndef THROTTLER_H
 #define THROTTLER_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 void InitThrottlers(void);
 void CalculateThrottlers(void);
+bool ThrottlersActive(void);
 int32_t Dm2CmSetBoardPowerLimit(const uint8_t *data, uint8_t size);
 
 #endif
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef THROTTLER_PARAMS_H
+#define THROTTLER_PARAMS_H
+
+#include "throttler_pd.h"
+
+typedef enum {
+	kThrottlerTDP,
+	kThrottlerFastTDC,
+	kThrottlerTDC,
+	kThrottlerThm,
+	kThrottlerBoardPower,
+	kThrottlerGDDRThm,
+	kThrottlerCount,
+} ThrottlerId;
+
+/* Every throttler, as X(id, arbiter, alpha_filter, p_gain, d_gain) */
+#define THROTTLER_LIST(X)                                                                          \
+	X(kThrottlerTDP, kAiclkArbMaxTDP, 1.0, 0.2, 0)                                             \
+	X(kThrottlerFastTDC, kAiclkArbMaxFastTDC, 1.0, 0.5, 0)                                     \
+	X(kThrottlerTDC, kAiclkArbMaxTDC, 0.1, 0.2, 0)                                             \
+	X(kThrottlerThm, kAiclkArbMaxThm, 1.0, 0.2, 0)                                             \
+	X(kThrottlerBoardPower, kAiclkArbMaxBoardPower, 1.0, 0.1, 0.1)                             \
+	X(kThrottlerGDDRThm, kAiclkArbMaxGDDRThm, 1.0, 0.2, 0)
+
+/* Initializers of ThrottlerParams and ThrottlerParamsFixed */
+#define THROTTLER_PARAMS_FLOAT(_alpha_filter, _p_gain, _d_gain)                                    \
+	{                                                                                          \
+		.alpha_filter = _alpha_filter,                                                     \
+		.p_gain = _p_gain,                                                                 \
+		.d_gain = _d_gain,                                                                 \
+	}
+
+#define THROTTLER_PARAMS_FIXED(_alpha_filter, _p_gain, _d_gain)                                    \
+	{                                                                                          \
+		.alpha_filter = Q16_16_CONST(_alpha_filter),                                       \
+		.p_gain = Q16_16_CONST(_p_gain),                                                   \
+		.d_gain = Q16_16_CONST(_d_gain),                                                   \
+	}
+
+#ifdef CONFIG_TT_BH_ARC_THROTTLER_FIXED_POINT
+#define THROTTLER_PARAMS THROTTLER_PARAMS_FIXED
+#else
+#define THROTTLER_PARAMS THROTTLER_PARAMS_FLOAT
+#endif
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/sys/util.h>
+
+#include "throttler_pd.h"
+
+/* Product of two Q16.16 values, rounded to nearest so that filters do not drift */
+static q16_16_t q16_16_mul(q16_16_t a, q16_16_t b)
+{
+	return ((int64_t)a * b + (Q16_16_ONE / 2)) >> Q16_16_SHIFT;
+}
+
+/* Converts with integer operations only, saturating values that do not fit */
+q16_16_t q16_16_from_float(float x)
+{
+	uint32_t bits;
+	int32_t exp;
+	uint32_t mant;
+	uint32_t mag;
+
+	memcpy(&bits, &x, sizeof(bits));
+	exp = (int32_t)((bits >> 23) & 0xFF) - 127;
+	mant = (bits & 0x7FFFFF) | BIT(23);
+
+	if (exp < -Q16_16_SHIFT - 1) {
+		/* Also covers zero and denormals */
+		return 0;
+	}
+
+	if (exp >= 31 - Q16_16_SHIFT) {
+		/* Also covers infinity and NaN */
+		mag = INT32_MAX;
+	} else {
+		/* The mantissa holds 23 fraction bits, the result 16 */
+		int32_t shift = exp + Q16_16_SHIFT - 23;
+
+		if (shift >= 0) {
+			mag = mant << shift;
+		} else {
+			mag = ((mant >> (-shift - 1)) + 1) >> 1;
+		}
+	}
+
+	return (bits & BIT(31)) ? -(q16_16_t)mag : (q16_16_t)mag;
+}
+
+void ThrottlerPDSetLimit(ThrottlerPD *t, float limit)
+{
+	t->limit = limit;
+	t->active_above = limit * kThrottlerActivePct / 100;
+	t->idle_below = limit * kThrottlerIdlePct / 100;
+}
+
+/* Hysteresis on the unfiltered input, so that a step is noticed on the first update */
+static bool ThrottlerActive(bool active, bool above, bool below)
+{
+	if (above) {
+		return true;
+	}
+
+	if (below) {
+		return false;
+	}
+
+	return active;
+}
+
+void ThrottlerPDUpdate(ThrottlerPD *t, const ThrottlerParams *params, float value)
+{
+	t->value = params->alpha_filter * value + (1 - params->alpha_filter) * t->value;
+	t->error = (t->limit - t->value) / t->limit;
+	t->output = params->p_gain * t->error + params->d_gain * (t->error - t->prev_error);
+	t->prev_error = t->error;
+	t->active = ThrottlerActive(t->active, value >= t->active_above, value < t->idle_below);
+}
+
+float ThrottlerPDArbUpdate(const ThrottlerPD *t, float arb, float min, float max)
+{
+	return CLAMP(arb + t->output * kThrottlerAiclkScaleFactor, min, max);
+}
+
+void ThrottlerPDFixedSetLimit(ThrottlerPDFixed *t, q16_16_t limit)
+{
+	t->limit = limit;
+	t->inv_limit = limit > 0 ? (uint32_t)((BIT64(32 + Q16_16_SHIFT) + limit / 2) / limit) : 0;
+	t->active_above = (int64_t)limit * kThrottlerActivePct / 100;
+	t->idle_below = (int64_t)limit * kThrottlerIdlePct / 100;
+}
+
+void ThrottlerPDFixedUpdate(ThrottlerPDFixed *t, const ThrottlerParamsFixed *params,
+			    q16_16_t value)
+{
+	/* value + alpha * (new - value) is the same filter, with one multiplication */
+	t->value += q16_16_mul(params->alpha_filter, value - t->value);
+	t->error = ((int64_t)(t->limit - t->value) * t->inv_limit + BIT64(31)) >> 32;
+	t->output = q16_16_mul(params->p_gain, t->error) +
+		    q16_16_mul(params->d_gain, t->error - t->prev_error);
+	t->prev_error = t->error;
+	t->active = ThrottlerActive(t->active, value >= t->active_above, value < t->idle_below);
+}
+
+q16_16_t ThrottlerPDFixedArbUpdate(const ThrottlerPDFixed *t, q16_16_t arb, q16_16_t min,
+				   q16_16_t max)
+{
+	int64_t new_arb = (int64_t)arb + (int64_t)t->output * kThrottlerAiclkScaleFactor;
+
+	return CLAMP(new_arb, min, max);
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef THROTTLER_PD_H
+#define THROTTLER_PD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Added to an arbiter for every unit of throttler output, in MHz */
+#define kThrottlerAiclkScaleFactor 500
+
+/* A throttler becomes active when its input reaches kThrottlerActivePct of its limit, */
+/* and stays active until the input drops below kThrottlerIdlePct */
+#define kThrottlerActivePct 90
+#define kThrottlerIdlePct   80
+
+/* Q16.16 fixed point */
+typedef int32_t q16_16_t;
+
+#define Q16_16_SHIFT 16
+#define Q16_16_ONE   (1 << Q16_16_SHIFT)
+/* Only for constants, so that the conversion is done by the compiler */
+#define Q16_16_CONST(x) ((q16_16_t)((x) * Q16_16_ONE + ((x) < 0 ? -0.5 : 0.5)))
+
+static inline q16_16_t q16_16_from_int(int32_t x)
+{
+	return x * Q16_16_ONE;
+}
+
+/* Rounds towards negative infinity */
+static inline int32_t q16_16_to_int(q16_16_t x)
+{
+	return x >> Q16_16_SHIFT;
+}
+
+q16_16_t q16_16_from_float(float x);
+
+typedef struct {
+	float alpha_filter;
+	float p_gain;
+	float d_gain;
+} ThrottlerParams;
+
+/* Filtered PD controller state of a throttler */
+typedef struct {
+	float limit;
+	float value;
+	float error;
+	float prev_error;
+	float output;
+	float active_above;
+	float idle_below;
+	bool active;
+} ThrottlerPD;
+
+void ThrottlerPDSetLimit(ThrottlerPD *t, float limit);
+void ThrottlerPDUpdate(ThrottlerPD *t, const ThrottlerParams *params, float value);
+float ThrottlerPDArbUpdate(const ThrottlerPD *t, float arb, float min, float max);
+
+typedef struct {
+	q16_16_t alpha_filter;
+	q16_16_t p_gain;
+	q16_16_t d_gain;
+} ThrottlerParamsFixed;
+
+/* Same controller in Q16.16, for cores without an FPU */
+typedef struct {
+	q16_16_t limit;
+	uint32_t inv_limit; /* 2^32 / limit, so that the error needs no division */
+	q16_16_t value;
+	q16_16_t error;
+	q16_16_t prev_error;
+	q16_16_t output;
+	q16_16_t active_above;
+	q16_16_t idle_below;
+	bool active;
+} ThrottlerPDFixed;
+
+void ThrottlerPDFixedSetLimit(ThrottlerPDFixed *t, q16_16_t limit);
+void ThrottlerPDFixedUpdate(ThrottlerPDFixed *t, const ThrottlerParamsFixed *params,
+			    q16_16_t value);
+q16_16_t ThrottlerPDFixedArbUpdate(const ThrottlerPDFixed *t, q16_16_t arb, q16_16_t min,
+				   q16_16_t max);
+
+#endif
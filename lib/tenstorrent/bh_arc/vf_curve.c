@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
 #include <zephyr/sys/util.h>
 #include "vf_curve.h"
 #include "fw_table.h"
@@ -14,24 +16,77 @@
 #define VOLTAGE_MARGIN_MAX 150.0F
 #define VOLTAGE_MARGIN_MIN -150.0F
 
+/* Frequencies covered by the lookup tables, wide enough for any fmin and fmax */
+#define VF_TABLE_FMIN_MHZ 200
+#define VF_TABLE_FMAX_MHZ 1400
+/* The curve is close enough to linear over a few MHz that interpolation is exact to ~1 uV */
+#define VF_TABLE_STEP_MHZ 4
+/* Millivolt steps in the maximum frequency table, more than the curve spans with any margin */
+#define VF_TABLE_VOLTAGES 512
+
 static float freq_margin_mhz;
 static float voltage_margin_mv;
 
+/* Voltage at every VF_TABLE_STEP_MHZ from VF_TABLE_FMIN_MHZ */
+static float vf_table[(VF_TABLE_FMAX_MHZ - VF_TABLE_FMIN_MHZ) / VF_TABLE_STEP_MHZ + 1];
+/* Highest whole MHz that runs at each mV from vf_min_voltage_mv, 0 if there is none */
+static uint16_t vf_max_freq[VF_TABLE_VOLTAGES];
+static uint32_t vf_min_voltage_mv;
+
+static uint32_t CeilVoltage(float voltage_mv)
+{
+	uint32_t ceil_mv = voltage_mv;
+
+	return (float)ceil_mv < voltage_mv ? ceil_mv + 1 : ceil_mv;
+}
+
+static void InitVFTables(void)
+{
+	float min_voltage_mv = VFCurveAnalytic(VF_TABLE_FMIN_MHZ);
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(vf_table); i++) {
+		vf_table[i] = VFCurveAnalytic(VF_TABLE_FMIN_MHZ + i * VF_TABLE_STEP_MHZ);
+	}
+
+	/* The curve is not monotonic over the whole range, so look for its minimum */
+	for (uint32_t freq = VF_TABLE_FMIN_MHZ; freq <= VF_TABLE_FMAX_MHZ; freq++) {
+		min_voltage_mv = MIN(min_voltage_mv, VFCurveAnalytic(freq));
+	}
+	vf_min_voltage_mv = min_voltage_mv;
+
+	/* Frequencies are visited in increasing order, so the last one stored at a voltage wins */
+	memset(vf_max_freq, 0, sizeof(vf_max_freq));
+	for (uint32_t freq = VF_TABLE_FMIN_MHZ; freq <= VF_TABLE_FMAX_MHZ; freq++) {
+		uint32_t i = CeilVoltage(VFCurveAnalytic(freq)) - vf_min_voltage_mv;
+
+		if (i < ARRAY_SIZE(vf_max_freq)) {
+			vf_max_freq[i] = freq;
+		}
+	}
+
+	/* and every frequency that runs at a voltage also runs at all higher ones */
+	for (uint32_t i = 1; i < ARRAY_SIZE(vf_max_freq); i++) {
+		vf_max_freq[i] = MAX(vf_max_freq[i], vf_max_freq[i - 1]);
+	}
+}
+
 void InitVFCurve(void)
 {
 	freq_margin_mhz = CLAMP(get_fw_table()->chip_limits.frequency_margin, FREQ_MARGIN_MIN,
 				FREQ_MARGIN_MAX);
 	voltage_margin_mv = CLAMP(get_fw_table()->chip_limits.voltage_margin, VOLTAGE_MARGIN_MIN,
 				  VOLTAGE_MARGIN_MAX);
+
+	InitVFTables();
 }
 
 /**
- * @brief Calculate the voltage based on the frequency
+ * @brief Calculate the voltage based on the frequency, without the lookup table
  *
  * @param freq_mhz The frequency in MHz
  * @return The voltage in mV
  */
-float VFCurve(float freq_mhz)
+float VFCurveAnalytic(float freq_mhz)
 {
 	float freq_with_margin_mhz = freq_mhz + freq_margin_mhz;
 	float voltage_mv = 0.00031395F * freq_with_margin_mhz * freq_with_margin_mhz -
@@ -39,3 +94,41 @@ float VFCurve(float freq_mhz)
 
 	return voltage_mv + voltage_margin_mv;
 }
+
+/**
+ * @brief Calculate the voltage based on the frequency
+ *
+ * Interpolates in the table built by InitVFCurve(), falling back to the polynomial for
+ * frequencies outside of it.
+ *
+ * @param freq_mhz The frequency in MHz
+ * @return The voltage in mV
+ */
+float VFCurve(float freq_mhz)
+{
+	float pos = (freq_mhz - VF_TABLE_FMIN_MHZ) * (1.0F / VF_TABLE_STEP_MHZ);
+
+	if (pos >= 0.0F && pos < ARRAY_SIZE(vf_table) - 1) {
+		uint32_t i = pos;
+
+		return vf_table[i] + (pos - i) * (vf_table[i + 1] - vf_table[i]);
+	}
+
+	return VFCurveAnalytic(freq_mhz);
+}
+
+/**
+ * @brief Find the highest frequency that runs at a voltage
+ *
+ * @param voltage_mv The voltage in mV
+ * @return The highest whole MHz between 200 and 1400 MHz whose VFCurveAnalytic() voltage is
+ *         at most @p voltage_mv, or 0 if there is none
+ */
+uint32_t VFCurveMaxFreq(uint32_t voltage_mv)
+{
+	if (voltage_mv < vf_min_voltage_mv) {
+		return 0;
+	}
+
+	return vf_max_freq[MIN(voltage_mv - vf_min_voltage_mv, ARRAY_SIZE(vf_max_freq) - 1)];
+}
@@ -6,6 +6,10 @@
 #ifndef VF_CURVE_H
 #define VF_CURVE_H
 
+#include <stdint.h>
+
 void InitVFCurve(void);
 float VFCurve(float freq_mhz);
+float VFCurveAnalytic(float freq_mhz);
+uint32_t VFCurveMaxFreq(uint32_t voltage_mv);
 #endif
@@ -7,7 +7,14 @@
 #include "zephyr/drivers/gpio.h"
 #include <tenstorrent/bh_arc.h>
 
-int bharc_enable_i2cbus(const struct bh_arc *dev)
+#define BH_ARC_DATA_DEFINE(n) struct bh_arc_data BH_ARC_DATA_NAME(n);
+
+DT_FOREACH_STATUS_OKAY(tenstorrent_bh_arc, BH_ARC_DATA_DEFINE)
+
+/* Protects the bus session state of every ARC */
+static K_MUTEX_DEFINE(bh_arc_bus_lock);
+
+static int bharc_enable_i2cbus(const struct bh_arc *dev)
 {
 	int ret = 0;
 
@@ -18,7 +25,7 @@ int bharc_enable_i2cbus(const struct bh_arc *dev)
 	return ret;
 }
 
-int bharc_disable_i2cbus(const struct bh_arc *dev)
+static int bharc_disable_i2cbus(const struct bh_arc *dev)
 {
 	int ret = 0;
 
@@ -29,19 +36,116 @@ int bharc_disable_i2cbus(const struct bh_arc *dev)
 	return ret;
 }
 
+static void bharc_bus_idle_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bh_arc_data *data = CONTAINER_OF(dwork, struct bh_arc_data, idle_work);
+
+	k_mutex_lock(&bh_arc_bus_lock, K_FOREVER);
+	if (data->session_count == 0 && data->bus_enabled) {
+		bharc_disable_i2cbus(data->dev);
+		data->bus_enabled = false;
+	}
+	k_mutex_unlock(&bh_arc_bus_lock);
+}
+
+int bharc_bus_session_begin(const struct bh_arc *dev)
+{
+	struct bh_arc_data *data = dev->data;
+	int ret = 0;
+
+	if (data == NULL) {
+		return bharc_enable_i2cbus(dev);
+	}
+
+	k_mutex_lock(&bh_arc_bus_lock, K_FOREVER);
+
+	if (!data->initialized) {
+		data->dev = dev;
+		k_work_init_delayable(&data->idle_work, bharc_bus_idle_work_handler);
+		data->initialized = true;
+	}
+
+	data->session_count++;
+	k_work_cancel_delayable(&data->idle_work);
+
+	if (!data->bus_enabled) {
+		ret = bharc_enable_i2cbus(dev);
+		data->bus_enabled = (ret == 0);
+	}
+
+	k_mutex_unlock(&bh_arc_bus_lock);
+
+	return ret;
+}
+
+int bharc_bus_session_end(const struct bh_arc *dev)
+{
+	struct bh_arc_data *data = dev->data;
+	int ret = 0;
+
+	if (data == NULL) {
+		return bharc_disable_i2cbus(dev);
+	}
+
+	k_mutex_lock(&bh_arc_bus_lock, K_FOREVER);
+
+	__ASSERT(data->session_count > 0, "unbalanced bus session end");
+	data->session_count--;
+
+	if (data->session_count == 0 && data->bus_enabled) {
+		if (CONFIG_TT_BH_CHIP_BUS_IDLE_TIMEOUT_MS == 0) {
+			ret = bharc_disable_i2cbus(dev);
+			data->bus_enabled = false;
+		} else {
+			k_work_schedule(&data->idle_work,
+					K_MSEC(CONFIG_TT_BH_CHIP_BUS_IDLE_TIMEOUT_MS));
+		}
+	}
+
+	k_mutex_unlock(&bh_arc_bus_lock);
+
+	return ret;
+}
+
+int bharc_bus_release(const struct bh_arc *dev)
+{
+	struct bh_arc_data *data = dev->data;
+	int ret = 0;
+
+	if (data == NULL) {
+		/* The bus is only enabled around transactions */
+		return 0;
+	}
+
+	k_mutex_lock(&bh_arc_bus_lock, K_FOREVER);
+
+	if (data->session_count != 0) {
+		ret = -EBUSY;
+	} else if (data->bus_enabled) {
+		k_work_cancel_delayable(&data->idle_work);
+		ret = bharc_disable_i2cbus(dev);
+		data->bus_enabled = false;
+	}
+
+	k_mutex_unlock(&bh_arc_bus_lock);
+
+	return ret;
+}
+
 int bharc_smbus_block_read(const struct bh_arc *dev, uint8_t cmd, uint8_t *count, uint8_t *output)
 {
 	int ret;
 
-	ret = bharc_enable_i2cbus(dev);
+	ret = bharc_bus_session_begin(dev);
 	if (ret != 0) {
-		bharc_disable_i2cbus(dev);
+		bharc_bus_session_end(dev);
 		return ret;
 	}
 
 	ret = smbus_block_read(dev->smbus.bus, dev->smbus.addr, cmd, count, output);
 
-	int newret = bharc_disable_i2cbus(dev);
+	int newret = bharc_bus_session_end(dev);
 
 	if (ret == 0) {
 		return newret;
@@ -54,15 +158,15 @@ int bharc_smbus_block_write(const struct bh_arc *dev, uint8_t cmd, uint8_t count
 {
 	int ret;
 
-	ret = bharc_enable_i2cbus(dev);
+	ret = bharc_bus_session_begin(dev);
 	if (ret != 0) {
-		bharc_disable_i2cbus(dev);
+		bharc_bus_session_end(dev);
 		return ret;
 	}
 
 	ret = smbus_block_write(dev->smbus.bus, dev->smbus.addr, cmd, count, input);
 
-	int newret = bharc_disable_i2cbus(dev);
+	int newret = bharc_bus_session_end(dev);
 
 	if (ret == 0) {
 		return newret;
@@ -75,15 +179,15 @@ int bharc_smbus_word_data_write(const struct bh_arc *dev, uint16_t cmd, uint16_t
 {
 	int ret;
 
-	ret = bharc_enable_i2cbus(dev);
+	ret = bharc_bus_session_begin(dev);
 	if (ret != 0) {
-		bharc_disable_i2cbus(dev);
+		bharc_bus_session_end(dev);
 		return ret;
 	}
 
 	ret = smbus_word_data_write(dev->smbus.bus, dev->smbus.addr, cmd, word);
 
-	int newret = bharc_disable_i2cbus(dev);
+	int newret = bharc_bus_session_end(dev);
 
 	if (ret == 0) {
 		return newret;
@@ -96,15 +200,15 @@ int bharc_smbus_byte_data_write(const struct bh_arc *dev, uint8_t cmd, uint8_t w
 {
 	int ret;
 
-	ret = bharc_enable_i2cbus(dev);
+	ret = bharc_bus_session_begin(dev);
 	if (ret != 0) {
-		bharc_disable_i2cbus(dev);
+		bharc_bus_session_end(dev);
 		return ret;
 	}
 
 	ret = smbus_byte_data_write(dev->smbus.bus, dev->smbus.addr, cmd, word);
 
-	int newret = bharc_disable_i2cbus(dev);
+	int newret = bharc_bus_session_end(dev);
 
 	if (ret == 0) {
 		return newret;
@@ -12,6 +12,7 @@
 #include <tenstorrent/tt_smbus_regs.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
 #include <string.h>
 
 LOG_MODULE_REGISTER(bh_chip, CONFIG_TT_BH_CHIP_LOG_LEVEL);
@@ -26,6 +27,61 @@ void bh_chip_cancel_bus_transfer_clear(struct bh_chip *dev)
 	dev->data.bus_cancel_flag = 0;
 }
 
+static int bh_chip_ack_cm2dm_message(struct bh_chip *chip, uint8_t cmd, const cm2dmMessage *msg,
+				     cm2dmAck *ack)
+{
+	union cm2dmAckWire wire_ack;
+
+	ack->msg_id = msg->msg_id;
+	ack->seq_num = msg->seq_num;
+	wire_ack.f = *ack;
+
+	return bharc_smbus_word_data_write(&chip->config.arc, cmd, wire_ack.val);
+}
+
+/* Read a batch of messages and acknowledge all of them at once */
+static int bh_chip_read_cm2dm_batch(struct bh_chip *chip)
+{
+	uint8_t count;
+	uint8_t buf[32]; /* Max block counter per API */
+	cm2dmMessage *last;
+	cm2dmAck ack;
+	int ret;
+
+	BUILD_ASSERT(sizeof(chip->data.cm2dm_batch) <= sizeof(buf));
+
+	ret = bharc_smbus_block_read(&chip->config.arc, CMFW_SMBUS_REQ_BATCH, &count, buf);
+	if (ret == -EIO) {
+		/* The command was NACKed, the CMFW does not know the batch register */
+		return -ENOTSUP;
+	} else if (ret != 0) {
+		return ret;
+	}
+
+	if (count == 0 || count > sizeof(chip->data.cm2dm_batch) ||
+	    (count % sizeof(cm2dmMessage)) != 0) {
+		return -EBADMSG;
+	}
+
+	memcpy(chip->data.cm2dm_batch, buf, count);
+	last = &chip->data.cm2dm_batch[count / sizeof(cm2dmMessage) - 1];
+	if (last->msg_id == kCm2DmMsgIdNull) {
+		/* Empty batch */
+		return 0;
+	}
+
+	/* If the ack is lost, the CMFW sends the same messages again in the next batch */
+	ret = bh_chip_ack_cm2dm_message(chip, CMFW_SMBUS_ACK_BATCH, last, &ack);
+	if (ret != 0) {
+		return ret;
+	}
+
+	chip->data.cm2dm_batch_len = count / sizeof(cm2dmMessage);
+	chip->data.cm2dm_batch_index = 0;
+
+	return 0;
+}
+
 cm2dmMessageRet bh_chip_get_cm2dm_message(struct bh_chip *chip)
 {
 	cm2dmMessageRet output = {
@@ -34,26 +90,103 @@ cm2dmMessageRet bh_chip_get_cm2dm_message(struct bh_chip *chip)
 	};
 	uint8_t count = sizeof(output.msg);
 	uint8_t buf[32]; /* Max block counter per API */
+	bool batch_nacked = false;
+
+	if (chip->data.cm2dm_batch_index == chip->data.cm2dm_batch_len &&
+	    !chip->data.cm2dm_batch_unsupported) {
+		chip->data.cm2dm_batch_len = 0;
+		chip->data.cm2dm_batch_index = 0;
+
+		output.ret = bh_chip_read_cm2dm_batch(chip);
+		if (output.ret == 0) {
+			chip->data.cm2dm_batch_nacks = 0;
+		}
+
+		if (output.ret == -ENOTSUP) {
+			/* A NACK may also be a glitch on the bus, so read a single message instead */
+			batch_nacked = true;
+		} else if (output.ret != 0 || chip->data.cm2dm_batch_len == 0) {
+			/* Nothing pending, or a bus error that the next poll retries */
+			memset(&output.msg, 0, sizeof(output.msg));
+			return output;
+		}
+	}
 
+	if (chip->data.cm2dm_batch_index < chip->data.cm2dm_batch_len) {
+		output.msg = chip->data.cm2dm_batch[chip->data.cm2dm_batch_index++];
+		output.ret = 0;
+		output.ack.msg_id = output.msg.msg_id;
+		output.ack.seq_num = output.msg.seq_num;
+		output.ack_ret = 0;
+		return output;
+	}
+
+	/* Older CMFW without batch support, read and ack a single message */
 	output.ret = bharc_smbus_block_read(&chip->config.arc, CMFW_SMBUS_REQ, &count, buf);
 	memcpy(&output.msg, buf, sizeof(output.msg));
 
+	/* Only a CMFW that keeps rejecting batches, but not single messages, lacks batch support */
+	if (batch_nacked && output.ret == 0 &&
+	    ++chip->data.cm2dm_batch_nacks >= BH_CHIP_CM2DM_BATCH_NACK_LIMIT) {
+		LOG_INF("CMFW does not support batched cm2dm messages");
+		chip->data.cm2dm_batch_unsupported = true;
+	}
+
 	if (output.ret == 0 && output.msg.msg_id != 0) {
-		cm2dmAck ack = {0};
+		output.ack_ret = bh_chip_ack_cm2dm_message(chip, CMFW_SMBUS_ACK, &output.msg,
+							   &output.ack);
+		if (output.msg.msg_id == kCm2DmMsgIdReady) {
+			/* The CMFW was restarted, possibly with a newer version */
+			chip->data.cm2dm_batch_unsupported = false;
+			chip->data.cm2dm_batch_nacks = 0;
+		}
+	}
+
+	return output;
+}
+
+void bh_chip_discard_cm2dm_messages(struct bh_chip *chip)
+{
+	chip->data.cm2dm_batch_len = 0;
+	chip->data.cm2dm_batch_index = 0;
+	/* The CMFW may come back with a different version */
+	chip->data.cm2dm_batch_unsupported = false;
+	chip->data.cm2dm_batch_nacks = 0;
+}
 
-		ack.msg_id = output.msg.msg_id;
-		ack.seq_num = output.msg.seq_num;
-		union cm2dmAckWire wire_ack;
+#ifdef CONFIG_TT_BH_CHIP_WORKQUEUE
+static void bh_chip_event_work_handler(struct k_work *work)
+{
+	struct bh_chip_data *data = CONTAINER_OF(work, struct bh_chip_data, event_work);
+	struct bh_chip *chip = CONTAINER_OF(data, struct bh_chip, data);
+	uint32_t events = atomic_clear(&data->events);
 
-		wire_ack.f = ack;
-		output.ack = ack;
-		output.ack_ret = bharc_smbus_word_data_write(&chip->config.arc,
-							     CMFW_SMBUS_ACK, wire_ack.val);
+	if (events != 0) {
+		data->event_handler(chip, events);
 	}
+}
 
-	return output;
+void bh_chip_workq_start(struct bh_chip *chip, bh_chip_event_handler_t handler, const char *name)
+{
+	const struct k_work_queue_config cfg = {
+		.name = name,
+	};
+
+	chip->data.event_handler = handler;
+	atomic_clear(&chip->data.events);
+	k_work_init(&chip->data.event_work, bh_chip_event_work_handler);
+	k_work_queue_start(&chip->data.workq, chip->data.workq_stack,
+			   K_KERNEL_STACK_SIZEOF(chip->data.workq_stack),
+			   CONFIG_TT_BH_CHIP_WORKQUEUE_PRIORITY, &cfg);
 }
 
+void bh_chip_workq_post(struct bh_chip *chip, uint32_t events)
+{
+	atomic_or(&chip->data.events, events);
+	k_work_submit_to_queue(&chip->data.workq, &chip->data.event_work);
+}
+#endif
+
 int bh_chip_set_static_info(struct bh_chip *chip, dmStaticInfo *info)
 {
 	int ret;
@@ -101,6 +234,45 @@ int bh_chip_set_therm_trip_count(struct bh_chip *chip, uint16_t therm_trip_count
 	return ret;
 }
 
+int bh_chip_set_telemetry_list(struct bh_chip *chip, const uint8_t *tags, uint8_t num_tags)
+{
+	uint8_t buf[CMFW_SMBUS_TELEMETRY_LIST_MAX];
+
+	if (num_tags == 0 || num_tags > ARRAY_SIZE(buf)) {
+		return -EINVAL;
+	}
+
+	memcpy(buf, tags, num_tags);
+
+	return bharc_smbus_block_write(&chip->config.arc, CMFW_SMBUS_TELEMETRY_LIST, num_tags, buf);
+}
+
+int bh_chip_get_telemetry(struct bh_chip *chip, uint32_t *values, uint8_t num_tags)
+{
+	uint8_t count;
+	uint8_t buf[32]; /* Max block counter per API */
+	int ret;
+
+	if (num_tags == 0 || num_tags > CMFW_SMBUS_TELEMETRY_LIST_MAX) {
+		return -EINVAL;
+	}
+
+	ret = bharc_smbus_block_read(&chip->config.arc, CMFW_SMBUS_TELEMETRY_BULK, &count, buf);
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (count != num_tags * sizeof(uint32_t)) {
+		return -EIO;
+	}
+
+	for (uint8_t i = 0; i < num_tags; i++) {
+		values[i] = sys_get_le32(&buf[i * sizeof(uint32_t)]);
+	}
+
+	return 0;
+}
+
 void bh_chip_assert_asic_reset(const struct bh_chip *chip)
 {
 	gpio_pin_set_dt(&chip->config.asic_reset, 1);
@@ -132,7 +304,7 @@ void therm_trip_detected(const struct device *dev, struct gpio_callback *cb, uin
 
 	chip->data.therm_trip_triggered = true;
 	bh_chip_cancel_bus_transfer_set(chip);
-	tt_event_post(TT_EVENT_WAKE);
+	tt_event_post(TT_EVENT_THERM_TRIP);
 }
 
 int therm_trip_gpio_setup(struct bh_chip *chip)
@@ -171,7 +343,7 @@ void pgood_change_detected(const struct device *dev, struct gpio_callback *cb, u
 	} else {
 		chip->data.pgood_fall_triggered = true;
 	}
-	tt_event_post(TT_EVENT_WAKE);
+	tt_event_post(TT_EVENT_PGOOD);
 }
 
 int pgood_gpio_setup(struct bh_chip *chip)
@@ -4,8 +4,6 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-#include "bh_arc_priv.h"
-
 #include <tenstorrent/bh_chip.h>
 
 #include <zephyr/drivers/gpio.h>
@@ -17,18 +15,18 @@ struct tt_smbus_stm32_config {
 
 void bh_chip_set_straps(struct bh_chip *chip)
 {
-	bharc_enable_i2cbus(&chip->config.arc);
+	bh_chip_bus_session_begin(chip);
 	if (chip->config.strapping.gpio6.port != NULL) {
 		gpio_pin_configure_dt(&chip->config.strapping.gpio6, GPIO_OUTPUT_ACTIVE);
 	}
-	bharc_disable_i2cbus(&chip->config.arc);
+	bh_chip_bus_session_end(chip);
 }
 
 void bh_chip_unset_straps(struct bh_chip *chip)
 {
-	bharc_enable_i2cbus(&chip->config.arc);
+	bh_chip_bus_session_begin(chip);
 	if (chip->config.strapping.gpio6.port != NULL) {
 		gpio_pin_configure_dt(&chip->config.strapping.gpio6, GPIO_INPUT);
 	}
-	bharc_disable_i2cbus(&chip->config.arc);
+	bh_chip_bus_session_end(chip);
 }
@@ -12,21 +12,117 @@
 #include <zephyr/sys/util.h>
 
 tt_boot_fs boot_fs_data;
-static tt_boot_fs_fd boot_fs_cache[16];
+static tt_boot_fs_fd boot_fs_cache[CONFIG_TT_BOOT_FS_FD_CACHE_SIZE];
+/* Number of valid descriptors at the head of boot_fs_cache */
+static uint32_t boot_fs_cache_count;
+
+#ifdef CONFIG_TT_BOOT_FS_INDEX
+static struct {
+	tt_boot_fs_index_hdr hdr;
+	uint16_t buckets[TT_BOOT_FS_INDEX_BUCKETS_MAX];
+} boot_fs_index;
+static bool boot_fs_index_valid;
+#endif
 
 uint32_t tt_boot_fs_next(uint32_t last_fd_addr)
 {
 	return (last_fd_addr + sizeof(tt_boot_fs_fd));
 }
 
-static int tt_boot_fs_load_cache(tt_boot_fs *tt_boot_fs)
+/* 32-bit FNV-1a hash of a (zero-padded) image tag, must match tag_hash() in tt_boot_fs.py */
+uint32_t tt_boot_fs_tag_hash(const uint8_t *tag)
 {
-	tt_boot_fs->hal_spi_read_f(TT_BOOT_FS_FD_HEAD_ADDR, sizeof(boot_fs_cache),
-				   (uint8_t *)boot_fs_cache);
+	uint32_t hash = 0x811c9dc5;
+
+	for (size_t i = 0; i < TT_BOOT_FS_IMAGE_TAG_SIZE; i++) {
+		hash ^= tag[i];
+		hash *= 0x01000193;
+	}
+
+	return hash;
+}
+
+#ifdef CONFIG_TT_BOOT_FS_INDEX
+static bool tt_boot_fs_load_index(const tt_boot_fs *tt_boot_fs)
+{
+	const tt_boot_fs_index_hdr *hdr = &boot_fs_index.hdr;
+	uint32_t crc;
+
+	/* Read the header and the largest possible bucket array in one transaction */
+	if (tt_boot_fs->hal_spi_read_f(TT_BOOT_FS_INDEX_ADDR, sizeof(boot_fs_index),
+				       (uint8_t *)&boot_fs_index) != 0) {
+		return false;
+	}
+
+	if (hdr->magic != TT_BOOT_FS_INDEX_MAGIC || hdr->version != TT_BOOT_FS_INDEX_VERSION) {
+		return false;
+	}
+
+	if (hdr->num_buckets < 2 || hdr->num_buckets > TT_BOOT_FS_INDEX_BUCKETS_MAX ||
+	    !IS_POWER_OF_TWO(hdr->num_buckets)) {
+		return false;
+	}
+
+	crc = tt_boot_fs_cksum(0, (const uint8_t *)hdr, offsetof(tt_boot_fs_index_hdr, index_crc));
+	crc = tt_boot_fs_cksum(crc, (const uint8_t *)boot_fs_index.buckets,
+			       hdr->num_buckets * sizeof(uint16_t));
+	if (crc != hdr->index_crc) {
+		return false;
+	}
+
+	/* An index that disagrees with the cached part of the table is stale */
+	if (boot_fs_cache_count < ARRAY_SIZE(boot_fs_cache)) {
+		return hdr->num_fds == boot_fs_cache_count;
+	}
+
+	return hdr->num_fds >= boot_fs_cache_count;
+}
+#endif
+
+static int tt_boot_fs_load_cache(const tt_boot_fs *tt_boot_fs)
+{
+	boot_fs_cache_count = 0;
+#ifdef CONFIG_TT_BOOT_FS_INDEX
+	boot_fs_index_valid = false;
+#endif
+
+	if (tt_boot_fs->hal_spi_read_f(TT_BOOT_FS_FD_HEAD_ADDR, sizeof(boot_fs_cache),
+				       (uint8_t *)boot_fs_cache) != 0) {
+		return TT_BOOT_FS_ERR;
+	}
+
+	/* The descriptor table ends at the first invalid descriptor */
+	while (boot_fs_cache_count < ARRAY_SIZE(boot_fs_cache) &&
+	       !boot_fs_cache[boot_fs_cache_count].flags.f.invalid) {
+		boot_fs_cache_count++;
+	}
+
+#ifdef CONFIG_TT_BOOT_FS_INDEX
+	boot_fs_index_valid = tt_boot_fs_load_index(tt_boot_fs);
+#endif
 
 	return TT_BOOT_FS_OK;
 }
 
+/*
+ * An index that does not cover a new descriptor would hide it. It cannot be updated without
+ * erasing the flash sector it shares with the descriptors, but clearing its magic only clears
+ * bits. `tt_boot_fs.py mkfs --index` writes a new one.
+ */
+static void tt_boot_fs_invalidate_index(const tt_boot_fs *tt_boot_fs)
+{
+	static const uint32_t no_magic;
+	uint32_t magic;
+
+	if (tt_boot_fs->hal_spi_read_f(TT_BOOT_FS_INDEX_ADDR, sizeof(magic), (uint8_t *)&magic) != 0 ||
+	    magic != TT_BOOT_FS_INDEX_MAGIC) {
+		return;
+	}
+
+	tt_boot_fs->hal_spi_write_f(TT_BOOT_FS_INDEX_ADDR, sizeof(no_magic),
+				    (const uint8_t *)&no_magic);
+}
+
 /* Sets up hardware abstraction layer (HAL) callbacks, initializes HEAD fd */
 int tt_boot_fs_mount(tt_boot_fs *tt_boot_fs, tt_boot_fs_read hal_read, tt_boot_fs_write hal_write,
 		     tt_boot_fs_erase hal_erase)
@@ -53,6 +149,7 @@ int tt_boot_fs_add_file(const tt_boot_fs *tt_boot_fs, tt_boot_fs_fd fd,
 	} else {
 		/* Regular file descriptor */
 		tt_boot_fs_fd head = {0};
+		uint32_t slot = 0;
 
 		curr_fd_addr = TT_BOOT_FS_FD_HEAD_ADDR;
 
@@ -61,6 +158,10 @@ int tt_boot_fs_add_file(const tt_boot_fs *tt_boot_fs, tt_boot_fs_fd fd,
 
 		/* Traverse until we find an invalid file descriptor entry in SPI device array */
 		while (head.flags.f.invalid == 0) {
+			if (++slot >= TT_BOOT_FS_NUM_FDS_MAX) {
+				/* The descriptor table is full */
+				return TT_BOOT_FS_ERR;
+			}
 			curr_fd_addr = tt_boot_fs_next(curr_fd_addr);
 			tt_boot_fs->hal_spi_read_f(curr_fd_addr, sizeof(tt_boot_fs_fd),
 						   (uint8_t *)&head);
@@ -69,6 +170,15 @@ int tt_boot_fs_add_file(const tt_boot_fs *tt_boot_fs, tt_boot_fs_fd fd,
 
 	tt_boot_fs->hal_spi_write_f(curr_fd_addr, sizeof(tt_boot_fs_fd), (uint8_t *)&fd);
 
+	if (!isFailoverEntry && !isSecurityBinaryEntry) {
+		tt_boot_fs_invalidate_index(tt_boot_fs);
+
+		/* Pick up the new descriptor */
+		if (tt_boot_fs_load_cache(tt_boot_fs) != TT_BOOT_FS_OK) {
+			return TT_BOOT_FS_ERR;
+		}
+	}
+
 	/*
 	 * Now copy total image size from image_data_src pointer into the specified address.
 	 * Total image size = image_size + signature_size (security) + padding.
@@ -121,34 +231,160 @@ static tt_checksum_res_t calculate_and_compare_checksum(uint8_t *data, size_t nu
 	return TT_BOOT_FS_CHK_OK;
 }
 
-static int find_fd_by_tag(const tt_boot_fs *tt_boot_fs, const uint8_t *tag, tt_boot_fs_fd *fd_data)
+static bool fd_matches_tag(const tt_boot_fs_fd *fd, const uint8_t *tag)
 {
-	for (uint32_t i = 0; i < ARRAY_SIZE(boot_fs_cache); i++) {
-		if (boot_fs_cache[i].flags.f.invalid) {
-			continue;
+	if (fd->flags.f.invalid) {
+		return false;
+	}
+
+	if (memcmp(fd->image_tag, tag, TT_BOOT_FS_IMAGE_TAG_SIZE) != 0) {
+		return false;
+	}
+
+	return calculate_and_compare_checksum((uint8_t *)fd,
+					      sizeof(tt_boot_fs_fd) - sizeof(uint32_t), fd->fd_crc,
+					      false) == TT_BOOT_FS_CHK_OK;
+}
+
+/* Fetch descriptor number slot, from the cache if possible and otherwise from flash */
+static int read_fd_slot(const tt_boot_fs *tt_boot_fs, uint32_t slot, tt_boot_fs_fd *fd_data)
+{
+	if (slot < ARRAY_SIZE(boot_fs_cache)) {
+		*fd_data = boot_fs_cache[slot];
+		return TT_BOOT_FS_OK;
+	}
+
+	if (tt_boot_fs->hal_spi_read_f(TT_BOOT_FS_FD_HEAD_ADDR + slot * sizeof(tt_boot_fs_fd),
+				       sizeof(tt_boot_fs_fd), (uint8_t *)fd_data) != 0) {
+		return TT_BOOT_FS_ERR;
+	}
+
+	return TT_BOOT_FS_OK;
+}
+
+#ifdef CONFIG_TT_BOOT_FS_INDEX
+static int find_fd_by_index(const tt_boot_fs *tt_boot_fs, const uint8_t *tag,
+			    tt_boot_fs_fd *fd_data)
+{
+	const uint32_t mask = boot_fs_index.hdr.num_buckets - 1;
+	uint32_t bucket = tt_boot_fs_tag_hash(tag) & mask;
+
+	for (uint32_t probe = 0; probe < boot_fs_index.hdr.num_buckets; probe++) {
+		uint16_t slot = boot_fs_index.buckets[bucket];
+
+		if (slot == TT_BOOT_FS_INDEX_EMPTY) {
+			break;
 		}
 
-		if (memcmp(boot_fs_cache[i].image_tag, tag, TT_BOOT_FS_IMAGE_TAG_SIZE) != 0) {
-			continue;
+		if (slot < boot_fs_index.hdr.num_fds) {
+			if (read_fd_slot(tt_boot_fs, slot, fd_data) != TT_BOOT_FS_OK) {
+				return TT_BOOT_FS_ERR;
+			}
+
+			if (fd_matches_tag(fd_data, tag)) {
+				return TT_BOOT_FS_OK;
+			}
 		}
 
-		tt_checksum_res_t chk_res = calculate_and_compare_checksum(
-			(uint8_t *)&boot_fs_cache[i], sizeof(tt_boot_fs_fd) - sizeof(uint32_t),
-			boot_fs_cache[i].fd_crc, false);
+		bucket = (bucket + 1) & mask;
+	}
+
+	return TT_BOOT_FS_ERR;
+}
+#endif
 
-		if (chk_res == TT_BOOT_FS_CHK_FAIL) {
-			continue;
+static int find_fd_by_tag(const tt_boot_fs *tt_boot_fs, const uint8_t *tag, tt_boot_fs_fd *fd_data)
+{
+#ifdef CONFIG_TT_BOOT_FS_INDEX
+	if (boot_fs_index_valid) {
+		return find_fd_by_index(tt_boot_fs, tag, fd_data);
+	}
+#endif
+
+	for (uint32_t i = 0; i < boot_fs_cache_count; i++) {
+		if (fd_matches_tag(&boot_fs_cache[i], tag)) {
+			/* Found the right file descriptor */
+			*fd_data = boot_fs_cache[i];
+			return TT_BOOT_FS_OK;
 		}
+	}
 
-		/* Found the right file descriptor */
-		*fd_data = boot_fs_cache[i];
-		return TT_BOOT_FS_OK;
+	/* The whole table is cached, file descriptor not found */
+	if (boot_fs_cache_count < ARRAY_SIZE(boot_fs_cache)) {
+		return TT_BOOT_FS_ERR;
+	}
+
+	/* Otherwise, keep scanning the rest of the table on flash */
+	for (uint32_t slot = ARRAY_SIZE(boot_fs_cache); slot < TT_BOOT_FS_NUM_FDS_MAX; slot++) {
+		if (read_fd_slot(tt_boot_fs, slot, fd_data) != TT_BOOT_FS_OK) {
+			return TT_BOOT_FS_ERR;
+		}
+
+		if (fd_data->flags.f.invalid) {
+			break;
+		}
+
+		if (fd_matches_tag(fd_data, tag)) {
+			return TT_BOOT_FS_OK;
+		}
 	}
 
 	/* File descriptor not found */
 	return TT_BOOT_FS_ERR;
 }
 
+/* Continue a checksum over a chunk of a file, zero-padding a trailing partial word */
+static uint32_t tt_boot_fs_cksum_chunk(uint32_t cksum, const uint8_t *data, size_t num_bytes)
+{
+	size_t aligned = ROUND_DOWN(num_bytes, sizeof(uint32_t));
+
+	if (aligned > 0) {
+		cksum = tt_boot_fs_cksum(cksum, data, aligned);
+	}
+
+	if (aligned < num_bytes) {
+		uint32_t tail = 0;
+
+		memcpy(&tail, &data[aligned], num_bytes - aligned);
+		cksum += tail;
+	}
+
+	return cksum;
+}
+
+static int read_file_chunks(const tt_boot_fs *tt_boot_fs, const tt_boot_fs_fd *fd_data,
+			    uint8_t *buf, size_t chunk_size, tt_boot_fs_chunk_cb chunk_cb,
+			    void *user_data)
+{
+	const size_t image_size = fd_data->flags.f.image_size;
+	uint32_t cksum = 0;
+	size_t len;
+
+	for (size_t offset = 0; offset < image_size; offset += len) {
+		len = MIN(chunk_size, image_size - offset);
+
+		if (tt_boot_fs->hal_spi_read_f(fd_data->spi_addr + offset, len, buf) != 0) {
+			return TT_BOOT_FS_ERR;
+		}
+
+		cksum = tt_boot_fs_cksum_chunk(cksum, buf, len);
+
+		if (chunk_cb != NULL) {
+			int rc = chunk_cb(buf, offset, len, user_data);
+
+			if (rc < 0) {
+				return rc;
+			}
+		}
+	}
+
+	if (cksum != fd_data->data_crc) {
+		return TT_BOOT_FS_ERR;
+	}
+
+	return TT_BOOT_FS_OK;
+}
+
 int tt_boot_fs_get_file(const tt_boot_fs *tt_boot_fs, const uint8_t *tag, uint8_t *buf,
 			size_t buf_size, size_t *file_size)
 {
@@ -167,11 +403,32 @@ int tt_boot_fs_get_file(const tt_boot_fs *tt_boot_fs, const uint8_t *tag, uint8_
 	}
 	*file_size = fd_data.flags.f.image_size;
 
-	tt_boot_fs->hal_spi_read_f(fd_data.spi_addr, fd_data.flags.f.image_size, buf);
-	if (calculate_and_compare_checksum(buf, fd_data.flags.f.image_size, fd_data.data_crc,
-					   false) != TT_BOOT_FS_CHK_OK) {
+	/* The whole file fits in buf, so read it as a single chunk */
+	return read_file_chunks(tt_boot_fs, &fd_data, buf, fd_data.flags.f.image_size, NULL, NULL);
+}
+
+int tt_boot_fs_read_file(const tt_boot_fs *tt_boot_fs, const uint8_t *tag, uint8_t *buf,
+			 size_t buf_size, tt_boot_fs_chunk_cb chunk_cb, void *user_data,
+			 size_t *file_size)
+{
+	/* Keep chunk boundaries on checksum word boundaries */
+	const size_t chunk_size = ROUND_DOWN(buf_size, sizeof(uint32_t));
+	tt_boot_fs_fd fd_data;
+	int rc;
+
+	if (tt_boot_fs == NULL || tag == NULL || buf == NULL || chunk_cb == NULL ||
+	    chunk_size == 0) {
 		return TT_BOOT_FS_ERR;
 	}
 
-	return TT_BOOT_FS_OK;
+	if (find_fd_by_tag(tt_boot_fs, tag, &fd_data) != TT_BOOT_FS_OK) {
+		return TT_BOOT_FS_ERR;
+	}
+
+	rc = read_file_chunks(tt_boot_fs, &fd_data, buf, chunk_size, chunk_cb, user_data);
+	if (rc == TT_BOOT_FS_OK && file_size != NULL) {
+		*file_size = fd_data.flags.f.image_size;
+	}
+
+	return rc;
 }
@@ -26,3 +26,44 @@ uint32_t tt_event_wait(uint32_t events, k_timeout_t timeout)
 
 	return ret;
 }
+
+uint32_t tt_event_wait_deadlines(uint32_t events, struct tt_event_deadline *deadlines,
+				 size_t num_deadlines)
+{
+	int64_t now = k_uptime_get();
+	int64_t wait_ms = INT64_MAX;
+	uint32_t ret;
+
+	for (size_t i = 0; i < num_deadlines; i++) {
+		if (deadlines[i].period_ms != 0) {
+			wait_ms = MIN(wait_ms, MAX(deadlines[i].next_ms - now, 0));
+		}
+	}
+
+	ret = k_event_wait_safe(&tt_event, events,
+				(wait_ms == INT64_MAX) ? K_FOREVER : K_MSEC(wait_ms));
+	now = k_uptime_get();
+
+	for (size_t i = 0; i < num_deadlines; i++) {
+		struct tt_event_deadline *deadline = &deadlines[i];
+
+		if (deadline->period_ms == 0) {
+			continue;
+		}
+
+		if ((ret & deadline->events) != 0) {
+			deadline->next_ms = now + deadline->period_ms;
+		} else if (now >= deadline->next_ms) {
+			ret |= deadline->events;
+			deadline->next_ms += deadline->period_ms;
+			if (deadline->next_ms <= now) {
+				/* Missed periods are skipped rather than run back-to-back */
+				deadline->next_ms = now + deadline->period_ms;
+			}
+		}
+	}
+
+	LOG_DBG("Woke up for events 0x%08X", ret);
+
+	return ret;
+}
@@ -6,6 +6,7 @@
 
 #include "blackhole_offsets.h"
 
+#include <limits.h>
 #include <stdint.h>
 
 #include <tenstorrent/bh_chip.h>
@@ -19,8 +20,11 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 #include <zephyr/sys/util.h>
 
+LOG_MODULE_DECLARE(jtag_bootrom, CONFIG_TT_JTAG_BOOTROM_LOG_LEVEL);
+
 bool jtag_axiwait(const struct device *dev, uint32_t addr)
 {
 	/* If we are using the emulated driver then always return true */
@@ -65,59 +69,85 @@ void gpio_asic_reset_callback(const struct device *port, struct gpio_callback *c
 		bh_chip_cancel_bus_transfer_set(chip);
 		chip->data.trigger_reset = true;
 	}
-	tt_event_post(TT_EVENT_WAKE);
+	tt_event_post(TT_EVENT_PERST);
 }
 
 static struct gpio_callback preset_cb_data;
 #endif /* IS_ENABLED(CONFIG_JTAG_LOAD_ON_PRESET) */
 
-int jtag_bootrom_reset_asic(struct bh_chip *chip)
+/*
+ * Resets are held and released on all chips together, so that the chips wait out the reset
+ * delays and boot at the same time rather than one after another.
+ */
+int jtag_bootrom_reset_asics(struct bh_chip *chips, size_t num_chips)
 {
-	/* Only check for pgood if we aren't emulating */
+	for (size_t i = 0; i < num_chips; ++i) {
+		struct bh_chip *chip = &chips[i];
+
+		/* Only check for pgood if we aren't emulating */
 #if !DT_HAS_COMPAT_STATUS_OKAY(zephyr_gpio_emul)
-	while (!gpio_pin_get_dt(&chip->config.pgood)) {
-	}
+		while (!gpio_pin_get_dt(&chip->config.pgood)) {
+		}
 #endif
 
-	bh_chip_assert_asic_reset(chip);
-	bh_chip_assert_spi_reset(chip);
+		/* The SMBus enable must not stay asserted while the ASIC is in reset */
+		int ret = bh_chip_bus_release(chip);
 
-	int ret = jtag_setup(chip->config.jtag);
+		if (ret) {
+			return ret;
+		}
 
-	if (ret) {
-		return ret;
+		bh_chip_assert_asic_reset(chip);
+		bh_chip_assert_spi_reset(chip);
+
+		ret = jtag_setup(chip->config.jtag);
+
+		if (ret) {
+			return ret;
+		}
 	}
 
 	/* k_sleep(K_MSEC(1)); */
 	k_busy_wait(1000);
 
-	bh_chip_set_straps(chip);
+	for (size_t i = 0; i < num_chips; ++i) {
+		bh_chip_set_straps(&chips[i]);
 
-	bh_chip_deassert_asic_reset(chip);
-	bh_chip_deassert_spi_reset(chip);
+		bh_chip_deassert_asic_reset(&chips[i]);
+		bh_chip_deassert_spi_reset(&chips[i]);
+	}
 
 	/* k_sleep(K_MSEC(2)); */
 	k_busy_wait(2000);
 
-	jtag_reset(chip->config.jtag);
+	for (size_t i = 0; i < num_chips; ++i) {
+		struct bh_chip *chip = &chips[i];
+
+		jtag_reset(chip->config.jtag);
 
 #if !DT_HAS_COMPAT_STATUS_OKAY(zephyr_gpio_emul)
-	jtag_bitbang_wait_for_id(chip->config.jtag);
+		jtag_bitbang_wait_for_id(chip->config.jtag);
 #endif
 
-	jtag_reset(chip->config.jtag);
+		jtag_reset(chip->config.jtag);
 
-	while (!jtag_axiwait(chip->config.jtag, BH_RESET_BASE + 0x60)) {
-		k_yield();
-	}
+		while (!jtag_axiwait(chip->config.jtag, BH_RESET_BASE + 0x60)) {
+			k_yield();
+		}
 
-	jtag_reset(chip->config.jtag);
+		jtag_reset(chip->config.jtag);
 
-	bh_chip_unset_straps(chip);
+		bh_chip_unset_straps(chip);
+	}
 
 	return 0;
 }
 
+int jtag_bootrom_reset_asic(struct bh_chip *chip)
+{
+	return jtag_bootrom_reset_asics(chip, 1);
+}
+
 int jtag_bootrom_init(struct bh_chip *chip)
 {
 	int ret = false;
@@ -173,12 +203,9 @@ int jtag_bootrom_init(struct bh_chip *chip)
 	return 0;
 }
 
-int jtag_bootrom_patch_offset(struct bh_chip *chip, const uint32_t *patch, size_t patch_len,
-			      const uint32_t start_addr)
-{
 #ifdef CONFIG_JTAG_LOAD_BOOTROM
-	const struct device *dev = chip->config.jtag;
-
+static void jtag_bootrom_halt_arc(const struct device *dev)
+{
 	jtag_reset(dev);
 
 	/* HALT THE ARC CORE!!!!! */
@@ -198,17 +225,224 @@ int jtag_bootrom_patch_offset(struct bh_chip *chip, const uint32_t *patch, size_
 
 	/* Write to postcode */
 	jtag_axi_write32(dev, BH_RESET_BASE + 0x60, 0xF2);
+}
+
+/*
+ * Literal records are written straight from the stream, repeated words from a small buffer, a
+ * chunk at a time. The stream must have been checked with jtag_bootrom_rle_len().
+ */
+static void jtag_bootrom_rle_write(const struct device *dev, uint32_t addr, const uint32_t *rle,
+				   size_t rle_len)
+{
+	uint32_t fill[32];
+
+	for (size_t i = 2; i < rle_len;) {
+		uint32_t op = rle[i] >> JTAG_BOOTROM_RLE_OP_SHIFT;
+		uint32_t count = rle[i] & JTAG_BOOTROM_RLE_COUNT_MASK;
+
+		++i;
+		if (op == JTAG_BOOTROM_RLE_OP_LITERAL) {
+			jtag_axi_block_write(dev, addr, &rle[i], count);
+			i += count;
+		} else if (op == JTAG_BOOTROM_RLE_OP_ZERO &&
+			   IS_ENABLED(CONFIG_TT_JTAG_BOOTROM_SKIP_ZERO)) {
+			/* The ASIC has already cleared it */
+		} else {
+			uint32_t value = (op == JTAG_BOOTROM_RLE_OP_REPEAT) ? rle[i++] : 0;
+
+			for (size_t k = 0; k < MIN(count, ARRAY_SIZE(fill)); ++k) {
+				fill[k] = value;
+			}
+
+			for (uint32_t done = 0; done < count;) {
+				uint32_t n = MIN(count - done, ARRAY_SIZE(fill));
+
+				jtag_axi_block_write(dev, addr + done * sizeof(uint32_t), fill, n);
+				done += n;
+			}
+		}
 
-	jtag_axi_block_write(dev, start_addr, patch, patch_len);
+		addr += count * sizeof(uint32_t);
+	}
+}
 
-	jtag_axi_write32(dev, BH_RESET_BASE + 0x60, 0xF3);
+static void jtag_bootrom_write(const struct device *dev, uint32_t addr, const uint32_t *patch,
+			       size_t patch_len, bool rle)
+{
+	if (rle) {
+		jtag_bootrom_rle_write(dev, addr, patch, patch_len);
+	} else {
+		jtag_axi_block_write(dev, addr, patch, patch_len);
+	}
+}
+#endif
 
-	chip->data.workaround_applied = true;
+/*
+ * The ARC of each chip is halted and released on its own, since those steps read chip state
+ * back. The patch itself is written to all chips whose JTAG pins can be ganged with the first
+ * chip's in a single pass, and to the others one after another.
+ */
+static int jtag_bootrom_patch_chips(struct bh_chip *chips, size_t num_chips, const uint32_t *patch,
+				    size_t patch_len, const uint32_t start_addr, bool rle)
+{
+#ifdef CONFIG_JTAG_LOAD_BOOTROM
+	const struct device *dev;
+	uint32_t ganged = BIT(0);
+	size_t num_ganged = 1;
+
+	__ASSERT_NO_MSG(num_chips <= 32);
+
+	if (num_chips == 0) {
+		return 0;
+	}
+
+	dev = chips[0].config.jtag;
+
+	for (size_t i = 0; i < num_chips; ++i) {
+		jtag_bootrom_halt_arc(chips[i].config.jtag);
+	}
+
+	for (size_t i = 1; i < num_chips; ++i) {
+		if (jtag_gang(dev, chips[i].config.jtag) == 0) {
+			ganged |= BIT(i);
+			++num_ganged;
+		}
+	}
+
+	jtag_bootrom_write(dev, start_addr, patch, patch_len, rle);
+
+	if (ganged != BIT(0)) {
+		jtag_gang(dev, NULL);
+	}
+
+	for (size_t i = 1; i < num_chips; ++i) {
+		if (!(ganged & BIT(i))) {
+			jtag_bootrom_write(chips[i].config.jtag, start_addr, patch, patch_len, rle);
+		}
+	}
+
+	for (size_t i = 0; i < num_chips; ++i) {
+		jtag_axi_write32(chips[i].config.jtag, BH_RESET_BASE + 0x60, 0xF3);
+
+		chips[i].data.workaround_applied = true;
+	}
+
+	LOG_DBG("Patched %zu of %zu chips in one pass", num_ganged, num_chips);
 #endif
 
 	return 0;
 }
 
+int jtag_bootrom_patch_offset(struct bh_chip *chip, const uint32_t *patch, size_t patch_len,
+			      const uint32_t start_addr)
+{
+	return jtag_bootrom_patch_chips(chip, 1, patch, patch_len, start_addr, false);
+}
+
+int jtag_bootrom_patch_chips_offset(struct bh_chip *chips, size_t num_chips, const uint32_t *patch,
+				    size_t patch_len, const uint32_t start_addr)
+{
+	return jtag_bootrom_patch_chips(chips, num_chips, patch, patch_len, start_addr, false);
+}
+
+int jtag_bootrom_patch_chips_rle_offset(struct bh_chip *chips, size_t num_chips, const uint32_t *rle,
+					size_t rle_len, const uint32_t start_addr)
+{
+	if (jtag_bootrom_rle_len(rle, rle_len) < 0) {
+		return -EINVAL;
+	}
+
+	return jtag_bootrom_patch_chips(chips, num_chips, rle, rle_len, start_addr, true);
+}
+
+int jtag_bootrom_rle_len(const uint32_t *rle, size_t rle_len)
+{
+	size_t len = 0;
+
+	if (rle_len < 2 || rle[0] != JTAG_BOOTROM_RLE_MAGIC) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 2; i < rle_len;) {
+		uint32_t op = rle[i] >> JTAG_BOOTROM_RLE_OP_SHIFT;
+		uint32_t count = rle[i] & JTAG_BOOTROM_RLE_COUNT_MASK;
+
+		++i;
+		if (count == 0) {
+			return -EINVAL;
+		}
+
+		switch (op) {
+		case JTAG_BOOTROM_RLE_OP_LITERAL:
+			if (count > rle_len - i) {
+				return -EINVAL;
+			}
+			i += count;
+			break;
+		case JTAG_BOOTROM_RLE_OP_REPEAT:
+			if (i == rle_len) {
+				return -EINVAL;
+			}
+			++i;
+			break;
+		case JTAG_BOOTROM_RLE_OP_ZERO:
+			break;
+		default:
+			return -EINVAL;
+		}
+
+		len += count;
+	}
+
+	if (len != rle[1] || len > INT_MAX) {
+		return -EINVAL;
+	}
+
+	return len;
+}
+
+/*
+ * Compares count words, read back from word i onwards, with src, which advances by stride words
+ * per word so that a repeated word does not have to be expanded. The words are read back a chunk
+ * at a time with pipelined block reads, rather than polling for each word.
+ */
+static int jtag_bootrom_verify_block(const struct device *dev, size_t i, const uint32_t *src,
+				     size_t stride, size_t count)
+{
+	uint32_t readback[64];
+
+	for (size_t done = 0; done < count;) {
+		uint32_t n = MIN(count - done, ARRAY_SIZE(readback));
+		/* ICCM start addr is 0 */
+		uint32_t addr = (i + done) * sizeof(uint32_t);
+		int ret = jtag_axi_block_read(dev, addr, readback, n);
+
+		if (ret) {
+			printk("Bootcode read back failed at %03x: %d\n", addr, ret);
+
+			jtag_axi_write32(dev, BH_RESET_BASE + 0x60, 0x6);
+			return 1;
+		}
+
+		for (uint32_t k = 0; k < n; ++k) {
+			uint32_t expected = src[(done + k) * stride];
+
+			if (expected != readback[k]) {
+				printk("Bootcode mismatch at %03x. expected: %08x actual: %08x "
+				       "¯\\_(ツ)_/¯\n",
+				       addr + k * 4, expected, readback[k]);
+
+				jtag_axi_write32(dev, BH_RESET_BASE + 0x60, 0x6);
+				return 1;
+			}
+		}
+
+		done += n;
+	}
+
+	return 0;
+}
+
 int jtag_bootrom_verify(const struct device *dev, const uint32_t *patch, size_t patch_len)
 {
 	if (!IS_ENABLED(CONFIG_JTAG_VERIFY_WRITE)) {
@@ -216,23 +450,46 @@ int jtag_bootrom_verify(const struct device *dev, const uint32_t *patch, size_t
 	}
 
 	/* Confirmed matching */
-	for (int i = 0; i < patch_len; ++i) {
-		/* ICCM start addr is 0 */
-		uint32_t readback = 0;
-#ifdef CONFIG_JTAG_EMUL
-		jtag_emul_axi_read32(dev, i * 4, &readback);
-#else
-		jtag_axi_read32(dev, i * 4, &readback);
-#endif
+	if (jtag_bootrom_verify_block(dev, 0, patch, 1, patch_len)) {
+		return 1;
+	}
+
+	printk("Bootcode write verified! \\o/\n");
 
-		if (patch[i] != readback) {
-			printk("Bootcode mismatch at %03x. expected: %08x actual: %08x "
-			       "¯\\_(ツ)_/¯\n",
-			       i * 4, patch[i], readback);
+	return 0;
+}
 
-			jtag_axi_write32(dev, BH_RESET_BASE + 0x60, 0x6);
+/* Decodes the patch while comparing it, rather than into a buffer the size of the image */
+int jtag_bootrom_verify_rle(const struct device *dev, const uint32_t *rle, size_t rle_len)
+{
+	static const uint32_t zero;
+	size_t addr = 0;
+
+	if (!IS_ENABLED(CONFIG_JTAG_VERIFY_WRITE)) {
+		return 0;
+	}
+
+	if (jtag_bootrom_rle_len(rle, rle_len) < 0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 2; i < rle_len;) {
+		uint32_t op = rle[i] >> JTAG_BOOTROM_RLE_OP_SHIFT;
+		uint32_t count = rle[i] & JTAG_BOOTROM_RLE_COUNT_MASK;
+		const uint32_t *src = (op == JTAG_BOOTROM_RLE_OP_ZERO) ? &zero : &rle[i + 1];
+		size_t stride = (op == JTAG_BOOTROM_RLE_OP_LITERAL) ? 1 : 0;
+
+		if (jtag_bootrom_verify_block(dev, addr, src, stride, count)) {
 			return 1;
 		}
+		addr += count;
+
+		++i;
+		if (op == JTAG_BOOTROM_RLE_OP_LITERAL) {
+			i += count;
+		} else if (op == JTAG_BOOTROM_RLE_OP_REPEAT) {
+			++i;
+		}
 	}
 
 	printk("Bootcode write verified! \\o/\n");
@@ -240,6 +497,50 @@ int jtag_bootrom_verify(const struct device *dev, const uint32_t *patch, size_t
 	return 0;
 }
 
+#ifdef CONFIG_TT_JTAG_BOOTROM_VERIFY_CRC
+uint32_t jtag_bootrom_crc(const uint32_t *patch, size_t patch_len)
+{
+	return crc32_ieee((const uint8_t *)patch, patch_len * sizeof(uint32_t));
+}
+
+/*
+ * The CRC word is set to something other than the expected CRC before the ARC is released, so
+ * that a stale value from an earlier load cannot pass for a new one.
+ */
+int jtag_bootrom_crc_arm(const struct device *dev, uint32_t crc_addr, uint32_t crc)
+{
+	return jtag_axi_write32(dev, crc_addr, ~crc);
+}
+
+int jtag_bootrom_verify_crc(const struct device *dev, uint32_t crc_addr, uint32_t crc,
+			    uint32_t timeout_ms)
+{
+	int64_t start = k_uptime_get();
+	uint32_t readback = ~crc;
+
+	/* Wait for the ARC to replace the value left by jtag_bootrom_crc_arm() */
+	while (jtag_axi_read32(dev, crc_addr, &readback) != 0 || readback == ~crc) {
+		if (k_uptime_get() - start >= timeout_ms) {
+			printk("Bootcode CRC not written by ARC\n");
+			return -ETIMEDOUT;
+		}
+		k_msleep(1);
+	}
+
+	if (readback != crc) {
+		printk("Bootcode CRC mismatch. expected: %08x actual: %08x ¯\\_(ツ)_/¯\n", crc,
+		       readback);
+
+		jtag_axi_write32(dev, BH_RESET_BASE + 0x60, 0x6);
+		return 1;
+	}
+
+	printk("Bootcode CRC verified! \\o/\n");
+
+	return 0;
+}
+#endif
+
 void jtag_bootrom_soft_reset_arc(struct bh_chip *chip)
 {
 #ifdef CONFIG_JTAG_LOAD_BOOTROM
@@ -29,20 +29,52 @@ const size_t get_bootcode_len(void)
 	return sizeof(bootcode) / sizeof(uint32_t);
 }
 
-int jtag_bootrom_reset_sequence(struct bh_chip *chip, bool force_reset)
+#ifdef CONFIG_TT_JTAG_BOOTROM_COMPRESSED
+__aligned(sizeof(uint32_t)) static const uint8_t bootcode_rle[] = {
+#include "bootcode_rle.h"
+};
+
+const uint32_t *get_bootcode_rle(void)
+{
+	return (const uint32_t *)bootcode_rle;
+}
+
+size_t get_bootcode_rle_len(void)
+{
+	return sizeof(bootcode_rle) / sizeof(uint32_t);
+}
+#endif
+
+/* Reads the patch back over JTAG */
+static int jtag_bootrom_verify_readback(const struct device *dev, const uint32_t *patch,
+					size_t patch_len)
 {
-	const uint32_t *const patch = (const uint32_t *)bootcode;
+#ifdef CONFIG_TT_JTAG_BOOTROM_COMPRESSED
+	ARG_UNUSED(patch);
+	ARG_UNUSED(patch_len);
+
+	return jtag_bootrom_verify_rle(dev, get_bootcode_rle(), get_bootcode_rle_len());
+#else
+	return jtag_bootrom_verify(dev, patch, patch_len);
+#endif
+}
+
+int jtag_bootrom_reset_sequence_chips(struct bh_chip *chips, size_t num_chips, bool force_reset)
+{
+	__maybe_unused const uint32_t *const patch = (const uint32_t *)bootcode;
 	const size_t patch_len = get_bootcode_len();
 
 #ifdef CONFIG_JTAG_LOAD_ON_PRESET
 	if (force_reset) {
-		chip->data.needs_reset = true;
+		for (size_t i = 0; i < num_chips; ++i) {
+			chips[i].data.needs_reset = true;
+		}
 	}
 #endif
 
 	int64_t start = k_uptime_get();
 
-	int ret = jtag_bootrom_reset_asic(chip);
+	int ret = jtag_bootrom_reset_asics(chips, num_chips);
 
 	if (ret) {
 		return ret;
@@ -52,32 +84,94 @@ int jtag_bootrom_reset_sequence(struct bh_chip *chip, bool force_reset)
 		jtag_bootrom_emul_setup((uint32_t *)sram, patch_len);
 	}
 
-	jtag_bootrom_patch_offset(chip, patch, patch_len, 0x80);
+#ifdef CONFIG_TT_JTAG_BOOTROM_COMPRESSED
+	ret = jtag_bootrom_patch_chips_rle_offset(chips, num_chips, get_bootcode_rle(),
+						  get_bootcode_rle_len(), 0x80);
+	if (ret) {
+		LOG_ERR("Bad compressed bootrom patch: %d", ret);
+		return ret;
+	}
+#else
+	jtag_bootrom_patch_chips_offset(chips, num_chips, patch, patch_len, 0x80);
+#endif
 
 	volatile int64_t end = k_uptime_delta(&start);
 
-	LOG_DBG("jtag bootrom load took %lld ms", end);
+	LOG_DBG("jtag bootrom load of %zu chips took %lld ms", num_chips, end);
 
-	if (jtag_bootrom_verify(chip->config.jtag, patch, patch_len) != 0) {
-		printk("Bootrom verification failed\n");
+#ifdef CONFIG_TT_JTAG_BOOTROM_VERIFY_CRC
+	const uint32_t crc = jtag_bootrom_crc(patch, patch_len);
+#endif
+
+	for (size_t i = 0; i < num_chips; ++i) {
+#ifdef CONFIG_TT_JTAG_BOOTROM_VERIFY_CRC
+		/* Checked once the ARC is released, instead of reading the patch back */
+		ret = jtag_bootrom_crc_arm(chips[i].config.jtag, CONFIG_TT_JTAG_BOOTROM_CRC_ADDR,
+					   crc);
+#else
+		ret = jtag_bootrom_verify_readback(chips[i].config.jtag, patch, patch_len);
+#endif
+		if (ret != 0) {
+			printk("Bootrom verification failed\n");
+		}
 	}
 
 	start = k_uptime_get();
 
-	bh_chip_cancel_bus_transfer_set(chip);
+	/* chips whose ARC was released from reset */
+	__maybe_unused uint32_t released = 0;
+
+	__ASSERT_NO_MSG(num_chips <= 32);
+
+	for (size_t i = 0; i < num_chips; ++i) {
+		struct bh_chip *chip = &chips[i];
+
+		bh_chip_cancel_bus_transfer_set(chip);
 #ifdef CONFIG_JTAG_LOAD_ON_PRESET
-	if (chip->data.needs_reset) {
+		if (chip->data.needs_reset) {
+			jtag_bootrom_soft_reset_arc(chip);
+			released |= BIT(i);
+		}
+#else
 		jtag_bootrom_soft_reset_arc(chip);
+		released |= BIT(i);
+#endif
+		if (released & BIT(i)) {
+			/* Messages buffered from before the reset are stale */
+			bh_chip_discard_cm2dm_messages(chip);
+		}
+		bh_chip_cancel_bus_transfer_clear(chip);
 	}
-#else
-	jtag_bootrom_soft_reset_arc(chip);
+
+	for (size_t i = 0; i < num_chips; ++i) {
+#ifdef CONFIG_TT_JTAG_BOOTROM_VERIFY_CRC
+		/* Released ARCs compute their CRCs in parallel, so wait for them after all resets */
+		ret = -ETIMEDOUT;
+		if (released & BIT(i)) {
+			ret = jtag_bootrom_verify_crc(chips[i].config.jtag,
+						      CONFIG_TT_JTAG_BOOTROM_CRC_ADDR, crc,
+						      CONFIG_TT_JTAG_BOOTROM_CRC_TIMEOUT_MS);
+		}
+		if (ret == -ETIMEDOUT) {
+			/* ARC left in reset, or a patch that does not compute the CRC */
+			LOG_WRN("No bootrom CRC from chip %zu, reading the patch back", i);
+			ret = jtag_bootrom_verify_readback(chips[i].config.jtag, patch, patch_len);
+		}
+		if (ret != 0) {
+			printk("Bootrom verification failed\n");
+		}
 #endif
-	bh_chip_cancel_bus_transfer_clear(chip);
 
-	jtag_bootrom_teardown(chip);
+		jtag_bootrom_teardown(&chips[i]);
+	}
 
 	end = k_uptime_delta(&start);
 	LOG_DBG("jtag bootrom reset took %lld ms", end);
 
 	return 0;
 }
+
+int jtag_bootrom_reset_sequence(struct bh_chip *chip, bool force_reset)
+{
+	return jtag_bootrom_reset_sequence_chips(chip, 1, force_reset);
+}
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2025 Tenstorrent AI ULC
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Run-length encoding of bootrom patches loaded over JTAG.
+
+The stream is made of little-endian 32-bit words, which is what the loader writes over AXI:
+
+    magic ("TRLE"), length of the decoded image in words, records...
+
+Each record starts with a header word, holding an op in bits 31:30 and a word count in bits 29:0:
+
+    OP_LITERAL  count words follow, and are written as they are
+    OP_REPEAT   one word follows, and is written count times
+    OP_ZERO     count zero words, which the loader may skip if the target memory is clear
+
+See lib/tenstorrent/jtag_bootrom/jtag_bootrom.c for the decoder.
+"""
+
+from __future__ import annotations
+
+import argparse
+from pathlib import Path
+import struct
+import sys
+from typing import List
+
+MAGIC = 0x454C5254
+OP_LITERAL = 0
+OP_REPEAT = 1
+OP_ZERO = 2
+OP_SHIFT = 30
+COUNT_MAX = (1 << OP_SHIFT) - 1
+
+# Shortest runs worth their own record, given the header word they cost
+MIN_ZERO_RUN = 2
+MIN_REPEAT_RUN = 3
+
+
+def _words(data: bytes) -> List[int]:
+    if len(data) % 4 != 0:
+        data += b"\0" * (4 - len(data) % 4)
+    return list(struct.unpack(f"<{len(data) // 4}I", data))
+
+
+def _run_length(words: List[int], i: int) -> int:
+    n = 1
+    while i + n < len(words) and words[i + n] == words[i] and n < COUNT_MAX:
+        n += 1
+    return n
+
+
+def encode(data: bytes) -> bytes:
+    """Encode an image, padded with zeros to a whole number of words"""
+    words = _words(data)
+    out = [MAGIC, len(words)]
+    literal: List[int] = []
+
+    def flush_literal():
+        for i in range(0, len(literal), COUNT_MAX):
+            chunk = literal[i : i + COUNT_MAX]
+            out.append((OP_LITERAL << OP_SHIFT) | len(chunk))
+            out.extend(chunk)
+        literal.clear()
+
+    i = 0
+    while i < len(words):
+        n = _run_length(words, i)
+        if words[i] == 0 and n >= MIN_ZERO_RUN:
+            flush_literal()
+            out.append((OP_ZERO << OP_SHIFT) | n)
+        elif n >= MIN_REPEAT_RUN:
+            flush_literal()
+            out.extend([(OP_REPEAT << OP_SHIFT) | n, words[i]])
+        else:
+            literal.extend(words[i : i + n])
+        i += n
+    flush_literal()
+
+    return struct.pack(f"<{len(out)}I", *out)
+
+
+def decode(data: bytes) -> bytes:
+    """Decode a stream made by encode(), raising ValueError if it is malformed"""
+    words = _words(data)
+    if len(words) < 2 or words[0] != MAGIC:
+        raise ValueError("not a bootrom RLE stream")
+
+    out: List[int] = []
+    i = 2
+    while i < len(words):
+        op = words[i] >> OP_SHIFT
+        count = words[i] & COUNT_MAX
+        i += 1
+        if count == 0:
+            raise ValueError(f"empty record at word {i - 1}")
+        if op == OP_LITERAL:
+            if i + count > len(words):
+                raise ValueError(f"truncated literal at word {i - 1}")
+            out.extend(words[i : i + count])
+            i += count
+        elif op == OP_REPEAT:
+            if i >= len(words):
+                raise ValueError(f"truncated repeat at word {i - 1}")
+            out.extend([words[i]] * count)
+            i += 1
+        elif op == OP_ZERO:
+            out.extend([0] * count)
+        else:
+            raise ValueError(f"bad op {op} at word {i - 1}")
+
+    if len(out) != words[1]:
+        raise ValueError(f"decoded {len(out)} words, expected {words[1]}")
+
+    return struct.pack(f"<{len(out)}I", *out)
+
+
+def parse_args(argv: List[str]):
+    parser = argparse.ArgumentParser(
+        description="Run-length encode bootrom patches loaded over JTAG"
+    )
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    for command, help in (
+        ("compress", "Encode a binary image"),
+        ("decompress", "Decode an encoded image"),
+    ):
+        subparser = subparsers.add_parser(command, help=help)
+        subparser.add_argument("input", type=Path, help="input file")
+        subparser.add_argument("output", type=Path, help="output file")
+
+    return parser.parse_args(argv)
+
+
+def main(argv: List[str]) -> int:
+    args = parse_args(argv)
+    data = args.input.read_bytes()
+
+    try:
+        out = encode(data) if args.command == "compress" else decode(data)
+    except ValueError as e:
+        print(f"{args.input}: {e}", file=sys.stderr)
+        return 1
+
+    args.output.write_bytes(out)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
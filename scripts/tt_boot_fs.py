@@ -39,6 +39,13 @@ MAX_TAG_LEN = 8
 FD_SIZE = 32
 CKSUM_SIZE = 4
 IMAGE_ADDR = 0x14000
+# Optional tag hash index, see include/tenstorrent/tt_boot_fs.h
+INDEX_ADDR = 0x3E00
+INDEX_MAGIC = 0x58495454  # "TTIX"
+INDEX_VERSION = 1
+INDEX_BUCKETS_MAX = 128
+INDEX_EMPTY = 0xFFFF
+INDEX_HDR_FMT = "<IHHHHI"
 
 SCHEMA_PATH = (
     Path(__file__).parents[1] / "scripts" / "schemas" / "tt-boot-fs-schema.yml"
@@ -196,6 +203,89 @@ def read_tag(
             return addr, fd
 
 
+def tag_hash(tag: str) -> int:
+    """32-bit FNV-1a hash of a zero-padded tag, must match tt_boot_fs_tag_hash()"""
+    h = 0x811C9DC5
+    for c in tag.encode("ascii").ljust(MAX_TAG_LEN, b"\x00")[:MAX_TAG_LEN]:
+        h ^= c
+        h = (h * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def build_index(tags: list[str]) -> bytes:
+    """
+    Build the descriptor index for descriptor slots holding the given tags, in order.
+
+    The index maps tag_hash(tag) to a descriptor slot with open addressing and linear probing.
+    The bucket count is kept at least twice the number of descriptors to keep probe chains short.
+    """
+    num_buckets = 4
+    while num_buckets < 2 * len(tags):
+        num_buckets *= 2
+    if num_buckets > INDEX_BUCKETS_MAX:
+        raise ValueError(
+            f"{len(tags)} descriptors do not fit in an index of {INDEX_BUCKETS_MAX} buckets"
+        )
+
+    buckets = [INDEX_EMPTY] * num_buckets
+    for slot, tag in enumerate(tags):
+        bucket = tag_hash(tag) % num_buckets
+        while buckets[bucket] != INDEX_EMPTY:
+            bucket = (bucket + 1) % num_buckets
+        buckets[bucket] = slot
+
+    hdr = struct.pack(
+        INDEX_HDR_FMT[:-1], INDEX_MAGIC, INDEX_VERSION, num_buckets, len(tags), 0
+    )
+    body = struct.pack(f"<{num_buckets}H", *buckets)
+    return hdr + struct.pack("<I", cksum(hdr + body)) + body
+
+
+def read_index(
+    reader: Callable[[int, int], bytes], tags: list[str]
+) -> Optional[list[int]]:
+    """
+    Return the bucket array of the index at INDEX_ADDR, or None if there is no index.
+
+    Raises ValueError if an index is present but does not describe the given descriptor tags.
+    """
+    hdr_size = struct.calcsize(INDEX_HDR_FMT)
+    magic, version, num_buckets, num_fds, _, crc = struct.unpack(
+        INDEX_HDR_FMT, reader(INDEX_ADDR, hdr_size)
+    )
+    if magic != INDEX_MAGIC:
+        return None
+
+    if version != INDEX_VERSION:
+        raise ValueError(f"unsupported index version {version}")
+
+    if (
+        num_buckets < 2
+        or num_buckets > INDEX_BUCKETS_MAX
+        or num_buckets & (num_buckets - 1) != 0
+    ):
+        raise ValueError(f"invalid index bucket count {num_buckets}")
+
+    body = reader(INDEX_ADDR + hdr_size, 2 * num_buckets)
+    if cksum(reader(INDEX_ADDR, hdr_size - CKSUM_SIZE) + body) != crc:
+        raise ValueError("index checksum does not match")
+
+    if num_fds != len(tags):
+        raise ValueError(f"index covers {num_fds} descriptors, table has {len(tags)}")
+
+    buckets = list(struct.unpack(f"<{num_buckets}H", body))
+    for slot, tag in enumerate(tags):
+        bucket = tag_hash(tag) % num_buckets
+        for _ in range(num_buckets):
+            if buckets[bucket] in (slot, INDEX_EMPTY):
+                break
+            bucket = (bucket + 1) % num_buckets
+        if buckets[bucket] != slot:
+            raise ValueError(f"index does not resolve {tag} to descriptor {slot}")
+
+    return buckets
+
+
 @dataclass
 class FsEntry:
     provisioning_only: bool
@@ -382,9 +472,14 @@ class RangeTracker:
 
 class BootFs:
     def __init__(
-        self, order: list[str], entries: dict[str, FsEntry], failover: FsEntry
+        self,
+        order: list[str],
+        entries: dict[str, FsEntry],
+        failover: FsEntry,
+        index: bool = False,
     ) -> None:
         self.writes: list[tuple[bool, int, bytes]] = []
+        self.index = index
 
         # Write image descriptors and data
         descriptor_addr = 0
@@ -398,6 +493,10 @@ class BootFs:
             )
             descriptor_addr += len(descriptor)
 
+        # Handle the optional descriptor index
+        if index:
+            self.writes.append((True, INDEX_ADDR, build_index(order)))
+
         # Handle failover
         self.writes.append((True, FAILOVER_HEAD_ADDR, failover.descriptor()))
         self.writes.append((True, failover.spi_addr, failover.data))
@@ -574,11 +673,15 @@ class BootFs:
         if spi_rx_training != SPI_RX_VALUE:
             raise ValueError(f"spi rx training data not found at 0x{SPI_RX_ADDR:x}")
 
+        index = (
+            read_index(lambda addr, size: data[addr : addr + size], order) is not None
+        )
+
         for tag in order:
             entries[tag] = BootFs.check_entry(tag, fds[tag], data, alignment)
         failover = BootFs.check_entry("failover", failover_fd, data, alignment)
 
-        return BootFs(order, entries, failover)
+        return BootFs(order, entries, failover, index)
 
 
 @dataclass
@@ -621,7 +724,7 @@ class FileImage:
             failover=BootImage.loads("", data["fail_over_image"], alignment, env),
         )
 
-    def to_boot_fs(self):
+    def to_boot_fs(self, index: bool = False):
         # We need to
         # - Load all binaries
         # - Place all binaries that have given addresses at the given locations
@@ -693,6 +796,7 @@ class FileImage:
                 load_addr=self.failover.load_addr,
                 executable=True,
             ),
+            index,
         )
 
 
@@ -711,14 +815,16 @@ def cksum(data: bytes):
     return calculated_checksum
 
 
-def mkfs(path: Path, env={"$ROOT": str(ROOT)}, hex=False) -> bytes:
+def mkfs(
+    path: Path, env={"$ROOT": str(ROOT)}, hex=False, index=False
+) -> Optional[bytes]:
     fi = None
     try:
         fi = FileImage.load(path, env)
         if hex:
-            return fi.to_boot_fs().to_intel_hex()
+            return fi.to_boot_fs(index).to_intel_hex()
         else:
-            return fi.to_boot_fs().to_binary()
+            return fi.to_boot_fs(index).to_binary()
     except Exception as e:
         _logger.error(f"Exception: {e}")
     return None
@@ -878,9 +984,9 @@ def invoke_mkfs(args):
         return os.EX_DATAERR
     if args.build_dir and args.build_dir.exists():
         env = {"$ROOT": str(ROOT), "$BUILD_DIR": str(args.build_dir)}
-        data = mkfs(args.specification, env, args.hex)
+        data = mkfs(args.specification, env, args.hex, args.index)
     else:
-        data = mkfs(args.specification, hex=args.hex)
+        data = mkfs(args.specification, hex=args.hex, index=args.index)
     if data is None:
         return os.EX_DATAERR
     with open(args.output_file, "wb") as file:
@@ -952,6 +1058,11 @@ def parse_args():
     mkfs_parser.add_argument(
         "--hex", action="store_true", help="Generate intel hex file"
     )
+    mkfs_parser.add_argument(
+        "--index",
+        action="store_true",
+        help="Write a tag hash index for constant-time descriptor lookup",
+    )
     mkfs_parser.set_defaults(func=invoke_mkfs)
 
     # Check a filesystem for validity
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Emulation of a NOR flash chip on the bus of the emulated DesignWare SSI controller, see
+ * tests/drivers/mspi/common/mspi_dw_emul.h. A transaction lasts from enabling the controller until
+ * it is disabled again. Page programs and erases keep the chip busy for the times set in Kconfig,
+ * so that the status polling of the flash driver is exercised like on real hardware.
+ */
+
+#include <string.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "mspi_dw_emul.h"
+
+#define RX_FIFO_DEPTH DT_PROP(DT_NODELABEL(mspi0), rx_fifo_depth)
+#define TX_FIFO_DEPTH DT_PROP(DT_NODELABEL(mspi0), fifo_depth)
+
+#define FLASH_SIZE  (DT_PROP(DT_NODELABEL(flash_emul), size) / 8)
+#define PAGE_SIZE   256
+#define SECTOR_SIZE 4096
+
+#define CTRLR0_SPI_FRF(v)    FIELD_GET(GENMASK(22, 21), v)
+#define SPI_CTRLR0_INST_L(v) FIELD_GET(GENMASK(9, 8), v)
+#define SPI_CTRLR0_ADDR_L(v) FIELD_GET(GENMASK(5, 2), v)
+
+#define CMD_WRSR        0x01
+#define CMD_PP          0x02
+#define CMD_READ        0x03
+#define CMD_RDSR        0x05
+#define CMD_WREN        0x06
+#define CMD_FAST        0x0b
+#define CMD_4READ       0x0c
+#define CMD_4PP         0x12
+#define CMD_4READ_1_1_1 0x13
+#define CMD_SE          0x20
+#define CMD_4SE         0x21
+#define CMD_BE32K       0x52
+#define CMD_4BE32K      0x5c
+#define CMD_PP_1_4_4    0x38
+#define CMD_4PP_1_4_4   0x3e
+#define CMD_CE          0x60
+#define CMD_RDID        0x9f
+#define CMD_CE2         0xc7
+#define CMD_BE          0xd8
+#define CMD_4BE         0xdc
+#define CMD_4READ_1_4_4 0xec
+
+#define STATUS_WIP BIT(0)
+#define STATUS_WEL BIT(1)
+
+/* In the TX/RX mode, a full TX FIFO of frames may be written before any is read back */
+BUILD_ASSERT(RX_FIFO_DEPTH > TX_FIFO_DEPTH + 5, "RX FIFO of the emulated controller too shallow");
+
+static const uint8_t jedec_id[] = DT_PROP(DT_NODELABEL(flash_emul), jedec_id);
+static uint8_t flash[FLASH_SIZE];
+
+/* Current transaction, from the command onwards */
+static uint8_t cmd;
+static uint32_t addr;
+static size_t addr_bytes;
+static size_t num_frames;
+static size_t data_pos;
+static uint8_t page_buf[PAGE_SIZE];
+static size_t page_len;
+
+static bool write_enabled;
+static uint32_t busy_start;
+static uint32_t busy_us;
+
+static bool is_busy(void)
+{
+	return k_cyc_to_us_floor32(k_cycle_get_32() - busy_start) < busy_us;
+}
+
+static void set_busy(uint32_t us)
+{
+	busy_start = k_cycle_get_32();
+	busy_us = us;
+}
+
+static bool standard_spi(void)
+{
+	return CTRLR0_SPI_FRF(mspi_dw_emul_ctrlr0()) == 0;
+}
+
+/* Commands sent in the standard SPI mode carry the address as data bytes */
+static size_t std_addr_bytes(uint8_t op)
+{
+	switch (op) {
+	case CMD_PP:
+	case CMD_READ:
+	case CMD_FAST:
+	case CMD_SE:
+	case CMD_BE32K:
+	case CMD_BE:
+	case CMD_PP_1_4_4:
+		return 3;
+	case CMD_4READ:
+	case CMD_4PP:
+	case CMD_4READ_1_1_1:
+	case CMD_4SE:
+	case CMD_4BE32K:
+	case CMD_4BE:
+	case CMD_4PP_1_4_4:
+	case CMD_4READ_1_4_4:
+		return 4;
+	default:
+		return 0;
+	}
+}
+
+static bool is_read(uint8_t op)
+{
+	return op == CMD_READ || op == CMD_FAST || op == CMD_4READ || op == CMD_4READ_1_1_1 ||
+	       op == CMD_4READ_1_4_4;
+}
+
+static bool is_program(uint8_t op)
+{
+	return op == CMD_PP || op == CMD_4PP || op == CMD_PP_1_4_4 || op == CMD_4PP_1_4_4;
+}
+
+/* The data byte the chip shifts out at position `pos` after the command and address */
+static uint8_t device_byte(size_t pos)
+{
+	if (cmd == CMD_RDID) {
+		return pos < sizeof(jedec_id) ? jedec_id[pos] : 0;
+	} else if (cmd == CMD_RDSR) {
+		return (is_busy() ? STATUS_WIP : 0) | (write_enabled ? STATUS_WEL : 0);
+	} else if (is_read(cmd) && !is_busy()) {
+		/* dummy cycles are not modelled, data follows the address */
+		return flash[(addr + pos) % FLASH_SIZE];
+	}
+
+	return 0xff;
+}
+
+static uint8_t rx_byte(void)
+{
+	return device_byte(data_pos++);
+}
+
+static void shift_data_byte(uint8_t tx)
+{
+	if (is_program(cmd) && page_len < PAGE_SIZE) {
+		page_buf[page_len++] = tx;
+	}
+	data_pos++;
+}
+
+/* Standard SPI: every frame is a byte, and the command and address are sent as data */
+static uint8_t shift_std_byte(uint8_t tx)
+{
+	uint8_t rx = 0xff;
+
+	if (num_frames == 0) {
+		cmd = tx;
+		addr_bytes = std_addr_bytes(cmd);
+	} else if (num_frames <= addr_bytes) {
+		addr = (addr << 8) | tx;
+	} else {
+		rx = device_byte(data_pos);
+		shift_data_byte(tx);
+	}
+
+	return rx;
+}
+
+/* Enhanced SPI: the command and address take one frame each, ahead of the data frames */
+static uint32_t shift_frame(uint32_t frame)
+{
+	uint32_t spi_ctrlr0 = mspi_dw_emul_spi_ctrlr0();
+	size_t inst_frames = SPI_CTRLR0_INST_L(spi_ctrlr0) != 0 ? 1 : 0;
+	uint32_t rx = (uint32_t)BIT64_MASK(8 * mspi_dw_emul_frame_bytes());
+
+	if (standard_spi()) {
+		rx = shift_std_byte(frame);
+	} else if (num_frames < inst_frames) {
+		cmd = frame;
+	} else if (num_frames == inst_frames && SPI_CTRLR0_ADDR_L(spi_ctrlr0) != 0) {
+		addr = frame;
+	} else {
+		for (size_t i = mspi_dw_emul_frame_bytes(); i > 0; i--) {
+			shift_data_byte(frame >> (8 * (i - 1)));
+		}
+	}
+
+	num_frames++;
+
+	return rx;
+}
+
+static void start_xfer(void)
+{
+	cmd = 0;
+	addr = 0;
+	addr_bytes = 0;
+	num_frames = 0;
+	data_pos = 0;
+	page_len = 0;
+}
+
+/* Commands take effect when CS is deasserted at the end of the transaction */
+static void end_xfer(void)
+{
+	if (num_frames == 0 || is_busy()) {
+		return;
+	}
+
+	addr %= FLASH_SIZE;
+
+	if (cmd == CMD_WREN) {
+		write_enabled = true;
+	} else if (!write_enabled) {
+		return;
+	} else if (is_program(cmd)) {
+		/* programming can only clear bits, and wraps within the page */
+		for (size_t i = 0; i < page_len; i++) {
+			flash[ROUND_DOWN(addr, PAGE_SIZE) + (addr + i) % PAGE_SIZE] &= page_buf[i];
+		}
+		write_enabled = false;
+		set_busy(CONFIG_FLASH_EMUL_PAGE_PROGRAM_TIME_US);
+	} else if (cmd == CMD_SE || cmd == CMD_4SE) {
+		memset(&flash[ROUND_DOWN(addr, SECTOR_SIZE)], 0xff, SECTOR_SIZE);
+		write_enabled = false;
+		set_busy(CONFIG_FLASH_EMUL_SECTOR_ERASE_TIME_US);
+	} else if (cmd == CMD_BE32K || cmd == CMD_4BE32K) {
+		memset(&flash[ROUND_DOWN(addr, KB(32))], 0xff, KB(32));
+		write_enabled = false;
+		set_busy(CONFIG_FLASH_EMUL_BLOCK_ERASE_32K_TIME_US);
+	} else if (cmd == CMD_BE || cmd == CMD_4BE) {
+		memset(&flash[ROUND_DOWN(addr, KB(64))], 0xff, KB(64));
+		write_enabled = false;
+		set_busy(CONFIG_FLASH_EMUL_BLOCK_ERASE_64K_TIME_US);
+	} else if (cmd == CMD_CE || cmd == CMD_CE2) {
+		memset(flash, 0xff, sizeof(flash));
+		write_enabled = false;
+		set_busy(CONFIG_FLASH_EMUL_SECTOR_ERASE_TIME_US * (FLASH_SIZE / SECTOR_SIZE));
+	} else if (cmd == CMD_WRSR) {
+		write_enabled = false;
+	}
+}
+
+static const struct mspi_dw_emul_target flash_emul_target = {
+	.start = start_xfer,
+	.end = end_xfer,
+	.tx = shift_frame,
+	.rx = rx_byte,
+};
+
+static int flash_emul_init(void)
+{
+	memset(flash, 0xff, sizeof(flash));
+	mspi_dw_emul_set_target(&flash_emul_target);
+
+	return 0;
+}
+
+SYS_INIT(flash_emul_init, PRE_KERNEL_1, 0);
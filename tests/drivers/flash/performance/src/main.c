@@ -75,5 +75,23 @@ ZTEST(flash_driver_perf, test_program_perf)
 	TC_PRINT("Data read back from flash matches data written\n");
 }
 
+ZTEST(flash_driver_perf, test_erase_perf)
+{
+	int rc;
+	int64_t ts = k_uptime_get();
+	int64_t delta;
+
+	rc = flash_erase(flash_dev, TEST_AREA_OFFSET, EXPECTED_SIZE);
+	delta = k_uptime_delta(&ts);
+	zassert_equal(rc, 0, "Cannot erase flash");
+	TC_PRINT("Erase performance test ran in %lld ms\n", delta);
+	zassert_true(delta < CONFIG_EXPECTED_ERASE_TIME, "Erase performance test failed");
+	/* Check that the whole area reads back as erased */
+	rc = flash_read(flash_dev, TEST_AREA_OFFSET, check_buf, EXPECTED_SIZE);
+	zassert_equal(rc, 0, "Cannot read flash");
+	for (int i = 0; i < EXPECTED_SIZE; i++) {
+		zassert_equal(check_buf[i], 0xff, "Byte at offset %d not erased", i);
+	}
+}
 
 ZTEST_SUITE(flash_driver_perf, NULL, NULL, NULL, NULL, NULL);
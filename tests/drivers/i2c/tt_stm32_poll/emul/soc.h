@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TT_STM32_I2C_EMUL_SOC_H_
+#define TT_STM32_I2C_EMUL_SOC_H_
+
+/* The registers of the I2C controller are those of the emulation in stm32_i2c_emul.c */
+typedef struct stm32_i2c_emul I2C_TypeDef;
+
+#endif
@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+
+#include <stm32_ll_i2c.h>
+
+#include "stm32_i2c_emul.h"
+
+struct stm32_i2c_emul {
+	/* CR1 */
+	bool pe;
+	bool txdmaen;
+	bool rxdmaen;
+	/* CR2 */
+	bool add10;
+	uint32_t sadd;
+	bool rd_wrn;
+	uint32_t nbytes;
+	bool reload;
+	bool autoend;
+	/* ISR */
+	bool txis;
+	bool rxne;
+	bool tc;
+	bool tcr;
+	bool nackf;
+	bool stopf;
+	/* Data registers, the DMA controller checks it is given their addresses */
+	uint32_t txdr;
+	uint32_t rxdr;
+	uint32_t timingr;
+
+	/* A START was acknowledged and no STOP followed yet */
+	bool active;
+	/* Bytes left in the current NBYTES block */
+	uint32_t remaining;
+	/* Offset of the next byte in the target memory */
+	size_t pos;
+};
+
+I2C_TypeDef stm32_i2c_emul;
+struct stm32_i2c_emul_target stm32_i2c_emul_target;
+size_t stm32_i2c_emul_num_starts;
+size_t stm32_i2c_emul_num_stops;
+
+/* Polling a flag takes time, which lets timers and the DMA controller run on native_sim */
+static struct stm32_i2c_emul *flag_read(I2C_TypeDef *i2c)
+{
+	k_busy_wait(1);
+
+	return i2c;
+}
+
+/* Ends the bus transaction, as the controller does after a NACK or when asked to */
+static void bus_stop(struct stm32_i2c_emul *i2c)
+{
+	i2c->active = false;
+	i2c->txis = false;
+	i2c->rxne = false;
+	i2c->tc = false;
+	i2c->tcr = false;
+	i2c->stopf = true;
+	stm32_i2c_emul_num_stops++;
+}
+
+static void block_end(struct stm32_i2c_emul *i2c)
+{
+	if (i2c->reload) {
+		i2c->tcr = true;
+	} else if (i2c->autoend) {
+		bus_stop(i2c);
+	} else {
+		i2c->tc = true;
+	}
+}
+
+/* Moves the bus on to the next byte, unless it waits on the driver or on the target */
+static void bus_advance(struct stm32_i2c_emul *i2c)
+{
+	struct stm32_i2c_emul_target *target = &stm32_i2c_emul_target;
+
+	if (!i2c->active || i2c->txis || i2c->rxne || i2c->tc || i2c->tcr || i2c->remaining == 0 ||
+	    i2c->pos == target->stall_at) {
+		return;
+	}
+
+	if (!i2c->rd_wrn) {
+		i2c->txis = true;
+		return;
+	}
+
+	i2c->rxdr = i2c->pos < sizeof(target->mem) ? target->mem[i2c->pos] : 0xff;
+	i2c->pos++;
+	i2c->rxne = true;
+	if (--i2c->remaining == 0) {
+		block_end(i2c);
+	}
+}
+
+void stm32_i2c_emul_reset(uint16_t addr)
+{
+	memset(&stm32_i2c_emul, 0, sizeof(stm32_i2c_emul));
+	memset(&stm32_i2c_emul_target, 0, sizeof(stm32_i2c_emul_target));
+
+	stm32_i2c_emul_target.addr = addr;
+	stm32_i2c_emul_target.nack_at = STM32_I2C_EMUL_NO_FAULT;
+	stm32_i2c_emul_target.stall_at = STM32_I2C_EMUL_NO_FAULT;
+	stm32_i2c_emul_target.byte_us = STM32_I2C_EMUL_BYTE_US;
+
+	stm32_i2c_emul_num_starts = 0;
+	stm32_i2c_emul_num_stops = 0;
+}
+
+size_t stm32_i2c_emul_pos(void)
+{
+	return stm32_i2c_emul.pos;
+}
+
+bool stm32_i2c_emul_dma_request(bool tx)
+{
+	return tx ? stm32_i2c_emul.txdmaen && stm32_i2c_emul.txis
+		  : stm32_i2c_emul.rxdmaen && stm32_i2c_emul.rxne;
+}
+
+void LL_I2C_Enable(I2C_TypeDef *i2c)
+{
+	i2c->pe = true;
+}
+
+void LL_I2C_Disable(I2C_TypeDef *i2c)
+{
+	/* Clearing PE resets the state machine and the status flags */
+	i2c->pe = false;
+	i2c->active = false;
+	i2c->txis = false;
+	i2c->rxne = false;
+	i2c->tc = false;
+	i2c->tcr = false;
+	i2c->nackf = false;
+	i2c->stopf = false;
+}
+
+uint32_t LL_I2C_IsEnabled(I2C_TypeDef *i2c)
+{
+	return flag_read(i2c)->pe;
+}
+
+void LL_I2C_SetTiming(I2C_TypeDef *i2c, uint32_t timing)
+{
+	i2c->timingr = timing;
+}
+
+void LL_I2C_SetMasterAddressingMode(I2C_TypeDef *i2c, uint32_t mode)
+{
+	i2c->add10 = mode == LL_I2C_ADDRESSING_MODE_10BIT;
+}
+
+void LL_I2C_SetSlaveAddr(I2C_TypeDef *i2c, uint32_t addr)
+{
+	i2c->sadd = addr;
+}
+
+void LL_I2C_SetTransferRequest(I2C_TypeDef *i2c, uint32_t request)
+{
+	i2c->rd_wrn = request == LL_I2C_REQUEST_READ;
+}
+
+void LL_I2C_SetTransferSize(I2C_TypeDef *i2c, uint32_t size)
+{
+	i2c->nbytes = size;
+
+	/* Writing NBYTES after TCR continues the transfer */
+	if (i2c->active && i2c->tcr) {
+		i2c->tcr = false;
+		i2c->remaining = size;
+		bus_advance(i2c);
+	}
+}
+
+uint32_t LL_I2C_GetTransferSize(I2C_TypeDef *i2c)
+{
+	return i2c->nbytes;
+}
+
+void LL_I2C_EnableReloadMode(I2C_TypeDef *i2c)
+{
+	i2c->reload = true;
+}
+
+void LL_I2C_DisableReloadMode(I2C_TypeDef *i2c)
+{
+	i2c->reload = false;
+}
+
+uint32_t LL_I2C_IsEnabledReloadMode(I2C_TypeDef *i2c)
+{
+	return i2c->reload;
+}
+
+void LL_I2C_DisableAutoEndMode(I2C_TypeDef *i2c)
+{
+	i2c->autoend = false;
+}
+
+void LL_I2C_GenerateStartCondition(I2C_TypeDef *i2c)
+{
+	const struct stm32_i2c_emul_target *target = &stm32_i2c_emul_target;
+
+	if (!i2c->pe) {
+		return;
+	}
+
+	stm32_i2c_emul_num_starts++;
+	i2c->tc = false;
+	i2c->txis = false;
+	i2c->rxne = false;
+	i2c->pos = 0;
+	i2c->remaining = i2c->nbytes;
+
+	/* The target only has a 7 bit address */
+	if (i2c->add10 || (i2c->sadd >> 1) != target->addr || target->nack_addr) {
+		/* The controller sends a STOP by itself after a NACK */
+		i2c->nackf = true;
+		bus_stop(i2c);
+		return;
+	}
+
+	i2c->active = true;
+	bus_advance(i2c);
+}
+
+void LL_I2C_GenerateStopCondition(I2C_TypeDef *i2c)
+{
+	if (i2c->pe) {
+		bus_stop(i2c);
+	}
+}
+
+void LL_I2C_TransmitData8(I2C_TypeDef *i2c, uint8_t data)
+{
+	struct stm32_i2c_emul_target *target = &stm32_i2c_emul_target;
+
+	i2c->txdr = data;
+	if (!i2c->active || !i2c->txis) {
+		return;
+	}
+
+	i2c->txis = false;
+	if (i2c->pos == target->nack_at) {
+		/* The controller sends a STOP by itself after a NACK */
+		i2c->nackf = true;
+		bus_stop(i2c);
+		return;
+	}
+
+	if (i2c->pos < sizeof(target->mem)) {
+		target->mem[i2c->pos] = data;
+	}
+	i2c->pos++;
+
+	if (--i2c->remaining == 0) {
+		block_end(i2c);
+	}
+	bus_advance(i2c);
+}
+
+uint8_t LL_I2C_ReceiveData8(I2C_TypeDef *i2c)
+{
+	uint8_t data = i2c->rxdr;
+
+	i2c->rxne = false;
+	bus_advance(i2c);
+
+	return data;
+}
+
+uint32_t LL_I2C_IsActiveFlag_TXIS(I2C_TypeDef *i2c)
+{
+	return flag_read(i2c)->txis;
+}
+
+uint32_t LL_I2C_IsActiveFlag_RXNE(I2C_TypeDef *i2c)
+{
+	return flag_read(i2c)->rxne;
+}
+
+uint32_t LL_I2C_IsActiveFlag_TC(I2C_TypeDef *i2c)
+{
+	return flag_read(i2c)->tc;
+}
+
+uint32_t LL_I2C_IsActiveFlag_TCR(I2C_TypeDef *i2c)
+{
+	return flag_read(i2c)->tcr;
+}
+
+uint32_t LL_I2C_IsActiveFlag_NACK(I2C_TypeDef *i2c)
+{
+	return flag_read(i2c)->nackf;
+}
+
+uint32_t LL_I2C_IsActiveFlag_STOP(I2C_TypeDef *i2c)
+{
+	return flag_read(i2c)->stopf;
+}
+
+/* There is a single controller on the bus, and it never sees bus errors or overruns */
+uint32_t LL_I2C_IsActiveFlag_ARLO(I2C_TypeDef *i2c)
+{
+	flag_read(i2c);
+
+	return 0;
+}
+
+uint32_t LL_I2C_IsActiveFlag_BERR(I2C_TypeDef *i2c)
+{
+	flag_read(i2c);
+
+	return 0;
+}
+
+uint32_t LL_I2C_IsActiveFlag_OVR(I2C_TypeDef *i2c)
+{
+	flag_read(i2c);
+
+	return 0;
+}
+
+void LL_I2C_ClearFlag_NACK(I2C_TypeDef *i2c)
+{
+	i2c->nackf = false;
+}
+
+void LL_I2C_ClearFlag_STOP(I2C_TypeDef *i2c)
+{
+	i2c->stopf = false;
+}
+
+void LL_I2C_ClearFlag_ARLO(I2C_TypeDef *i2c)
+{
+	ARG_UNUSED(i2c);
+}
+
+void LL_I2C_ClearFlag_BERR(I2C_TypeDef *i2c)
+{
+	ARG_UNUSED(i2c);
+}
+
+void LL_I2C_ClearFlag_OVR(I2C_TypeDef *i2c)
+{
+	ARG_UNUSED(i2c);
+}
+
+void LL_I2C_EnableDMAReq_TX(I2C_TypeDef *i2c)
+{
+	i2c->txdmaen = true;
+}
+
+void LL_I2C_DisableDMAReq_TX(I2C_TypeDef *i2c)
+{
+	i2c->txdmaen = false;
+}
+
+void LL_I2C_EnableDMAReq_RX(I2C_TypeDef *i2c)
+{
+	i2c->rxdmaen = true;
+}
+
+void LL_I2C_DisableDMAReq_RX(I2C_TypeDef *i2c)
+{
+	i2c->rxdmaen = false;
+}
+
+uint32_t LL_I2C_DMA_GetRegAddr(I2C_TypeDef *i2c, uint32_t direction)
+{
+	return (uint32_t)(uintptr_t)(direction == LL_I2C_DMA_REG_DATA_TRANSMIT ? &i2c->txdr
+									   : &i2c->rxdr);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STM32_I2C_EMUL_H_
+#define STM32_I2C_EMUL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+#include <soc.h>
+
+/*
+ * Emulation of the STM32 I2C v2 controller registers behind the LL API used by the polled mode of
+ * the tt_stm32_i2c driver, with a single memory-like target on the bus.
+ *
+ * Every START addresses the target from the start of its memory. Bytes move as fast as the driver
+ * serves TXIS and RXNE, or at STM32_I2C_EMUL_BYTE_US per byte when the DMA controller emulated by
+ * stm32_i2c_emul_dma.c serves them. Flag reads take a microsecond, so that polling loops see time
+ * pass on native_sim.
+ */
+
+#define STM32_I2C_EMUL_MEM_SIZE 512
+#define STM32_I2C_EMUL_NO_FAULT -1
+/* Nine bit times of a 100 kHz bus */
+#define STM32_I2C_EMUL_BYTE_US  90
+
+struct stm32_i2c_emul_target {
+	uint16_t addr;
+	uint8_t mem[STM32_I2C_EMUL_MEM_SIZE];
+	/* The address is not acknowledged */
+	bool nack_addr;
+	/* The byte written at this offset is not acknowledged */
+	int nack_at;
+	/* The target holds the bus before the byte at this offset */
+	int stall_at;
+	/* Time the DMA controller takes per byte */
+	uint32_t byte_us;
+};
+
+extern I2C_TypeDef stm32_i2c_emul;
+extern struct stm32_i2c_emul_target stm32_i2c_emul_target;
+
+/* Resets the controller, and the target to one at @p addr without faults */
+void stm32_i2c_emul_reset(uint16_t addr);
+
+/* Offset in the target memory of the next byte */
+size_t stm32_i2c_emul_pos(void);
+
+/* Number of START and STOP conditions on the bus */
+extern size_t stm32_i2c_emul_num_starts;
+extern size_t stm32_i2c_emul_num_stops;
+
+/* DMA controller serving the emulated I2C controller, with channel 0 for TX and 1 for RX */
+#define STM32_I2C_EMUL_DMA_TX 0
+#define STM32_I2C_EMUL_DMA_RX 1
+
+const struct device *stm32_i2c_emul_dma(void);
+
+/*
+ * DMA handshake. Requests follow TXIS and RXNE while the matching DMA request of the controller
+ * is enabled, and are served through the data registers with LL_I2C_TransmitData8() and
+ * LL_I2C_ReceiveData8().
+ */
+bool stm32_i2c_emul_dma_request(bool tx);
+
+/* Number of DMA transfers started, and of those stopped before they completed */
+extern size_t stm32_i2c_emul_dma_starts;
+extern size_t stm32_i2c_emul_dma_aborts;
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Emulation of a DMA controller serving the emulated STM32 I2C controller. A timer moves one byte
+ * per byte time of the target on every channel the controller requests data for, and completion
+ * is reported from there like a real DMA controller would from its interrupt.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/kernel.h>
+
+#include <stm32_ll_i2c.h>
+
+#include "stm32_i2c_emul.h"
+
+struct emul_dma_channel {
+	struct dma_config cfg;
+	struct dma_block_config block;
+	uint32_t pos;
+	bool active;
+};
+
+static struct emul_dma_channel channels[2];
+
+size_t stm32_i2c_emul_dma_starts;
+size_t stm32_i2c_emul_dma_aborts;
+
+static bool channel_tx(const struct emul_dma_channel *ch)
+{
+	return ch->cfg.channel_direction == MEMORY_TO_PERIPHERAL;
+}
+
+static void emul_dma_byte(struct k_timer *timer)
+{
+	const struct device *dev = stm32_i2c_emul_dma();
+	bool active = false;
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(channels); i++) {
+		struct emul_dma_channel *ch = &channels[i];
+		bool tx = channel_tx(ch);
+
+		if (!ch->active || !stm32_i2c_emul_dma_request(tx)) {
+			active |= ch->active;
+			continue;
+		}
+
+		if (tx) {
+			const uint8_t *src = (const uint8_t *)ch->block.source_address;
+
+			LL_I2C_TransmitData8(&stm32_i2c_emul, src[ch->pos]);
+		} else {
+			uint8_t *dst = (uint8_t *)ch->block.dest_address;
+
+			dst[ch->pos] = LL_I2C_ReceiveData8(&stm32_i2c_emul);
+		}
+
+		if (++ch->pos < ch->block.block_size) {
+			active = true;
+			continue;
+		}
+
+		/* The callback may configure and start the channel again */
+		ch->active = false;
+		if (ch->cfg.dma_callback) {
+			ch->cfg.dma_callback(dev, ch->cfg.user_data, i, DMA_STATUS_COMPLETE);
+		}
+		active |= ch->active;
+	}
+
+	if (!active) {
+		k_timer_stop(timer);
+	}
+}
+
+static K_TIMER_DEFINE(emul_dma_timer, emul_dma_byte, NULL);
+
+static int emul_dma_config(const struct device *dev, uint32_t channel, struct dma_config *cfg)
+{
+	struct emul_dma_channel *ch;
+	uint32_t periph_addr;
+	uint32_t data_reg;
+
+	ARG_UNUSED(dev);
+
+	if (channel >= ARRAY_SIZE(channels) || cfg->block_count != 1 ||
+	    cfg->source_data_size != 1 || cfg->dest_data_size != 1) {
+		return -EINVAL;
+	}
+
+	ch = &channels[channel];
+	if (ch->active) {
+		return -EBUSY;
+	}
+
+	switch (cfg->channel_direction) {
+	case MEMORY_TO_PERIPHERAL:
+		periph_addr = cfg->head_block->dest_address;
+		data_reg = LL_I2C_DMA_GetRegAddr(&stm32_i2c_emul, LL_I2C_DMA_REG_DATA_TRANSMIT);
+		break;
+	case PERIPHERAL_TO_MEMORY:
+		periph_addr = cfg->head_block->source_address;
+		data_reg = LL_I2C_DMA_GetRegAddr(&stm32_i2c_emul, LL_I2C_DMA_REG_DATA_RECEIVE);
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	if (periph_addr != data_reg) {
+		return -EINVAL;
+	}
+
+	ch->cfg = *cfg;
+	ch->block = *cfg->head_block;
+	ch->cfg.head_block = &ch->block;
+
+	return 0;
+}
+
+static int emul_dma_start(const struct device *dev, uint32_t channel)
+{
+	const k_timeout_t byte_time = K_USEC(stm32_i2c_emul_target.byte_us);
+
+	ARG_UNUSED(dev);
+
+	if (channel >= ARRAY_SIZE(channels)) {
+		return -EINVAL;
+	}
+
+	channels[channel].pos = 0;
+	channels[channel].active = true;
+	stm32_i2c_emul_dma_starts++;
+	k_timer_start(&emul_dma_timer, byte_time, byte_time);
+
+	return 0;
+}
+
+static int emul_dma_stop(const struct device *dev, uint32_t channel)
+{
+	ARG_UNUSED(dev);
+
+	if (channel >= ARRAY_SIZE(channels)) {
+		return -EINVAL;
+	}
+
+	if (channels[channel].active) {
+		channels[channel].active = false;
+		stm32_i2c_emul_dma_aborts++;
+	}
+
+	return 0;
+}
+
+static int emul_dma_get_status(const struct device *dev, uint32_t channel,
+			       struct dma_status *stat)
+{
+	const struct emul_dma_channel *ch;
+
+	ARG_UNUSED(dev);
+
+	if (channel >= ARRAY_SIZE(channels)) {
+		return -EINVAL;
+	}
+
+	ch = &channels[channel];
+	*stat = (struct dma_status){
+		.busy = ch->active,
+		.dir = ch->cfg.channel_direction,
+		.pending_length = ch->active ? ch->block.block_size - ch->pos : 0,
+	};
+
+	return 0;
+}
+
+static DEVICE_API(dma, emul_dma_api) = {
+	.config = emul_dma_config,
+	.start = emul_dma_start,
+	.stop = emul_dma_stop,
+	.get_status = emul_dma_get_status,
+};
+
+DEVICE_DEFINE(stm32_i2c_emul_dma_dev, "stm32_i2c_emul_dma", NULL, NULL, NULL, NULL,
+	      PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &emul_dma_api);
+
+const struct device *stm32_i2c_emul_dma(void)
+{
+	return DEVICE_GET(stm32_i2c_emul_dma_dev);
+}
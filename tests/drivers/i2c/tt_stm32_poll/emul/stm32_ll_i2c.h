@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TT_STM32_I2C_EMUL_LL_I2C_H_
+#define TT_STM32_I2C_EMUL_LL_I2C_H_
+
+#include <stdint.h>
+
+#include <soc.h>
+
+/*
+ * The subset of the STM32 LL I2C API used by tt_stm32_i2c_poll_api.c, implemented on the
+ * emulated controller of stm32_i2c_emul.c.
+ */
+
+#define LL_I2C_ADDRESSING_MODE_7BIT  0U
+#define LL_I2C_ADDRESSING_MODE_10BIT 1U
+
+#define LL_I2C_REQUEST_WRITE 0U
+#define LL_I2C_REQUEST_READ  1U
+
+#define LL_I2C_DMA_REG_DATA_TRANSMIT 0U
+#define LL_I2C_DMA_REG_DATA_RECEIVE  1U
+
+#define __LL_I2C_CONVERT_TIMINGS(presc, setup, hold, sclh, scll)                                 \
+	(((presc) << 28) | ((setup) << 20) | ((hold) << 16) | ((sclh) << 8) | (scll))
+
+void LL_I2C_Enable(I2C_TypeDef *i2c);
+void LL_I2C_Disable(I2C_TypeDef *i2c);
+uint32_t LL_I2C_IsEnabled(I2C_TypeDef *i2c);
+void LL_I2C_SetTiming(I2C_TypeDef *i2c, uint32_t timing);
+
+void LL_I2C_SetMasterAddressingMode(I2C_TypeDef *i2c, uint32_t mode);
+void LL_I2C_SetSlaveAddr(I2C_TypeDef *i2c, uint32_t addr);
+void LL_I2C_SetTransferRequest(I2C_TypeDef *i2c, uint32_t request);
+void LL_I2C_SetTransferSize(I2C_TypeDef *i2c, uint32_t size);
+uint32_t LL_I2C_GetTransferSize(I2C_TypeDef *i2c);
+void LL_I2C_EnableReloadMode(I2C_TypeDef *i2c);
+void LL_I2C_DisableReloadMode(I2C_TypeDef *i2c);
+uint32_t LL_I2C_IsEnabledReloadMode(I2C_TypeDef *i2c);
+void LL_I2C_DisableAutoEndMode(I2C_TypeDef *i2c);
+void LL_I2C_GenerateStartCondition(I2C_TypeDef *i2c);
+void LL_I2C_GenerateStopCondition(I2C_TypeDef *i2c);
+
+void LL_I2C_TransmitData8(I2C_TypeDef *i2c, uint8_t data);
+uint8_t LL_I2C_ReceiveData8(I2C_TypeDef *i2c);
+
+uint32_t LL_I2C_IsActiveFlag_TXIS(I2C_TypeDef *i2c);
+uint32_t LL_I2C_IsActiveFlag_RXNE(I2C_TypeDef *i2c);
+uint32_t LL_I2C_IsActiveFlag_TC(I2C_TypeDef *i2c);
+uint32_t LL_I2C_IsActiveFlag_TCR(I2C_TypeDef *i2c);
+uint32_t LL_I2C_IsActiveFlag_NACK(I2C_TypeDef *i2c);
+uint32_t LL_I2C_IsActiveFlag_STOP(I2C_TypeDef *i2c);
+uint32_t LL_I2C_IsActiveFlag_ARLO(I2C_TypeDef *i2c);
+uint32_t LL_I2C_IsActiveFlag_BERR(I2C_TypeDef *i2c);
+uint32_t LL_I2C_IsActiveFlag_OVR(I2C_TypeDef *i2c);
+void LL_I2C_ClearFlag_NACK(I2C_TypeDef *i2c);
+void LL_I2C_ClearFlag_STOP(I2C_TypeDef *i2c);
+void LL_I2C_ClearFlag_ARLO(I2C_TypeDef *i2c);
+void LL_I2C_ClearFlag_BERR(I2C_TypeDef *i2c);
+void LL_I2C_ClearFlag_OVR(I2C_TypeDef *i2c);
+
+void LL_I2C_EnableDMAReq_TX(I2C_TypeDef *i2c);
+void LL_I2C_DisableDMAReq_TX(I2C_TypeDef *i2c);
+void LL_I2C_EnableDMAReq_RX(I2C_TypeDef *i2c);
+void LL_I2C_DisableDMAReq_RX(I2C_TypeDef *i2c);
+uint32_t LL_I2C_DMA_GetRegAddr(I2C_TypeDef *i2c, uint32_t direction);
+
+#endif
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TT_STM32_I2C_EMUL_STM32_CLOCK_CONTROL_H_
+#define TT_STM32_I2C_EMUL_STM32_CLOCK_CONTROL_H_
+
+#include <stdint.h>
+
+/* Only referenced by the configuration of the driver, the emulated controller has no clocks */
+struct stm32_pclken {
+	uint32_t bus;
+	uint32_t enr;
+};
+
+#endif
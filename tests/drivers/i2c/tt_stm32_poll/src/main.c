@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The polled mode of the tt_stm32_i2c driver, against an emulated STM32 I2C controller with a
+ * target that can NACK or hold the bus, and with CONFIG_DMA against an emulated DMA controller.
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/ztest.h>
+
+#include "stm32_i2c_emul.h"
+#include "tt_stm32_i2c.h"
+
+#define TARGET_ADDR 0x0A
+#define TIMEOUT_MS  CONFIG_TT_I2C_STM32_TIMEOUT
+#define NO_FAULT    STM32_I2C_EMUL_NO_FAULT
+
+static unsigned int abort_flag;
+static uint8_t buf[STM32_I2C_EMUL_MEM_SIZE];
+
+static struct tt_stm32_i2c_config i2c_cfg = {
+	.i2c = &stm32_i2c_emul,
+};
+
+static struct tt_stm32_i2c_data i2c_data = {
+	.dev_config = I2C_SPEED_SET(I2C_SPEED_STANDARD) | I2C_MODE_CONTROLLER,
+	.abort = &abort_flag,
+};
+
+/* What tt_stm32_i2c_init() sets up for the polled mode, without clocks and pins */
+static int i2c_emul_init(const struct device *dev)
+{
+	struct tt_stm32_i2c_data *data = dev->data;
+
+	k_sem_init(&data->bus_mutex, 1, 1);
+#ifdef CONFIG_TT_I2C_STM32_DMA
+	k_sem_init(&data->dma.done, 0, 1);
+	i2c_cfg.dma_tx = (struct tt_stm32_i2c_dma_channel){
+		.dev = stm32_i2c_emul_dma(),
+		.channel = STM32_I2C_EMUL_DMA_TX,
+	};
+	i2c_cfg.dma_rx = (struct tt_stm32_i2c_dma_channel){
+		.dev = stm32_i2c_emul_dma(),
+		.channel = STM32_I2C_EMUL_DMA_RX,
+	};
+#endif
+
+	return 0;
+}
+
+DEVICE_DEFINE(tt_stm32_i2c_emul, "tt_stm32_i2c_emul", i2c_emul_init, NULL, &i2c_data, &i2c_cfg,
+	      POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);
+
+#define I2C_DEV DEVICE_GET(tt_stm32_i2c_emul)
+
+/* Sends the messages of a transfer like tt_stm32_i2c_send_messages() */
+static int transfer(struct i2c_msg *msgs, uint8_t num_msgs)
+{
+	int ret = 0;
+
+	msgs[0].flags |= I2C_MSG_RESTART;
+
+	tt_stm32_i2c_enable(I2C_DEV);
+	for (uint8_t i = 0; i < num_msgs; i++) {
+		bool cont = i + 1 < num_msgs && !(msgs[i + 1].flags & I2C_MSG_RESTART) &&
+			    !(msgs[i].flags & I2C_MSG_STOP) &&
+			    (msgs[i].flags & I2C_MSG_RW_MASK) == (msgs[i + 1].flags & I2C_MSG_RW_MASK);
+
+		ret = tt_stm32_i2c_send_message(I2C_DEV, TARGET_ADDR, msgs[i], i == 0, cont);
+		if (ret < 0) {
+			break;
+		}
+	}
+	tt_stm32_i2c_disable(I2C_DEV);
+
+	return ret;
+}
+
+static int xfer(size_t len, bool write)
+{
+	struct i2c_msg msg = {
+		.buf = buf,
+		.len = len,
+		.flags = (write ? I2C_MSG_WRITE : I2C_MSG_READ) | I2C_MSG_STOP,
+	};
+
+	return transfer(&msg, 1);
+}
+
+static void fill(uint8_t *data, size_t len, uint8_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		data[i] = seed + 31 * i;
+	}
+}
+
+/* Number of DMA transfers used so far, or zero when the driver only polls */
+static size_t dma_starts(void)
+{
+#ifdef CONFIG_TT_I2C_STM32_DMA
+	return stm32_i2c_emul_dma_starts;
+#else
+	return 0;
+#endif
+}
+
+static void assert_dma_stopped(void)
+{
+#ifdef CONFIG_TT_I2C_STM32_DMA
+	zassert_equal(stm32_i2c_emul_dma_aborts, 1, "the DMA channel was not stopped");
+	zassert_false(stm32_i2c_emul_dma_request(true) || stm32_i2c_emul_dma_request(false),
+		      "the controller still requests DMA transfers");
+#endif
+}
+
+ZTEST(tt_stm32_i2c_poll, test_read)
+{
+	fill(stm32_i2c_emul_target.mem, 64, 0x5a);
+
+	zassert_ok(xfer(64, false));
+	zassert_mem_equal(buf, stm32_i2c_emul_target.mem, 64);
+	zassert_equal(stm32_i2c_emul_num_starts, 1);
+	zassert_equal(stm32_i2c_emul_num_stops, 1);
+	zassert_equal(dma_starts(), IS_ENABLED(CONFIG_TT_I2C_STM32_DMA) ? 1 : 0);
+}
+
+ZTEST(tt_stm32_i2c_poll, test_write)
+{
+	fill(buf, 64, 0xa5);
+
+	zassert_ok(xfer(64, true));
+	zassert_mem_equal(stm32_i2c_emul_target.mem, buf, 64);
+	zassert_equal(stm32_i2c_emul_num_stops, 1);
+	zassert_equal(dma_starts(), IS_ENABLED(CONFIG_TT_I2C_STM32_DMA) ? 1 : 0);
+}
+
+ZTEST(tt_stm32_i2c_poll, test_short_message)
+{
+	/* Too short to be worth a DMA transfer */
+	fill(buf, 4, 0x42);
+
+	zassert_ok(xfer(4, true));
+	zassert_mem_equal(stm32_i2c_emul_target.mem, buf, 4);
+	zassert_equal(dma_starts(), 0);
+}
+
+ZTEST(tt_stm32_i2c_poll, test_reload)
+{
+	const size_t len = 300;
+
+	/* Longer than NBYTES can count, so the message is split in two blocks */
+	fill(buf, len, 0x3c);
+	zassert_ok(xfer(len, true));
+	zassert_mem_equal(stm32_i2c_emul_target.mem, buf, len);
+
+	memset(buf, 0, sizeof(buf));
+	zassert_ok(xfer(len, false));
+	zassert_mem_equal(buf, stm32_i2c_emul_target.mem, len);
+	zassert_equal(dma_starts(), IS_ENABLED(CONFIG_TT_I2C_STM32_DMA) ? 4 : 0);
+}
+
+ZTEST(tt_stm32_i2c_poll, test_write_read)
+{
+	uint8_t cmd = 0x77;
+	struct i2c_msg msgs[] = {
+		{.buf = &cmd, .len = 1, .flags = I2C_MSG_WRITE},
+		{.buf = buf, .len = 16, .flags = I2C_MSG_READ | I2C_MSG_RESTART | I2C_MSG_STOP},
+	};
+
+	fill(stm32_i2c_emul_target.mem, 16, 0x10);
+
+	zassert_ok(transfer(msgs, ARRAY_SIZE(msgs)));
+	zassert_equal(stm32_i2c_emul_num_starts, 2);
+	zassert_equal(stm32_i2c_emul_num_stops, 1);
+	/* The read starts over from the start of the target memory */
+	zassert_equal(stm32_i2c_emul_target.mem[0], cmd);
+	zassert_mem_equal(buf, stm32_i2c_emul_target.mem, 16);
+}
+
+ZTEST(tt_stm32_i2c_poll, test_addr_nack)
+{
+	int64_t start = k_uptime_get();
+
+	stm32_i2c_emul_target.nack_addr = true;
+	zassert_equal(xfer(32, false), -EIO);
+
+	/* The NACK is reported without waiting for the timeout */
+	zassert_true(k_uptime_get() - start < TIMEOUT_MS);
+	zassert_equal(stm32_i2c_emul_pos(), 0);
+	assert_dma_stopped();
+
+	/* and the next transfer goes through */
+	stm32_i2c_emul_target.nack_addr = false;
+	fill(stm32_i2c_emul_target.mem, 32, 0x11);
+	zassert_ok(xfer(32, false));
+	zassert_mem_equal(buf, stm32_i2c_emul_target.mem, 32);
+}
+
+ZTEST(tt_stm32_i2c_poll, test_data_nack)
+{
+	const int nack_at = 10;
+	int64_t start = k_uptime_get();
+
+	stm32_i2c_emul_target.nack_at = nack_at;
+	fill(buf, 32, 0x22);
+	zassert_equal(xfer(32, true), -EIO);
+
+	zassert_true(k_uptime_get() - start < TIMEOUT_MS);
+	zassert_equal(stm32_i2c_emul_pos(), nack_at);
+	zassert_mem_equal(stm32_i2c_emul_target.mem, buf, nack_at);
+	assert_dma_stopped();
+
+	stm32_i2c_emul_target.nack_at = NO_FAULT;
+	zassert_ok(xfer(32, true));
+	zassert_mem_equal(stm32_i2c_emul_target.mem, buf, 32);
+}
+
+ZTEST(tt_stm32_i2c_poll, test_stall_timeout)
+{
+	const int stall_at = 20;
+	int64_t start = k_uptime_get();
+
+	stm32_i2c_emul_target.stall_at = stall_at;
+	zassert_equal(xfer(64, false), -ETIMEDOUT);
+
+	/* The timeout runs from the last byte that was moved */
+	zassert_true(k_uptime_get() - start >= TIMEOUT_MS);
+	zassert_equal(stm32_i2c_emul_pos(), stall_at);
+	assert_dma_stopped();
+
+	/* The controller recovers once the target releases the bus */
+	stm32_i2c_emul_target.stall_at = NO_FAULT;
+	fill(buf, 64, 0x33);
+	zassert_ok(xfer(64, true));
+	zassert_mem_equal(stm32_i2c_emul_target.mem, buf, 64);
+}
+
+static void set_abort(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	abort_flag = 1;
+}
+
+static K_TIMER_DEFINE(abort_timer, set_abort, NULL);
+
+ZTEST(tt_stm32_i2c_poll, test_abort)
+{
+	int64_t start = k_uptime_get();
+
+	stm32_i2c_emul_target.stall_at = 20;
+	k_timer_start(&abort_timer, K_MSEC(2), K_NO_WAIT);
+	zassert_equal(xfer(64, false), -ECANCELED);
+
+	zassert_true(k_uptime_get() - start < TIMEOUT_MS);
+	assert_dma_stopped();
+}
+
+#ifdef CONFIG_TT_I2C_STM32_DMA
+static size_t num_spins;
+
+static void spin_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_busy_wait(10);
+		num_spins++;
+	}
+}
+
+K_THREAD_STACK_DEFINE(spin_stack, 1024);
+static struct k_thread spin;
+
+ZTEST(tt_stm32_i2c_poll, test_cpu_free)
+{
+	const size_t len = 200;
+	size_t spins;
+
+	/* A lower priority thread only runs while the transfer leaves the CPU idle */
+	k_thread_create(&spin, spin_stack, K_THREAD_STACK_SIZEOF(spin_stack), spin_thread, NULL,
+			NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+	num_spins = 0;
+	zassert_ok(xfer(len, false));
+	spins = num_spins;
+	k_thread_abort(&spin);
+
+	/* Most of the time the bus takes for the message went to the other thread */
+	zassert_true(spins * 10 >= len * STM32_I2C_EMUL_BYTE_US / 2, "%zu spins", spins);
+	zassert_equal(dma_starts(), 1);
+}
+
+ZTEST(tt_stm32_i2c_poll, test_slow_target)
+{
+	const size_t len = 16;
+
+	/* A target that stretches every byte keeps the transfer going past the timeout */
+	stm32_i2c_emul_target.byte_us = 2 * USEC_PER_MSEC;
+	fill(stm32_i2c_emul_target.mem, len, 0x44);
+
+	zassert_ok(xfer(len, false));
+	zassert_true(len * stm32_i2c_emul_target.byte_us > TIMEOUT_MS * USEC_PER_MSEC);
+	zassert_mem_equal(buf, stm32_i2c_emul_target.mem, len);
+}
+#endif /* CONFIG_TT_I2C_STM32_DMA */
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	stm32_i2c_emul_reset(TARGET_ADDR);
+#ifdef CONFIG_TT_I2C_STM32_DMA
+	stm32_i2c_emul_dma_starts = 0;
+	stm32_i2c_emul_dma_aborts = 0;
+#endif
+
+	memset(buf, 0, sizeof(buf));
+	abort_flag = 0;
+}
+
+ZTEST_SUITE(tt_stm32_i2c_poll, NULL, NULL, before, NULL, NULL);
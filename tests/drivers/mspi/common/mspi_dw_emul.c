@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/devicetree.h>
+#include <zephyr/sys/util.h>
+
+#include "irq_ctrl.h"
+
+#include "mspi_dw_emul.h"
+
+#define EMUL_NODE     DT_NODELABEL(mspi0)
+#define EMUL_IRQ      DT_IRQN(EMUL_NODE)
+#define TX_FIFO_DEPTH DT_PROP(EMUL_NODE, fifo_depth)
+#define RX_FIFO_DEPTH DT_PROP(EMUL_NODE, rx_fifo_depth)
+
+#define REG_CTRLR0     0x00
+#define REG_CTRLR1     0x04
+#define REG_SSIENR     0x08
+#define REG_SER        0x10
+#define REG_TXFTLR     0x18
+#define REG_RXFTLR     0x1c
+#define REG_TXFLR      0x20
+#define REG_RXFLR      0x24
+#define REG_IMR        0x2c
+#define REG_ISR        0x30
+#define REG_DMACR      0x4c
+#define REG_DMATDLR    0x50
+#define REG_DMARDLR    0x54
+#define REG_DR         MSPI_DW_EMUL_REG_DR
+#define REG_SPI_CTRLR0 0xf4
+
+#define CTRLR0_DFS32(v) FIELD_GET(GENMASK(20, 16), v)
+#define CTRLR0_TMOD(v)  FIELD_GET(GENMASK(9, 8), v)
+#define CTRLR1_NDF(v)   FIELD_GET(GENMASK(15, 0), v)
+#define TXFTLR_TFT(v)   FIELD_GET(GENMASK(7, 0), v)
+#define TMOD_TX_RX      0
+#define TMOD_RX         2
+
+#define ISR_TXEIS BIT(0)
+#define ISR_RXFIS BIT(4)
+
+#define DMACR_RDMAE BIT(0)
+#define DMACR_TDMAE BIT(1)
+
+size_t mspi_dw_emul_num_packets;
+bool mspi_dw_emul_stalled;
+
+/* Updated by mspi_dw_emul_dma.c, and left at zero without it */
+size_t mspi_dw_emul_dma_starts;
+size_t mspi_dw_emul_dma_aborts;
+int mspi_dw_emul_dma_error;
+
+static const struct mspi_dw_emul_target *target;
+
+static uint32_t ctrlr0;
+static uint32_t ctrlr1;
+static uint32_t spi_ctrlr0;
+static uint32_t ssienr;
+static uint32_t ser;
+static uint32_t txftlr;
+static uint32_t rxftlr;
+static uint32_t imr;
+static uint32_t dmacr;
+static uint32_t dmatdlr;
+static uint32_t dmardlr;
+
+static uint32_t tx_fifo[TX_FIFO_DEPTH];
+static size_t tx_head;
+static size_t tx_count;
+
+static uint32_t rx_fifo[RX_FIFO_DEPTH];
+static size_t rx_head;
+static size_t rx_count;
+static uint32_t rx_pending;
+
+void mspi_dw_emul_set_target(const struct mspi_dw_emul_target *t)
+{
+	target = t;
+}
+
+uint32_t mspi_dw_emul_ctrlr0(void)
+{
+	return ctrlr0;
+}
+
+uint32_t mspi_dw_emul_spi_ctrlr0(void)
+{
+	return spi_ctrlr0;
+}
+
+size_t mspi_dw_emul_frame_bytes(void)
+{
+	return (CTRLR0_DFS32(ctrlr0) + 1) / 8;
+}
+
+static uint32_t idle_frame(void)
+{
+	return (uint32_t)BIT64_MASK(8 * mspi_dw_emul_frame_bytes());
+}
+
+static bool shifting(void)
+{
+	return ssienr && ser && !mspi_dw_emul_stalled;
+}
+
+static void push_rx_frame(uint32_t frame)
+{
+	rx_fifo[(rx_head + rx_count) % RX_FIFO_DEPTH] = frame;
+	rx_count++;
+}
+
+static void fill_rx_fifo(void)
+{
+	while (rx_pending > 0 && rx_count < RX_FIFO_DEPTH && shifting()) {
+		uint32_t frame = 0;
+
+		for (size_t i = 0; i < mspi_dw_emul_frame_bytes(); i++) {
+			frame = (frame << 8) | ((target && target->rx) ? target->rx() : 0xff);
+		}
+		push_rx_frame(frame);
+		rx_pending--;
+	}
+}
+
+/* In the TX/RX mode, a frame is shifted in for every frame shifted out */
+static void drain_tx_fifo(void)
+{
+	while (tx_count > 0 && shifting()) {
+		uint32_t frame = tx_fifo[tx_head];
+		uint32_t rx;
+
+		tx_head = (tx_head + 1) % TX_FIFO_DEPTH;
+		tx_count--;
+
+		rx = (target && target->tx) ? target->tx(frame) : idle_frame();
+		if (CTRLR0_TMOD(ctrlr0) == TMOD_TX_RX && rx_count < RX_FIFO_DEPTH) {
+			push_rx_frame(rx);
+		}
+	}
+}
+
+static void flush_fifos(void)
+{
+	tx_head = 0;
+	tx_count = 0;
+	rx_head = 0;
+	rx_count = 0;
+	rx_pending = 0;
+}
+
+static uint32_t raw_isr(void)
+{
+	uint32_t status = 0;
+
+	if (!shifting()) {
+		return 0;
+	}
+
+	if (tx_count <= TXFTLR_TFT(txftlr)) {
+		status |= ISR_TXEIS;
+	}
+	if (rx_count > rxftlr) {
+		status |= ISR_RXFIS;
+	}
+
+	return status;
+}
+
+bool mspi_dw_emul_dma_request(bool tx)
+{
+	if (!ssienr || mspi_dw_emul_stalled) {
+		return false;
+	}
+
+	if (tx) {
+		return (dmacr & DMACR_TDMAE) && tx_count <= dmatdlr && tx_count < TX_FIFO_DEPTH;
+	}
+
+	return (dmacr & DMACR_RDMAE) && rx_count > dmardlr;
+}
+
+uintptr_t mspi_dw_emul_dr_addr(void)
+{
+	return DT_REG_ADDR(EMUL_NODE) + REG_DR;
+}
+
+/* The interrupt is level-triggered, so it follows the masked status after every access */
+static void update_irq(void)
+{
+	if (raw_isr() & imr) {
+		hw_irq_ctrl_raise_im_from_sw(EMUL_IRQ);
+	} else {
+		hw_irq_ctrl_clear_irq(EMUL_IRQ);
+	}
+
+#if defined(CONFIG_MSPI_DW_DMA)
+	mspi_dw_emul_dma_update();
+#endif
+}
+
+uint32_t mspi_dw_emul_reg_read(const struct device *dev, uint32_t off)
+{
+	uint32_t val = 0;
+
+	ARG_UNUSED(dev);
+
+	switch (off) {
+	case REG_TXFTLR:
+		val = txftlr;
+		break;
+	case REG_RXFTLR:
+		val = rxftlr;
+		break;
+	case REG_TXFLR:
+		val = tx_count;
+		break;
+	case REG_RXFLR:
+		val = rx_count;
+		break;
+	case REG_ISR:
+		val = raw_isr() & imr;
+		break;
+	case REG_DR:
+		if (rx_count > 0) {
+			val = rx_fifo[rx_head];
+			rx_head = (rx_head + 1) % RX_FIFO_DEPTH;
+			rx_count--;
+			fill_rx_fifo();
+		}
+		break;
+	default:
+		/* SR (never busy), ICR */
+		break;
+	}
+
+	update_irq();
+
+	return val;
+}
+
+void mspi_dw_emul_reg_write(const struct device *dev, uint32_t off, uint32_t data)
+{
+	ARG_UNUSED(dev);
+
+	switch (off) {
+	case REG_CTRLR0:
+		ctrlr0 = data;
+		break;
+	case REG_CTRLR1:
+		ctrlr1 = data;
+		break;
+	case REG_SPI_CTRLR0:
+		spi_ctrlr0 = data;
+		break;
+	case REG_SSIENR:
+		if ((data & BIT(0)) && !ssienr) {
+			flush_fifos();
+			if (target && target->start) {
+				target->start();
+			}
+		} else if (!(data & BIT(0)) && ssienr) {
+			if (target && target->end) {
+				target->end();
+			}
+			/* disabling the controller flushes the FIFOs */
+			flush_fifos();
+		}
+		ssienr = data & BIT(0);
+		break;
+	case REG_SER:
+		ser = data;
+		if (ser && ssienr) {
+			mspi_dw_emul_num_packets++;
+			if (CTRLR0_TMOD(ctrlr0) == TMOD_RX) {
+				rx_pending = CTRLR1_NDF(ctrlr1) + 1;
+				fill_rx_fifo();
+			}
+		}
+		drain_tx_fifo();
+		break;
+	case REG_TXFTLR:
+		txftlr = data;
+		break;
+	case REG_RXFTLR:
+		rxftlr = data;
+		break;
+	case REG_IMR:
+		imr = data;
+		break;
+	case REG_DMACR:
+		dmacr = data;
+		break;
+	case REG_DMATDLR:
+		dmatdlr = data;
+		break;
+	case REG_DMARDLR:
+		dmardlr = data;
+		break;
+	case REG_DR:
+		if (ssienr && tx_count < TX_FIFO_DEPTH) {
+			tx_fifo[(tx_head + tx_count) % TX_FIFO_DEPTH] = data;
+			tx_count++;
+			drain_tx_fifo();
+		}
+		break;
+	default:
+		/* BAUDR and timing registers */
+		break;
+	}
+
+	/* may run the interrupt handler right away, so this must be done last */
+	update_irq();
+}
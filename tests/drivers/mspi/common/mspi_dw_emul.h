@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef MSPI_DW_EMUL_H_
+#define MSPI_DW_EMUL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct device;
+
+/*
+ * Emulation of the DesignWare SSI controller registers used by the mspi_dw driver with
+ * CONFIG_MSPI_DW_EMUL. It is shared by the tests of the controller driver and of the drivers of
+ * devices behind it, which describe the device on the bus with a mspi_dw_emul_target.
+ *
+ * TX frames wait in the TX FIFO until a slave is selected, and are then shifted out immediately.
+ * Frames to be received are made available in the RX FIFO as fast as the driver reads them.
+ */
+
+/* Register accesses of the driver, see drivers/mspi/mspi_dw.h */
+uint32_t mspi_dw_emul_reg_read(const struct device *dev, uint32_t off);
+void mspi_dw_emul_reg_write(const struct device *dev, uint32_t off, uint32_t data);
+
+struct mspi_dw_emul_target {
+	/* The controller is enabled, which starts a transaction */
+	void (*start)(void);
+	/* The controller is disabled, which ends the transaction */
+	void (*end)(void);
+	/* A frame is shifted out; returns the frame shifted in at the same time */
+	uint32_t (*tx)(uint32_t frame);
+	/* Returns the next byte sent by the device in the receive only mode */
+	uint8_t (*rx)(void);
+};
+
+/* Set the device on the bus, NULL leaves the bus idle with all ones shifted in */
+void mspi_dw_emul_set_target(const struct mspi_dw_emul_target *target);
+
+/* Register fields of the current transaction, for targets that decode them */
+uint32_t mspi_dw_emul_ctrlr0(void);
+uint32_t mspi_dw_emul_spi_ctrlr0(void);
+size_t mspi_dw_emul_frame_bytes(void);
+
+/* Number of packets started, that is of writes to SER with the controller enabled */
+extern size_t mspi_dw_emul_num_packets;
+
+/* When set, started packets never make progress and no DMA requests are made */
+extern bool mspi_dw_emul_stalled;
+
+/*
+ * DMA handshake, for the DMA controller emulation in mspi_dw_emul_dma.c. Requests follow DMACR
+ * and the FIFO levels against DMATDLR and DMARDLR. Transfers have to use the bus address of the
+ * DR register, and move the data with accesses to MSPI_DW_EMUL_REG_DR.
+ */
+#define MSPI_DW_EMUL_REG_DR 0x60
+
+bool mspi_dw_emul_dma_request(bool tx);
+uintptr_t mspi_dw_emul_dr_addr(void);
+
+/* Called after every register access, to serve DMA requests */
+void mspi_dw_emul_dma_update(void);
+
+/* Number of DMA transfers started, and of those stopped before they completed */
+extern size_t mspi_dw_emul_dma_starts;
+extern size_t mspi_dw_emul_dma_aborts;
+
+/* When nonzero, the next DMA transfer fails with this status at its first request */
+extern int mspi_dw_emul_dma_error;
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Emulation of a DMA controller serving the emulated DesignWare SSI controller. Started channels
+ * move data between memory and the DR register from their own interrupt, for as long as the SSI
+ * controller requests it, and report completion from there like a real DMA controller would.
+ */
+
+#define DT_DRV_COMPAT vnd_mspi_dw_emul_dma
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/irq.h>
+
+#include "irq_ctrl.h"
+
+#include "mspi_dw_emul.h"
+
+#define EMUL_IRQ     DT_INST_IRQN(0)
+#define NUM_CHANNELS DT_INST_PROP(0, dma_channels)
+
+struct emul_dma_channel {
+	struct dma_config cfg;
+	struct dma_block_config block;
+	uint32_t pos;
+	bool active;
+};
+
+static struct emul_dma_channel channels[NUM_CHANNELS];
+
+static bool channel_tx(const struct emul_dma_channel *ch)
+{
+	return ch->cfg.channel_direction == MEMORY_TO_PERIPHERAL;
+}
+
+static bool channel_pending(const struct emul_dma_channel *ch)
+{
+	return ch->active && mspi_dw_emul_dma_request(channel_tx(ch));
+}
+
+void mspi_dw_emul_dma_update(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(channels); i++) {
+		if (channel_pending(&channels[i])) {
+			hw_irq_ctrl_raise_im_from_sw(EMUL_IRQ);
+			return;
+		}
+	}
+}
+
+static void emul_dma_isr(const void *arg)
+{
+	const struct device *dev = arg;
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(channels); i++) {
+		struct emul_dma_channel *ch = &channels[i];
+		bool tx = channel_tx(ch);
+		int status = DMA_STATUS_COMPLETE;
+
+		if (!channel_pending(ch)) {
+			continue;
+		}
+
+		/* An injected error hits once the controller requests data, like a bus error */
+		if (mspi_dw_emul_dma_error != 0) {
+			status = mspi_dw_emul_dma_error;
+			mspi_dw_emul_dma_error = 0;
+		} else {
+			while (ch->pos < ch->block.block_size && mspi_dw_emul_dma_request(tx)) {
+				if (tx) {
+					const uint8_t *src = (const uint8_t *)ch->block.source_address;
+
+					mspi_dw_emul_reg_write(NULL, MSPI_DW_EMUL_REG_DR, src[ch->pos]);
+				} else {
+					uint8_t *dst = (uint8_t *)ch->block.dest_address;
+
+					dst[ch->pos] = mspi_dw_emul_reg_read(NULL, MSPI_DW_EMUL_REG_DR);
+				}
+				ch->pos++;
+			}
+
+			if (ch->pos < ch->block.block_size) {
+				continue;
+			}
+		}
+
+		/* The callback may configure and start the channel again */
+		ch->active = false;
+		if (ch->cfg.dma_callback) {
+			ch->cfg.dma_callback(dev, ch->cfg.user_data, i, status);
+		}
+	}
+}
+
+static int emul_dma_config(const struct device *dev, uint32_t channel, struct dma_config *cfg)
+{
+	struct emul_dma_channel *ch;
+	uintptr_t periph_addr;
+
+	ARG_UNUSED(dev);
+
+	if (channel >= ARRAY_SIZE(channels) || cfg->block_count != 1 ||
+	    cfg->source_data_size != 1 || cfg->dest_data_size != 1) {
+		return -EINVAL;
+	}
+
+	ch = &channels[channel];
+	if (ch->active) {
+		return -EBUSY;
+	}
+
+	switch (cfg->channel_direction) {
+	case MEMORY_TO_PERIPHERAL:
+		periph_addr = cfg->head_block->dest_address;
+		break;
+	case PERIPHERAL_TO_MEMORY:
+		periph_addr = cfg->head_block->source_address;
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	if (periph_addr != mspi_dw_emul_dr_addr()) {
+		return -EINVAL;
+	}
+
+	ch->cfg = *cfg;
+	ch->block = *cfg->head_block;
+	ch->cfg.head_block = &ch->block;
+
+	return 0;
+}
+
+static int emul_dma_start(const struct device *dev, uint32_t channel)
+{
+	ARG_UNUSED(dev);
+
+	if (channel >= ARRAY_SIZE(channels)) {
+		return -EINVAL;
+	}
+
+	channels[channel].pos = 0;
+	channels[channel].active = true;
+	mspi_dw_emul_dma_starts++;
+	mspi_dw_emul_dma_update();
+
+	return 0;
+}
+
+static int emul_dma_stop(const struct device *dev, uint32_t channel)
+{
+	ARG_UNUSED(dev);
+
+	if (channel >= ARRAY_SIZE(channels)) {
+		return -EINVAL;
+	}
+
+	if (channels[channel].active) {
+		channels[channel].active = false;
+		mspi_dw_emul_dma_aborts++;
+	}
+
+	return 0;
+}
+
+static DEVICE_API(dma, emul_dma_api) = {
+	.config = emul_dma_config,
+	.start = emul_dma_start,
+	.stop = emul_dma_stop,
+};
+
+static int emul_dma_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	IRQ_CONNECT(EMUL_IRQ, DT_INST_IRQ(0, priority), emul_dma_isr, DEVICE_DT_INST_GET(0), 0);
+	irq_enable(EMUL_IRQ);
+
+	return 0;
+}
+
+DEVICE_DT_INST_DEFINE(0, emul_dma_init, NULL, NULL, NULL, PRE_KERNEL_1, CONFIG_DMA_INIT_PRIORITY,
+		      &emul_dma_api);
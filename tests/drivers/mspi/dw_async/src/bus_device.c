@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The device behind the emulated controller, which logs the bytes it receives and sends back a
+ * fixed stream of bytes in the receive only mode.
+ */
+
+#include <zephyr/sys/util.h>
+
+#include "bus_device.h"
+
+uint8_t bus_tx_log[BUS_TX_LOG_SIZE];
+size_t bus_tx_len;
+
+static const uint8_t *rx_data;
+static size_t rx_len;
+static size_t rx_pos;
+
+static uint8_t device_rx(void)
+{
+	return (rx_pos < rx_len) ? rx_data[rx_pos++] : 0xff;
+}
+
+static uint32_t device_tx(uint32_t frame)
+{
+	for (size_t i = mspi_dw_emul_frame_bytes(); i > 0; i--) {
+		if (bus_tx_len < sizeof(bus_tx_log)) {
+			bus_tx_log[bus_tx_len++] = frame >> (8 * (i - 1));
+		}
+	}
+
+	return (uint32_t)BIT64_MASK(8 * mspi_dw_emul_frame_bytes());
+}
+
+static const struct mspi_dw_emul_target device = {
+	.tx = device_tx,
+	.rx = device_rx,
+};
+
+void bus_device_reset(const uint8_t *data, size_t len)
+{
+	rx_data = data;
+	rx_len = len;
+	rx_pos = 0;
+	bus_tx_len = 0;
+
+	mspi_dw_emul_set_target(&device);
+	mspi_dw_emul_num_packets = 0;
+	mspi_dw_emul_stalled = false;
+	mspi_dw_emul_dma_starts = 0;
+	mspi_dw_emul_dma_aborts = 0;
+	mspi_dw_emul_dma_error = 0;
+}
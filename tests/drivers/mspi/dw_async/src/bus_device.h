@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BUS_DEVICE_H_
+#define BUS_DEVICE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mspi_dw_emul.h"
+
+#define BUS_TX_LOG_SIZE 1024
+
+/* Bytes shifted out by the controller, in bus order */
+extern uint8_t bus_tx_log[BUS_TX_LOG_SIZE];
+extern size_t bus_tx_len;
+
+/*
+ * Clear the logs and the state of the controller emulation, and set the bytes the device sends
+ * back
+ */
+void bus_device_reset(const uint8_t *rx_data, size_t rx_len);
+
+#endif
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/mspi.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "bus_device.h"
+
+#define NUM_PACKETS 4
+#define RX_SIZE     (10 + 200)
+#define TIMEOUT_MS  10
+
+static const struct device *const controller = DEVICE_DT_GET(DT_NODELABEL(mspi0));
+static const struct mspi_dev_id dev_id = {
+	.dev_idx = 0,
+};
+
+static const uint8_t tx_data0[16] = "sixteen bytes!!";
+static const uint8_t tx_data2[3] = {0xa5, 0x5a, 0xc3};
+static uint8_t rx_data[RX_SIZE];
+static uint8_t rx_buf1[10];
+static uint8_t rx_buf3[200];
+
+/* Mixed directions and frame sizes; 200 bytes take several RX FIFO fills */
+static struct mspi_xfer_packet packets[NUM_PACKETS] = {
+	{
+		.dir = MSPI_TX,
+		.cb_mask = MSPI_BUS_XFER_COMPLETE_CB,
+		.num_bytes = sizeof(tx_data0),
+		.data_buf = (uint8_t *)tx_data0,
+	},
+	{
+		.dir = MSPI_RX,
+		.cb_mask = MSPI_BUS_XFER_COMPLETE_CB,
+		.num_bytes = sizeof(rx_buf1),
+		.data_buf = rx_buf1,
+	},
+	{
+		/* not reported */
+		.dir = MSPI_TX,
+		.cb_mask = MSPI_BUS_NO_CB,
+		.num_bytes = sizeof(tx_data2),
+		.data_buf = (uint8_t *)tx_data2,
+	},
+	{
+		.dir = MSPI_RX,
+		.cb_mask = MSPI_BUS_XFER_COMPLETE_CB,
+		.num_bytes = sizeof(rx_buf3),
+		.data_buf = rx_buf3,
+	},
+};
+
+#if defined(CONFIG_MSPI_DW_DMA)
+/* Only the 200-byte packet is long enough to be moved by DMA */
+#define NUM_DMA_PACKETS (sizeof(rx_buf3) >= CONFIG_MSPI_DW_DMA_MIN_BYTES ? 1 : 0)
+
+static uint8_t dma_tx_data[CONFIG_MSPI_DW_DMA_MIN_BYTES + 36];
+
+/* Both directions over DMA, in 1-byte frames */
+static struct mspi_xfer_packet dma_packets[] = {
+	{
+		.dir = MSPI_TX,
+		.cb_mask = MSPI_BUS_XFER_COMPLETE_CB,
+		.num_bytes = sizeof(dma_tx_data),
+		.data_buf = dma_tx_data,
+	},
+	{
+		.dir = MSPI_RX,
+		.cb_mask = MSPI_BUS_XFER_COMPLETE_CB,
+		.num_bytes = sizeof(rx_buf3),
+		.data_buf = rx_buf3,
+	},
+};
+#else
+#define NUM_DMA_PACKETS 0
+#endif
+
+static struct mspi_callback_context cb_ctx;
+static K_SEM_DEFINE(xfer_done, 0, 1);
+
+static struct {
+	uint32_t packet_idx[NUM_PACKETS];
+	int status[NUM_PACKETS];
+	const struct mspi_xfer_packet *packet[NUM_PACKETS];
+	size_t count;
+	size_t last_idx;
+	bool bad_ctx;
+} events;
+
+static void xfer_complete_cb(struct mspi_callback_context *ctx, ...)
+{
+	const struct mspi_event_data *data = &ctx->mspi_evt.evt_data;
+
+	if (ctx != &cb_ctx || ctx->mspi_evt.evt_type != MSPI_BUS_XFER_COMPLETE ||
+	    data->controller != controller || data->dev_id != &dev_id ||
+	    events.count >= NUM_PACKETS) {
+		events.bad_ctx = true;
+		k_sem_give(&xfer_done);
+		return;
+	}
+
+	events.packet_idx[events.count] = data->packet_idx;
+	events.status[events.count] = data->status;
+	events.packet[events.count] = data->packet;
+	events.count++;
+
+	if (data->packet_idx == events.last_idx || data->status != 0) {
+		k_sem_give(&xfer_done);
+	}
+}
+
+static struct mspi_xfer make_xfer(bool async, uint32_t num_packet)
+{
+	return (struct mspi_xfer){
+		.async = async,
+		.xfer_mode = MSPI_PIO,
+		.packets = packets,
+		.num_packet = num_packet,
+		.timeout = TIMEOUT_MS,
+	};
+}
+
+static void reset_test(void)
+{
+	for (size_t i = 0; i < sizeof(rx_data); i++) {
+		rx_data[i] = 0x3c ^ (i * 7);
+	}
+
+	memset(rx_buf1, 0, sizeof(rx_buf1));
+	memset(rx_buf3, 0, sizeof(rx_buf3));
+	memset(&events, 0, sizeof(events));
+	events.last_idx = NUM_PACKETS - 1;
+	k_sem_reset(&xfer_done);
+	bus_device_reset(rx_data, sizeof(rx_data));
+}
+
+static void check_bus_traffic(void)
+{
+	/* TX packets went out in order, and RX packets got the device data in order */
+	zassert_equal(sizeof(tx_data0) + sizeof(tx_data2), bus_tx_len);
+	zassert_mem_equal(tx_data0, bus_tx_log, sizeof(tx_data0));
+	zassert_mem_equal(tx_data2, &bus_tx_log[sizeof(tx_data0)], sizeof(tx_data2));
+	zassert_mem_equal(rx_data, rx_buf1, sizeof(rx_buf1));
+	zassert_mem_equal(&rx_data[sizeof(rx_buf1)], rx_buf3, sizeof(rx_buf3));
+	zassert_equal(NUM_DMA_PACKETS, mspi_dw_emul_dma_starts);
+	zassert_equal(0, mspi_dw_emul_dma_aborts);
+}
+
+ZTEST(mspi_dw_async, test_sync_multi_packet)
+{
+	struct mspi_xfer xfer = make_xfer(false, NUM_PACKETS);
+
+	zassert_ok(mspi_transceive(controller, &dev_id, &xfer));
+	zassert_equal(NUM_PACKETS, mspi_dw_emul_num_packets);
+	check_bus_traffic();
+
+	/* no callbacks for synchronous transfers */
+	zassert_equal(0, events.count);
+}
+
+ZTEST(mspi_dw_async, test_async_multi_packet)
+{
+	static const uint32_t expected_idx[] = {0, 1, 3};
+	struct mspi_xfer xfer = make_xfer(true, NUM_PACKETS);
+
+	zassert_ok(mspi_transceive(controller, &dev_id, &xfer));
+	zassert_ok(k_sem_take(&xfer_done, K_MSEC(100 * TIMEOUT_MS)));
+
+	zassert_false(events.bad_ctx);
+	zassert_equal(ARRAY_SIZE(expected_idx), events.count);
+	for (size_t i = 0; i < ARRAY_SIZE(expected_idx); i++) {
+		zassert_equal(expected_idx[i], events.packet_idx[i], "event %zu", i);
+		zassert_equal(&packets[expected_idx[i]], events.packet[i], "event %zu", i);
+		zassert_ok(events.status[i], "event %zu", i);
+	}
+
+	zassert_equal(NUM_PACKETS, mspi_dw_emul_num_packets);
+	check_bus_traffic();
+
+	/* the controller is released once the transfer is done */
+	xfer = make_xfer(false, 1);
+	zassert_ok(mspi_transceive(controller, &dev_id, &xfer));
+}
+
+ZTEST(mspi_dw_async, test_async_timeout)
+{
+	struct mspi_xfer xfer = make_xfer(true, NUM_PACKETS);
+
+	mspi_dw_emul_stalled = true;
+
+	zassert_ok(mspi_transceive(controller, &dev_id, &xfer));
+	zassert_ok(k_sem_take(&xfer_done, K_MSEC(100 * TIMEOUT_MS)));
+
+	/* the stalled packet is reported, and the rest are dropped */
+	zassert_false(events.bad_ctx);
+	zassert_equal(1, events.count);
+	zassert_equal(0, events.packet_idx[0]);
+	zassert_equal(-ETIMEDOUT, events.status[0]);
+	zassert_equal(1, mspi_dw_emul_num_packets);
+
+	/* the controller recovers for the next transfer */
+	reset_test();
+	xfer = make_xfer(true, NUM_PACKETS);
+	zassert_ok(mspi_transceive(controller, &dev_id, &xfer));
+	zassert_ok(k_sem_take(&xfer_done, K_MSEC(100 * TIMEOUT_MS)));
+	zassert_equal(3, events.count);
+	check_bus_traffic();
+}
+
+#if defined(CONFIG_MSPI_DW_DMA)
+static struct mspi_xfer make_dma_xfer(const struct mspi_xfer_packet *first, uint32_t num_packet)
+{
+	struct mspi_xfer xfer = make_xfer(true, num_packet);
+
+	xfer.packets = first;
+	events.last_idx = num_packet - 1;
+
+	return xfer;
+}
+
+static void check_dma_traffic(void)
+{
+	zassert_equal(sizeof(dma_tx_data), bus_tx_len);
+	zassert_mem_equal(dma_tx_data, bus_tx_log, sizeof(dma_tx_data));
+	zassert_mem_equal(rx_data, rx_buf3, sizeof(rx_buf3));
+}
+
+ZTEST(mspi_dw_async, test_dma)
+{
+	struct mspi_xfer xfer = make_dma_xfer(dma_packets, ARRAY_SIZE(dma_packets));
+
+	zassert_ok(mspi_transceive(controller, &dev_id, &xfer));
+	zassert_ok(k_sem_take(&xfer_done, K_MSEC(100 * TIMEOUT_MS)));
+
+	zassert_false(events.bad_ctx);
+	zassert_equal(ARRAY_SIZE(dma_packets), events.count);
+	for (size_t i = 0; i < ARRAY_SIZE(dma_packets); i++) {
+		zassert_equal(i, events.packet_idx[i], "event %zu", i);
+		zassert_ok(events.status[i], "event %zu", i);
+	}
+
+	zassert_equal(ARRAY_SIZE(dma_packets), mspi_dw_emul_dma_starts);
+	zassert_equal(0, mspi_dw_emul_dma_aborts);
+	check_dma_traffic();
+}
+
+ZTEST(mspi_dw_async, test_dma_error)
+{
+	/* RX only, as the DMA request and so the error comes after the packet is started */
+	struct mspi_xfer xfer = make_dma_xfer(&dma_packets[1], 1);
+
+	mspi_dw_emul_dma_error = -ENXIO;
+
+	zassert_ok(mspi_transceive(controller, &dev_id, &xfer));
+	zassert_ok(k_sem_take(&xfer_done, K_MSEC(100 * TIMEOUT_MS)));
+
+	zassert_false(events.bad_ctx);
+	zassert_equal(1, events.count);
+	zassert_equal(-EIO, events.status[0]);
+	zassert_equal(1, mspi_dw_emul_dma_starts);
+
+	/* the failed channel can be used again */
+	reset_test();
+	xfer = make_dma_xfer(dma_packets, ARRAY_SIZE(dma_packets));
+	zassert_ok(mspi_transceive(controller, &dev_id, &xfer));
+	zassert_ok(k_sem_take(&xfer_done, K_MSEC(100 * TIMEOUT_MS)));
+	zassert_equal(ARRAY_SIZE(dma_packets), events.count);
+	check_dma_traffic();
+}
+
+ZTEST(mspi_dw_async, test_dma_timeout)
+{
+	struct mspi_xfer xfer = make_dma_xfer(dma_packets, ARRAY_SIZE(dma_packets));
+
+	mspi_dw_emul_stalled = true;
+
+	zassert_ok(mspi_transceive(controller, &dev_id, &xfer));
+	zassert_ok(k_sem_take(&xfer_done, K_MSEC(100 * TIMEOUT_MS)));
+
+	/* the DMA transfer of the stalled packet is stopped */
+	zassert_false(events.bad_ctx);
+	zassert_equal(1, events.count);
+	zassert_equal(0, events.packet_idx[0]);
+	zassert_equal(-ETIMEDOUT, events.status[0]);
+	zassert_equal(1, mspi_dw_emul_dma_starts);
+	zassert_equal(1, mspi_dw_emul_dma_aborts);
+
+	reset_test();
+	xfer = make_dma_xfer(dma_packets, ARRAY_SIZE(dma_packets));
+	zassert_ok(mspi_transceive(controller, &dev_id, &xfer));
+	zassert_ok(k_sem_take(&xfer_done, K_MSEC(100 * TIMEOUT_MS)));
+	zassert_equal(ARRAY_SIZE(dma_packets), events.count);
+	check_dma_traffic();
+}
+#endif
+
+static void *mspi_dw_async_setup(void)
+{
+	const struct mspi_dev_cfg cfg = {
+		.io_mode = MSPI_IO_MODE_SINGLE,
+		.cpp = MSPI_CPP_MODE_0,
+		.freq = MHZ(25),
+		.data_rate = MSPI_DATA_RATE_SINGLE,
+	};
+
+#if defined(CONFIG_MSPI_DW_DMA)
+	for (size_t i = 0; i < sizeof(dma_tx_data); i++) {
+		dma_tx_data[i] = 0xa7 ^ (i * 3);
+	}
+#endif
+
+	zassert_true(device_is_ready(controller));
+	zassert_ok(mspi_dev_config(controller, &dev_id,
+				   MSPI_DEVICE_CONFIG_IO_MODE | MSPI_DEVICE_CONFIG_CPP |
+					   MSPI_DEVICE_CONFIG_FREQUENCY |
+					   MSPI_DEVICE_CONFIG_DATA_RATE,
+				   &cfg));
+	zassert_ok(mspi_register_callback(controller, &dev_id, MSPI_BUS_XFER_COMPLETE,
+					  xfer_complete_cb, &cb_ctx));
+
+	return NULL;
+}
+
+static void mspi_dw_async_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	reset_test();
+}
+
+ZTEST_SUITE(mspi_dw_async, NULL, mspi_dw_async_setup, mspi_dw_async_before, NULL, NULL);
@@ -32,4 +32,95 @@ ZTEST(msgqueue, test_msgqueue_register_handler)
 	zassert_equal(rsp.data[1], 0x73737373);
 }
 
+static msgqueue_token_t slow_token;
+
+static void slow_work_handler(struct k_work *work)
+{
+	struct response rsp = {0};
+
+	rsp.data[1] = 0x74747474;
+	zassert_ok(msgqueue_complete(slow_token, &rsp, 0));
+}
+
+static K_WORK_DELAYABLE_DEFINE(slow_work, slow_work_handler);
+
+static int msgqueue_handler_74(uint32_t msg_code, const struct request *req,
+			       struct response *rsp, msgqueue_token_t token)
+{
+	slow_token = token;
+	k_work_schedule(&slow_work, K_MSEC(50));
+	return -EINPROGRESS;
+}
+
+ZTEST(msgqueue, test_msgqueue_async_handler)
+{
+	struct request req = {0};
+	struct response rsp = {0};
+
+	msgqueue_register_handler(0x73, msgqueue_handler_73);
+	msgqueue_register_async_handler(0x74, msgqueue_handler_74);
+
+	/* slow message followed by a fast one on queue 0, fast message on queue 1 */
+	req.data[0] = 0x74;
+	msgqueue_request_push(0, &req);
+	req.data[0] = 0x73;
+	msgqueue_request_push(0, &req);
+	req.data[0] = 0x173;
+	msgqueue_request_push(1, &req);
+	process_message_queues();
+
+	/* queue 1 is answered while queue 0 is still waiting on the slow message */
+	zassert_ok(msgqueue_response_pop(1, &rsp));
+	zassert_equal(rsp.data[1], 0x173);
+	zassert_not_ok(msgqueue_response_pop(0, &rsp));
+
+	k_msleep(100);
+	process_message_queues();
+
+	/* queue 0 responses arrive in request order */
+	zassert_ok(msgqueue_response_pop(0, &rsp));
+	zassert_equal(rsp.data[1], 0x74747474);
+	zassert_ok(msgqueue_response_pop(0, &rsp));
+	zassert_equal(rsp.data[1], 0x73);
+	zassert_not_ok(msgqueue_response_pop(0, &rsp));
+
+	/* a token can only be completed once */
+	zassert_not_ok(msgqueue_complete(slow_token, &rsp, 0));
+}
+
+static int msgqueue_handler_75(uint32_t msg_code, const struct request *req,
+			       struct response *rsp, msgqueue_token_t token)
+{
+	struct response done = {0};
+
+	done.data[1] = 0x75757575;
+	zassert_ok(msgqueue_complete(token, &done, 0));
+
+	/* and then also returns an exit code */
+	rsp->data[1] = 0x76767676;
+	return 0;
+}
+
+ZTEST(msgqueue, test_msgqueue_async_complete_once)
+{
+	struct request req = {0};
+	struct response rsp = {0};
+
+	msgqueue_register_handler(0x73, msgqueue_handler_73);
+	msgqueue_register_async_handler(0x75, msgqueue_handler_75);
+
+	req.data[0] = 0x75;
+	msgqueue_request_push(0, &req);
+	req.data[0] = 0x73;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+
+	/* only the response sent by msgqueue_complete() is pushed */
+	zassert_ok(msgqueue_response_pop(0, &rsp));
+	zassert_equal(rsp.data[1], 0x75757575);
+	zassert_ok(msgqueue_response_pop(0, &rsp));
+	zassert_equal(rsp.data[1], 0x73);
+	zassert_not_ok(msgqueue_response_pop(0, &rsp));
+}
+
 ZTEST_SUITE(msgqueue, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/ztest.h>
+#include <tenstorrent/tt_smbus_regs.h>
+
+#include "dw_apb_i2c.h"
+#include "telemetry.h"
+
+#define TARGET_ADDR 0xA
+#define PEC_POLY    0x07
+
+extern const struct i2c_target_callbacks i2c_target_cb_impl;
+extern struct i2c_target_config i2c_target_config_impl;
+
+static const struct i2c_target_callbacks *const cb = &i2c_target_cb_impl;
+static struct i2c_target_config *const cfg = &i2c_target_config_impl;
+
+/* Drives a PEC-checked SMBus block write through the target callbacks, like the I2C driver */
+static int smbus_block_write(uint8_t cmd, const uint8_t *data, uint8_t count, uint8_t pec_xor)
+{
+	uint8_t hdr[] = {TARGET_ADDR << 1 | I2C_WRITE_BIT, cmd, count};
+	uint8_t pec = crc8(hdr, sizeof(hdr), PEC_POLY, 0, false);
+	int ret;
+
+	pec = crc8(data, count, PEC_POLY, pec, false);
+
+	ret = cb->write_received(cfg, cmd);
+	if (ret == 0) {
+		ret = cb->write_received(cfg, count);
+	}
+	for (uint8_t i = 0; i < count && ret == 0; i++) {
+		ret = cb->write_received(cfg, data[i]);
+	}
+	if (ret == 0) {
+		ret = cb->write_received(cfg, pec ^ pec_xor);
+	}
+
+	cb->stop(cfg);
+	return ret;
+}
+
+/* Drives a PEC-checked SMBus block read through the target callbacks, checking the PEC */
+static int smbus_block_read(uint8_t cmd, uint8_t *count, uint8_t *data)
+{
+	uint8_t hdr[] = {TARGET_ADDR << 1 | I2C_READ_BIT, cmd};
+	uint8_t pec = crc8(hdr, sizeof(hdr), PEC_POLY, 0, false);
+	uint8_t rcv_pec;
+	int ret;
+
+	ret = cb->write_received(cfg, cmd);
+	if (ret == 0) {
+		ret = cb->read_requested(cfg, count);
+	}
+	for (uint8_t i = 0; i < *count && ret == 0; i++) {
+		ret = cb->read_requested(cfg, &data[i]);
+	}
+	if (ret == 0) {
+		ret = cb->read_requested(cfg, &rcv_pec);
+	}
+
+	cb->stop(cfg);
+	if (ret != 0) {
+		return ret;
+	}
+
+	pec = crc8(count, sizeof(*count), PEC_POLY, pec, false);
+	pec = crc8(data, *count, PEC_POLY, pec, false);
+
+	return (pec == rcv_pec) ? 0 : -EIO;
+}
+
+/* The legacy interface, one tag per pair of transactions */
+static uint32_t read_single_tag(uint8_t tag)
+{
+	uint8_t hdr[] = {TARGET_ADDR << 1 | I2C_WRITE_BIT, CMFW_SMBUS_TELEMETRY_REG, tag};
+	uint8_t data[sizeof(uint32_t)];
+	uint8_t count = 0;
+
+	zassert_ok(cb->write_received(cfg, CMFW_SMBUS_TELEMETRY_REG));
+	zassert_ok(cb->write_received(cfg, tag));
+	zassert_ok(cb->write_received(cfg, crc8(hdr, sizeof(hdr), PEC_POLY, 0, false)));
+	cb->stop(cfg);
+
+	zassert_ok(smbus_block_read(CMFW_SMBUS_TELEMETRY_DATA, &count, data));
+	zassert_equal(count, sizeof(uint32_t));
+
+	return sys_get_le32(data);
+}
+
+ZTEST(smbus_target, test_telemetry_bulk_read)
+{
+	static const uint8_t tags[] = {TAG_BOARD_POWER_LIMIT, TAG_THERM_TRIP_COUNT,
+				       TAG_BOARD_POWER_LIMIT};
+	uint8_t data[CMFW_SMBUS_TELEMETRY_LIST_MAX * sizeof(uint32_t)];
+	uint8_t count = 0;
+
+	UpdateTelemetryBoardPowerLimit(450);
+	UpdateTelemetryThermTripCount(3);
+
+	/* one transaction selects the tags, one reads all of them */
+	zassert_ok(smbus_block_write(CMFW_SMBUS_TELEMETRY_LIST, tags, sizeof(tags), 0));
+	zassert_ok(smbus_block_read(CMFW_SMBUS_TELEMETRY_BULK, &count, data));
+	zassert_equal(count, sizeof(tags) * sizeof(uint32_t));
+
+	zassert_equal(sys_get_le32(&data[0]), 450);
+	zassert_equal(sys_get_le32(&data[4]), 3);
+	zassert_equal(sys_get_le32(&data[8]), 450);
+
+	/* the values match the ones read one tag at a time */
+	for (size_t i = 0; i < ARRAY_SIZE(tags); i++) {
+		zassert_equal(sys_get_le32(&data[i * sizeof(uint32_t)]), read_single_tag(tags[i]));
+	}
+
+	/* the list stays selected, and reads follow telemetry updates */
+	UpdateTelemetryThermTripCount(4);
+	zassert_ok(smbus_block_read(CMFW_SMBUS_TELEMETRY_BULK, &count, data));
+	zassert_equal(sys_get_le32(&data[4]), 4);
+}
+
+ZTEST(smbus_target, test_telemetry_bulk_read_max)
+{
+	uint8_t tags[CMFW_SMBUS_TELEMETRY_LIST_MAX];
+	uint8_t data[CMFW_SMBUS_TELEMETRY_LIST_MAX * sizeof(uint32_t)];
+	uint8_t count = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(tags); i++) {
+		tags[i] = (i % 2 == 0) ? TAG_BOARD_POWER_LIMIT : TAG_THERM_TRIP_COUNT;
+	}
+
+	UpdateTelemetryBoardPowerLimit(600);
+	UpdateTelemetryThermTripCount(7);
+
+	zassert_ok(smbus_block_write(CMFW_SMBUS_TELEMETRY_LIST, tags, sizeof(tags), 0));
+	zassert_ok(smbus_block_read(CMFW_SMBUS_TELEMETRY_BULK, &count, data));
+	zassert_equal(count, sizeof(data));
+
+	for (size_t i = 0; i < ARRAY_SIZE(tags); i++) {
+		zassert_equal(sys_get_le32(&data[i * sizeof(uint32_t)]), (i % 2 == 0) ? 600 : 7);
+	}
+}
+
+ZTEST(smbus_target, test_telemetry_list_invalid)
+{
+	static const uint8_t tag = TAG_THERM_TRIP_COUNT;
+	uint8_t tags[CMFW_SMBUS_TELEMETRY_LIST_MAX + 1] = {0};
+	uint8_t data[CMFW_SMBUS_TELEMETRY_LIST_MAX * sizeof(uint32_t)];
+	uint8_t count = 0;
+
+	UpdateTelemetryThermTripCount(5);
+	zassert_ok(smbus_block_write(CMFW_SMBUS_TELEMETRY_LIST, &tag, 1, 0));
+
+	/* empty and oversized lists, and lists with a bad PEC, are rejected */
+	zassert_not_ok(smbus_block_write(CMFW_SMBUS_TELEMETRY_LIST, tags, 0, 0));
+	zassert_not_ok(smbus_block_write(CMFW_SMBUS_TELEMETRY_LIST, tags, sizeof(tags), 0));
+	zassert_not_ok(smbus_block_write(CMFW_SMBUS_TELEMETRY_LIST, tags, 2, 0x01));
+
+	/* and the previous list is still selected */
+	zassert_ok(smbus_block_read(CMFW_SMBUS_TELEMETRY_BULK, &count, data));
+	zassert_equal(count, sizeof(uint32_t));
+	zassert_equal(sys_get_le32(data), 5);
+}
+
+ZTEST_SUITE(smbus_target, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "telemetry.h"
+
+#define NUM_UPDATES  1000
+#define STACK_SIZE   1024
+#define THREAD_PRIO  K_PRIO_PREEMPT(5)
+
+static K_THREAD_STACK_DEFINE(writer_stack, STACK_SIZE);
+static struct k_thread writer_thread;
+
+static volatile bool writer_done;
+
+/*
+ * Updates a coherent pair of tags, yielding halfway through to let the reader in. The extra
+ * yield every few updates shifts the phase, so that some reads also complete undisturbed.
+ */
+static void writer(void *arg1, void *arg2, void *arg3)
+{
+	for (uint32_t i = 1; i <= NUM_UPDATES; i++) {
+		TelemetryWriteBegin();
+		UpdateTelemetryBoardPowerLimit(i);
+		k_yield();
+		UpdateTelemetryThermTripCount(i);
+		TelemetryWriteEnd();
+		k_yield();
+		if (i % 3 == 0) {
+			k_yield();
+		}
+	}
+
+	writer_done = true;
+}
+
+/* Reference implementation of the host read protocol described in telemetry.h */
+static int host_read_snapshot(uint32_t *snapshot, uint32_t *retries)
+{
+	for (;;) {
+		uint32_t gen = GetTelemetryTag(TAG_TELEMETRY_GENERATION);
+
+		if (gen % 2 != 0) {
+			++*retries;
+			k_yield();
+			continue;
+		}
+
+		for (uint16_t tag = 0; tag < TAG_COUNT; tag++) {
+			snapshot[tag] = GetTelemetryTag(tag);
+			if (tag == TAG_BOARD_POWER_LIMIT) {
+				k_yield();
+			}
+		}
+
+		if (GetTelemetryTag(TAG_TELEMETRY_GENERATION) == gen) {
+			return 0;
+		}
+
+		++*retries;
+	}
+}
+
+ZTEST(telemetry, test_telemetry_generation)
+{
+	uint32_t gen = GetTelemetryTag(TAG_TELEMETRY_GENERATION);
+
+	zassert_equal(gen % 2, 0);
+
+	TelemetryWriteBegin();
+	zassert_equal(GetTelemetryTag(TAG_TELEMETRY_GENERATION), gen + 1);
+
+	/* Nested writers, e.g. an SMBus handler preempting the telemetry worker */
+	TelemetryWriteBegin();
+	TelemetryWriteEnd();
+	zassert_equal(GetTelemetryTag(TAG_TELEMETRY_GENERATION), gen + 1);
+
+	TelemetryWriteEnd();
+	zassert_equal(GetTelemetryTag(TAG_TELEMETRY_GENERATION), gen + 2);
+}
+
+ZTEST(telemetry, test_telemetry_no_torn_snapshots)
+{
+	uint32_t snapshot[TAG_COUNT];
+	uint32_t snapshots = 0;
+	uint32_t retries = 0;
+
+	UpdateTelemetryBoardPowerLimit(0);
+	UpdateTelemetryThermTripCount(0);
+	writer_done = false;
+
+	k_thread_create(&writer_thread, writer_stack, K_THREAD_STACK_SIZEOF(writer_stack), writer,
+			NULL, NULL, NULL, THREAD_PRIO, 0, K_NO_WAIT);
+
+	k_thread_priority_set(k_current_get(), THREAD_PRIO);
+	while (!writer_done) {
+		zassert_ok(host_read_snapshot(snapshot, &retries));
+		zassert_equal(snapshot[TAG_BOARD_POWER_LIMIT], snapshot[TAG_THERM_TRIP_COUNT],
+			      "torn snapshot: %u != %u", snapshot[TAG_BOARD_POWER_LIMIT],
+			      snapshot[TAG_THERM_TRIP_COUNT]);
+		++snapshots;
+	}
+
+	k_thread_join(&writer_thread, K_FOREVER);
+
+	TC_PRINT("%u consistent snapshots, %u retries\n", snapshots, retries);
+	zassert_true(snapshots > 0);
+	/* Make sure the reader actually raced with the writer */
+	zassert_true(retries > 0);
+}
+
+ZTEST_SUITE(telemetry, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include "telemetry.h"
+#include "telemetry_history.h"
+
+#define DEPTH CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_DEPTH
+
+static uint32_t fake_telemetry[TAG_COUNT];
+
+/* Stand-in for update_telemetry(), every tag reads as (sample << 8) | tag */
+static void fake_update_telemetry(uint32_t sample, uint64_t timestamp)
+{
+	for (int tag = 0; tag < TAG_COUNT; tag++) {
+		fake_telemetry[tag] = (sample << 8) | tag;
+	}
+
+	TelemetryHistoryRecord(fake_telemetry, timestamp);
+}
+
+static void check_sample(const struct telemetry_history *history, uint32_t sample,
+			 uint64_t timestamp)
+{
+	const struct telemetry_history_sample *s = &history->samples[sample % history->depth];
+
+	zassert_equal(s->timestamp_lo, (uint32_t)timestamp);
+	zassert_equal(s->timestamp_hi, (uint32_t)(timestamp >> 32));
+	for (int i = 0; i < history->tag_count; i++) {
+		zassert_equal(s->values[i], (sample << 8) | history->tags[i],
+			      "sample %u tag %u: %08x", sample, history->tags[i], s->values[i]);
+	}
+}
+
+ZTEST(telemetry_history, test_telemetry_history_header)
+{
+	const struct telemetry_history *history = GetTelemetryHistory();
+
+	zassert_equal(history->version, TELEMETRY_HISTORY_VERSION);
+	zassert_equal(history->depth, DEPTH);
+	zassert_equal(history->period_ms, CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_PERIOD_MS);
+	zassert_equal(history->head, 0);
+
+	/* The tags from CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_TAGS in prj.conf */
+	zassert_equal(history->tag_count, 3);
+	zassert_equal(history->tags[0], TAG_TDC);
+	zassert_equal(history->tags[1], TAG_AICLK);
+	zassert_equal(history->tags[2], TAG_INPUT_POWER);
+}
+
+ZTEST(telemetry_history, test_telemetry_history_wrap)
+{
+	const struct telemetry_history *history = GetTelemetryHistory();
+	/* 64-bit timestamps, crossing the 32-bit boundary */
+	const uint64_t t0 = BIT64(32) - 3 * 5000000ULL;
+
+	/* Partially filled */
+	for (uint32_t i = 0; i < DEPTH / 2; i++) {
+		fake_update_telemetry(i, t0 + i * 5000000ULL);
+	}
+	zassert_equal(history->head, DEPTH / 2);
+	for (uint32_t i = 0; i < DEPTH / 2; i++) {
+		check_sample(history, i, t0 + i * 5000000ULL);
+	}
+
+	/* Wrapped more than once, only the newest DEPTH samples remain */
+	const uint32_t total = 2 * DEPTH + 3;
+
+	for (uint32_t i = DEPTH / 2; i < total; i++) {
+		fake_update_telemetry(i, t0 + i * 5000000ULL);
+	}
+	zassert_equal(history->head, total);
+	for (uint32_t i = total - DEPTH; i < total; i++) {
+		check_sample(history, i, t0 + i * 5000000ULL);
+	}
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	InitTelemetryHistory();
+}
+
+ZTEST_SUITE(telemetry_history, NULL, NULL, before, NULL, NULL);
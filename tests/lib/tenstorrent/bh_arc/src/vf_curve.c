@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+
+#include <zephyr/ztest.h>
+
+#include "aiclk_ppm.h"
+#include "fw_table.h"
+#include "vf_curve.h"
+
+#define TABLE_FMIN_MHZ 200
+#define TABLE_FMAX_MHZ 1400
+
+/* Largest allowed difference from the polynomial, in mV */
+#define MAX_VOLTAGE_ERROR_MV 0.01F
+
+extern uint32_t GetMaxAiclkForVoltage(uint32_t voltage);
+
+static void set_margins(int32_t freq_margin_mhz, int32_t voltage_margin_mv)
+{
+	FwTable *fw_table = (FwTable *)get_fw_table();
+
+	fw_table->chip_limits.frequency_margin = freq_margin_mhz;
+	fw_table->chip_limits.voltage_margin = voltage_margin_mv;
+	InitVFCurve();
+}
+
+/* Highest whole MHz in [fmin, fmax] whose voltage is at most voltage_mv, or fmin - 1 */
+static uint32_t max_freq_for_voltage(uint32_t fmin, uint32_t fmax, uint32_t voltage_mv)
+{
+	for (uint32_t freq = fmax; freq >= fmin; freq--) {
+		if (VFCurveAnalytic(freq) <= voltage_mv) {
+			return freq;
+		}
+	}
+
+	return fmin - 1;
+}
+
+static void check_voltage_table(void)
+{
+	/* Quarter MHz steps also cover the interpolation between table entries */
+	for (float freq = TABLE_FMIN_MHZ; freq <= TABLE_FMAX_MHZ; freq += 0.25F) {
+		float error = fabsf(VFCurve(freq) - VFCurveAnalytic(freq));
+
+		zassert_true(error <= MAX_VOLTAGE_ERROR_MV, "%f MHz: %f mV off", (double)freq,
+			     (double)error);
+	}
+}
+
+static void check_max_freq_table(void)
+{
+	for (uint32_t voltage = 400; voltage <= 1200; voltage++) {
+		uint32_t expected = max_freq_for_voltage(TABLE_FMIN_MHZ, TABLE_FMAX_MHZ, voltage);
+
+		if (expected < TABLE_FMIN_MHZ) {
+			expected = 0;
+		}
+
+		zassert_equal(VFCurveMaxFreq(voltage), expected, "%u mV: %u != %u MHz", voltage,
+			      VFCurveMaxFreq(voltage), expected);
+	}
+}
+
+ZTEST(vf_curve, test_voltage_table)
+{
+	set_margins(0, 0);
+	check_voltage_table();
+
+	set_margins(50, -20);
+	check_voltage_table();
+
+	set_margins(-300, 150);
+	check_voltage_table();
+
+	/* outside of the table */
+	zassert_equal(VFCurve(100.0F), VFCurveAnalytic(100.0F));
+	zassert_equal(VFCurve(1500.0F), VFCurveAnalytic(1500.0F));
+}
+
+ZTEST(vf_curve, test_max_freq_table)
+{
+	set_margins(0, 0);
+	check_max_freq_table();
+
+	set_margins(50, -20);
+	check_max_freq_table();
+
+	set_margins(-300, 150);
+	check_max_freq_table();
+
+	set_margins(300, -150);
+	check_max_freq_table();
+}
+
+ZTEST(vf_curve, test_max_aiclk_for_voltage)
+{
+	set_margins(0, 0);
+	aiclk_ppm.fmin = 800;
+	aiclk_ppm.fmax = 1400;
+
+	/* The curve rises monotonically from fmin, like the search this replaced assumed */
+	for (uint32_t voltage = 600; voltage <= 900; voltage++) {
+		zassert_equal(GetMaxAiclkForVoltage(voltage),
+			      max_freq_for_voltage(aiclk_ppm.fmin, aiclk_ppm.fmax, voltage),
+			      "%u mV", voltage);
+	}
+
+	/* below fmin and capped at fmax */
+	zassert_equal(GetMaxAiclkForVoltage(600), aiclk_ppm.fmin - 1);
+	zassert_equal(GetMaxAiclkForVoltage(1000), aiclk_ppm.fmax);
+}
+
+ZTEST_SUITE(vf_curve, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/smbus.h>
+#include <zephyr/ztest.h>
+
+#include <tenstorrent/bh_chip.h>
+#include <tenstorrent/event.h>
+#include <tenstorrent/jtag_bootrom.h>
+
+#include "chip_service.h"
+
+#define IDLE_TIMEOUT_MS CONFIG_TT_BH_CHIP_BUS_IDLE_TIMEOUT_MS
+#define ENABLE_PIN      0
+
+/* The periodic SMBus traffic of the DMC to a chip */
+#define DMC_EVENTS (TT_EVENT_CM2DM | TT_EVENT_POWER_SAMPLE | TT_EVENT_FAN_SAMPLE)
+
+/* Emulated bus enable GPIO, counting every assert and deassert of the pin */
+struct enable_gpio_emul {
+	struct gpio_driver_data common;
+	bool asserted;
+	int config_ret;
+	size_t num_asserts;
+	size_t num_deasserts;
+};
+
+/* Emulated ARC SMBus target, recording what it is sent */
+struct arc_smbus_emul {
+	size_t num_xfers;
+	size_t num_disabled_xfers;
+	/* Last word written to each register */
+	uint16_t regs[256];
+	/* Message returned by the next read of the cm2dm batch register */
+	cm2dmMessage req;
+};
+
+/* What the chip looked like when the DMC reset it */
+struct chip_reset {
+	size_t num_resets;
+	unsigned int session_count;
+	bool bus_enabled;
+};
+
+static const struct gpio_driver_config enable_gpio_config = {
+	.port_pin_mask = BIT(ENABLE_PIN),
+};
+static struct enable_gpio_emul enable_gpio;
+static struct arc_smbus_emul arc_smbus;
+static struct chip_reset chip_reset;
+
+static int enable_gpio_pin_configure(const struct device *port, gpio_pin_t pin,
+				     gpio_flags_t flags)
+{
+	struct enable_gpio_emul *data = port->data;
+	/* The enable is active low, like on the boards */
+	bool asserted = (flags & GPIO_OUTPUT_INIT_LOW) != 0;
+
+	if (data->config_ret != 0) {
+		return data->config_ret;
+	}
+
+	if (asserted && !data->asserted) {
+		data->num_asserts++;
+	} else if (!asserted && data->asserted) {
+		data->num_deasserts++;
+	}
+	data->asserted = asserted;
+
+	return 0;
+}
+
+static DEVICE_API(gpio, enable_gpio_api) = {
+	.pin_configure = enable_gpio_pin_configure,
+};
+
+DEVICE_DEFINE(enable_gpio_emul, "enable_gpio_emul", NULL, NULL, &enable_gpio,
+	      &enable_gpio_config, POST_KERNEL, CONFIG_GPIO_INIT_PRIORITY, &enable_gpio_api);
+
+static void arc_smbus_xfer(void)
+{
+	arc_smbus.num_xfers++;
+	if (!enable_gpio.asserted) {
+		arc_smbus.num_disabled_xfers++;
+	}
+}
+
+static int arc_smbus_block_read(const struct device *dev, uint16_t addr, uint8_t cmd,
+				uint8_t *count, uint8_t *buf)
+{
+	arc_smbus_xfer();
+
+	/* A batch of one message, or a null message when the queue is empty */
+	*count = sizeof(arc_smbus.req);
+	memcpy(buf, &arc_smbus.req, sizeof(arc_smbus.req));
+	memset(&arc_smbus.req, 0, sizeof(arc_smbus.req));
+
+	return 0;
+}
+
+static int arc_smbus_block_write(const struct device *dev, uint16_t addr, uint8_t cmd,
+				 uint8_t count, uint8_t *buf)
+{
+	arc_smbus_xfer();
+
+	return 0;
+}
+
+static int arc_smbus_word_data_write(const struct device *dev, uint16_t addr, uint8_t cmd,
+				     uint16_t word)
+{
+	arc_smbus_xfer();
+	arc_smbus.regs[cmd] = word;
+
+	return 0;
+}
+
+static DEVICE_API(smbus, arc_smbus_api) = {
+	.smbus_word_data_write = arc_smbus_word_data_write,
+	.smbus_block_write = arc_smbus_block_write,
+	.smbus_block_read = arc_smbus_block_read,
+};
+
+DEVICE_DEFINE(arc_smbus_emul, "arc_smbus_emul", NULL, NULL, NULL, NULL, POST_KERNEL,
+	      CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &arc_smbus_api);
+
+#define TEST_ARC(_data)                                                                            \
+	{                                                                                          \
+		.smbus = {.bus = DEVICE_GET(arc_smbus_emul), .addr = 0xA},                         \
+		.enable = {.port = DEVICE_GET(enable_gpio_emul),                                   \
+			   .pin = ENABLE_PIN,                                                      \
+			   .dt_flags = GPIO_ACTIVE_LOW},                                           \
+		.data = _data,                                                                     \
+	}
+
+static struct bh_arc_data test_arc_data;
+static struct bh_chip test_chip = {.config = {.arc = TEST_ARC(&test_arc_data)}};
+/* Without session data every transaction enables and disables the bus */
+static struct bh_chip legacy_chip = {.config = {.arc = TEST_ARC(NULL)}};
+
+static void wait_idle(void)
+{
+	k_msleep(IDLE_TIMEOUT_MS + 2);
+}
+
+/* The reset sequence of the chip, which releases the bus before it asserts the ASIC reset */
+int jtag_bootrom_reset_sequence(struct bh_chip *chip, bool force_reset)
+{
+	chip_reset.num_resets++;
+	chip_reset.session_count = test_arc_data.session_count;
+	zassert_ok(bh_chip_bus_release(chip));
+	chip_reset.bus_enabled = enable_gpio.asserted;
+
+	return 0;
+}
+
+/* Only reached on PERST, which the tests do not signal */
+int jtag_bootrom_reset_asic(struct bh_chip *chip)
+{
+	return -ENOSYS;
+}
+
+void jtag_bootrom_soft_reset_arc(struct bh_chip *chip)
+{
+}
+
+void jtag_bootrom_teardown(const struct bh_chip *chip)
+{
+}
+
+/* One periodic service of the chip by the DMC main loop */
+static void dmc_cycle(struct bh_chip *chip)
+{
+	zassert_equal(service_chip(chip, DMC_EVENTS), 0);
+	zassert_equal(arc_smbus.regs[CMFW_SMBUS_POWER_INSTANT], 120);
+	zassert_equal(arc_smbus.regs[CMFW_SMBUS_FAN_RPM], 2500);
+}
+
+ZTEST(bus_session, test_no_session_data)
+{
+	for (int i = 0; i < 10; i++) {
+		zassert_ok(bh_chip_set_fan_rpm(&legacy_chip, i));
+	}
+
+	zassert_equal(arc_smbus.num_xfers, 10);
+	zassert_equal(arc_smbus.num_disabled_xfers, 0);
+	zassert_equal(enable_gpio.num_asserts, 10);
+	zassert_equal(enable_gpio.num_deasserts, 10);
+	zassert_false(enable_gpio.asserted);
+}
+
+ZTEST(bus_session, test_session)
+{
+	zassert_ok(bh_chip_bus_session_begin(&test_chip));
+	for (int i = 0; i < 10; i++) {
+		zassert_ok(bh_chip_set_fan_rpm(&test_chip, i));
+	}
+	zassert_ok(bh_chip_bus_session_end(&test_chip));
+
+	zassert_equal(arc_smbus.num_xfers, 10);
+	zassert_equal(arc_smbus.num_disabled_xfers, 0);
+	zassert_equal(enable_gpio.num_asserts, 1);
+	zassert_equal(enable_gpio.num_deasserts, 0);
+
+	/* the bus is released once it has been idle long enough */
+	zassert_true(enable_gpio.asserted);
+	wait_idle();
+	zassert_false(enable_gpio.asserted);
+	zassert_equal(enable_gpio.num_deasserts, 1);
+}
+
+ZTEST(bus_session, test_nested_sessions)
+{
+	zassert_ok(bh_chip_bus_session_begin(&test_chip));
+	zassert_ok(bh_chip_bus_session_begin(&test_chip));
+	zassert_ok(bh_chip_bus_session_end(&test_chip));
+
+	/* the outer session still holds the bus */
+	wait_idle();
+	zassert_true(enable_gpio.asserted);
+	zassert_ok(bh_chip_set_fan_rpm(&test_chip, 1));
+
+	zassert_ok(bh_chip_bus_session_end(&test_chip));
+	wait_idle();
+	zassert_false(enable_gpio.asserted);
+
+	zassert_equal(arc_smbus.num_disabled_xfers, 0);
+	zassert_equal(enable_gpio.num_asserts, 1);
+	zassert_equal(enable_gpio.num_deasserts, 1);
+}
+
+ZTEST(bus_session, test_idle_reuse)
+{
+	/* back to back transactions share the bus until it goes idle */
+	zassert_ok(bh_chip_set_fan_rpm(&test_chip, 1));
+	zassert_ok(bh_chip_set_input_power(&test_chip, 2));
+	zassert_equal(enable_gpio.num_asserts, 1);
+	zassert_equal(enable_gpio.num_deasserts, 0);
+
+	wait_idle();
+	zassert_ok(bh_chip_set_fan_rpm(&test_chip, 3));
+	zassert_equal(enable_gpio.num_asserts, 2);
+	zassert_equal(enable_gpio.num_deasserts, 1);
+	zassert_equal(arc_smbus.num_disabled_xfers, 0);
+}
+
+ZTEST(bus_session, test_dmc_cycles)
+{
+	const int num_cycles = 10;
+
+	for (int i = 0; i < num_cycles; i++) {
+		dmc_cycle(&legacy_chip);
+	}
+	zassert_equal(arc_smbus.num_disabled_xfers, 0);
+	zassert_equal(enable_gpio.num_asserts, 3 * num_cycles, "legacy: %zu toggles",
+		      enable_gpio.num_asserts);
+
+	/* one toggle per cycle, even when cycles are further apart than the idle timeout */
+	enable_gpio.num_asserts = 0;
+	for (int i = 0; i < num_cycles; i++) {
+		dmc_cycle(&test_chip);
+		wait_idle();
+	}
+	zassert_equal(arc_smbus.num_disabled_xfers, 0);
+	zassert_equal(enable_gpio.num_asserts, num_cycles, "session: %zu toggles",
+		      enable_gpio.num_asserts);
+	zassert_false(enable_gpio.asserted);
+}
+
+ZTEST(bus_session, test_release)
+{
+	zassert_ok(bh_chip_bus_session_begin(&test_chip));
+	zassert_equal(bh_chip_bus_release(&test_chip), -EBUSY);
+	zassert_true(enable_gpio.asserted);
+	zassert_ok(bh_chip_bus_session_end(&test_chip));
+
+	/* the bus is disabled without waiting for it to go idle */
+	zassert_ok(bh_chip_bus_release(&test_chip));
+	zassert_false(enable_gpio.asserted);
+	wait_idle();
+	zassert_equal(enable_gpio.num_asserts, 1);
+	zassert_equal(enable_gpio.num_deasserts, 1);
+
+	/* which it always is between transactions without session data */
+	zassert_ok(bh_chip_bus_release(&legacy_chip));
+}
+
+ZTEST(bus_session, test_cm2dm_reset)
+{
+	arc_smbus.req = (cm2dmMessage){
+		.msg_id = kCm2DmMsgIdResetReq,
+		.seq_num = 1,
+		.data = 0,
+	};
+	service_chip(&test_chip, DMC_EVENTS);
+
+	/* the chip is reset once the DMC is done with the bus, and with the bus disabled */
+	zassert_equal(chip_reset.num_resets, 1);
+	zassert_equal(chip_reset.session_count, 0);
+	zassert_false(chip_reset.bus_enabled);
+	zassert_false(test_chip.data.reset_requested);
+	zassert_equal(arc_smbus.num_disabled_xfers, 0);
+
+	/* the next cycle talks to the chip as usual */
+	dmc_cycle(&test_chip);
+	zassert_equal(chip_reset.num_resets, 1);
+}
+
+ZTEST(bus_session, test_enable_failure)
+{
+	enable_gpio.config_ret = -EIO;
+	zassert_equal(bh_chip_bus_session_begin(&test_chip), -EIO);
+	zassert_equal(bh_chip_set_fan_rpm(&test_chip, 1), -EIO);
+	zassert_equal(arc_smbus.num_xfers, 0);
+	enable_gpio.config_ret = 0;
+
+	/* the failed session still has to be ended, and the next transaction enables the bus */
+	zassert_ok(bh_chip_set_fan_rpm(&test_chip, 1));
+	zassert_ok(bh_chip_bus_session_end(&test_chip));
+	zassert_equal(arc_smbus.num_disabled_xfers, 0);
+
+	wait_idle();
+	zassert_false(enable_gpio.asserted);
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	wait_idle();
+	memset(&arc_smbus, 0, sizeof(arc_smbus));
+	memset(&chip_reset, 0, sizeof(chip_reset));
+	enable_gpio.config_ret = 0;
+	enable_gpio.num_asserts = 0;
+	enable_gpio.num_deasserts = 0;
+	test_chip.data.cm2dm_batch_unsupported = false;
+	legacy_chip.data.cm2dm_batch_unsupported = false;
+
+	board_set_input_power(120);
+	board_set_fan_rpm(2500);
+}
+
+ZTEST_SUITE(bus_session, NULL, NULL, before, NULL, NULL);
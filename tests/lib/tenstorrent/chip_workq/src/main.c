@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The DMC chip service of app/dmc, run from the work queue of each chip against emulated ARC
+ * SMBus targets, with one chip much slower to respond than the other.
+ */
+
+#include <stdio.h>
+
+#include <zephyr/drivers/smbus.h>
+#include <zephyr/ztest.h>
+
+#include <tenstorrent/bh_chip.h>
+#include <tenstorrent/event.h>
+#include <tenstorrent/tt_smbus_regs.h>
+
+#include "chip_service.h"
+
+#define NUM_CHIPS 2
+#define SLOW_CHIP 0
+#define FAST_CHIP 1
+
+/* Time the slow chip takes for every SMBus transaction */
+#define SLOW_XFER_MS 100
+/* Worst case latency allowed for the fast chip */
+#define FAST_LATENCY_MS 5
+
+#define MAX_CALLS 16
+
+/* Emulated ARC SMBus target of one chip, optionally taking a long time per transaction */
+struct chip_smbus_emul {
+	uint32_t xfer_ms;
+	size_t num_xfers;
+	/* Last word written to each register */
+	uint16_t regs[256];
+	/* Message returned by the next read of the cm2dm batch register */
+	cm2dmMessage req;
+};
+
+static struct chip_smbus_emul chip_smbus[NUM_CHIPS];
+
+static void chip_smbus_xfer(struct chip_smbus_emul *data)
+{
+	if (data->xfer_ms != 0) {
+		k_msleep(data->xfer_ms);
+	}
+
+	data->num_xfers++;
+}
+
+static int chip_smbus_word_data_write(const struct device *dev, uint16_t addr, uint8_t cmd,
+				      uint16_t word)
+{
+	struct chip_smbus_emul *data = dev->data;
+
+	chip_smbus_xfer(data);
+	data->regs[cmd] = word;
+
+	return 0;
+}
+
+static int chip_smbus_block_read(const struct device *dev, uint16_t addr, uint8_t cmd,
+				 uint8_t *count, uint8_t *buf)
+{
+	struct chip_smbus_emul *data = dev->data;
+
+	chip_smbus_xfer(data);
+	if (cmd != CMFW_SMBUS_REQ_BATCH) {
+		return -EIO;
+	}
+
+	/* A batch of one message, or a null message when the queue is empty */
+	*count = sizeof(data->req);
+	memcpy(buf, &data->req, sizeof(data->req));
+	memset(&data->req, 0, sizeof(data->req));
+
+	return 0;
+}
+
+static DEVICE_API(smbus, chip_smbus_api) = {
+	.smbus_word_data_write = chip_smbus_word_data_write,
+	.smbus_block_read = chip_smbus_block_read,
+};
+
+DEVICE_DEFINE(chip0_smbus_emul, "chip0_smbus_emul", NULL, NULL, &chip_smbus[0], NULL,
+	      POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &chip_smbus_api);
+DEVICE_DEFINE(chip1_smbus_emul, "chip1_smbus_emul", NULL, NULL, &chip_smbus[1], NULL,
+	      POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &chip_smbus_api);
+
+#define TEST_CHIP(_smbus)                                                                          \
+	{                                                                                          \
+		.config = {.arc = {.smbus = {.bus = DEVICE_GET(_smbus), .addr = 0xA}}},            \
+	}
+
+static struct bh_chip chips[NUM_CHIPS] = {
+	TEST_CHIP(chip0_smbus_emul),
+	TEST_CHIP(chip1_smbus_emul),
+};
+
+/* What the event handler of each chip was called with */
+struct chip_calls {
+	struct k_sem done;
+	size_t num_calls;
+	uint32_t events[MAX_CALLS];
+	int64_t done_ms;
+};
+
+static struct chip_calls calls[NUM_CHIPS];
+
+/* Runs the handler of the DMC, recording when each chip was serviced */
+static void chip_handler(struct bh_chip *chip, uint32_t events)
+{
+	struct chip_calls *c = &calls[chip - chips];
+
+	chip_event_handler(chip, events);
+
+	if (c->num_calls < MAX_CALLS) {
+		c->events[c->num_calls] = events;
+	}
+	c->num_calls++;
+	c->done_ms = k_uptime_get();
+	k_sem_give(&c->done);
+}
+
+static int64_t wait_done(int idx, int32_t timeout_ms)
+{
+	zassert_ok(k_sem_take(&calls[idx].done, K_MSEC(timeout_ms)), "chip %d not serviced", idx);
+
+	return calls[idx].done_ms;
+}
+
+static void post_all(uint32_t events)
+{
+	ARRAY_FOR_EACH_PTR(chips, chip) {
+		bh_chip_workq_post(chip, events);
+	}
+}
+
+ZTEST(chip_workq, test_sequential_baseline)
+{
+	int64_t start = k_uptime_get();
+
+	/* Serviced one after the other, the fast chip waits for the slow one */
+	board_set_input_power(120);
+	service_chip(&chips[SLOW_CHIP], TT_EVENT_POWER_SAMPLE);
+	service_chip(&chips[FAST_CHIP], TT_EVENT_POWER_SAMPLE);
+
+	zassert_true(k_uptime_get() - start >= SLOW_XFER_MS);
+	zassert_equal(chip_smbus[SLOW_CHIP].regs[CMFW_SMBUS_POWER_INSTANT], 120);
+	zassert_equal(chip_smbus[FAST_CHIP].regs[CMFW_SMBUS_POWER_INSTANT], 120);
+}
+
+ZTEST(chip_workq, test_slow_chip_isolated)
+{
+	int64_t start = k_uptime_get();
+	int64_t fast_ms;
+	int64_t slow_ms;
+
+	board_set_input_power(120);
+	post_all(TT_EVENT_POWER_SAMPLE);
+
+	fast_ms = wait_done(FAST_CHIP, SLOW_XFER_MS) - start;
+	zassert_true(fast_ms <= FAST_LATENCY_MS, "fast chip took %lld ms", fast_ms);
+	zassert_equal(chip_smbus[FAST_CHIP].regs[CMFW_SMBUS_POWER_INSTANT], 120);
+
+	slow_ms = wait_done(SLOW_CHIP, 2 * SLOW_XFER_MS) - start;
+	zassert_true(slow_ms >= SLOW_XFER_MS, "slow chip took %lld ms", slow_ms);
+	zassert_equal(chip_smbus[SLOW_CHIP].regs[CMFW_SMBUS_POWER_INSTANT], 120);
+}
+
+ZTEST(chip_workq, test_slow_chip_periodic)
+{
+	const int num_periods = 10;
+	const int period_ms = 20;
+
+	/* The fast chip keeps up with every period, while the slow chip is busy */
+	for (int i = 0; i < num_periods; i++) {
+		int64_t start = k_uptime_get();
+		int64_t fast_ms;
+
+		board_set_input_power(100 + i);
+		post_all(TT_EVENT_POWER_SAMPLE);
+
+		fast_ms = wait_done(FAST_CHIP, period_ms) - start;
+		zassert_true(fast_ms <= FAST_LATENCY_MS, "period %d: fast chip took %lld ms", i,
+			     fast_ms);
+		zassert_equal(chip_smbus[FAST_CHIP].regs[CMFW_SMBUS_POWER_INSTANT], 100 + i);
+		k_msleep(period_ms - fast_ms);
+	}
+	zassert_equal(calls[FAST_CHIP].num_calls, num_periods);
+	zassert_equal(chip_smbus[FAST_CHIP].num_xfers, num_periods);
+
+	/* The samples posted while the slow chip was busy are handled together */
+	k_work_queue_drain(&chips[SLOW_CHIP].data.workq, false);
+	zassert_true(calls[SLOW_CHIP].num_calls < num_periods, "%zu calls",
+		     calls[SLOW_CHIP].num_calls);
+	zassert_equal(chip_smbus[SLOW_CHIP].num_xfers, calls[SLOW_CHIP].num_calls);
+	/* and report the latest sample */
+	zassert_equal(chip_smbus[SLOW_CHIP].regs[CMFW_SMBUS_POWER_INSTANT],
+		      100 + num_periods - 1);
+}
+
+ZTEST(chip_workq, test_events_combined)
+{
+	struct bh_chip *chip = &chips[SLOW_CHIP];
+
+	bh_chip_workq_post(chip, TT_EVENT_POWER_SAMPLE);
+	/* let the handler start its slow transaction */
+	k_msleep(1);
+
+	bh_chip_workq_post(chip, TT_EVENT_PGOOD);
+	bh_chip_workq_post(chip, TT_EVENT_PERST);
+	bh_chip_workq_post(chip, TT_EVENT_PGOOD);
+
+	k_work_queue_drain(&chip->data.workq, false);
+
+	zassert_equal(calls[SLOW_CHIP].num_calls, 2);
+	zassert_equal(calls[SLOW_CHIP].events[0], TT_EVENT_POWER_SAMPLE);
+	zassert_equal(calls[SLOW_CHIP].events[1], TT_EVENT_PGOOD | TT_EVENT_PERST);
+	zassert_equal(calls[FAST_CHIP].num_calls, 0);
+}
+
+ZTEST(chip_workq, test_board_samples)
+{
+	/* Every chip reports the board samples taken before it is serviced */
+	board_set_input_power(150);
+	board_set_fan_rpm(2000);
+	post_all(TT_EVENT_POWER_SAMPLE | TT_EVENT_FAN_SAMPLE);
+
+	wait_done(FAST_CHIP, SLOW_XFER_MS);
+	zassert_equal(chip_smbus[FAST_CHIP].regs[CMFW_SMBUS_POWER_INSTANT], 150);
+	zassert_equal(chip_smbus[FAST_CHIP].regs[CMFW_SMBUS_FAN_RPM], 2000);
+
+	/* The slow chip is still busy with the power sample, and picks up the new fan speed */
+	board_set_fan_rpm(2500);
+
+	wait_done(SLOW_CHIP, 3 * SLOW_XFER_MS);
+	zassert_equal(chip_smbus[SLOW_CHIP].regs[CMFW_SMBUS_POWER_INSTANT], 150);
+	zassert_equal(chip_smbus[SLOW_CHIP].regs[CMFW_SMBUS_FAN_RPM], 2500);
+	zassert_equal(chip_smbus[FAST_CHIP].regs[CMFW_SMBUS_FAN_RPM], 2000);
+}
+
+ZTEST(chip_workq, test_fan_speed_requests)
+{
+	chip_smbus[SLOW_CHIP].req = (cm2dmMessage){
+		.msg_id = kCm2DmMsgIdFanSpeedUpdate,
+		.seq_num = 1,
+		.data = 40,
+	};
+	chip_smbus[FAST_CHIP].req = (cm2dmMessage){
+		.msg_id = kCm2DmMsgIdFanSpeedUpdate,
+		.seq_num = 7,
+		.data = 70,
+	};
+	post_all(TT_EVENT_CM2DM);
+
+	/* Both chips set the board fan speed, each from its own work queue */
+	wait_done(FAST_CHIP, SLOW_XFER_MS);
+	zassert_equal(board_get_fan_speed(), 70);
+	zassert_not_equal(chip_smbus[FAST_CHIP].regs[CMFW_SMBUS_ACK_BATCH], 0);
+
+	/* the batch read and its ack, then the read of an empty batch */
+	wait_done(SLOW_CHIP, 4 * SLOW_XFER_MS);
+	zassert_equal(board_get_fan_speed(), 40);
+	zassert_equal(chip_smbus[SLOW_CHIP].num_xfers, 3);
+}
+
+static void *setup(void)
+{
+	ARRAY_FOR_EACH_PTR(chips, chip) {
+		char name[sizeof("bh_chipNN")];
+
+		snprintf(name, sizeof(name), "bh_chip%d", (int)(chip - chips));
+		bh_chip_workq_start(chip, chip_handler, name);
+	}
+
+	return NULL;
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	ARRAY_FOR_EACH_PTR(chips, chip) {
+		k_work_queue_drain(&chip->data.workq, false);
+	}
+
+	memset(chip_smbus, 0, sizeof(chip_smbus));
+	chip_smbus[SLOW_CHIP].xfer_ms = SLOW_XFER_MS;
+
+	for (int i = 0; i < NUM_CHIPS; i++) {
+		memset(&calls[i], 0, sizeof(calls[i]));
+		k_sem_init(&calls[i].done, 0, K_SEM_MAX_LIMIT);
+	}
+
+	board_set_input_power(0);
+	board_set_fan_rpm(0);
+	board_set_fan_speed(0);
+}
+
+ZTEST_SUITE(chip_workq, NULL, setup, before, NULL, NULL);
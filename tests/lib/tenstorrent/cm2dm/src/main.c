@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The DMC side of the cm2dm messages, bh_chip_get_cm2dm_message(), reading from the CMFW side,
+ * the SMBus target of the bh_arc library, over an emulated SMBus.
+ */
+
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/smbus.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/ztest.h>
+
+#include <tenstorrent/bh_chip.h>
+#include <tenstorrent/tt_smbus_regs.h>
+
+#include "cm2dm_msg.h"
+
+#define TARGET_ADDR 0xA
+#define PEC_POLY    0x07
+#define CM2DM_BURST 12
+
+BUILD_ASSERT(CM2DM_BURST <= CONFIG_TT_BH_ARC_CM2DM_MSG_QUEUE_SIZE);
+
+extern const struct i2c_target_callbacks i2c_target_cb_impl;
+extern struct i2c_target_config i2c_target_config_impl;
+
+static const struct i2c_target_callbacks *const cb = &i2c_target_cb_impl;
+static struct i2c_target_config *const cfg = &i2c_target_config_impl;
+
+/* SMBus controller of the DMC, with the CMFW SMBus target as the only device on the bus */
+struct cmfw_smbus_emul {
+	size_t num_xfers;
+	/* Like a CMFW without the batch registers, which NACKs their command byte */
+	bool no_batch;
+	/* When nonzero, returned by the next transaction with fail_cmd, which is then dropped */
+	int fail_ret;
+	uint8_t fail_cmd;
+};
+
+static struct cmfw_smbus_emul cmfw_smbus;
+
+/* Starts a transaction with its command byte, returning -EIO if it is NACKed like the I2C driver */
+static int cmfw_smbus_start(uint8_t cmd)
+{
+	int ret;
+
+	cmfw_smbus.num_xfers++;
+
+	if (cmfw_smbus.fail_ret != 0 && cmd == cmfw_smbus.fail_cmd) {
+		ret = cmfw_smbus.fail_ret;
+		cmfw_smbus.fail_ret = 0;
+		return ret;
+	}
+
+	if (cmfw_smbus.no_batch && (cmd == CMFW_SMBUS_REQ_BATCH || cmd == CMFW_SMBUS_ACK_BATCH)) {
+		return -EIO;
+	}
+
+	return cb->write_received(cfg, cmd) == 0 ? 0 : -EIO;
+}
+
+static int cmfw_smbus_block_read(const struct device *dev, uint16_t addr, uint8_t cmd,
+				 uint8_t *count, uint8_t *buf)
+{
+	uint8_t hdr[] = {addr << 1 | I2C_READ_BIT, cmd};
+	uint8_t pec = crc8(hdr, sizeof(hdr), PEC_POLY, 0, false);
+	uint8_t rcv_pec;
+	int ret;
+
+	ARG_UNUSED(dev);
+
+	ret = cmfw_smbus_start(cmd);
+	if (ret == 0 && cb->read_requested(cfg, count) != 0) {
+		ret = -EIO;
+	}
+	for (uint8_t i = 0; ret == 0 && i < *count; i++) {
+		if (cb->read_requested(cfg, &buf[i]) != 0) {
+			ret = -EIO;
+		}
+	}
+	if (ret == 0 && cb->read_requested(cfg, &rcv_pec) != 0) {
+		ret = -EIO;
+	}
+
+	cb->stop(cfg);
+	if (ret != 0) {
+		return ret;
+	}
+
+	pec = crc8(count, sizeof(*count), PEC_POLY, pec, false);
+	pec = crc8(buf, *count, PEC_POLY, pec, false);
+
+	return (pec == rcv_pec) ? 0 : -EINVAL;
+}
+
+static int cmfw_smbus_word_data_write(const struct device *dev, uint16_t addr, uint8_t cmd,
+				      uint16_t word)
+{
+	uint8_t msg[] = {addr << 1 | I2C_WRITE_BIT, cmd, word & 0xff, word >> 8};
+	int ret;
+
+	ARG_UNUSED(dev);
+
+	ret = cmfw_smbus_start(cmd);
+	/* the data bytes, then the PEC */
+	for (size_t i = 2; i <= sizeof(msg) && ret == 0; i++) {
+		uint8_t byte = i < sizeof(msg) ? msg[i] : crc8(msg, sizeof(msg), PEC_POLY, 0, false);
+
+		if (cb->write_received(cfg, byte) != 0) {
+			ret = -EIO;
+		}
+	}
+
+	cb->stop(cfg);
+	return ret;
+}
+
+static DEVICE_API(smbus, cmfw_smbus_api) = {
+	.smbus_word_data_write = cmfw_smbus_word_data_write,
+	.smbus_block_read = cmfw_smbus_block_read,
+};
+
+DEVICE_DEFINE(cmfw_smbus_emul, "cmfw_smbus_emul", NULL, NULL, NULL, NULL, POST_KERNEL,
+	      CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &cmfw_smbus_api);
+
+static struct bh_chip chip = {
+	.config = {.arc = {.smbus = {.bus = DEVICE_GET(cmfw_smbus_emul), .addr = TARGET_ADDR}}},
+};
+
+static uint16_t cm2dm_ack(const cm2dmMessage *msg)
+{
+	union cm2dmAckWire ack = {.f = {.msg_id = msg->msg_id, .seq_num = msg->seq_num}};
+
+	return ack.val;
+}
+
+/* Polls the messages like the DMC main loop, until none is pending */
+static size_t dmc_poll(cm2dmMessage *msgs, size_t max)
+{
+	size_t num = 0;
+
+	while (num < max) {
+		cm2dmMessageRet ret = bh_chip_get_cm2dm_message(&chip);
+
+		zassert_ok(ret.ret);
+		if (ret.msg.msg_id == kCm2DmMsgIdNull) {
+			break;
+		}
+		zassert_ok(ret.ack_ret);
+		msgs[num++] = ret.msg;
+	}
+
+	return num;
+}
+
+static void enqueue_msgs(size_t num, uint32_t first)
+{
+	for (size_t i = 0; i < num; i++) {
+		Cm2DmMsg msg = {.msg_id = kCm2DmMsgIdFanSpeedUpdate, .data = first + i};
+
+		zassert_ok(EnqueueCm2DmMsg(&msg));
+	}
+}
+
+static void check_msgs(const cm2dmMessage *msgs, size_t num, uint32_t first)
+{
+	for (size_t i = 0; i < num; i++) {
+		zassert_equal(msgs[i].msg_id, kCm2DmMsgIdFanSpeedUpdate);
+		zassert_equal(msgs[i].data, first + i, "message %zu out of order", i);
+		zassert_equal((uint8_t)(msgs[i].seq_num - msgs[0].seq_num), i);
+	}
+}
+
+static void cm2dm_before(void *fixture)
+{
+	static cm2dmMessage msgs[CONFIG_TT_BH_ARC_CM2DM_MSG_QUEUE_SIZE + CMFW_SMBUS_REQ_BATCH_MAX];
+
+	ARG_UNUSED(fixture);
+
+	/* drop anything queued by other tests */
+	memset(&cmfw_smbus, 0, sizeof(cmfw_smbus));
+	bh_chip_discard_cm2dm_messages(&chip);
+	dmc_poll(msgs, ARRAY_SIZE(msgs));
+	cmfw_smbus.num_xfers = 0;
+}
+
+ZTEST(cm2dm_msg, test_cm2dm_burst)
+{
+	static cm2dmMessage msgs[CM2DM_BURST + CMFW_SMBUS_REQ_BATCH_MAX];
+
+	/* a read and an ack per batch, plus the read that finds the queue empty */
+	enqueue_msgs(CM2DM_BURST, 100);
+	zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), CM2DM_BURST);
+	zassert_equal(cmfw_smbus.num_xfers,
+		      2 * DIV_ROUND_UP(CM2DM_BURST, CMFW_SMBUS_REQ_BATCH_MAX) + 1,
+		      "batch took %zu transactions", cmfw_smbus.num_xfers);
+	check_msgs(msgs, CM2DM_BURST, 100);
+	zassert_false(chip.data.cm2dm_batch_unsupported);
+}
+
+ZTEST(cm2dm_msg, test_cm2dm_no_batch)
+{
+	static cm2dmMessage msgs[CM2DM_BURST + 1];
+
+	/* the rejected batch reads, then a read and an ack per message and the empty read */
+	cmfw_smbus.no_batch = true;
+	enqueue_msgs(CM2DM_BURST, 0);
+	zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), CM2DM_BURST);
+	zassert_equal(cmfw_smbus.num_xfers, BH_CHIP_CM2DM_BATCH_NACK_LIMIT + 2 * CM2DM_BURST + 1,
+		      "legacy took %zu transactions", cmfw_smbus.num_xfers);
+	check_msgs(msgs, CM2DM_BURST, 0);
+	zassert_true(chip.data.cm2dm_batch_unsupported);
+
+	/* batches are not tried again */
+	cmfw_smbus.num_xfers = 0;
+	zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), 0);
+	zassert_equal(cmfw_smbus.num_xfers, 1);
+
+	/* until the CMFW restarts, possibly with batch support */
+	cmfw_smbus.no_batch = false;
+	Dm2CmReadyRequest();
+	zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), 1);
+	zassert_equal(msgs[0].msg_id, kCm2DmMsgIdReady);
+	zassert_false(chip.data.cm2dm_batch_unsupported);
+
+	cmfw_smbus.num_xfers = 0;
+	enqueue_msgs(3, 50);
+	zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), 3);
+	zassert_equal(cmfw_smbus.num_xfers, 3);
+	check_msgs(msgs, 3, 50);
+}
+
+ZTEST(cm2dm_msg, test_cm2dm_bus_error)
+{
+	cm2dmMessage msgs[CMFW_SMBUS_REQ_BATCH_MAX];
+	cm2dmMessageRet ret;
+
+	/* a failed batch read is reported, without falling back to single messages */
+	enqueue_msgs(3, 10);
+	cmfw_smbus.fail_cmd = CMFW_SMBUS_REQ_BATCH;
+	cmfw_smbus.fail_ret = -ETIMEDOUT;
+	ret = bh_chip_get_cm2dm_message(&chip);
+	zassert_equal(ret.ret, -ETIMEDOUT);
+	zassert_equal(cmfw_smbus.num_xfers, 1);
+	zassert_false(chip.data.cm2dm_batch_unsupported);
+
+	/* and the next poll reads the batch */
+	zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), 3);
+	zassert_equal(cmfw_smbus.num_xfers, 1 + 3);
+	check_msgs(msgs, 3, 10);
+}
+
+ZTEST(cm2dm_msg, test_cm2dm_batch_nack)
+{
+	cm2dmMessage msgs[CMFW_SMBUS_REQ_BATCH_MAX];
+	cm2dmMessageRet ret;
+
+	/* a batch read NACKed once falls back to a single message */
+	enqueue_msgs(3, 20);
+	cmfw_smbus.fail_cmd = CMFW_SMBUS_REQ_BATCH;
+	cmfw_smbus.fail_ret = -EIO;
+	ret = bh_chip_get_cm2dm_message(&chip);
+	zassert_ok(ret.ret);
+	zassert_ok(ret.ack_ret);
+	zassert_equal(ret.msg.data, 20);
+	zassert_equal(cmfw_smbus.num_xfers, 3);
+	zassert_false(chip.data.cm2dm_batch_unsupported);
+
+	/* without giving up on batches, which the next poll reads again */
+	zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), 2);
+	zassert_equal(cmfw_smbus.num_xfers, 3 + 3);
+	check_msgs(msgs, 2, 21);
+	zassert_equal(chip.data.cm2dm_batch_nacks, 0);
+
+	/* NACKs that are not in a row never add up to the limit */
+	for (int i = 0; i < 2 * BH_CHIP_CM2DM_BATCH_NACK_LIMIT; i++) {
+		enqueue_msgs(1, i);
+		cmfw_smbus.fail_cmd = CMFW_SMBUS_REQ_BATCH;
+		cmfw_smbus.fail_ret = -EIO;
+		zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), 1);
+		zassert_equal(msgs[0].data, i);
+	}
+	zassert_false(chip.data.cm2dm_batch_unsupported);
+}
+
+ZTEST(cm2dm_msg, test_cm2dm_lost_ack)
+{
+	cm2dmMessage msgs[CMFW_SMBUS_REQ_BATCH_MAX];
+	cm2dmMessageRet ret;
+
+	/* the batch is read, but its ack fails */
+	enqueue_msgs(3, 30);
+	cmfw_smbus.fail_cmd = CMFW_SMBUS_ACK_BATCH;
+	cmfw_smbus.fail_ret = -ETIMEDOUT;
+	ret = bh_chip_get_cm2dm_message(&chip);
+	zassert_equal(ret.ret, -ETIMEDOUT);
+	zassert_equal(cmfw_smbus.num_xfers, 2);
+	zassert_false(chip.data.cm2dm_batch_unsupported);
+
+	/* the CMFW sends the unacked messages again, and the DMC gets each of them once */
+	zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), 3);
+	zassert_equal(cmfw_smbus.num_xfers, 2 + 3);
+	check_msgs(msgs, 3, 30);
+}
+
+ZTEST(cm2dm_msg, test_cm2dm_discard)
+{
+	cm2dmMessage msgs[CMFW_SMBUS_REQ_BATCH_MAX];
+	cm2dmMessageRet ret;
+
+	enqueue_msgs(3, 40);
+	ret = bh_chip_get_cm2dm_message(&chip);
+	zassert_ok(ret.ret);
+	zassert_equal(ret.msg.data, 40);
+	zassert_equal(cmfw_smbus.num_xfers, 2);
+
+	/* after a chip reset the rest of the batch is stale, and the CMFW is read again */
+	bh_chip_discard_cm2dm_messages(&chip);
+	zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), 0);
+	zassert_equal(cmfw_smbus.num_xfers, 3);
+}
+
+ZTEST(cm2dm_msg, test_cm2dm_batch_retransmit)
+{
+	const struct device *bus = chip.config.arc.smbus.bus;
+	cm2dmMessage first[CMFW_SMBUS_REQ_BATCH_MAX];
+	cm2dmMessage again[CMFW_SMBUS_REQ_BATCH_MAX];
+	uint8_t count = 0;
+
+	enqueue_msgs(3, 10);
+	zassert_ok(smbus_block_read(bus, TARGET_ADDR, CMFW_SMBUS_REQ_BATCH, &count,
+				    (uint8_t *)first));
+	zassert_equal(count, 3 * sizeof(cm2dmMessage));
+	check_msgs(first, 3, 10);
+
+	/* without an ack the same messages are sent again, followed by new ones */
+	enqueue_msgs(1, 13);
+	zassert_ok(smbus_block_read(bus, TARGET_ADDR, CMFW_SMBUS_REQ_BATCH, &count,
+				    (uint8_t *)again));
+	zassert_equal(count, 4 * sizeof(cm2dmMessage));
+	zassert_mem_equal(first, again, 3 * sizeof(cm2dmMessage));
+	check_msgs(again, 4, 10);
+
+	/* the legacy request sees the oldest unacknowledged message */
+	zassert_ok(smbus_block_read(bus, TARGET_ADDR, CMFW_SMBUS_REQ, &count, (uint8_t *)first));
+	zassert_mem_equal(&first[0], &again[0], sizeof(cm2dmMessage));
+
+	zassert_ok(smbus_word_data_write(bus, TARGET_ADDR, CMFW_SMBUS_ACK_BATCH,
+					 cm2dm_ack(&again[3])));
+	zassert_equal(dmc_poll(again, ARRAY_SIZE(again)), 0);
+}
+
+ZTEST(cm2dm_msg, test_cm2dm_batch_partial_ack)
+{
+	const struct device *bus = chip.config.arc.smbus.bus;
+	cm2dmMessage msgs[CMFW_SMBUS_REQ_BATCH_MAX];
+	cm2dmMessage rest[CMFW_SMBUS_REQ_BATCH_MAX];
+	uint8_t count = 0;
+
+	enqueue_msgs(4, 20);
+	zassert_ok(smbus_block_read(bus, TARGET_ADDR, CMFW_SMBUS_REQ_BATCH, &count,
+				    (uint8_t *)msgs));
+	zassert_equal(count, 4 * sizeof(cm2dmMessage));
+
+	/* acking the second message also acks the first one */
+	zassert_ok(smbus_word_data_write(bus, TARGET_ADDR, CMFW_SMBUS_ACK_BATCH,
+					 cm2dm_ack(&msgs[1])));
+	zassert_ok(smbus_block_read(bus, TARGET_ADDR, CMFW_SMBUS_REQ_BATCH, &count,
+				    (uint8_t *)rest));
+	zassert_equal(count, 2 * sizeof(cm2dmMessage));
+	zassert_mem_equal(rest, &msgs[2], count);
+
+	/* acks for messages that are no longer in flight, or never were, are rejected */
+	zassert_not_ok(smbus_word_data_write(bus, TARGET_ADDR, CMFW_SMBUS_ACK_BATCH,
+					     cm2dm_ack(&msgs[0])));
+	rest[0].seq_num = msgs[3].seq_num + 1;
+	zassert_not_ok(smbus_word_data_write(bus, TARGET_ADDR, CMFW_SMBUS_ACK_BATCH,
+					     cm2dm_ack(&rest[0])));
+	rest[0].msg_id = kCm2DmMsgIdPing;
+	rest[0].seq_num = msgs[2].seq_num;
+	zassert_not_ok(smbus_word_data_write(bus, TARGET_ADDR, CMFW_SMBUS_ACK_BATCH,
+					     cm2dm_ack(&rest[0])));
+
+	/* the DMC gets the two messages left in flight */
+	zassert_equal(dmc_poll(rest, ARRAY_SIZE(rest)), 2);
+	zassert_mem_equal(rest, &msgs[2], 2 * sizeof(cm2dmMessage));
+}
+
+ZTEST(cm2dm_msg, test_cm2dm_queue_full)
+{
+	static cm2dmMessage msgs[CONFIG_TT_BH_ARC_CM2DM_MSG_QUEUE_SIZE + CMFW_SMBUS_REQ_BATCH_MAX];
+	Cm2DmMsg msg = {.msg_id = kCm2DmMsgIdFanSpeedUpdate};
+
+	enqueue_msgs(CONFIG_TT_BH_ARC_CM2DM_MSG_QUEUE_SIZE, 0);
+	zassert_not_ok(EnqueueCm2DmMsg(&msg));
+
+	/* nothing queued before the overflow is lost */
+	zassert_equal(dmc_poll(msgs, ARRAY_SIZE(msgs)), CONFIG_TT_BH_ARC_CM2DM_MSG_QUEUE_SIZE);
+	check_msgs(msgs, CONFIG_TT_BH_ARC_CM2DM_MSG_QUEUE_SIZE, 0);
+}
+
+ZTEST_SUITE(cm2dm_msg, NULL, NULL, cm2dm_before, NULL, NULL);
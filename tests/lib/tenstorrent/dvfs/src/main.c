@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#include "aiclk_ppm.h"
+#include "avs.h"
+#include "dvfs.h"
+#include "dvfs_sched.h"
+#include "fw_table.h"
+#include "pll.h"
+#include "pvt.h"
+#include "regulator.h"
+#include "telemetry.h"
+#include "throttler.h"
+
+#ifdef CONFIG_TT_BH_ARC_DVFS_ADAPTIVE
+#define IDLE_PERIOD_MS CONFIG_TT_BH_ARC_DVFS_IDLE_PERIOD_MS
+#define SETTLE_UPDATES CONFIG_TT_BH_ARC_DVFS_SETTLE_UPDATES
+#else
+#define IDLE_PERIOD_MS 1
+#define SETTLE_UPDATES 0
+#endif
+
+#define FMIN      800
+#define FMAX      1350
+#define TDP_LIMIT 150.0F
+
+/* Vcore power at full load and FMAX, throttled to 1012 MHz at full load */
+#define FULL_LOAD_POWER 200.0F
+
+/* The rest of the board, well below the board power limit */
+#define BOARD_POWER       50
+#define BOARD_POWER_LIMIT 600
+
+/* Only the TDP limit is reached by the loads in this test */
+static const FwTable fw_table = {
+	.chip_limits = {
+		.asic_fmax = FMAX,
+		.asic_fmin = FMIN,
+		.voltage_margin = 50,
+		.tdp_limit = TDP_LIMIT,
+		.tdc_limit = 400,
+		.thm_limit = 90,
+		.tdc_fast_limit = 500,
+		.gddr_thm_limit = 85,
+		.board_power_limit = BOARD_POWER_LIMIT,
+	},
+};
+
+/* The chip behind the stubbed PLL, regulator, PVT and telemetry layers */
+static struct {
+	uint32_t aiclk; /* MHz */
+	uint32_t vcore; /* mV */
+
+	/* Fraction of the chip that is busy */
+	float load;
+
+	/* DVFSUpdate() calls, counted by the GDDR temperature read each of them makes */
+	uint32_t evaluations;
+	int64_t aiclk_changed;
+} chip;
+
+static float vcore_power(void)
+{
+	return chip.load * FULL_LOAD_POWER * chip.aiclk / FMAX;
+}
+
+uint32_t GetAICLK(void)
+{
+	return chip.aiclk;
+}
+
+void SetAICLK(uint32_t aiclk_in_mhz)
+{
+	if (aiclk_in_mhz != chip.aiclk) {
+		chip.aiclk_changed = k_uptime_ticks();
+	}
+	chip.aiclk = aiclk_in_mhz;
+}
+
+uint32_t get_vcore(void)
+{
+	return chip.vcore;
+}
+
+void set_vcore(uint32_t voltage_in_mv)
+{
+	chip.vcore = voltage_in_mv;
+}
+
+void set_vcorem(uint32_t voltage_in_mv)
+{
+	ARG_UNUSED(voltage_in_mv);
+}
+
+AVSStatus AVSReadCurrent(uint8_t rail_sel, float *current_in_A)
+{
+	*current_in_A = rail_sel != AVS_VCORE_RAIL || chip.vcore == 0
+				? 0
+				: vcore_power() * 1000 / chip.vcore;
+
+	return AVSOk;
+}
+
+float GetAvgChipTemp(void)
+{
+	return 50.0F;
+}
+
+int GetMaxGDDRTemp(void)
+{
+	chip.evaluations++;
+
+	return 50;
+}
+
+uint16_t GetInputPower(void)
+{
+	return BOARD_POWER + vcore_power();
+}
+
+void UpdateTelemetryBoardPowerLimit(uint32_t power_limit)
+{
+	ARG_UNUSED(power_limit);
+}
+
+const FwTable *get_fw_table(void)
+{
+	return &fw_table;
+}
+
+static uint32_t evaluations_during(int32_t ms)
+{
+	uint32_t start = chip.evaluations;
+
+	k_msleep(ms);
+
+	return chip.evaluations - start;
+}
+
+/* Largest number of updates in a window of ms while DVFS is settled */
+static uint32_t max_idle_evaluations(int32_t ms)
+{
+	return ms / IDLE_PERIOD_MS + 1;
+}
+
+ZTEST(dvfs, test_idle_rate)
+{
+	uint32_t evaluations;
+
+	chip.load = 0.3F;
+	evaluations = evaluations_during(1000);
+
+	/* The fast updates before settling, then the idle rate */
+	zassert_true(evaluations <= SETTLE_UPDATES + max_idle_evaluations(1000), "%u updates",
+		     evaluations);
+	zassert_true(evaluations >= 1000 / IDLE_PERIOD_MS - 1, "%u updates", evaluations);
+	zassert_equal(aiclk_ppm.targ_freq, FMAX);
+	zassert_equal(chip.aiclk, FMAX);
+}
+
+ZTEST(dvfs, test_step_response)
+{
+	int64_t start;
+	int32_t response_ms;
+
+	chip.load = 0.3F;
+	k_msleep(200);
+
+	/* A step to full load is noticed by the next update, even while settled */
+	chip.load = 1.0F;
+	start = k_uptime_get();
+	while (chip.aiclk == FMAX && k_uptime_get() - start < 100) {
+		k_msleep(1);
+	}
+	response_ms = k_uptime_get() - start;
+
+	zassert_true(chip.aiclk < FMAX);
+	zassert_true(response_ms <= IDLE_PERIOD_MS + 1, "responded after %d ms", response_ms);
+
+	/* and DVFS runs at the fast rate while it holds Vcore power at the TDP limit */
+	zassert_true(evaluations_during(100) >= 95);
+	zassert_within(vcore_power(), TDP_LIMIT, 3, "%f W at %u MHz", (double)vcore_power(),
+		       chip.aiclk);
+}
+
+ZTEST(dvfs, test_recovery)
+{
+	uint32_t evaluations;
+
+	chip.load = 1.0F;
+	k_msleep(100);
+	zassert_true(chip.aiclk < FMAX);
+
+	/* Once the load goes away the arbiter recovers before DVFS slows down */
+	chip.load = 0.3F;
+	k_msleep(200);
+	zassert_equal(chip.aiclk, FMAX);
+
+	evaluations = evaluations_during(200);
+	zassert_true(evaluations <= max_idle_evaluations(200), "%u updates", evaluations);
+}
+
+ZTEST(dvfs, test_hysteresis)
+{
+	uint32_t evaluations;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_TT_BH_ARC_DVFS_ADAPTIVE);
+
+	/* 85% of the TDP limit, between the two thresholds, does not wake DVFS up */
+	chip.load = 0.85F * TDP_LIMIT / FULL_LOAD_POWER;
+	k_msleep(200);
+	evaluations = evaluations_during(100);
+	zassert_true(evaluations <= max_idle_evaluations(100), "%u updates", evaluations);
+
+	/* 95% does, without throttling */
+	chip.load = 0.95F * TDP_LIMIT / FULL_LOAD_POWER;
+	k_msleep(IDLE_PERIOD_MS + 1);
+	evaluations = evaluations_during(20);
+	zassert_true(evaluations >= 19, "%u updates", evaluations);
+	zassert_equal(chip.aiclk, FMAX);
+
+	/* and 85% then keeps it at the fast rate */
+	chip.load = 0.85F * TDP_LIMIT / FULL_LOAD_POWER;
+	evaluations = evaluations_during(100);
+	zassert_true(evaluations >= 95, "%u updates", evaluations);
+
+	/* until the input drops below 80% and stays there */
+	chip.load = 0.75F * TDP_LIMIT / FULL_LOAD_POWER;
+	k_msleep(SETTLE_UPDATES + 2 * IDLE_PERIOD_MS);
+	evaluations = evaluations_during(100);
+	zassert_true(evaluations <= max_idle_evaluations(100), "%u updates", evaluations);
+}
+
+ZTEST(dvfs, test_wake)
+{
+	int64_t wake;
+	uint32_t evaluations;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_TT_BH_ARC_DVFS_ADAPTIVE);
+
+	chip.load = 0.3F;
+	k_msleep(200);
+
+	/* AICLK_GO_LONG_IDLE lowers the busy arbiter and wakes DVFS */
+	evaluations = chip.evaluations;
+	wake = k_uptime_ticks();
+	SetAiclkArbMin(kAiclkArbMinBusy, FMIN);
+	WakeDVFS();
+	k_msleep(1);
+
+	zassert_true(chip.evaluations > evaluations);
+	zassert_equal(chip.aiclk, FMIN);
+	zassert_true(chip.aiclk_changed - wake < k_ms_to_ticks_ceil64(1));
+
+	/* and runs at the fast rate until it settles again */
+	evaluations = evaluations_during(SETTLE_UPDATES / 2);
+	zassert_true(evaluations >= SETTLE_UPDATES / 2 - 1, "%u updates", evaluations);
+	k_msleep(SETTLE_UPDATES + 2 * IDLE_PERIOD_MS);
+	evaluations = evaluations_during(100);
+	zassert_true(evaluations <= max_idle_evaluations(100), "%u updates", evaluations);
+}
+
+static void before(void *arg)
+{
+	uint8_t board_power_limit[2];
+
+	ARG_UNUSED(arg);
+
+	/* A workload is already running at FMAX, see AICLK_GO_BUSY */
+	memset(&chip, 0, sizeof(chip));
+	chip.aiclk = FMAX;
+
+	InitAiclkPPM();
+	InitDVFS();
+
+	sys_put_le16(BOARD_POWER_LIMIT, board_power_limit);
+	Dm2CmSetBoardPowerLimit(board_power_limit, sizeof(board_power_limit));
+	SetAiclkArbMin(kAiclkArbMinBusy, FMAX);
+
+	StartDVFSTimer();
+}
+
+static void after(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	/* Stops the scheduler until the next StartDVFSTimer() */
+	InitDVFS();
+	/* Let an update that was already submitted finish */
+	k_msleep(2);
+}
+
+ZTEST_SUITE(dvfs, NULL, NULL, before, after, NULL);
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/sys/util.h>
+
+#include "avs.h"
+#include "chip_model.h"
+#include "fw_table.h"
+#include "pll.h"
+#include "pvt.h"
+#include "regulator.h"
+#include "telemetry.h"
+
+#define BOOT_AICLK 800
+
+/* Junction to ambient, in degC/W */
+#define THERMAL_RESISTANCE      0.35F
+#define THERMAL_TIME_CONSTANT_MS 500.0F
+
+/* The rest of the board, and the efficiency of the Vcore regulator */
+#define BOARD_POWER      40.0F
+#define VCORE_EFFICIENCY 0.85F
+
+struct chip_model chip_model;
+
+/* The chip limits of a P150A */
+static const FwTable fw_table = {
+	.chip_limits = {
+		.asic_fmax = 1350,
+		.asic_fmin = 800,
+		.voltage_margin = 50,
+		.tdp_limit = 150,
+		.tdc_limit = 200,
+		.thm_limit = 90,
+		.tdc_fast_limit = 220,
+		.gddr_thm_limit = 85,
+		.board_power_limit = 300,
+	},
+};
+
+void chip_model_reset(const struct workload_phase *phase)
+{
+	memset(&chip_model, 0, sizeof(chip_model));
+	chip_model.aiclk = BOOT_AICLK;
+	chip_model.phase = phase;
+	chip_model.temperature = phase->ambient;
+}
+
+float chip_model_vcore_power(void)
+{
+	float f = (float)chip_model.aiclk / CHIP_MODEL_REF_AICLK;
+	float v = (float)chip_model.vcore / CHIP_MODEL_REF_VCORE;
+
+	return chip_model.phase->power * f * v * v;
+}
+
+float chip_model_vcore_current(void)
+{
+	return chip_model.vcore == 0 ? 0 : chip_model_vcore_power() * 1000 / chip_model.vcore;
+}
+
+float chip_model_input_power(void)
+{
+	return BOARD_POWER + chip_model_vcore_power() / VCORE_EFFICIENCY;
+}
+
+void chip_model_step(uint32_t ms)
+{
+	float steady = chip_model.phase->ambient + THERMAL_RESISTANCE * chip_model_vcore_power();
+
+	chip_model.temperature +=
+		(steady - chip_model.temperature) * MIN(ms / THERMAL_TIME_CONSTANT_MS, 1.0F);
+}
+
+/* PLL */
+uint32_t GetAICLK(void)
+{
+	return chip_model.aiclk;
+}
+
+void SetAICLK(uint32_t aiclk_in_mhz)
+{
+	chip_model.aiclk = aiclk_in_mhz;
+}
+
+/* Regulator */
+uint32_t get_vcore(void)
+{
+	return chip_model.vcore;
+}
+
+void set_vcore(uint32_t voltage_in_mv)
+{
+	chip_model.vcore = voltage_in_mv;
+}
+
+void set_vcorem(uint32_t voltage_in_mv)
+{
+	chip_model.vcorem = voltage_in_mv;
+}
+
+AVSStatus AVSReadCurrent(uint8_t rail_sel, float *current_in_A)
+{
+	*current_in_A = rail_sel == AVS_VCORE_RAIL ? chip_model_vcore_current() : 0;
+
+	return AVSOk;
+}
+
+/* PVT */
+float GetAvgChipTemp(void)
+{
+	return chip_model.temperature;
+}
+
+/* Telemetry and DMC */
+int GetMaxGDDRTemp(void)
+{
+	return chip_model.phase->gddr_temperature;
+}
+
+uint16_t GetInputPower(void)
+{
+	return chip_model_input_power();
+}
+
+void UpdateTelemetryBoardPowerLimit(uint32_t power_limit)
+{
+	ARG_UNUSED(power_limit);
+}
+
+const FwTable *get_fw_table(void)
+{
+	return &fw_table;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef CHIP_MODEL_H
+#define CHIP_MODEL_H
+
+#include <stdint.h>
+
+/* A part of a workload trace, with a constant load on the chip */
+struct workload_phase {
+	uint32_t duration_ms;
+	/* Vcore power at CHIP_MODEL_REF_AICLK and CHIP_MODEL_REF_VCORE, in W */
+	float power;
+	/* Temperature the ASIC cools down to, in degC */
+	float ambient;
+	/* GDDR temperature, in degC */
+	int gddr_temperature;
+};
+
+/* Operating point at which the workload power is given */
+#define CHIP_MODEL_REF_AICLK 1350
+#define CHIP_MODEL_REF_VCORE 850
+
+/*
+ * Model of the chip behind the stubbed PLL, regulator, PVT and telemetry layers. Power scales
+ * with f * V^2 from the reference operating point, the ASIC temperature follows power through
+ * a first order thermal model.
+ */
+struct chip_model {
+	uint32_t aiclk; /* MHz */
+	uint32_t vcore; /* mV */
+	uint32_t vcorem; /* mV */
+	float temperature; /* degC */
+	const struct workload_phase *phase;
+};
+
+extern struct chip_model chip_model;
+
+void chip_model_reset(const struct workload_phase *phase);
+void chip_model_step(uint32_t ms);
+float chip_model_vcore_power(void);
+float chip_model_vcore_current(void);
+float chip_model_input_power(void);
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#include "aiclk_ppm.h"
+#include "chip_model.h"
+#include "dvfs.h"
+#include "throttler.h"
+
+#define FMIN 800
+#define FMAX 1350
+
+#define MAX_PHASES   8
+#define MAX_PHASE_MS 5000
+
+/* AICLK is settled once it stays within this many MHz of where the phase ends */
+#define SETTLE_BAND_MHZ 10
+
+struct phase_report {
+	uint32_t settling_ms;
+	uint32_t final_aiclk;
+	float final_power;
+	float final_current;
+	float final_temperature;
+};
+
+struct sim_report {
+	uint32_t duration_ms;
+	float avg_aiclk;
+	uint32_t throttled_ms[kAiclkArbMaxCount];
+	struct phase_report phases[MAX_PHASES];
+};
+
+static const char *const arb_max_names[kAiclkArbMaxCount] = {
+	[kAiclkArbMaxFmax] = "fmax",
+	[kAiclkArbMaxTDP] = "tdp",
+	[kAiclkArbMaxFastTDC] = "fast_tdc",
+	[kAiclkArbMaxTDC] = "tdc",
+	[kAiclkArbMaxThm] = "thm",
+	[kAiclkArbMaxBoardPower] = "board_power",
+	[kAiclkArbMaxVoltage] = "voltage",
+	[kAiclkArbMaxGDDRThm] = "gddr_thm",
+};
+
+static uint16_t aiclk_history[MAX_PHASE_MS];
+
+/* Bring DVFS up the way SMC firmware does, with a workload running */
+static void start_dvfs(const struct workload_phase *phase)
+{
+	uint8_t board_power_limit[2];
+
+	chip_model_reset(phase);
+
+	InitAiclkPPM();
+	InitDVFS();
+
+	/* DMC reports the cable power limit after boot */
+	sys_put_le16(300, board_power_limit);
+	Dm2CmSetBoardPowerLimit(board_power_limit, sizeof(board_power_limit));
+
+	/* as if the host sent AICLK_GO_BUSY */
+	SetAiclkArbMin(kAiclkArbMinBusy, aiclk_ppm.fmax);
+
+	StartDVFSTimer();
+}
+
+static uint32_t settling_time(uint32_t duration_ms, uint32_t final_aiclk)
+{
+	uint32_t settled = 0;
+
+	for (uint32_t t = 0; t < duration_ms; t++) {
+		if (abs((int)aiclk_history[t] - (int)final_aiclk) > SETTLE_BAND_MHZ) {
+			settled = t + 1;
+		}
+	}
+
+	return settled;
+}
+
+/* Runs a workload trace against DVFS, sampling the chip every millisecond */
+static void run_trace(const char *name, const struct workload_phase *trace, size_t num_phases,
+		      struct sim_report *report)
+{
+	uint64_t aiclk_sum = 0;
+
+	zassert_true(num_phases <= MAX_PHASES);
+	memset(report, 0, sizeof(*report));
+	start_dvfs(&trace[0]);
+
+	for (size_t i = 0; i < num_phases; i++) {
+		struct phase_report *phase = &report->phases[i];
+
+		zassert_true(trace[i].duration_ms <= MAX_PHASE_MS);
+		chip_model.phase = &trace[i];
+
+		for (uint32_t t = 0; t < trace[i].duration_ms; t++) {
+			k_msleep(1);
+			chip_model_step(1);
+
+			aiclk_history[t] = chip_model.aiclk;
+			aiclk_sum += chip_model.aiclk;
+			for (AiclkArbMax arb = 0; arb < kAiclkArbMaxCount; arb++) {
+				if (aiclk_ppm.arbiter_max[arb] < aiclk_ppm.fmax) {
+					report->throttled_ms[arb]++;
+				}
+			}
+		}
+
+		phase->final_aiclk = chip_model.aiclk;
+		phase->settling_ms = settling_time(trace[i].duration_ms, phase->final_aiclk);
+		phase->final_power = chip_model_vcore_power();
+		phase->final_current = chip_model_vcore_current();
+		phase->final_temperature = chip_model.temperature;
+		report->duration_ms += trace[i].duration_ms;
+	}
+
+	report->avg_aiclk = (float)aiclk_sum / report->duration_ms;
+
+	TC_PRINT("%s: %u ms, average AICLK %.1f MHz\n", name, report->duration_ms,
+		 (double)report->avg_aiclk);
+	for (size_t i = 0; i < num_phases; i++) {
+		const struct phase_report *phase = &report->phases[i];
+
+		TC_PRINT("  phase %zu: settled after %u ms at %u MHz, %.1f W, %.1f A, %.1f C\n", i,
+			 phase->settling_ms, phase->final_aiclk, (double)phase->final_power,
+			 (double)phase->final_current, (double)phase->final_temperature);
+	}
+	for (AiclkArbMax arb = 0; arb < kAiclkArbMaxCount; arb++) {
+		if (report->throttled_ms[arb] > 0) {
+			TC_PRINT("  %s throttled for %u ms\n", arb_max_names[arb],
+				 report->throttled_ms[arb]);
+		}
+	}
+}
+
+static void assert_not_throttled(const struct sim_report *report, AiclkArbMax arb)
+{
+	zassert_equal(report->throttled_ms[arb], 0, "%s throttled for %u ms", arb_max_names[arb],
+		      report->throttled_ms[arb]);
+}
+
+ZTEST(dvfs_sim, test_light_load)
+{
+	static const struct workload_phase trace[] = {
+		{.duration_ms = 1000, .power = 60, .ambient = 40, .gddr_temperature = 50},
+	};
+	struct sim_report report;
+
+	run_trace("light load", trace, ARRAY_SIZE(trace), &report);
+
+	for (AiclkArbMax arb = 0; arb < kAiclkArbMaxCount; arb++) {
+		assert_not_throttled(&report, arb);
+	}
+	zassert_equal(report.phases[0].final_aiclk, FMAX);
+	zassert_true(report.avg_aiclk >= FMAX - 1);
+}
+
+ZTEST(dvfs_sim, test_power_step)
+{
+	static const struct workload_phase trace[] = {
+		{.duration_ms = 200, .power = 60, .ambient = 30, .gddr_temperature = 50},
+		{.duration_ms = 1500, .power = 220, .ambient = 30, .gddr_temperature = 50},
+		{.duration_ms = 500, .power = 60, .ambient = 30, .gddr_temperature = 50},
+	};
+	struct sim_report report;
+
+	run_trace("power step", trace, ARRAY_SIZE(trace), &report);
+
+	/* TDP holds Vcore power at its limit, and the fast TDC catches the first overshoot */
+	zassert_true(report.throttled_ms[kAiclkArbMaxTDP] >= 1000);
+	zassert_true(report.throttled_ms[kAiclkArbMaxFastTDC] > 0);
+	zassert_within(report.phases[1].final_power, 150, 3, "%f W",
+		       (double)report.phases[1].final_power);
+	zassert_true(report.phases[1].final_current <= 200);
+	zassert_true(report.phases[1].final_aiclk < FMAX);
+	zassert_true(report.phases[1].settling_ms <= 200, "%u ms", report.phases[1].settling_ms);
+
+	/* and AICLK recovers once the load goes away */
+	zassert_equal(report.phases[2].final_aiclk, FMAX);
+	zassert_true(report.phases[2].settling_ms <= 200, "%u ms", report.phases[2].settling_ms);
+
+	assert_not_throttled(&report, kAiclkArbMaxThm);
+	assert_not_throttled(&report, kAiclkArbMaxGDDRThm);
+}
+
+ZTEST(dvfs_sim, test_thermal)
+{
+	static const struct workload_phase trace[] = {
+		{.duration_ms = 4000, .power = 140, .ambient = 50, .gddr_temperature = 60},
+	};
+	struct sim_report report;
+
+	run_trace("thermal", trace, ARRAY_SIZE(trace), &report);
+
+	/* Below the TDP limit, but hot enough to be held at the thermal limit */
+	zassert_true(report.throttled_ms[kAiclkArbMaxThm] > 0);
+	zassert_within(report.phases[0].final_temperature, 90, 1, "%f C",
+		       (double)report.phases[0].final_temperature);
+	zassert_true(report.phases[0].final_aiclk < FMAX);
+	assert_not_throttled(&report, kAiclkArbMaxTDP);
+	assert_not_throttled(&report, kAiclkArbMaxGDDRThm);
+}
+
+ZTEST(dvfs_sim, test_gddr_thermal)
+{
+	static const struct workload_phase trace[] = {
+		{.duration_ms = 200, .power = 60, .ambient = 30, .gddr_temperature = 70},
+		{.duration_ms = 1000, .power = 60, .ambient = 30, .gddr_temperature = 88},
+		{.duration_ms = 1000, .power = 60, .ambient = 30, .gddr_temperature = 70},
+	};
+	struct sim_report report;
+
+	run_trace("gddr thermal", trace, ARRAY_SIZE(trace), &report);
+
+	/* GDDR temperature does not follow AICLK, so the throttler goes all the way to fmin */
+	zassert_equal(report.phases[1].final_aiclk, FMIN);
+	zassert_true(report.phases[1].settling_ms <= 500, "%u ms", report.phases[1].settling_ms);
+	zassert_equal(report.phases[2].final_aiclk, FMAX);
+	zassert_true(report.phases[2].settling_ms <= 500, "%u ms", report.phases[2].settling_ms);
+	assert_not_throttled(&report, kAiclkArbMaxTDP);
+}
+
+ZTEST_SUITE(dvfs_sim, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The DMC chip service of app/dmc, woken by its own deadline table and run against emulated ARC
+ * SMBus targets that count their transactions.
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/smbus.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <tenstorrent/bh_chip.h>
+#include <tenstorrent/event.h>
+#include <tenstorrent/tt_smbus_regs.h>
+
+#include "chip_service.h"
+
+#define NUM_CHIPS       2
+#define CM2DM_PERIOD_MS CONFIG_DMC_CM2DM_POLL_PERIOD_MS
+#define POWER_PERIOD_MS CONFIG_DMC_POWER_SAMPLE_PERIOD_MS
+#define FAN_PERIOD_MS   CONFIG_DMC_FAN_SAMPLE_PERIOD_MS
+
+/* The previous main loop woke every 20 ms and polled cm2dm, power and fan speed each time */
+#define LEGACY_XFERS(duration_ms) (3 * NUM_CHIPS * ((duration_ms) / 20))
+
+#define MAX_PENDING 16
+
+/* Emulated ARC SMBus target of one chip, with a queue of fan speed requests */
+struct chip_smbus_emul {
+	size_t num_xfers;
+	size_t num_cm2dm_polls;
+	/* Last word written to each register */
+	uint16_t regs[256];
+	/* Fan speeds requested by the CMFW, oldest first */
+	uint8_t pending[MAX_PENDING];
+	size_t num_pending;
+	size_t num_acked;
+	int64_t drained_ticks;
+};
+
+static struct chip_smbus_emul chip_smbus[NUM_CHIPS];
+
+static int chip_smbus_word_data_write(const struct device *dev, uint16_t addr, uint8_t cmd,
+				      uint16_t word)
+{
+	struct chip_smbus_emul *data = dev->data;
+	union cm2dmAckWire ack = {.val = word};
+
+	data->num_xfers++;
+	data->regs[cmd] = word;
+
+	if (cmd == CMFW_SMBUS_ACK_BATCH) {
+		/* The ack of the last message read also acks every message before it */
+		size_t num_acked = MIN(ack.f.seq_num - data->num_acked, data->num_pending);
+
+		data->num_pending -= num_acked;
+		memmove(data->pending, &data->pending[num_acked], data->num_pending);
+		data->num_acked += num_acked;
+		if (data->num_pending == 0) {
+			data->drained_ticks = k_uptime_ticks();
+		}
+	}
+
+	return 0;
+}
+
+static int chip_smbus_block_read(const struct device *dev, uint16_t addr, uint8_t cmd,
+				 uint8_t *count, uint8_t *buf)
+{
+	struct chip_smbus_emul *data = dev->data;
+	cm2dmMessage *msgs = (cm2dmMessage *)buf;
+	size_t num_msgs = MIN(data->num_pending, CMFW_SMBUS_REQ_BATCH_MAX);
+
+	data->num_xfers++;
+	if (cmd != CMFW_SMBUS_REQ_BATCH) {
+		return -EIO;
+	}
+	data->num_cm2dm_polls++;
+
+	if (num_msgs == 0) {
+		/* A null message when the queue is empty */
+		*count = sizeof(cm2dmMessage);
+		memset(buf, 0, *count);
+		return 0;
+	}
+
+	*count = num_msgs * sizeof(cm2dmMessage);
+	for (size_t i = 0; i < num_msgs; i++) {
+		msgs[i] = (cm2dmMessage){
+			.msg_id = kCm2DmMsgIdFanSpeedUpdate,
+			.seq_num = data->num_acked + i + 1,
+			.data = data->pending[i],
+		};
+	}
+
+	return 0;
+}
+
+static DEVICE_API(smbus, chip_smbus_api) = {
+	.smbus_word_data_write = chip_smbus_word_data_write,
+	.smbus_block_read = chip_smbus_block_read,
+};
+
+DEVICE_DEFINE(chip0_smbus_emul, "chip0_smbus_emul", NULL, NULL, &chip_smbus[0], NULL,
+	      POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &chip_smbus_api);
+DEVICE_DEFINE(chip1_smbus_emul, "chip1_smbus_emul", NULL, NULL, &chip_smbus[1], NULL,
+	      POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &chip_smbus_api);
+
+#define TEST_CHIP(_smbus)                                                                          \
+	{                                                                                          \
+		.config = {.arc = {.smbus = {.bus = DEVICE_GET(_smbus), .addr = 0xA}}},            \
+	}
+
+static struct bh_chip chips[NUM_CHIPS] = {
+	TEST_CHIP(chip0_smbus_emul),
+	TEST_CHIP(chip1_smbus_emul),
+};
+
+static const dmStaticInfo static_info;
+static const struct gpio_dt_spec no_fault_led;
+
+static int64_t reset_handled_ticks[NUM_CHIPS];
+static volatile int64_t perst_posted_ticks;
+
+/* Run the DMC main loop, without a work queue per chip, for at least @p duration_ms */
+static void run_dmc(uint32_t duration_ms)
+{
+	int64_t end_ms = k_uptime_get() + duration_ms;
+
+	while (k_uptime_get() < end_ms) {
+		uint32_t events = chip_service_wait();
+
+		ARRAY_FOR_EACH_PTR(chips, chip) {
+			bool trigger_reset = chip->data.trigger_reset;
+			uint32_t repost = service_chip(chip, events);
+
+			if (trigger_reset && !chip->data.trigger_reset) {
+				reset_handled_ticks[chip - chips] = k_uptime_ticks();
+			}
+
+			if (repost != 0) {
+				tt_event_post(repost);
+			}
+		}
+	}
+}
+
+static void perst_timer_expiry(struct k_timer *timer)
+{
+	ARRAY_FOR_EACH_PTR(chips, chip) {
+		chip->data.trigger_reset = true;
+	}
+
+	perst_posted_ticks = k_uptime_ticks();
+	tt_event_post(TT_EVENT_PERST);
+}
+
+static K_TIMER_DEFINE(perst_timer, perst_timer_expiry, NULL);
+
+ZTEST(tt_event, test_idle_bus_xfers)
+{
+	/* one poll per period, plus the one at the start */
+	const size_t expected = (1000 / CM2DM_PERIOD_MS + 1) + (1000 / POWER_PERIOD_MS + 1) +
+				(1000 / FAN_PERIOD_MS + 1);
+	size_t total = 0;
+
+	board_set_input_power(120);
+	board_set_fan_rpm(2500);
+	run_dmc(1000);
+
+	for (int i = 0; i < NUM_CHIPS; i++) {
+		zassert_true(chip_smbus[i].num_xfers <= expected,
+			     "chip %d: %zu bus transactions, expected at most %zu", i,
+			     chip_smbus[i].num_xfers, expected);
+		zassert_true(chip_smbus[i].num_cm2dm_polls >= 1000 / CM2DM_PERIOD_MS,
+			     "chip %d: cm2dm polled only %zu times", i,
+			     chip_smbus[i].num_cm2dm_polls);
+		zassert_equal(chip_smbus[i].regs[CMFW_SMBUS_POWER_INSTANT], 120);
+		zassert_equal(chip_smbus[i].regs[CMFW_SMBUS_FAN_RPM], 2500);
+		total += chip_smbus[i].num_xfers;
+	}
+
+	TC_PRINT("%zu bus transactions in 1 s, %u with fixed 20 ms polling\n", total,
+		 LEGACY_XFERS(1000));
+	zassert_true(total < LEGACY_XFERS(1000));
+}
+
+ZTEST(tt_event, test_perst_latency)
+{
+	/* PERST is asserted half-way between two polls */
+	k_timer_start(&perst_timer, K_MSEC(CM2DM_PERIOD_MS / 2 + 3), K_NO_WAIT);
+	run_dmc(2 * CM2DM_PERIOD_MS);
+
+	for (int i = 0; i < NUM_CHIPS; i++) {
+		int64_t latency = reset_handled_ticks[i] - perst_posted_ticks;
+
+		zassert_true(reset_handled_ticks[i] != 0, "chip %d: PERST not handled", i);
+		zassert_true(latency >= 0 && latency <= k_ms_to_ticks_ceil64(1),
+			     "chip %d: PERST handled after %lld ticks", i, latency);
+		zassert_true(chips[i].data.needs_reset);
+
+		/* handling PERST does not poll the chip, which is only polled when due */
+		zassert_true(chip_smbus[i].num_cm2dm_polls <= 3, "chip %d: cm2dm polled %zu times",
+			     i, chip_smbus[i].num_cm2dm_polls);
+	}
+}
+
+ZTEST(tt_event, test_cm2dm_drain)
+{
+	static const uint8_t speeds[] = {10, 20, 30, 40, 50, 60, 70};
+	int64_t start_ticks = k_uptime_ticks();
+
+	memcpy(chip_smbus[0].pending, speeds, sizeof(speeds));
+	chip_smbus[0].num_pending = ARRAY_SIZE(speeds);
+	run_dmc(CM2DM_PERIOD_MS / 2);
+
+	/* every queued message is handled at once, not one batch per poll period */
+	zassert_equal(chip_smbus[0].num_pending, 0);
+	zassert_equal(chip_smbus[0].num_acked, ARRAY_SIZE(speeds));
+	zassert_equal(board_get_fan_speed(), speeds[ARRAY_SIZE(speeds) - 1]);
+	zassert_true(chip_smbus[0].drained_ticks - start_ticks <= k_ms_to_ticks_ceil64(1),
+		     "messages drained after %lld ticks", chip_smbus[0].drained_ticks - start_ticks);
+
+	/* two batches, then an empty poll that leaves the rest to the deadline */
+	zassert_equal(chip_smbus[0].num_cm2dm_polls, 3, "cm2dm polled %zu times",
+		      chip_smbus[0].num_cm2dm_polls);
+	/* the other chip is polled again with the first batch drained, and then only when due */
+	zassert_equal(chip_smbus[1].num_cm2dm_polls, 2, "cm2dm polled %zu times",
+		      chip_smbus[1].num_cm2dm_polls);
+}
+
+ZTEST(tt_event, test_no_fan_sensor)
+{
+	/* a board without a fan controller never reports the fan speed */
+	board_set_fan_rpm(2500);
+	chip_service_init(&static_info, 0, &no_fault_led, TT_EVENT_POWER_SAMPLE);
+	run_dmc(2 * FAN_PERIOD_MS);
+
+	for (int i = 0; i < NUM_CHIPS; i++) {
+		zassert_equal(chip_smbus[i].regs[CMFW_SMBUS_FAN_RPM], 0);
+		zassert_true(chip_smbus[i].num_xfers >= 2 * FAN_PERIOD_MS / POWER_PERIOD_MS);
+	}
+}
+
+ZTEST(tt_event, test_signalled_rearm)
+{
+	struct tt_event_deadline deadlines[] = {
+		TT_EVENT_DEADLINE_INIT(TT_EVENT_CM2DM, 20),
+		TT_EVENT_DEADLINE_INIT(TT_EVENT_POWER_SAMPLE, 30),
+		TT_EVENT_DEADLINE_INIT(TT_EVENT_FAN_SAMPLE, 0),
+	};
+	int64_t start_ms = k_uptime_get();
+	uint32_t events;
+
+	/* every enabled deadline expires immediately the first time */
+	events = tt_event_wait_deadlines(TT_EVENT_MASK, deadlines, ARRAY_SIZE(deadlines));
+	zassert_equal(events, TT_EVENT_CM2DM | TT_EVENT_POWER_SAMPLE);
+	zassert_equal(k_uptime_get(), start_ms);
+
+	/* a signalled source pushes its own deadline back a full period, and no other */
+	k_msleep(15);
+	tt_event_post(TT_EVENT_CM2DM);
+	events = tt_event_wait_deadlines(TT_EVENT_MASK, deadlines, ARRAY_SIZE(deadlines));
+	zassert_equal(events, TT_EVENT_CM2DM);
+	zassert_equal(deadlines[0].next_ms, k_uptime_get() + 20);
+	zassert_equal(deadlines[1].next_ms, start_ms + 30);
+
+	/* the next wake is for the earliest deadline only */
+	events = tt_event_wait_deadlines(TT_EVENT_MASK, deadlines, ARRAY_SIZE(deadlines));
+	zassert_equal(events, TT_EVENT_POWER_SAMPLE);
+	zassert_equal(k_uptime_get(), start_ms + 30);
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	/* discard events left over from the previous test */
+	(void)tt_event_wait(TT_EVENT_MASK, K_NO_WAIT);
+
+	memset(chip_smbus, 0, sizeof(chip_smbus));
+	memset(reset_handled_ticks, 0, sizeof(reset_handled_ticks));
+	perst_posted_ticks = 0;
+
+	ARRAY_FOR_EACH_PTR(chips, chip) {
+		chip->data.trigger_reset = false;
+		chip->data.needs_reset = false;
+	}
+
+	board_set_input_power(0);
+	board_set_fan_rpm(0);
+	board_set_fan_speed(0);
+	chip_service_init(&static_info, 0, &no_fault_led,
+			  TT_EVENT_POWER_SAMPLE | TT_EVENT_FAN_SAMPLE);
+}
+
+ZTEST_SUITE(tt_event, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+
+#include <tenstorrent/jtag_bootrom.h>
+#include <zephyr/drivers/jtag.h>
+
+/* The size of the ARC CSM, the most a bootrom image can be */
+#define FULL_IMAGE_WORDS (512 * 1024 / sizeof(uint32_t))
+
+/* ARC AXI TDRs and control values, see drivers/jtag/axi.h */
+#define AXI_ADDR_TDR     2
+#define AXI_DATA_TDR     3
+#define AXI_CONTROL_TDR  4
+#define AXI_CNTL_READ    0x80000000
+#define AXI_CNTL_WRITE   0x8000010f
+#define AXI_CNTL_AUTOINC 0x40000000
+
+static struct bh_chip test_chip = {.config = {
+					   .jtag = DEVICE_DT_GET(DT_PATH(jtag)),
+					   .asic_reset = GPIO_DT_SPEC_GET(DT_PATH(mcureset), gpios),
+					   .spi_reset = GPIO_DT_SPEC_GET(DT_PATH(spireset), gpios),
+					   .pgood = GPIO_DT_SPEC_GET(DT_PATH(pgood), gpios),
+				   }};
+
+static uint32_t image[FULL_IMAGE_WORDS];
+
+static void fill_image(uint32_t seed)
+{
+	uint32_t x = seed;
+
+	/* xorshift32, so that every word is different and none are zero */
+	for (size_t i = 0; i < ARRAY_SIZE(image); ++i) {
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		image[i] = x;
+	}
+}
+
+/*
+ * The gpio-emul based emulator takes minutes over an image this size, this one a small fraction
+ * of a second. Time does not pass on native_sim while the CPU is busy, so that is left to the
+ * testcase timeout.
+ */
+ZTEST(jtag_axi_emul, test_full_size_bootrom)
+{
+	fill_image(0x12345678);
+
+	zassert_ok(jtag_bootrom_patch(&test_chip, image, ARRAY_SIZE(image)));
+	zassert_ok(jtag_bootrom_verify(test_chip.config.jtag, image, ARRAY_SIZE(image)));
+
+	/* and a single corrupted word is caught */
+	zassert_ok(jtag_axi_write32(test_chip.config.jtag, 0x1234 * sizeof(uint32_t),
+				    image[0x1234] ^ BIT(7)));
+	zassert_not_ok(jtag_bootrom_verify(test_chip.config.jtag, image, ARRAY_SIZE(image)));
+}
+
+ZTEST(jtag_axi_emul, test_bootcode)
+{
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = get_bootcode_len();
+
+	zassert_ok(jtag_bootrom_patch(&test_chip, patch, patch_len));
+	zassert_ok(jtag_bootrom_verify(test_chip.config.jtag, patch, patch_len));
+}
+
+ZTEST(jtag_axi_emul, test_sparse)
+{
+	const struct device *dev = test_chip.config.jtag;
+	const uint32_t addrs[] = {0x0, 0xffc, 0x1000, 0x10000000, 0x80030060, 0xfffffffc};
+	uint32_t readback;
+
+	for (size_t i = 0; i < ARRAY_SIZE(addrs); ++i) {
+		zassert_ok(jtag_axi_write32(dev, addrs[i], ~addrs[i]));
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(addrs); ++i) {
+		zassert_ok(jtag_axi_read32(dev, addrs[i], &readback));
+		zassert_equal(readback, ~addrs[i], "at %08x: expected %08x actual %08x", addrs[i],
+			      ~addrs[i], readback);
+	}
+
+	/* Memory that was never written reads as zero */
+	zassert_ok(jtag_axi_read32(dev, 0x20000000, &readback));
+	zassert_equal(readback, 0);
+
+	/* A block write that crosses a page */
+	fill_image(0xcafef00d);
+	zassert_ok(jtag_axi_block_write(dev, 0x40000ff0, image, 8));
+	for (size_t i = 0; i < 8; ++i) {
+		zassert_ok(jtag_axi_read32(dev, 0x40000ff0 + i * sizeof(uint32_t), &readback));
+		zassert_equal(readback, image[i]);
+	}
+
+	/* and read back as a block, with the words after it never written */
+	uint32_t block[12];
+
+	zassert_ok(jtag_axi_block_read(dev, 0x40000ff0, block, ARRAY_SIZE(block)));
+	zassert_mem_equal(block, image, 8 * sizeof(uint32_t));
+	for (size_t i = 8; i < ARRAY_SIZE(block); ++i) {
+		zassert_equal(block[i], 0);
+	}
+
+	zassert_equal(jtag_axi_write32(dev, 0x2, 0), -EINVAL);
+}
+
+/* A TDR select, then a TDR update, the way the bit-bang driver shifts them */
+static uint32_t tdr_update(const struct device *dev, uint8_t tdr, uint32_t value)
+{
+	uint8_t select = tdr + 1;
+	uint8_t dr[8] = {0};
+	uint8_t out[8] = {0};
+
+	zassert_ok(jtag_update_dr(dev, false, 5, &select, NULL));
+	sys_put_le64((uint64_t)value << 4, dr);
+	zassert_ok(jtag_update_dr(dev, true, 37, dr, out));
+
+	return sys_get_le64(out) >> 4;
+}
+
+ZTEST(jtag_axi_emul, test_tdr_protocol)
+{
+	const struct device *dev = test_chip.config.jtag;
+	/* ISCAN_SEL of the Tensix RTAP */
+	const uint8_t ir[] = {0x02, 0x03, 0x66};
+	uint32_t readback;
+
+	zassert_ok(jtag_update_ir(dev, 24, ir));
+
+	/* AXI write */
+	tdr_update(dev, AXI_ADDR_TDR, 0x100);
+	tdr_update(dev, AXI_DATA_TDR, 0xa5c3e1f0);
+	tdr_update(dev, AXI_CONTROL_TDR, AXI_CNTL_WRITE);
+	zassert_ok(jtag_axi_read32(dev, 0x100, &readback));
+	zassert_equal(readback, 0xa5c3e1f0, "expected %08x actual %08x", 0xa5c3e1f0, readback);
+
+	/* AXI read, with the data and status captured by the next update */
+	zassert_ok(jtag_axi_write32(dev, 0x200, 0x0badf00d));
+	tdr_update(dev, AXI_ADDR_TDR, 0x200);
+	tdr_update(dev, AXI_CONTROL_TDR, AXI_CNTL_READ);
+	zassert_equal(tdr_update(dev, AXI_CONTROL_TDR, 0) & 0xf, 0xf);
+	zassert_equal(tdr_update(dev, AXI_DATA_TDR, 0), 0x0badf00d);
+
+	/* Auto-increment, every data TDR update is a write */
+	tdr_update(dev, AXI_ADDR_TDR, 0x300);
+	tdr_update(dev, AXI_CONTROL_TDR, AXI_CNTL_WRITE | AXI_CNTL_AUTOINC);
+	for (uint32_t i = 0; i < 4; ++i) {
+		tdr_update(dev, AXI_DATA_TDR, i + 1);
+	}
+	tdr_update(dev, AXI_CONTROL_TDR, 0);
+	for (uint32_t i = 0; i < 4; ++i) {
+		zassert_ok(jtag_axi_read32(dev, 0x300 + i * sizeof(uint32_t), &readback));
+		zassert_equal(readback, i + 1);
+	}
+
+	/* Auto-increment reads, each data TDR capture is a word and its update reads the next */
+	tdr_update(dev, AXI_ADDR_TDR, 0x300);
+	tdr_update(dev, AXI_CONTROL_TDR, AXI_CNTL_READ | AXI_CNTL_AUTOINC);
+	for (uint32_t i = 0; i < 4; ++i) {
+		zassert_equal(tdr_update(dev, AXI_DATA_TDR, 0), i + 1);
+	}
+	tdr_update(dev, AXI_CONTROL_TDR, 0);
+	for (uint32_t i = 0; i < 4; ++i) {
+		zassert_ok(jtag_axi_read32(dev, 0x300 + i * sizeof(uint32_t), &readback));
+		zassert_equal(readback, i + 1);
+	}
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	zassert_ok(jtag_bootrom_init(&test_chip));
+	zassert_ok(jtag_bootrom_reset_asic(&test_chip));
+}
+
+static void after(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	jtag_bootrom_teardown(&test_chip);
+}
+
+ZTEST_SUITE(jtag_axi_emul, NULL, NULL, before, after, NULL);
@@ -0,0 +1,115 @@
+# Copyright (c) 2025 Tenstorrent AI ULC
+# SPDX-License-Identifier: Apache-2.0
+
+import os
+import struct
+import sys
+
+import pytest
+
+from pathlib import Path
+
+TEST_ROOT = Path(__file__).parent.resolve()
+MODULE_ROOT = TEST_ROOT.parents[4]
+
+sys.path.append(str(MODULE_ROOT / "scripts"))
+
+import bootrom_rle  # noqa: E402
+
+
+def _image(*words):
+    return struct.pack(f"<{len(words)}I", *words)
+
+
+def _records(data):
+    """Return the (op, count) of each record in an encoded stream"""
+    words = struct.unpack(f"<{len(data) // 4}I", data)
+    records = []
+    i = 2
+    while i < len(words):
+        op = words[i] >> bootrom_rle.OP_SHIFT
+        count = words[i] & bootrom_rle.COUNT_MAX
+        records.append((op, count))
+        i += 1 + (count if op == bootrom_rle.OP_LITERAL else op == bootrom_rle.OP_REPEAT)
+    return records
+
+
+@pytest.mark.parametrize(
+    "data",
+    [
+        b"",
+        _image(0x12345678),
+        _image(0, 0, 0, 0),
+        _image(7, 7, 7, 7, 7, 1, 0, 0, 2),
+        _image(0, 1, 0, 1, 0, 1),
+        bytes(4096) + os.urandom(1024) + b"\xa5" * 2048 + bytes(8192),
+    ],
+)
+def test_round_trip(data):
+    assert bootrom_rle.decode(bootrom_rle.encode(data)) == data
+
+
+def test_round_trip_bootcode():
+    data = (MODULE_ROOT / "zephyr/blobs/tt_blackhole_nano_bootcode.bin").read_bytes()
+    encoded = bootrom_rle.encode(data)
+
+    assert bootrom_rle.decode(encoded) == data
+    # An image with no runs costs the stream header and one record header
+    assert len(encoded) <= len(data) + 12
+
+
+def test_unaligned_is_padded():
+    assert bootrom_rle.decode(bootrom_rle.encode(b"\x01\x02\x03")) == b"\x01\x02\x03\x00"
+
+
+def test_records():
+    encoded = bootrom_rle.encode(_image(1, 2, 0, 0, 0, 5, 5, 5, 5, 3, 0))
+
+    assert _records(encoded) == [
+        (bootrom_rle.OP_LITERAL, 2),
+        (bootrom_rle.OP_ZERO, 3),
+        (bootrom_rle.OP_REPEAT, 4),
+        (bootrom_rle.OP_LITERAL, 2),
+    ]
+
+
+def test_zero_runs_are_free():
+    encoded = bootrom_rle.encode(bytes(512 * 1024))
+
+    assert len(encoded) == 12
+
+
+@pytest.mark.parametrize(
+    "data",
+    [
+        b"",
+        _image(0x12345678, 1),
+        # literal of two words with only one present
+        _image(bootrom_rle.MAGIC, 2, 2, 1),
+        # repeat with no word
+        _image(bootrom_rle.MAGIC, 2, (bootrom_rle.OP_REPEAT << bootrom_rle.OP_SHIFT) | 2),
+        # empty record
+        _image(bootrom_rle.MAGIC, 0, 0),
+        # unknown op
+        _image(bootrom_rle.MAGIC, 1, (3 << bootrom_rle.OP_SHIFT) | 1),
+        # wrong length
+        _image(bootrom_rle.MAGIC, 3, (bootrom_rle.OP_ZERO << bootrom_rle.OP_SHIFT) | 2),
+    ],
+)
+def test_malformed(data):
+    with pytest.raises(ValueError):
+        bootrom_rle.decode(data)
+
+
+def test_cli(tmp_path: Path):
+    data = bytes(64) + os.urandom(64) + b"\x5a" * 64
+    raw = tmp_path / "patch.bin"
+    encoded = tmp_path / "patch.rle"
+    decoded = tmp_path / "patch.out"
+
+    raw.write_bytes(data)
+    assert bootrom_rle.main(["compress", str(raw), str(encoded)]) == 0
+    assert bootrom_rle.main(["decompress", str(encoded), str(decoded)]) == 0
+    assert decoded.read_bytes() == data
+
+    assert bootrom_rle.main(["decompress", str(raw), str(decoded)]) == 1
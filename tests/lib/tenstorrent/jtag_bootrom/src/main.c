@@ -6,10 +6,25 @@
 
 #include <zephyr/ztest.h>
 #include <zephyr/drivers/gpio.h>
+#include <zephyr/sys/byteorder.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <tenstorrent/jtag_bootrom.h>
 #include <zephyr/drivers/jtag.h>
+#include <zephyr/sys/crc.h>
+
+/*
+ * Block transfers skip the IR scan and per-word status reads. Without auto-increment they still
+ * shift the address, data and control TDRs for every word, with it only the data TDR.
+ */
+#define BLOCK_TCKS_MAX(word_tcks)                                                                  \
+	(IS_ENABLED(CONFIG_JTAG_AXI_AUTO_INCREMENT) ? (word_tcks) / 2 : (word_tcks) * 3 / 4)
+
+/* ARC AXI control TDR value that starts a write, see drivers/jtag/axi.h */
+#define AXI_CNTL_WRITE 0x8000010f
+/* ARC AXI control TDR status once an access is done */
+#define AXI_STATUS_DONE 0xf
 
 static struct bh_chip test_chip = {.config = {
 					   .jtag = DEVICE_DT_GET(DT_PATH(jtag)),
@@ -18,6 +33,22 @@ static struct bh_chip test_chip = {.config = {
 					   .pgood = GPIO_DT_SPEC_GET(DT_PATH(pgood), gpios),
 				   }};
 
+/* Two chips sharing reset lines, with their own JTAG ports on the same GPIO port */
+static struct bh_chip gang_chips[] = {
+	{.config = {
+		 .jtag = DEVICE_DT_GET(DT_PATH(jtag)),
+		 .asic_reset = GPIO_DT_SPEC_GET(DT_PATH(mcureset), gpios),
+		 .spi_reset = GPIO_DT_SPEC_GET(DT_PATH(spireset), gpios),
+		 .pgood = GPIO_DT_SPEC_GET(DT_PATH(pgood), gpios),
+	 }},
+	{.config = {
+		 .jtag = DEVICE_DT_GET(DT_PATH(jtag1)),
+		 .asic_reset = GPIO_DT_SPEC_GET(DT_PATH(mcureset), gpios),
+		 .spi_reset = GPIO_DT_SPEC_GET(DT_PATH(spireset), gpios),
+		 .pgood = GPIO_DT_SPEC_GET(DT_PATH(pgood), gpios),
+	 }},
+};
+
 ZTEST(jtag_bootrom, test_jtag_bootrom)
 {
 	const uint32_t *const patch = (const uint32_t *)get_bootcode();
@@ -27,12 +58,428 @@ ZTEST(jtag_bootrom, test_jtag_bootrom)
 	zassert_ok(jtag_bootrom_verify(test_chip.config.jtag, patch, patch_len));
 }
 
+ZTEST(jtag_bootrom, test_jtag_axi_block_write_tck_count)
+{
+	const struct device *dev = test_chip.config.jtag;
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = MIN(get_bootcode_len(), 256);
+	size_t word_tcks;
+	size_t block_tcks;
+	uint32_t readback;
+
+	/*
+	 * Write the inverse word-by-word first, so the block write has to overwrite all of it.
+	 * The emulator does not drive TDO, so write status is not meaningful here.
+	 */
+	word_tcks = jtag_emul_tck_count(dev);
+	for (size_t i = 0; i < patch_len; ++i) {
+		(void)jtag_axi_write32(dev, i * sizeof(uint32_t), ~patch[i]);
+	}
+	word_tcks = jtag_emul_tck_count(dev) - word_tcks;
+
+	block_tcks = jtag_emul_tck_count(dev);
+	(void)jtag_axi_block_write(dev, 0, patch, patch_len);
+	block_tcks = jtag_emul_tck_count(dev) - block_tcks;
+
+	for (size_t i = 0; i < patch_len; ++i) {
+		zassert_ok(jtag_emul_axi_read32(dev, i * sizeof(uint32_t), &readback));
+		zassert_equal(readback, patch[i], "mismatch at %zu: expected %08x actual %08x", i,
+			      patch[i], readback);
+	}
+
+	TC_PRINT("%zu words: %zu TCKs word-by-word, %zu TCKs streamed\n", patch_len, word_tcks,
+		 block_tcks);
+	zassert_true(block_tcks < BLOCK_TCKS_MAX(word_tcks), "expected fewer TCKs when streamed");
+}
+
+ZTEST(jtag_bootrom, test_jtag_axi_write_io_count)
+{
+	const struct device *dev = test_chip.config.jtag;
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = MIN(get_bootcode_len(), 256);
+	size_t tcks;
+	size_t ios;
+	uint32_t readback;
+
+	tcks = jtag_emul_tck_count(dev);
+	ios = jtag_emul_io_count(dev);
+	(void)jtag_axi_write32(dev, 0, ~patch[0]);
+	tcks = jtag_emul_tck_count(dev) - tcks;
+	ios = jtag_emul_io_count(dev) - ios;
+
+	zassert_ok(jtag_emul_axi_read32(dev, 0, &readback));
+	zassert_equal(readback, ~patch[0]);
+	TC_PRINT("AXI write: %zu TCKs, %zu pin writes\n", tcks, ios);
+
+	/*
+	 * Pin writes are counted by the GPIO emulator. Two TCK writes per cycle, with TMS and TDI
+	 * only written when they change. Writing both on every cycle took 898 pin writes for the
+	 * 229 cycles of an AXI write.
+	 */
+	zassert_true(ios < 3 * tcks, "%zu pin writes for %zu TCKs", ios, tcks);
+
+	tcks = jtag_emul_tck_count(dev);
+	ios = jtag_emul_io_count(dev);
+	(void)jtag_axi_block_write(dev, 0, patch, patch_len);
+	tcks = jtag_emul_tck_count(dev) - tcks;
+	ios = jtag_emul_io_count(dev) - ios;
+
+	for (size_t i = 0; i < patch_len; ++i) {
+		zassert_ok(jtag_emul_axi_read32(dev, i * sizeof(uint32_t), &readback));
+		zassert_equal(readback, patch[i], "mismatch at %zu: expected %08x actual %08x", i,
+			      patch[i], readback);
+	}
+
+	TC_PRINT("AXI block write: %zu TCKs, %zu pin writes per word\n", tcks / patch_len,
+		 ios / patch_len);
+	zassert_true(ios < 3 * tcks, "%zu pin writes for %zu TCKs", ios, tcks);
+}
+
+ZTEST(jtag_bootrom, test_jtag_update_dr)
+{
+	const struct device *dev = test_chip.config.jtag;
+	/* ISCAN_SEL of the Tensix RTAP */
+	const uint8_t ir[] = {0x02, 0x03, 0x66};
+	/* ARC AXI address, data and control TDRs, plus one */
+	const uint8_t addr_tdr = 3;
+	const uint8_t data_tdr = 4;
+	const uint8_t ctrl_tdr = 5;
+	const uint32_t addr = 0x40;
+	const uint32_t value = 0xa5c3e1f0;
+	uint8_t dr[13] = {0};
+	uint32_t readback;
+
+	zassert_ok(jtag_update_ir(dev, 24, ir));
+
+	zassert_ok(jtag_update_dr(dev, false, 5, &addr_tdr, NULL));
+	sys_put_le64((uint64_t)addr << 4, dr);
+	zassert_ok(jtag_update_dr(dev, false, 37, dr, NULL));
+
+	/*
+	 * A scan longer than 64 bits, with the 37 bit TDR value in its last bits. The bits before
+	 * it are shifted through the TDR.
+	 */
+	zassert_ok(jtag_update_dr(dev, false, 5, &data_tdr, NULL));
+	memset(dr, 0, sizeof(dr));
+	for (int i = 0; i < 32; ++i) {
+		if (value & BIT(i)) {
+			dr[(67 + i) / 8] |= BIT((67 + i) % 8);
+		}
+	}
+	zassert_ok(jtag_update_dr(dev, false, 100, dr, NULL));
+
+	/* The write itself is started by a control TDR update */
+	zassert_ok(jtag_update_dr(dev, false, 5, &ctrl_tdr, NULL));
+	sys_put_le64((uint64_t)AXI_CNTL_WRITE << 4, dr);
+	zassert_ok(jtag_update_dr(dev, true, 37, dr, NULL));
+
+	zassert_ok(jtag_emul_axi_read32(dev, addr, &readback));
+	zassert_equal(readback, value, "expected %08x actual %08x", value, readback);
+}
+
+ZTEST(jtag_bootrom, test_jtag_axi_block_read)
+{
+	const struct device *dev = test_chip.config.jtag;
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = get_bootcode_len();
+	uint32_t *sram = malloc(patch_len * sizeof(uint32_t));
+	uint32_t *readback = malloc(patch_len * sizeof(uint32_t));
+	size_t word_tcks;
+	size_t block_tcks;
+
+	zassert_not_null(sram);
+	zassert_not_null(readback);
+
+	memcpy(sram, patch, patch_len * sizeof(uint32_t));
+	jtag_emul_setup(dev, sram, patch_len);
+
+	word_tcks = jtag_emul_tck_count(dev);
+	for (size_t i = 0; i < patch_len; ++i) {
+		zassert_ok(jtag_axi_read32(dev, i * sizeof(uint32_t), &readback[i]));
+		zassert_equal(readback[i], patch[i], "mismatch at %zu: expected %08x actual %08x",
+			      i, patch[i], readback[i]);
+	}
+	word_tcks = jtag_emul_tck_count(dev) - word_tcks;
+
+	memset(readback, 0, patch_len * sizeof(uint32_t));
+	block_tcks = jtag_emul_tck_count(dev);
+	zassert_ok(jtag_axi_block_read(dev, 0, readback, patch_len));
+	block_tcks = jtag_emul_tck_count(dev) - block_tcks;
+
+	for (size_t i = 0; i < patch_len; ++i) {
+		zassert_equal(readback[i], patch[i], "mismatch at %zu: expected %08x actual %08x",
+			      i, patch[i], readback[i]);
+		/* and reads leave memory as it was */
+		zassert_equal(sram[i], patch[i]);
+	}
+
+	/* Lengths that end part way through a batch of reads */
+	for (size_t len = 1; len < 20; len += 3) {
+		memset(readback, 0, patch_len * sizeof(uint32_t));
+		zassert_ok(jtag_axi_block_read(dev, 2 * sizeof(uint32_t), readback, len));
+		zassert_mem_equal(readback, &patch[2], len * sizeof(uint32_t));
+		/* without starting a read past the end of the block */
+		zassert_equal(jtag_emul_axi_last_read(dev), (2 + len - 1) * sizeof(uint32_t),
+			      "len %zu: last read at %08x", len, jtag_emul_axi_last_read(dev));
+	}
+
+	TC_PRINT("%zu words: %zu TCKs word-by-word, %zu TCKs pipelined\n", patch_len, word_tcks,
+		 block_tcks);
+	zassert_true(block_tcks < BLOCK_TCKS_MAX(word_tcks), "expected fewer TCKs when pipelined");
+
+	free(sram);
+	free(readback);
+}
+
+ZTEST(jtag_bootrom, test_jtag_axi_block_read_error)
+{
+	const struct device *dev = test_chip.config.jtag;
+	uint32_t sram[20];
+	uint32_t readback[ARRAY_SIZE(sram)];
+
+	for (size_t i = 0; i < ARRAY_SIZE(sram); ++i) {
+		sram[i] = 0x01010101 * i;
+	}
+	jtag_emul_setup(dev, sram, ARRAY_SIZE(sram));
+
+	/* An AXI access that never completes fails the whole block */
+	jtag_emul_set_axi_status(dev, 0);
+	zassert_equal(jtag_axi_block_read(dev, 0, readback, ARRAY_SIZE(readback)), -EIO);
+	jtag_emul_set_axi_status(dev, AXI_STATUS_DONE);
+
+	/* So does a single read in the middle that was not done when its data was captured */
+	if (!IS_ENABLED(CONFIG_JTAG_AXI_AUTO_INCREMENT)) {
+		jtag_emul_set_axi_pending_read(dev, 5 * sizeof(uint32_t));
+		zassert_equal(jtag_axi_block_read(dev, 0, readback, ARRAY_SIZE(readback)), -EIO);
+		jtag_emul_set_axi_pending_read(dev, UINT32_MAX);
+	}
+
+	zassert_ok(jtag_axi_block_read(dev, 0, readback, ARRAY_SIZE(readback)));
+	zassert_mem_equal(readback, sram, sizeof(sram));
+}
+
+ZTEST(jtag_bootrom, test_jtag_bootrom_verify_bit_flip)
+{
+	const struct device *dev = test_chip.config.jtag;
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = get_bootcode_len();
+	uint32_t *sram = calloc(patch_len, sizeof(uint32_t));
+
+	zassert_not_null(sram);
+	jtag_emul_setup(dev, sram, patch_len);
+
+	zassert_ok(jtag_bootrom_patch(&test_chip, patch, patch_len));
+	zassert_ok(jtag_bootrom_verify(dev, patch, patch_len));
+
+	/* A single flipped bit, in the last word so that every chunk is compared before it */
+	sram[patch_len - 1] ^= BIT(17);
+	zassert_not_ok(jtag_bootrom_verify(dev, patch, patch_len));
+
+	free(sram);
+}
+
+#ifdef CONFIG_TT_JTAG_BOOTROM_VERIFY_CRC
+/* What the ARC does once released from reset: CRC the patch and write it after the patch */
+static void arc_write_crc(uint32_t *sram, size_t patch_len)
+{
+	sram[patch_len] = crc32_ieee((const uint8_t *)sram, patch_len * sizeof(uint32_t));
+}
+
+ZTEST(jtag_bootrom, test_jtag_bootrom_verify_crc)
+{
+	const struct device *dev = test_chip.config.jtag;
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = get_bootcode_len();
+	const uint32_t crc_addr = patch_len * sizeof(uint32_t);
+	const uint32_t crc = jtag_bootrom_crc(patch, patch_len);
+	uint32_t *sram = calloc(patch_len + 1, sizeof(uint32_t));
+	size_t tcks;
+
+	zassert_not_null(sram);
+	jtag_emul_setup(dev, sram, patch_len + 1);
+
+	zassert_ok(jtag_bootrom_patch(&test_chip, patch, patch_len));
+	zassert_ok(jtag_bootrom_crc_arm(dev, crc_addr, crc));
+	zassert_equal(sram[patch_len], ~crc);
+
+	/* Not written by the ARC */
+	zassert_equal(jtag_bootrom_verify_crc(dev, crc_addr, crc, 5), -ETIMEDOUT);
+
+	arc_write_crc(sram, patch_len);
+	tcks = jtag_emul_tck_count(dev);
+	zassert_ok(jtag_bootrom_verify_crc(dev, crc_addr, crc, 5));
+	tcks = jtag_emul_tck_count(dev) - tcks;
+	TC_PRINT("%zu words: %zu TCKs to compare the CRC\n", patch_len, tcks);
+
+	/* A single flipped bit */
+	zassert_ok(jtag_bootrom_crc_arm(dev, crc_addr, crc));
+	sram[patch_len / 2] ^= BIT(0);
+	arc_write_crc(sram, patch_len);
+	zassert_equal(jtag_bootrom_verify_crc(dev, crc_addr, crc, 5), 1);
+
+	free(sram);
+}
+#endif
+
+/* TCK of both chips, on the same port */
+static const struct gpio_dt_spec gang_tck[] = {
+	GPIO_DT_SPEC_GET(DT_PATH(jtag), tck_gpios),
+	GPIO_DT_SPEC_GET(DT_PATH(jtag1), tck_gpios),
+};
+static struct gpio_callback gang_tck_cb;
+static size_t gang_tck_writes;
+
+/* A port write that drives the TCK of both chips takes as long as one that drives a single TCK */
+static void gang_tck_callback(const struct device *port, struct gpio_callback *cb,
+			      gpio_port_pins_t pins)
+{
+	++gang_tck_writes;
+}
+
+/* TCK cycles clocked out on the port by the load, each a rising and a falling TCK write */
+static size_t gang_load_cycles(struct bh_chip *chips, size_t num_chips, const uint32_t *patch,
+			       size_t patch_len)
+{
+	size_t writes = gang_tck_writes;
+
+	zassert_ok(jtag_bootrom_patch_chips_offset(chips, num_chips, patch, patch_len, 0));
+
+	return (gang_tck_writes - writes) / 2;
+}
+
+ZTEST(jtag_bootrom, test_jtag_bootrom_gang)
+{
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = get_bootcode_len();
+	const struct device *dev0 = gang_chips[0].config.jtag;
+	const struct device *dev1 = gang_chips[1].config.jtag;
+	uint32_t *sram0 = malloc(patch_len * sizeof(uint32_t));
+	uint32_t *sram1 = malloc(patch_len * sizeof(uint32_t));
+	size_t single_cycles;
+	size_t gang_cycles;
+	uint32_t readback;
+
+	zassert_not_null(sram0);
+	zassert_not_null(sram1);
+
+	zassert_ok(jtag_bootrom_reset_asics(gang_chips, ARRAY_SIZE(gang_chips)));
+	jtag_emul_setup(dev0, sram0, patch_len);
+	jtag_emul_setup(dev1, sram1, patch_len);
+
+	gpio_init_callback(&gang_tck_cb, gang_tck_callback,
+			   BIT(gang_tck[0].pin) | BIT(gang_tck[1].pin));
+	zassert_ok(gpio_add_callback(gang_tck[0].port, &gang_tck_cb));
+
+	single_cycles = gang_load_cycles(gang_chips, 1, patch, patch_len);
+
+	memset(sram0, 0, patch_len * sizeof(uint32_t));
+	gang_cycles = gang_load_cycles(gang_chips, ARRAY_SIZE(gang_chips), patch, patch_len);
+
+	zassert_ok(gpio_remove_callback(gang_tck[0].port, &gang_tck_cb));
+
+	for (size_t i = 0; i < patch_len; ++i) {
+		zassert_ok(jtag_emul_axi_read32(dev0, i * sizeof(uint32_t), &readback));
+		zassert_equal(readback, patch[i], "chip 0 mismatch at %zu", i);
+		zassert_ok(jtag_emul_axi_read32(dev1, i * sizeof(uint32_t), &readback));
+		zassert_equal(readback, patch[i], "chip 1 mismatch at %zu", i);
+	}
+
+	/* Both chips are patched in about the time it takes to patch one */
+	TC_PRINT("one chip: %zu TCK cycles, two chips: %zu TCK cycles\n", single_cycles,
+		 gang_cycles);
+	zassert_true(gang_cycles < single_cycles + single_cycles / 10, "%zu TCK cycles",
+		     gang_cycles);
+
+	/* and each chip can be driven on its own afterwards */
+	zassert_equal(jtag_gang(dev0, dev0), -EINVAL);
+	(void)jtag_axi_write32(dev1, 0, ~patch[0]);
+	zassert_ok(jtag_emul_axi_read32(dev1, 0, &readback));
+	zassert_equal(readback, ~patch[0]);
+	zassert_ok(jtag_emul_axi_read32(dev0, 0, &readback));
+	zassert_equal(readback, patch[0]);
+
+	jtag_bootrom_teardown(&gang_chips[1]);
+	free(sram0);
+	free(sram1);
+}
+
+ZTEST(jtag_bootrom, test_jtag_bootrom_rle)
+{
+	const struct device *dev = test_chip.config.jtag;
+	/* Longer runs than the decoder's fill buffer, so that they take more than one write */
+	uint32_t rle[] = {
+		JTAG_BOOTROM_RLE_MAGIC,
+		3 + 40 + 50 + 2,
+		JTAG_BOOTROM_RLE_HEADER(JTAG_BOOTROM_RLE_OP_LITERAL, 3),
+		0x11111111,
+		0x22222222,
+		0x33333333,
+		JTAG_BOOTROM_RLE_HEADER(JTAG_BOOTROM_RLE_OP_REPEAT, 40),
+		0xdeadbeef,
+		JTAG_BOOTROM_RLE_HEADER(JTAG_BOOTROM_RLE_OP_ZERO, 50),
+		JTAG_BOOTROM_RLE_HEADER(JTAG_BOOTROM_RLE_OP_LITERAL, 2),
+		0x44444444,
+		0x55555555,
+	};
+	uint32_t image[3 + 40 + 50 + 2] = {0x11111111, 0x22222222, 0x33333333};
+	uint32_t sram[ARRAY_SIZE(image)];
+	uint32_t readback;
+
+	for (size_t i = 3; i < 43; ++i) {
+		image[i] = 0xdeadbeef;
+	}
+	image[93] = 0x44444444;
+	image[94] = 0x55555555;
+
+	zassert_equal(jtag_bootrom_rle_len(rle, ARRAY_SIZE(rle)), ARRAY_SIZE(image));
+
+	/* Zeros have to be written, unless the memory is known to be clear */
+	memset(sram, IS_ENABLED(CONFIG_TT_JTAG_BOOTROM_SKIP_ZERO) ? 0 : 0xff, sizeof(sram));
+	jtag_emul_setup(dev, sram, ARRAY_SIZE(sram));
+
+	zassert_ok(jtag_bootrom_patch_chips_rle_offset(&test_chip, 1, rle, ARRAY_SIZE(rle), 0));
+
+	for (size_t i = 0; i < ARRAY_SIZE(image); ++i) {
+		zassert_ok(jtag_emul_axi_read32(dev, i * sizeof(uint32_t), &readback));
+		zassert_equal(readback, image[i], "mismatch at %zu: expected %08x actual %08x", i,
+			      image[i], readback);
+	}
+	zassert_ok(jtag_bootrom_verify(dev, image, ARRAY_SIZE(image)));
+	zassert_ok(jtag_bootrom_verify_rle(dev, rle, ARRAY_SIZE(rle)));
+
+	/* A word in the zero run that was not cleared is caught */
+	(void)jtag_axi_write32(dev, 60 * sizeof(uint32_t), 1);
+	zassert_not_ok(jtag_bootrom_verify_rle(dev, rle, ARRAY_SIZE(rle)));
+
+	/* and malformed streams are not written */
+	rle[1] += 1;
+	zassert_equal(jtag_bootrom_rle_len(rle, ARRAY_SIZE(rle)), -EINVAL);
+	zassert_equal(jtag_bootrom_patch_chips_rle_offset(&test_chip, 1, rle, ARRAY_SIZE(rle), 0),
+		      -EINVAL);
+	rle[1] -= 1;
+	zassert_equal(jtag_bootrom_rle_len(rle, ARRAY_SIZE(rle) - 1), -EINVAL);
+}
+
+#ifdef CONFIG_TT_JTAG_BOOTROM_COMPRESSED
+ZTEST(jtag_bootrom, test_jtag_bootrom_rle_bootcode)
+{
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = get_bootcode_len();
+
+	zassert_equal(jtag_bootrom_rle_len(get_bootcode_rle(), get_bootcode_rle_len()), patch_len);
+
+	zassert_ok(jtag_bootrom_patch_chips_rle_offset(&test_chip, 1, get_bootcode_rle(),
+						       get_bootcode_rle_len(), 0));
+	zassert_ok(jtag_bootrom_verify(test_chip.config.jtag, patch, patch_len));
+}
+#endif
+
 static void before(void *arg)
 {
 	ARG_UNUSED(arg);
 
 	/* discarded if no zephyr,gpio-emul exists or if CONFIG_JTAG_VERIFY_WRITE=n */
-	__aligned(sizeof(uint32_t)) uint8_t *sram = malloc(get_bootcode_len() * sizeof(uint8_t));
+	__aligned(sizeof(uint32_t)) uint8_t *sram = malloc(get_bootcode_len() * sizeof(uint32_t));
 	const size_t patch_len = get_bootcode_len();
 
 	zassert_ok(jtag_bootrom_init(&test_chip));
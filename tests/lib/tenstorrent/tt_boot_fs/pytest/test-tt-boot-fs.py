@@ -382,3 +382,87 @@ def test_tt_boot_fs_ls(tmp_path: Path):
     assert not tt_boot_fs.ls(
         get_corrupted_test_image_path(tmp_path)
     ), "tt_boot_fs.ls() succeeded with invalid image"
+
+
+def gen_boot_fs(num_images: int, index: bool) -> tt_boot_fs.BootFs:
+    order = []
+    entries = {}
+    spi_addr = tt_boot_fs.IMAGE_ADDR
+    for i in range(num_images):
+        tag = f"image{i}"
+        data = (0x42427373 + i).to_bytes(4, "little")
+        entries[tag] = tt_boot_fs.FsEntry(
+            tag=tag,
+            data=data,
+            spi_addr=spi_addr,
+            load_addr=None,
+            executable=False,
+            provisioning_only=False,
+        )
+        order.append(tag)
+        spi_addr = _align_up(spi_addr + len(data), TEST_ALIGNMENT)
+
+    failover = tt_boot_fs.FsEntry(
+        tag="failover",
+        data=b"\x73\x73\x42\x42",
+        spi_addr=spi_addr,
+        load_addr=0x1000000,
+        executable=False,
+        provisioning_only=False,
+    )
+
+    return tt_boot_fs.BootFs(order, entries, failover, index)
+
+
+def test_tt_boot_fs_index(tmp_path: Path):
+    """
+    Test the optional descriptor index for both the indexed and legacy layouts.
+
+    Use more images than the default descriptor cache in firmware holds.
+    """
+    num_images = 20
+
+    for index in (False, True):
+        data = gen_boot_fs(num_images, index).to_binary()
+        fs = tt_boot_fs.BootFs.from_binary(data, alignment=TEST_ALIGNMENT)
+        assert fs.index == index
+
+        tags = [f"image{i}" for i in range(num_images)]
+        buckets = tt_boot_fs.read_index(lambda addr, size: data[addr : addr + size], tags)
+        if not index:
+            assert buckets is None
+            continue
+
+        # every tag must resolve to its own descriptor by probing from its hash
+        for slot, tag in enumerate(tags):
+            bucket = tt_boot_fs.tag_hash(tag) % len(buckets)
+            while buckets[bucket] != slot:
+                assert buckets[bucket] != tt_boot_fs.INDEX_EMPTY, f"{tag} not in index"
+                bucket = (bucket + 1) % len(buckets)
+
+        # a corrupted index must fail the filesystem check
+        corrupted = bytearray(data)
+        corrupted[tt_boot_fs.INDEX_ADDR + 16] ^= 0x01
+        pth = tmp_path / "indexed.bin.corrupted"
+        with open(pth, "wb") as f:
+            f.write(corrupted)
+        assert not tt_boot_fs.fsck(pth), "tt_boot_fs.fsck() accepted a corrupted index"
+
+
+def test_tt_boot_fs_tag_hash():
+    """
+    Test the tag hash used by the descriptor index.
+
+    This test is intentionally consistent with the accompanying C ZTest in src/main.c.
+    """
+    assert tt_boot_fs.tag_hash("") == 0x9BE17165
+    assert tt_boot_fs.tag_hash("cmfw") == 0x725EE8B2
+
+
+def test_tt_boot_fs_mkfs_index():
+    """
+    Test the ability to make a tt_boot_fs with a descriptor index.
+    """
+    data = tt_boot_fs.mkfs(TEST_ROOT / "p100.yml", index=True)
+    assert data is not None, "tt_boot_fs.mkfs() failed"
+    assert tt_boot_fs.BootFs.from_binary(data).index
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fake_flash.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <tenstorrent/tt_boot_fs.h>
+
+uint8_t fake_flash[FAKE_FLASH_SIZE];
+size_t fake_flash_num_reads;
+
+int fake_flash_read(uint32_t addr, uint32_t size, uint8_t *dst)
+{
+	if (addr + size > sizeof(fake_flash)) {
+		return -EIO;
+	}
+
+	memcpy(dst, &fake_flash[addr], size);
+	fake_flash_num_reads++;
+
+	return 0;
+}
+
+int fake_flash_write(uint32_t addr, uint32_t size, const uint8_t *src)
+{
+	if (addr + size > sizeof(fake_flash)) {
+		return -EIO;
+	}
+
+	for (uint32_t i = 0; i < size; i++) {
+		fake_flash[addr + i] &= src[i];
+	}
+
+	return 0;
+}
+
+void fake_flash_erase(void)
+{
+	memset(fake_flash, 0xff, sizeof(fake_flash));
+}
+
+/* Reference checksum, zero-padding a trailing partial word like cksum() in tt_boot_fs.py */
+static uint32_t data_cksum(const uint8_t *data, size_t size)
+{
+	uint32_t cksum = 0;
+
+	for (size_t i = 0; i < size; i += sizeof(uint32_t)) {
+		uint32_t word = 0;
+
+		for (size_t j = 0; j < sizeof(uint32_t) && i + j < size; j++) {
+			word |= (uint32_t)data[i + j] << (8 * j);
+		}
+		cksum += word;
+	}
+
+	return cksum;
+}
+
+void fake_flash_add_file(uint32_t slot, const uint8_t *tag, uint32_t spi_addr, const uint8_t *data,
+			 size_t size)
+{
+	tt_boot_fs_fd fd = {
+		.spi_addr = spi_addr,
+		.flags.f.image_size = size,
+		.data_crc = data_cksum(data, size),
+	};
+
+	memcpy(&fake_flash[spi_addr], data, size);
+	memcpy(fd.image_tag, tag, TT_BOOT_FS_IMAGE_TAG_SIZE);
+	fd.fd_crc = data_cksum((uint8_t *)&fd, sizeof(fd) - sizeof(uint32_t));
+
+	memcpy(&fake_flash[TT_BOOT_FS_FD_HEAD_ADDR + slot * sizeof(fd)], &fd, sizeof(fd));
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef FAKE_FLASH_H_
+#define FAKE_FLASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FAKE_FLASH_SIZE       0x16000
+#define FAKE_FLASH_IMAGE_ADDR 0x14000
+
+extern uint8_t fake_flash[FAKE_FLASH_SIZE];
+extern size_t fake_flash_num_reads;
+
+/* tt_boot_fs_read implementation backed by fake_flash, counting every read */
+int fake_flash_read(uint32_t addr, uint32_t size, uint8_t *dst);
+
+/* tt_boot_fs_write implementation backed by fake_flash, which only clears bits like NOR flash */
+int fake_flash_write(uint32_t addr, uint32_t size, const uint8_t *src);
+
+/* Erase the whole fake flash to 0xff */
+void fake_flash_erase(void);
+
+/* Write file data to spi_addr and its descriptor to descriptor slot */
+void fake_flash_add_file(uint32_t slot, const uint8_t *tag, uint32_t spi_addr, const uint8_t *data,
+			 size_t size);
+
+#endif
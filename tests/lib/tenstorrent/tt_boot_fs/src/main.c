@@ -66,4 +66,14 @@ ZTEST(tt_boot_fs, test_tt_boot_fs_cksum)
 	}
 }
 
+ZTEST(tt_boot_fs, test_tt_boot_fs_tag_hash)
+{
+	static const uint8_t empty[TT_BOOT_FS_IMAGE_TAG_SIZE];
+	static const uint8_t cmfw[TT_BOOT_FS_IMAGE_TAG_SIZE] = "cmfw";
+
+	/* consistent with test_tt_boot_fs_tag_hash() in pytest/test-tt-boot-fs.py */
+	zassert_equal(0x9be17165, tt_boot_fs_tag_hash(empty));
+	zassert_equal(0x725ee8b2, tt_boot_fs_tag_hash(cmfw));
+}
+
 ZTEST_SUITE(tt_boot_fs, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <tenstorrent/tt_boot_fs.h>
+
+#include "fake_flash.h"
+
+#define MAX_IMAGES      10
+#define CACHE_SIZE      CONFIG_TT_BOOT_FS_FD_CACHE_SIZE
+#define MOUNT_NUM_READS (1 + IS_ENABLED(CONFIG_TT_BOOT_FS_INDEX))
+
+BUILD_ASSERT(CACHE_SIZE < MAX_IMAGES, "tests require more images than cached descriptors");
+
+static tt_boot_fs test_fs;
+
+static void make_tag(uint8_t tag[TT_BOOT_FS_IMAGE_TAG_SIZE], int i)
+{
+	memset(tag, 0, TT_BOOT_FS_IMAGE_TAG_SIZE);
+	memcpy(tag, "image", strlen("image"));
+	tag[strlen("image")] = '0' + i;
+}
+
+static void write_fd(int i)
+{
+	uint32_t data = 0x42427373 + i;
+	uint8_t tag[TT_BOOT_FS_IMAGE_TAG_SIZE];
+
+	make_tag(tag, i);
+	fake_flash_add_file(i, tag, FAKE_FLASH_IMAGE_ADDR + i * sizeof(data), (uint8_t *)&data,
+			    sizeof(data));
+}
+
+/* Same layout as build_index() in scripts/tt_boot_fs.py */
+static void write_index(int num_images)
+{
+	tt_boot_fs_index_hdr hdr = {
+		.magic = TT_BOOT_FS_INDEX_MAGIC,
+		.version = TT_BOOT_FS_INDEX_VERSION,
+		.num_buckets = 4,
+		.num_fds = num_images,
+	};
+	uint16_t buckets[TT_BOOT_FS_INDEX_BUCKETS_MAX];
+	uint8_t tag[TT_BOOT_FS_IMAGE_TAG_SIZE];
+
+	while (hdr.num_buckets < 2 * num_images) {
+		hdr.num_buckets *= 2;
+	}
+
+	memset(buckets, 0xff, sizeof(buckets));
+	for (int i = 0; i < num_images; i++) {
+		make_tag(tag, i);
+
+		uint32_t bucket = tt_boot_fs_tag_hash(tag) & (hdr.num_buckets - 1);
+
+		while (buckets[bucket] != TT_BOOT_FS_INDEX_EMPTY) {
+			bucket = (bucket + 1) & (hdr.num_buckets - 1);
+		}
+		buckets[bucket] = i;
+	}
+
+	hdr.index_crc =
+		tt_boot_fs_cksum(0, (uint8_t *)&hdr, offsetof(tt_boot_fs_index_hdr, index_crc));
+	hdr.index_crc = tt_boot_fs_cksum(hdr.index_crc, (uint8_t *)buckets,
+					 hdr.num_buckets * sizeof(uint16_t));
+
+	memcpy(&fake_flash[TT_BOOT_FS_INDEX_ADDR], &hdr, sizeof(hdr));
+	memcpy(&fake_flash[TT_BOOT_FS_INDEX_ADDR + sizeof(hdr)], buckets,
+	       hdr.num_buckets * sizeof(uint16_t));
+}
+
+static void mount_fs(int num_images, bool index)
+{
+	fake_flash_erase();
+
+	for (int i = 0; i < num_images; i++) {
+		write_fd(i);
+	}
+
+	if (index) {
+		write_index(num_images);
+	}
+
+	fake_flash_num_reads = 0;
+	zassert_ok(tt_boot_fs_mount(&test_fs, fake_flash_read, NULL, NULL));
+	zassert_equal(MOUNT_NUM_READS, fake_flash_num_reads, "mount took %zu reads",
+		      fake_flash_num_reads);
+}
+
+static void check_file(int i)
+{
+	uint8_t tag[TT_BOOT_FS_IMAGE_TAG_SIZE];
+	uint32_t data = 0;
+	size_t size = 0;
+
+	make_tag(tag, i);
+	zassert_ok(tt_boot_fs_get_file(&test_fs, tag, (uint8_t *)&data, sizeof(data), &size),
+		   "image%d not found", i);
+	zassert_equal(sizeof(data), size);
+	zassert_equal(0x42427373 + i, data);
+}
+
+static void check_missing_file(void)
+{
+	static const uint8_t tag[TT_BOOT_FS_IMAGE_TAG_SIZE] = "missing";
+	uint32_t data;
+	size_t size;
+
+	zassert_equal(TT_BOOT_FS_ERR,
+		      tt_boot_fs_get_file(&test_fs, tag, (uint8_t *)&data, sizeof(data), &size));
+}
+
+ZTEST(tt_boot_fs_mount, test_legacy_layout_cached)
+{
+	mount_fs(CACHE_SIZE - 1, false);
+
+	for (int i = 0; i < CACHE_SIZE - 1; i++) {
+		fake_flash_num_reads = 0;
+		check_file(i);
+		/* only the image itself is read */
+		zassert_equal(1, fake_flash_num_reads, "image%d took %zu reads", i,
+			      fake_flash_num_reads);
+	}
+
+	check_missing_file();
+}
+
+ZTEST(tt_boot_fs_mount, test_legacy_layout_uncached)
+{
+	mount_fs(MAX_IMAGES, false);
+
+	for (int i = 0; i < MAX_IMAGES; i++) {
+		fake_flash_num_reads = 0;
+		check_file(i);
+		/* descriptors past the cache are read one at a time */
+		zassert_equal(1 + MAX(0, i - CACHE_SIZE + 1), fake_flash_num_reads,
+			      "image%d took %zu reads", i, fake_flash_num_reads);
+	}
+
+	check_missing_file();
+}
+
+ZTEST(tt_boot_fs_mount, test_indexed_layout)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_TT_BOOT_FS_INDEX);
+
+	mount_fs(MAX_IMAGES, true);
+
+	for (int i = 0; i < MAX_IMAGES; i++) {
+		fake_flash_num_reads = 0;
+		check_file(i);
+		/* at most one descriptor read, plus the image itself */
+		zassert_equal((i < CACHE_SIZE) ? 1 : 2, fake_flash_num_reads,
+			      "image%d took %zu reads", i, fake_flash_num_reads);
+	}
+
+	fake_flash_num_reads = 0;
+	check_missing_file();
+	zassert_true(fake_flash_num_reads <= 1, "missing file took %zu reads",
+		     fake_flash_num_reads);
+}
+
+ZTEST(tt_boot_fs_mount, test_invalid_index)
+{
+	/* a corrupted index is ignored */
+	mount_fs(MAX_IMAGES, true);
+	fake_flash[TT_BOOT_FS_INDEX_ADDR + sizeof(tt_boot_fs_index_hdr)] ^= 0x01;
+	zassert_ok(tt_boot_fs_mount(&test_fs, fake_flash_read, NULL, NULL));
+
+	for (int i = 0; i < MAX_IMAGES; i++) {
+		check_file(i);
+	}
+	check_missing_file();
+
+	/* as is an index that does not cover every descriptor */
+	mount_fs(CACHE_SIZE - 1, true);
+	write_fd(CACHE_SIZE - 1);
+	zassert_ok(tt_boot_fs_mount(&test_fs, fake_flash_read, NULL, NULL));
+
+	for (int i = 0; i < CACHE_SIZE; i++) {
+		check_file(i);
+	}
+}
+
+ZTEST(tt_boot_fs_mount, test_full_table)
+{
+	uint8_t tag[TT_BOOT_FS_IMAGE_TAG_SIZE];
+	uint32_t data = 0x73734242;
+
+	/* every descriptor slot is used, and the index follows right after the table */
+	mount_fs(0, false);
+	for (int i = 0; i < TT_BOOT_FS_NUM_FDS_MAX; i++) {
+		memset(tag, 0, sizeof(tag));
+		snprintf((char *)tag, sizeof(tag), "full%03d", i);
+		fake_flash_add_file(i, tag, FAKE_FLASH_IMAGE_ADDR, (uint8_t *)&data, sizeof(data));
+	}
+	/* a corrupted one, so that the table is scanned */
+	write_index(MAX_IMAGES);
+	fake_flash[TT_BOOT_FS_INDEX_ADDR + sizeof(tt_boot_fs_index_hdr)] ^= 0x01;
+	zassert_ok(tt_boot_fs_mount(&test_fs, fake_flash_read, fake_flash_write, NULL));
+
+	/* up to the index, without reading the index as descriptors */
+	fake_flash_num_reads = 0;
+	check_missing_file();
+	zassert_equal(TT_BOOT_FS_NUM_FDS_MAX - CACHE_SIZE, fake_flash_num_reads,
+		      "missing file took %zu reads", fake_flash_num_reads);
+
+	/* and no file can be added */
+	tt_boot_fs_fd fd = {.spi_addr = FAKE_FLASH_IMAGE_ADDR};
+
+	zassert_equal(TT_BOOT_FS_ERR, tt_boot_fs_add_file(&test_fs, fd, (uint8_t *)&data, false,
+							  false));
+}
+
+ZTEST(tt_boot_fs_mount, test_add_file_indexed)
+{
+	uint32_t data = 0x42427373 + MAX_IMAGES;
+	tt_boot_fs_fd fd = {
+		.spi_addr = FAKE_FLASH_IMAGE_ADDR + MAX_IMAGES * sizeof(data),
+		.flags.f.image_size = sizeof(data),
+		.data_crc = data,
+	};
+
+	mount_fs(MAX_IMAGES, true);
+	zassert_ok(tt_boot_fs_mount(&test_fs, fake_flash_read, fake_flash_write, NULL));
+
+	make_tag(fd.image_tag, MAX_IMAGES);
+	fd.fd_crc = tt_boot_fs_cksum(0, (uint8_t *)&fd, sizeof(fd) - sizeof(uint32_t));
+	zassert_ok(tt_boot_fs_add_file(&test_fs, fd, (uint8_t *)&data, false, false));
+
+	/* the index no longer covers every descriptor, so it is not used any more */
+	for (int i = 0; i <= MAX_IMAGES; i++) {
+		check_file(i);
+	}
+	check_missing_file();
+
+	zassert_ok(tt_boot_fs_mount(&test_fs, fake_flash_read, fake_flash_write, NULL));
+	for (int i = 0; i <= MAX_IMAGES; i++) {
+		check_file(i);
+	}
+}
+
+ZTEST_SUITE(tt_boot_fs_mount, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <tenstorrent/tt_boot_fs.h>
+
+#include "fake_flash.h"
+
+#define MAX_FILE_SIZE 1024
+#define MAX_BUF_SIZE  256
+
+static const uint8_t test_tag[TT_BOOT_FS_IMAGE_TAG_SIZE] = "chunked";
+
+static tt_boot_fs test_fs;
+static uint8_t file_data[MAX_FILE_SIZE];
+static __aligned(sizeof(uint32_t)) uint8_t chunk_buf[MAX_BUF_SIZE];
+
+struct chunk_sink {
+	uint8_t data[MAX_FILE_SIZE];
+	size_t size;
+	size_t num_chunks;
+	size_t max_chunk;
+	size_t stop_after;
+	bool bad_chunk;
+};
+
+static int sink_chunk(const uint8_t *chunk, size_t offset, size_t len, void *user_data)
+{
+	struct chunk_sink *sink = user_data;
+
+	/* chunks must be contiguous, and all but the last word-sized */
+	if (offset != sink->size || len == 0 || len > sink->max_chunk ||
+	    offset + len > sizeof(sink->data) || (sink->size % sizeof(uint32_t)) != 0) {
+		sink->bad_chunk = true;
+		return -EINVAL;
+	}
+
+	memcpy(&sink->data[offset], chunk, len);
+	sink->size += len;
+	sink->num_chunks++;
+
+	if (sink->num_chunks == sink->stop_after) {
+		return -ENOSPC;
+	}
+
+	return 0;
+}
+
+static void add_test_file(size_t size)
+{
+	for (size_t i = 0; i < size; i++) {
+		file_data[i] = 0x73 + 37 * i;
+	}
+
+	fake_flash_erase();
+	fake_flash_add_file(0, test_tag, FAKE_FLASH_IMAGE_ADDR, file_data, size);
+	zassert_ok(tt_boot_fs_mount(&test_fs, fake_flash_read, NULL, NULL));
+}
+
+static int read_test_file(size_t buf_size, struct chunk_sink *sink, size_t *file_size)
+{
+	memset(sink, 0, sizeof(*sink));
+	sink->max_chunk = ROUND_DOWN(buf_size, sizeof(uint32_t));
+
+	return tt_boot_fs_read_file(&test_fs, test_tag, chunk_buf, buf_size, sink_chunk, sink,
+				    file_size);
+}
+
+ZTEST(tt_boot_fs_read_file, test_read_file_odd_sizes)
+{
+	static const size_t file_sizes[] = {1, 3, 4, 5, 63, 64, 65, 255, 1021, MAX_FILE_SIZE};
+	static const size_t buf_sizes[] = {4, 7, 16, 63, 100, MAX_BUF_SIZE};
+	static struct chunk_sink sink;
+	size_t file_size;
+
+	ARRAY_FOR_EACH_PTR(file_sizes, size) {
+		add_test_file(*size);
+
+		ARRAY_FOR_EACH_PTR(buf_sizes, buf_size) {
+			size_t chunk = ROUND_DOWN(*buf_size, sizeof(uint32_t));
+
+			file_size = 0;
+			zassert_ok(read_test_file(*buf_size, &sink, &file_size),
+				   "size %zu buf %zu failed", *size, *buf_size);
+			zassert_false(sink.bad_chunk, "size %zu buf %zu", *size, *buf_size);
+			zassert_equal(*size, file_size);
+			zassert_equal(*size, sink.size);
+			zassert_equal(DIV_ROUND_UP(*size, chunk), sink.num_chunks);
+			zassert_mem_equal(file_data, sink.data, *size);
+		}
+	}
+}
+
+ZTEST(tt_boot_fs_read_file, test_read_file_corrupt_chunk)
+{
+	static struct chunk_sink sink;
+	size_t file_size = 0;
+
+	add_test_file(200);
+
+	/* corrupt a byte in the third 64-byte chunk */
+	fake_flash[FAKE_FLASH_IMAGE_ADDR + 2 * 64 + 5] ^= 0x10;
+
+	zassert_equal(TT_BOOT_FS_ERR, read_test_file(64, &sink, &file_size));
+	zassert_false(sink.bad_chunk);
+	zassert_equal(0, file_size, "file size reported for a corrupt file");
+
+	/* corrupting the odd-sized tail is caught too */
+	add_test_file(201);
+	fake_flash[FAKE_FLASH_IMAGE_ADDR + 200] ^= 0x01;
+	zassert_equal(TT_BOOT_FS_ERR, read_test_file(64, &sink, NULL));
+}
+
+ZTEST(tt_boot_fs_read_file, test_read_file_stop)
+{
+	static struct chunk_sink sink;
+
+	add_test_file(MAX_FILE_SIZE);
+
+	/* the consumer can stop the read, and its error is returned */
+	memset(&sink, 0, sizeof(sink));
+	sink.max_chunk = 64;
+	sink.stop_after = 2;
+	zassert_equal(-ENOSPC, tt_boot_fs_read_file(&test_fs, test_tag, chunk_buf, 64, sink_chunk,
+						    &sink, NULL));
+	zassert_equal(2, sink.num_chunks);
+}
+
+ZTEST(tt_boot_fs_read_file, test_read_file_invalid)
+{
+	static const uint8_t missing_tag[TT_BOOT_FS_IMAGE_TAG_SIZE] = "missing";
+	static struct chunk_sink sink;
+
+	add_test_file(64);
+
+	zassert_equal(TT_BOOT_FS_ERR, read_test_file(3, &sink, NULL));
+	zassert_equal(TT_BOOT_FS_ERR, tt_boot_fs_read_file(&test_fs, test_tag, chunk_buf,
+							   sizeof(chunk_buf), NULL, NULL, NULL));
+	zassert_equal(TT_BOOT_FS_ERR, tt_boot_fs_read_file(&test_fs, missing_tag, chunk_buf,
+							   sizeof(chunk_buf), sink_chunk, &sink,
+							   NULL));
+	zassert_equal(0, sink.num_chunks);
+}
+
+ZTEST(tt_boot_fs_read_file, test_get_file_odd_size)
+{
+	static __aligned(sizeof(uint32_t)) uint8_t buf[MAX_FILE_SIZE];
+	size_t file_size = 0;
+
+	add_test_file(65);
+
+	zassert_ok(tt_boot_fs_get_file(&test_fs, test_tag, buf, sizeof(buf), &file_size));
+	zassert_equal(65, file_size);
+	zassert_mem_equal(file_data, buf, file_size);
+
+	zassert_equal(TT_BOOT_FS_ERR, tt_boot_fs_get_file(&test_fs, test_tag, buf, 64, &file_size));
+}
+
+ZTEST_SUITE(tt_boot_fs_read_file, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include "flash_mspi_nor_erase.h"
+
+#define UNITS_SECTOR (KB(4))
+#define UNITS_32K    (KB(4) | KB(32))
+#define UNITS_ALL    (KB(4) | KB(32) | KB(64))
+
+struct erase_plan {
+	uint32_t num_4k;
+	uint32_t num_32k;
+	uint32_t num_64k;
+	uint32_t num_erases;
+};
+
+/* Split a range the same way api_erase() does, counting the erases of each size */
+static int plan_erase(uint32_t addr, uint32_t size, uint32_t units, struct erase_plan *plan)
+{
+	memset(plan, 0, sizeof(*plan));
+
+	while (size > 0) {
+		uint32_t unit = flash_mspi_nor_erase_unit(addr, size, units);
+
+		switch (unit) {
+		case KB(4):
+			plan->num_4k++;
+			break;
+		case KB(32):
+			plan->num_32k++;
+			break;
+		case KB(64):
+			plan->num_64k++;
+			break;
+		default:
+			return -EINVAL;
+		}
+
+		plan->num_erases++;
+		addr += unit;
+		size -= unit;
+	}
+
+	return 0;
+}
+
+ZTEST(flash_mspi_nor_erase, test_unit)
+{
+	zexpect_equal(flash_mspi_nor_erase_unit(0, KB(64), UNITS_ALL), KB(64));
+	zexpect_equal(flash_mspi_nor_erase_unit(0, KB(64) - 1, UNITS_ALL), KB(32));
+	zexpect_equal(flash_mspi_nor_erase_unit(KB(32), KB(64), UNITS_ALL), KB(32));
+	zexpect_equal(flash_mspi_nor_erase_unit(KB(4), KB(64), UNITS_ALL), KB(4));
+	zexpect_equal(flash_mspi_nor_erase_unit(0, KB(64), UNITS_SECTOR), KB(4));
+	zexpect_equal(flash_mspi_nor_erase_unit(0, KB(128), UNITS_32K), KB(32));
+
+	/* nothing fits an unaligned or short range */
+	zexpect_equal(flash_mspi_nor_erase_unit(0x100, KB(64), UNITS_ALL), 0);
+	zexpect_equal(flash_mspi_nor_erase_unit(0, KB(4) - 1, UNITS_ALL), 0);
+	zexpect_equal(flash_mspi_nor_erase_unit(0, KB(64), 0), 0);
+}
+
+ZTEST(flash_mspi_nor_erase, test_plan_unaligned)
+{
+	struct erase_plan plan;
+
+	/* sectors up to the 32K boundary, then the largest blocks, then a sector */
+	zassert_ok(plan_erase(0x1000, 0x30000, UNITS_ALL, &plan));
+	zexpect_equal(plan.num_4k, 8);
+	zexpect_equal(plan.num_32k, 1);
+	zexpect_equal(plan.num_64k, 2);
+	zexpect_equal(plan.num_erases, 11);
+
+	/* the same range with sector erases only */
+	zassert_ok(plan_erase(0x1000, 0x30000, UNITS_SECTOR, &plan));
+	zexpect_equal(plan.num_4k, 0x30);
+	zexpect_equal(plan.num_erases, 0x30);
+
+	/* without 64K blocks, as on MT35X parts */
+	zassert_ok(plan_erase(0x1000, 0x30000, UNITS_32K, &plan));
+	zexpect_equal(plan.num_4k, 8);
+	zexpect_equal(plan.num_32k, 5);
+	zexpect_equal(plan.num_64k, 0);
+}
+
+ZTEST(flash_mspi_nor_erase, test_plan_aligned)
+{
+	struct erase_plan plan;
+
+	zassert_ok(plan_erase(0x80000, KB(128), UNITS_ALL, &plan));
+	zexpect_equal(plan.num_64k, 2);
+	zexpect_equal(plan.num_erases, 2);
+
+	/* a 32K tail after the 64K blocks */
+	zassert_ok(plan_erase(0x80000, KB(96), UNITS_ALL, &plan));
+	zexpect_equal(plan.num_64k, 1);
+	zexpect_equal(plan.num_32k, 1);
+	zexpect_equal(plan.num_erases, 2);
+
+	/* a single sector */
+	zassert_ok(plan_erase(0x80000, KB(4), UNITS_ALL, &plan));
+	zexpect_equal(plan.num_4k, 1);
+	zexpect_equal(plan.num_erases, 1);
+}
+
+ZTEST(flash_mspi_nor_erase, test_plan_invalid)
+{
+	struct erase_plan plan;
+
+	/* ranges that are not sector aligned cannot be erased */
+	zassert_equal(plan_erase(0x800, KB(4), UNITS_ALL, &plan), -EINVAL);
+	zassert_equal(plan_erase(0, KB(4) + 1, UNITS_ALL, &plan), -EINVAL);
+}
+
+ZTEST_SUITE(flash_mspi_nor_erase, NULL, NULL, NULL, NULL, NULL);
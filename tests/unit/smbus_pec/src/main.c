@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <time.h>
+
+#include <zephyr/ztest.h>
+#include <tenstorrent/smbus_pec.h>
+
+#define BENCH_SIZE   4096
+#define BENCH_ROUNDS 256
+
+typedef uint8_t (*smbus_pec_fn)(uint8_t pec, const uint8_t *buf, size_t len);
+
+static const struct {
+	const char *name;
+	smbus_pec_fn fn;
+} impls[] = {
+	{"bitwise", smbus_pec_bitwise},
+	{"nibble", smbus_pec_nibble},
+	{"table", smbus_pec_table},
+};
+
+/* The implementation smbus_pec() should use, see SMBUS_PEC_IMPL in CMakeLists.txt */
+#if defined(CONFIG_TT_SMBUS_PEC_TABLE)
+#define SELECTED_IMPL smbus_pec_table
+#elif defined(CONFIG_TT_SMBUS_PEC_NIBBLE)
+#define SELECTED_IMPL smbus_pec_nibble
+#else
+#define SELECTED_IMPL smbus_pec_bitwise
+#endif
+
+static uint8_t bench_buf[BENCH_SIZE];
+
+ZTEST(smbus_pec, test_known_values)
+{
+	/* CRC-8/SMBUS check value */
+	static const uint8_t check[] = "123456789";
+	/* Block write of 0x12 0x34 to command 0x21 of target 0x0A */
+	static const uint8_t block_write[] = {0x0A << 1, 0x21, 2, 0x12, 0x34};
+
+	ARRAY_FOR_EACH(impls, i) {
+		zexpect_equal(impls[i].fn(0, check, sizeof(check) - 1), 0xF4, "%s", impls[i].name);
+		zexpect_equal(impls[i].fn(0, NULL, 0), 0, "%s", impls[i].name);
+		zexpect_equal(impls[i].fn(0x5A, NULL, 0), 0x5A, "%s", impls[i].name);
+		/* appending the PEC gives a PEC of 0 */
+		uint8_t msg[sizeof(block_write) + 1];
+
+		memcpy(msg, block_write, sizeof(block_write));
+		msg[sizeof(block_write)] = impls[i].fn(0, block_write, sizeof(block_write));
+		zexpect_equal(impls[i].fn(0, msg, sizeof(msg)), 0, "%s", impls[i].name);
+	}
+}
+
+ZTEST(smbus_pec, test_equivalence)
+{
+	uint8_t buf[2];
+
+	/* every byte value, continuing from every PEC value */
+	for (int pec = 0; pec < 256; pec++) {
+		for (int byte = 0; byte < 256; byte++) {
+			uint8_t expected;
+
+			buf[0] = byte;
+			expected = smbus_pec_bitwise(pec, buf, 1);
+			zassert_equal(smbus_pec_nibble(pec, buf, 1), expected, "pec %#x byte %#x",
+				      pec, byte);
+			zassert_equal(smbus_pec_table(pec, buf, 1), expected, "pec %#x byte %#x",
+				      pec, byte);
+		}
+	}
+
+	/* splitting a buffer does not change the result */
+	ARRAY_FOR_EACH(impls, i) {
+		uint8_t whole = impls[i].fn(0, bench_buf, sizeof(bench_buf));
+		uint8_t split = impls[i].fn(0, bench_buf, 1000);
+
+		split = impls[i].fn(split, &bench_buf[1000], sizeof(bench_buf) - 1000);
+		zexpect_equal(whole, split, "%s", impls[i].name);
+		zexpect_equal(whole, smbus_pec_bitwise(0, bench_buf, sizeof(bench_buf)), "%s",
+			      impls[i].name);
+	}
+
+	/* the Kconfig selected implementation matches too */
+	zexpect_equal(smbus_pec(0x33, bench_buf, sizeof(bench_buf)),
+		      SELECTED_IMPL(0x33, bench_buf, sizeof(bench_buf)));
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void bench(const char *name, smbus_pec_fn fn)
+{
+	volatile uint8_t sink;
+	uint64_t start = now_ns();
+	uint8_t pec = 0;
+
+	for (int round = 0; round < BENCH_ROUNDS; round++) {
+		pec = fn(pec, bench_buf, sizeof(bench_buf));
+	}
+	sink = pec;
+	ARG_UNUSED(sink);
+
+	TC_PRINT("%-9s %6.2f ns/byte\n", name,
+		 (double)(now_ns() - start) / (BENCH_ROUNDS * BENCH_SIZE));
+}
+
+/* Timings depend on the host, so they are only reported */
+ZTEST(smbus_pec, test_benchmark)
+{
+	ARRAY_FOR_EACH(impls, i) {
+		bench(impls[i].name, impls[i].fn);
+	}
+	bench("smbus_pec", smbus_pec);
+}
+
+static void *smbus_pec_setup(void)
+{
+	for (size_t i = 0; i < sizeof(bench_buf); i++) {
+		bench_buf[i] = (i * 167 + 13) ^ (i >> 8);
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(smbus_pec, NULL, smbus_pec_setup, NULL, NULL, NULL);
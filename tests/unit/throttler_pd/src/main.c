@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include "throttler_pd.h"
+#include "throttler_params.h"
+#include "traces.h"
+
+#define FMIN 800
+#define FMAX 1400
+
+/* Largest allowed difference between the implementations, in MHz and in controller error */
+#define MAX_ARB_DIFF_MHZ 1.0
+#define MAX_ERROR_DIFF   1e-4
+
+#define THROTTLER_PARAMS_INIT(_id, _arb_max, _alpha_filter, _p_gain, _d_gain)                      \
+	[_id] = THROTTLER_PARAMS_FLOAT(_alpha_filter, _p_gain, _d_gain),
+#define THROTTLER_PARAMS_FIXED_INIT(_id, _arb_max, _alpha_filter, _p_gain, _d_gain)                \
+	[_id] = THROTTLER_PARAMS_FIXED(_alpha_filter, _p_gain, _d_gain),
+
+/* The gains of the throttlers in throttler.c */
+static const ThrottlerParams params[kThrottlerCount] = {THROTTLER_LIST(THROTTLER_PARAMS_INIT)};
+static const ThrottlerParamsFixed params_fixed[kThrottlerCount] = {
+	THROTTLER_LIST(THROTTLER_PARAMS_FIXED_INIT)};
+
+/* Typical limits of the throttlers, which come from the firmware table */
+static const float limits[kThrottlerCount] = {
+	[kThrottlerTDP] = 300, [kThrottlerFastTDC] = 400,    [kThrottlerTDC] = 350,
+	[kThrottlerThm] = 90,  [kThrottlerBoardPower] = 300, [kThrottlerGDDRThm] = 85,
+};
+
+struct throttler_pair {
+	ThrottlerParams params;
+	ThrottlerPD pd;
+	float arb;
+
+	ThrottlerParamsFixed params_fixed;
+	ThrottlerPDFixed pd_fixed;
+	q16_16_t arb_fixed;
+};
+
+static struct throttler_pair throttlers[kThrottlerCount];
+
+static double q16_16_to_double(q16_16_t x)
+{
+	return (double)x / Q16_16_ONE;
+}
+
+static void init_throttlers(void)
+{
+	memset(throttlers, 0, sizeof(throttlers));
+
+	for (int i = 0; i < kThrottlerCount; i++) {
+		struct throttler_pair *t = &throttlers[i];
+
+		t->params = params[i];
+		ThrottlerPDSetLimit(&t->pd, limits[i]);
+		t->arb = FMAX;
+
+		t->params_fixed = params_fixed[i];
+		ThrottlerPDFixedSetLimit(&t->pd_fixed, q16_16_from_float(limits[i]));
+		t->arb_fixed = q16_16_from_int(FMAX);
+	}
+}
+
+/* Runs one DVFS update through both implementations, as CalculateThrottlers() does */
+static void update_throttlers(const struct throttler_sample *s)
+{
+	const float values[kThrottlerCount] = {
+		[kThrottlerTDP] = s->vcore_power,
+		[kThrottlerFastTDC] = s->vcore_current,
+		[kThrottlerTDC] = s->vcore_current,
+		[kThrottlerThm] = s->asic_temperature,
+		[kThrottlerBoardPower] = s->input_power,
+		[kThrottlerGDDRThm] = s->gddr_temperature,
+	};
+	const q16_16_t values_fixed[kThrottlerCount] = {
+		[kThrottlerTDP] = q16_16_from_float(s->vcore_power),
+		[kThrottlerFastTDC] = q16_16_from_float(s->vcore_current),
+		[kThrottlerTDC] = q16_16_from_float(s->vcore_current),
+		[kThrottlerThm] = q16_16_from_float(s->asic_temperature),
+		[kThrottlerBoardPower] = q16_16_from_int(s->input_power),
+		[kThrottlerGDDRThm] = q16_16_from_int(s->gddr_temperature),
+	};
+
+	for (int i = 0; i < kThrottlerCount; i++) {
+		struct throttler_pair *t = &throttlers[i];
+
+		ThrottlerPDUpdate(&t->pd, &t->params, values[i]);
+		t->arb = ThrottlerPDArbUpdate(&t->pd, t->arb, FMIN, FMAX);
+
+		ThrottlerPDFixedUpdate(&t->pd_fixed, &t->params_fixed, values_fixed[i]);
+		t->arb_fixed = ThrottlerPDFixedArbUpdate(&t->pd_fixed, t->arb_fixed,
+							 q16_16_from_int(FMIN),
+							 q16_16_from_int(FMAX));
+	}
+}
+
+ZTEST(throttler_pd, test_from_float)
+{
+	static const float values[] = {0.0F,     1.0F,     -1.0F,   0.1F,     -0.1F,  0.2F,
+				       0.5F,     99.44F,   556.08F, 1e-6F,    3e-5F,  -3e-5F,
+				       32767.0F, -32767.5F, 1234.567F, 7.62939453125e-6F};
+
+	ARRAY_FOR_EACH(values, i) {
+		double expected = round((double)values[i] * Q16_16_ONE);
+
+		zassert_equal(q16_16_from_float(values[i]), (q16_16_t)expected, "%f: %d != %d",
+			      (double)values[i], q16_16_from_float(values[i]), (q16_16_t)expected);
+	}
+
+	/* saturated */
+	zassert_equal(q16_16_from_float(1e6F), INT32_MAX);
+	zassert_equal(q16_16_from_float(-1e6F), -INT32_MAX);
+	zassert_equal(q16_16_from_float(-32768.0F), -INT32_MAX);
+	zassert_equal(q16_16_from_float(INFINITY), INT32_MAX);
+	zassert_equal(q16_16_from_float(-0.0F), 0);
+
+	/* constants are rounded the same way */
+	zassert_equal(Q16_16_CONST(0.2), q16_16_from_float(0.2F));
+	zassert_equal(Q16_16_CONST(-0.1), q16_16_from_float(-0.1F));
+	zassert_equal(q16_16_to_int(q16_16_from_float(-0.5F)), -1);
+}
+
+ZTEST(throttler_pd, test_workload_trace)
+{
+	double max_arb_diff = 0;
+	double max_error_diff = 0;
+	int throttled_samples = 0;
+
+	init_throttlers();
+
+	ARRAY_FOR_EACH_PTR(workload_trace, sample) {
+		update_throttlers(sample);
+
+		for (int i = 0; i < kThrottlerCount; i++) {
+			struct throttler_pair *t = &throttlers[i];
+			double arb_diff = fabs(t->arb - q16_16_to_double(t->arb_fixed));
+			double error_diff = fabs(t->pd.error - q16_16_to_double(t->pd_fixed.error));
+
+			max_arb_diff = MAX(max_arb_diff, arb_diff);
+			max_error_diff = MAX(max_error_diff, error_diff);
+
+			zassert_true(arb_diff <= MAX_ARB_DIFF_MHZ, "sample %d throttler %d: %f MHz",
+				     (int)(sample - workload_trace), i, arb_diff);
+			zassert_true(error_diff <= MAX_ERROR_DIFF, "sample %d throttler %d: %f",
+				     (int)(sample - workload_trace), i, error_diff);
+
+			if (t->arb < FMAX) {
+				throttled_samples++;
+			}
+		}
+	}
+
+	/* The trace has to exercise the controllers, not just sit at the limits */
+	zassert_true(throttled_samples > ARRAY_SIZE(workload_trace));
+	TC_PRINT("max divergence: %f MHz, error %g\n", max_arb_diff, max_error_diff);
+}
+
+ZTEST(throttler_pd, test_arbiter_whole_mhz)
+{
+	int max_diff = 0;
+
+	init_throttlers();
+
+	/* The arbiters only see whole MHz, which have to agree on almost every update */
+	ARRAY_FOR_EACH_PTR(workload_trace, sample) {
+		update_throttlers(sample);
+
+		for (int i = 0; i < kThrottlerCount; i++) {
+			int diff = abs((int)throttlers[i].arb -
+				       q16_16_to_int(throttlers[i].arb_fixed));
+
+			max_diff = MAX(max_diff, diff);
+		}
+	}
+
+	zassert_true(max_diff <= 1, "%d MHz", max_diff);
+}
+
+ZTEST(throttler_pd, test_step_response)
+{
+	struct throttler_sample step = {0};
+	const int steps = 2000;
+
+	init_throttlers();
+
+	/* A long constant overload integrates down to FMIN in both implementations */
+	step.vcore_power = 330.0F;
+	step.vcore_current = 420.0F;
+	step.asic_temperature = 91.5F;
+	step.input_power = 305;
+	step.gddr_temperature = 86;
+
+	for (int n = 0; n < steps; n++) {
+		update_throttlers(&step);
+	}
+
+	for (int i = 0; i < kThrottlerCount; i++) {
+		zassert_equal(throttlers[i].arb, FMIN, "throttler %d", i);
+		zassert_equal(throttlers[i].arb_fixed, q16_16_from_int(FMIN), "throttler %d", i);
+	}
+
+	/* and recovers to FMAX once the load goes away */
+	step = (struct throttler_sample){30.0F, 40.0F, 40.0F, 60, 50};
+	for (int n = 0; n < steps; n++) {
+		update_throttlers(&step);
+	}
+
+	for (int i = 0; i < kThrottlerCount; i++) {
+		zassert_equal(throttlers[i].arb, FMAX, "throttler %d", i);
+		zassert_equal(throttlers[i].arb_fixed, q16_16_from_int(FMAX), "throttler %d", i);
+	}
+}
+
+ZTEST_SUITE(throttler_pd, NULL, NULL, NULL, NULL, NULL);
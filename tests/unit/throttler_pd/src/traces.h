@@ -0,0 +1,626 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef THROTTLER_TRACES_H
+#define THROTTLER_TRACES_H
+
+/* Telemetry as seen by CalculateThrottlers() at every 1 ms DVFS update */
+struct throttler_sample {
+	float vcore_power;      /* W */
+	float vcore_current;    /* A */
+	float asic_temperature; /* degC */
+	uint16_t input_power;   /* W */
+	int gddr_temperature;   /* degC */
+};
+
+/*
+ * Idle, ramp into a workload that alternates between 100% and 85% load and overshoots every
+ * limit, back to light load, then a sustained burst above the TDP.
+ */
+static const struct throttler_sample workload_trace[] = {
+	{76.10F, 98.16F, 44.97F, 111, 60},
+	{77.21F, 99.40F, 44.95F, 110, 60},
+	{73.84F, 94.45F, 45.12F, 108, 60},
+	{76.01F, 97.09F, 45.62F, 110, 60},
+	{75.55F, 97.83F, 45.63F, 103, 60},
+	{77.71F, 98.93F, 45.56F, 110, 60},
+	{78.08F, 99.52F, 45.84F, 109, 60},
+	{76.63F, 97.87F, 45.96F, 104, 60},
+	{75.88F, 98.25F, 45.96F, 104, 60},
+	{77.43F, 100.10F, 45.77F, 105, 60},
+	{73.96F, 95.29F, 46.20F, 104, 60},
+	{75.43F, 97.23F, 45.85F, 110, 60},
+	{76.26F, 98.66F, 46.00F, 108, 60},
+	{74.94F, 96.63F, 46.22F, 104, 60},
+	{76.25F, 97.87F, 46.32F, 105, 60},
+	{77.90F, 99.51F, 46.54F, 108, 60},
+	{76.36F, 97.45F, 46.52F, 104, 60},
+	{75.31F, 96.48F, 46.52F, 105, 60},
+	{77.04F, 98.40F, 46.80F, 105, 60},
+	{77.87F, 98.88F, 46.68F, 109, 60},
+	{75.56F, 97.32F, 46.69F, 111, 60},
+	{75.51F, 96.21F, 46.49F, 105, 60},
+	{74.22F, 94.61F, 46.79F, 109, 60},
+	{77.39F, 100.05F, 46.56F, 111, 60},
+	{77.94F, 99.11F, 47.09F, 111, 60},
+	{76.72F, 98.17F, 46.70F, 105, 60},
+	{76.62F, 97.73F, 46.87F, 108, 60},
+	{74.47F, 95.08F, 47.06F, 108, 60},
+	{75.51F, 96.78F, 47.13F, 107, 60},
+	{75.75F, 98.02F, 47.02F, 109, 60},
+	{75.17F, 95.77F, 46.95F, 106, 60},
+	{77.11F, 99.00F, 47.52F, 108, 60},
+	{75.22F, 96.59F, 47.37F, 110, 60},
+	{76.52F, 97.84F, 47.55F, 112, 60},
+	{75.10F, 96.01F, 47.46F, 107, 60},
+	{76.11F, 96.97F, 47.62F, 108, 60},
+	{77.21F, 98.88F, 47.55F, 108, 60},
+	{76.17F, 97.60F, 47.45F, 104, 60},
+	{78.22F, 100.94F, 47.80F, 109, 60},
+	{74.68F, 95.30F, 47.81F, 106, 60},
+	{73.85F, 94.62F, 47.81F, 109, 60},
+	{78.25F, 99.51F, 47.99F, 112, 60},
+	{73.84F, 94.74F, 47.66F, 108, 60},
+	{76.68F, 99.00F, 47.83F, 110, 60},
+	{73.99F, 94.93F, 47.94F, 103, 60},
+	{74.95F, 95.79F, 48.15F, 107, 60},
+	{78.17F, 100.03F, 48.15F, 105, 60},
+	{75.27F, 96.99F, 47.77F, 109, 60},
+	{77.05F, 98.36F, 47.99F, 107, 60},
+	{76.18F, 97.16F, 48.00F, 107, 60},
+	{74.29F, 94.77F, 48.05F, 107, 60},
+	{74.63F, 95.43F, 48.50F, 104, 60},
+	{77.31F, 98.42F, 48.20F, 107, 60},
+	{76.13F, 97.38F, 48.44F, 108, 60},
+	{74.42F, 95.53F, 48.34F, 103, 60},
+	{75.17F, 96.95F, 48.63F, 110, 60},
+	{75.58F, 97.12F, 48.52F, 104, 60},
+	{77.27F, 98.92F, 48.58F, 107, 60},
+	{77.14F, 99.49F, 48.31F, 107, 60},
+	{74.86F, 95.39F, 48.27F, 102, 60},
+	{75.97F, 97.26F, 48.45F, 110, 60},
+	{74.50F, 96.33F, 48.46F, 103, 60},
+	{77.20F, 98.62F, 48.74F, 112, 60},
+	{75.13F, 97.02F, 48.63F, 110, 60},
+	{74.37F, 94.60F, 48.89F, 109, 60},
+	{76.70F, 98.87F, 48.53F, 110, 60},
+	{74.69F, 96.46F, 48.68F, 109, 60},
+	{74.95F, 95.28F, 48.99F, 106, 60},
+	{74.65F, 95.35F, 48.82F, 102, 60},
+	{73.99F, 95.20F, 48.76F, 106, 60},
+	{74.90F, 95.65F, 49.10F, 110, 60},
+	{77.15F, 98.34F, 48.78F, 106, 60},
+	{77.71F, 100.52F, 48.97F, 107, 60},
+	{75.45F, 96.65F, 49.05F, 104, 60},
+	{77.29F, 99.96F, 48.91F, 108, 60},
+	{76.67F, 97.57F, 49.13F, 111, 60},
+	{74.76F, 95.66F, 49.20F, 106, 60},
+	{76.88F, 98.05F, 49.28F, 112, 60},
+	{77.63F, 99.51F, 48.99F, 108, 60},
+	{78.18F, 100.19F, 48.88F, 113, 60},
+	{73.86F, 94.64F, 48.94F, 103, 60},
+	{73.88F, 94.01F, 48.87F, 105, 60},
+	{75.07F, 96.46F, 49.02F, 105, 60},
+	{75.45F, 96.27F, 49.33F, 107, 60},
+	{73.86F, 94.76F, 49.43F, 106, 60},
+	{76.93F, 98.18F, 49.44F, 109, 60},
+	{78.06F, 100.61F, 49.15F, 106, 60},
+	{75.90F, 96.98F, 49.24F, 109, 60},
+	{78.18F, 99.25F, 49.04F, 112, 60},
+	{76.08F, 96.86F, 49.35F, 106, 60},
+	{78.09F, 99.20F, 49.07F, 108, 60},
+	{77.11F, 98.15F, 49.51F, 106, 60},
+	{73.93F, 95.52F, 49.65F, 104, 60},
+	{74.20F, 94.37F, 49.25F, 106, 60},
+	{76.66F, 97.89F, 49.10F, 107, 60},
+	{74.12F, 94.09F, 49.63F, 105, 60},
+	{76.17F, 97.31F, 49.58F, 107, 60},
+	{77.69F, 98.79F, 49.32F, 110, 60},
+	{77.96F, 100.39F, 49.56F, 110, 60},
+	{77.19F, 98.12F, 49.20F, 107, 60},
+	{74.42F, 96.23F, 49.31F, 107, 60},
+	{91.07F, 116.56F, 49.74F, 116, 60},
+	{107.63F, 136.76F, 49.60F, 133, 60},
+	{126.57F, 161.50F, 49.79F, 147, 60},
+	{140.00F, 178.15F, 50.18F, 162, 60},
+	{160.12F, 205.93F, 50.35F, 176, 60},
+	{170.20F, 216.45F, 50.45F, 182, 60},
+	{186.08F, 238.26F, 50.79F, 200, 61},
+	{201.89F, 256.87F, 50.78F, 207, 61},
+	{218.63F, 281.48F, 51.34F, 227, 61},
+	{231.51F, 297.17F, 51.52F, 238, 61},
+	{256.17F, 331.69F, 52.29F, 254, 61},
+	{275.45F, 354.31F, 52.88F, 268, 61},
+	{288.08F, 370.51F, 53.40F, 282, 61},
+	{304.10F, 393.17F, 53.45F, 291, 61},
+	{312.06F, 400.14F, 54.55F, 303, 62},
+	{325.29F, 412.93F, 54.99F, 311, 62},
+	{349.27F, 445.81F, 55.65F, 329, 62},
+	{369.95F, 478.59F, 56.17F, 347, 62},
+	{394.44F, 507.71F, 57.01F, 367, 62},
+	{344.90F, 438.56F, 57.45F, 325, 63},
+	{342.08F, 436.46F, 57.88F, 327, 63},
+	{344.98F, 442.36F, 58.77F, 324, 63},
+	{341.18F, 434.45F, 58.97F, 325, 63},
+	{336.29F, 427.81F, 59.60F, 317, 63},
+	{342.40F, 436.42F, 60.43F, 323, 64},
+	{347.57F, 446.56F, 61.00F, 326, 64},
+	{336.29F, 433.42F, 61.21F, 322, 64},
+	{342.58F, 439.57F, 61.98F, 327, 64},
+	{336.80F, 428.24F, 62.14F, 322, 64},
+	{347.66F, 444.68F, 62.96F, 326, 64},
+	{339.50F, 433.81F, 63.49F, 325, 65},
+	{353.40F, 456.97F, 63.56F, 333, 65},
+	{345.14F, 445.39F, 64.26F, 329, 65},
+	{350.28F, 446.52F, 64.60F, 333, 65},
+	{353.90F, 451.99F, 65.18F, 336, 65},
+	{350.27F, 451.64F, 65.32F, 334, 65},
+	{355.66F, 451.76F, 65.86F, 338, 66},
+	{337.71F, 431.77F, 66.24F, 319, 66},
+	{355.69F, 458.86F, 66.83F, 336, 66},
+	{348.04F, 444.58F, 67.21F, 327, 66},
+	{353.17F, 456.96F, 67.84F, 335, 66},
+	{344.31F, 443.95F, 68.30F, 330, 66},
+	{339.63F, 435.64F, 68.50F, 320, 66},
+	{345.43F, 443.67F, 68.75F, 329, 67},
+	{338.54F, 432.48F, 69.09F, 325, 67},
+	{355.66F, 459.07F, 69.57F, 335, 67},
+	{352.19F, 447.10F, 69.91F, 336, 67},
+	{349.63F, 443.84F, 70.06F, 333, 67},
+	{341.52F, 438.84F, 70.60F, 326, 67},
+	{340.97F, 435.96F, 70.87F, 323, 68},
+	{340.76F, 436.84F, 71.58F, 326, 68},
+	{343.80F, 444.69F, 71.92F, 326, 68},
+	{352.52F, 454.24F, 72.12F, 337, 68},
+	{353.91F, 451.67F, 72.43F, 335, 68},
+	{346.69F, 440.56F, 72.79F, 327, 68},
+	{343.24F, 441.83F, 73.06F, 328, 68},
+	{338.37F, 433.34F, 73.22F, 326, 68},
+	{337.48F, 435.00F, 73.46F, 321, 69},
+	{346.27F, 447.62F, 73.77F, 329, 69},
+	{388.21F, 496.92F, 74.66F, 361, 69},
+	{409.20F, 529.62F, 74.67F, 384, 69},
+	{403.25F, 517.52F, 75.25F, 376, 69},
+	{393.22F, 500.65F, 75.75F, 364, 69},
+	{392.00F, 506.23F, 75.93F, 368, 70},
+	{409.48F, 520.69F, 76.62F, 378, 70},
+	{396.89F, 512.98F, 76.54F, 370, 70},
+	{410.33F, 531.19F, 77.35F, 381, 70},
+	{404.39F, 514.32F, 77.60F, 379, 70},
+	{404.66F, 513.66F, 77.79F, 376, 70},
+	{410.24F, 521.00F, 78.24F, 378, 71},
+	{407.61F, 519.37F, 78.88F, 381, 71},
+	{402.29F, 514.59F, 78.83F, 377, 71},
+	{394.43F, 509.36F, 79.26F, 366, 71},
+	{391.27F, 501.97F, 79.54F, 369, 71},
+	{400.33F, 517.28F, 80.08F, 370, 71},
+	{395.20F, 507.17F, 80.68F, 373, 72},
+	{395.97F, 504.63F, 81.01F, 370, 72},
+	{393.80F, 502.57F, 81.33F, 367, 72},
+	{395.13F, 503.47F, 81.41F, 368, 72},
+	{393.34F, 507.06F, 81.71F, 365, 72},
+	{396.58F, 512.34F, 81.98F, 374, 72},
+	{397.59F, 508.76F, 82.10F, 372, 72},
+	{388.93F, 496.29F, 82.50F, 364, 73},
+	{391.91F, 502.96F, 83.15F, 370, 73},
+	{393.92F, 501.92F, 83.38F, 369, 73},
+	{390.95F, 501.38F, 83.73F, 364, 73},
+	{410.72F, 523.88F, 83.51F, 385, 73},
+	{394.01F, 509.57F, 84.27F, 367, 73},
+	{401.88F, 516.57F, 84.40F, 378, 73},
+	{395.78F, 506.60F, 84.37F, 368, 74},
+	{395.73F, 509.42F, 84.52F, 369, 74},
+	{407.51F, 524.17F, 85.08F, 382, 74},
+	{396.19F, 510.96F, 85.33F, 371, 74},
+	{402.46F, 514.62F, 85.25F, 373, 74},
+	{398.43F, 510.91F, 86.03F, 369, 74},
+	{409.94F, 523.73F, 85.76F, 378, 74},
+	{403.15F, 519.55F, 86.41F, 375, 74},
+	{393.95F, 503.33F, 86.19F, 366, 75},
+	{388.17F, 501.51F, 86.45F, 360, 75},
+	{349.08F, 446.00F, 86.50F, 332, 75},
+	{336.84F, 431.67F, 86.67F, 325, 75},
+	{338.60F, 436.46F, 86.95F, 325, 75},
+	{350.74F, 448.19F, 86.92F, 330, 75},
+	{341.42F, 438.35F, 87.29F, 327, 75},
+	{349.37F, 445.14F, 87.03F, 333, 75},
+	{338.44F, 433.24F, 87.20F, 326, 75},
+	{349.71F, 450.85F, 87.14F, 333, 75},
+	{349.19F, 449.29F, 87.18F, 330, 75},
+	{336.82F, 433.51F, 87.19F, 325, 75},
+	{344.13F, 443.78F, 87.71F, 330, 76},
+	{338.91F, 433.21F, 87.55F, 319, 76},
+	{351.08F, 447.95F, 87.55F, 337, 76},
+	{345.84F, 443.79F, 87.88F, 329, 76},
+	{346.17F, 446.54F, 88.10F, 330, 76},
+	{353.05F, 456.16F, 87.98F, 338, 76},
+	{344.39F, 438.70F, 87.95F, 325, 76},
+	{351.39F, 450.31F, 87.89F, 330, 76},
+	{346.94F, 441.92F, 87.96F, 333, 76},
+	{337.96F, 436.88F, 87.97F, 322, 76},
+	{337.55F, 432.97F, 88.09F, 325, 76},
+	{343.14F, 443.11F, 88.42F, 328, 76},
+	{335.67F, 433.44F, 88.25F, 324, 76},
+	{352.43F, 448.44F, 88.63F, 332, 76},
+	{340.23F, 435.14F, 88.22F, 323, 77},
+	{354.39F, 450.56F, 88.39F, 339, 77},
+	{349.37F, 446.47F, 88.60F, 330, 77},
+	{354.96F, 456.29F, 88.66F, 334, 77},
+	{349.69F, 452.65F, 88.89F, 331, 77},
+	{345.19F, 446.90F, 88.56F, 328, 77},
+	{350.49F, 453.12F, 88.68F, 330, 77},
+	{345.51F, 446.69F, 88.65F, 332, 77},
+	{349.00F, 448.79F, 88.58F, 332, 77},
+	{344.33F, 445.06F, 89.16F, 326, 77},
+	{351.55F, 449.77F, 88.77F, 331, 77},
+	{353.72F, 454.54F, 88.94F, 338, 77},
+	{348.90F, 445.75F, 89.01F, 328, 77},
+	{339.83F, 435.47F, 88.89F, 322, 77},
+	{341.98F, 441.89F, 89.35F, 328, 77},
+	{340.16F, 435.74F, 88.97F, 325, 78},
+	{397.36F, 512.16F, 89.14F, 374, 78},
+	{400.14F, 512.95F, 89.76F, 373, 78},
+	{388.36F, 501.09F, 89.63F, 366, 78},
+	{406.09F, 523.49F, 89.65F, 377, 78},
+	{393.44F, 508.86F, 90.21F, 366, 78},
+	{390.03F, 503.04F, 90.31F, 363, 78},
+	{394.95F, 508.70F, 90.66F, 370, 78},
+	{392.84F, 502.81F, 90.61F, 370, 78},
+	{390.41F, 496.53F, 90.47F, 366, 78},
+	{389.79F, 499.26F, 90.83F, 363, 78},
+	{399.61F, 513.95F, 91.26F, 370, 79},
+	{389.92F, 502.88F, 91.13F, 364, 79},
+	{401.95F, 514.25F, 91.58F, 374, 79},
+	{402.34F, 516.34F, 91.71F, 373, 79},
+	{403.95F, 515.87F, 91.44F, 380, 79},
+	{410.73F, 531.30F, 91.60F, 384, 79},
+	{410.75F, 526.65F, 91.84F, 378, 79},
+	{400.89F, 513.07F, 91.79F, 370, 79},
+	{393.38F, 502.64F, 92.19F, 366, 79},
+	{407.02F, 522.76F, 92.10F, 379, 79},
+	{398.38F, 508.86F, 92.26F, 371, 79},
+	{411.39F, 527.85F, 92.77F, 382, 80},
+	{402.26F, 519.41F, 92.92F, 377, 80},
+	{394.52F, 507.50F, 92.70F, 372, 80},
+	{409.41F, 520.36F, 92.71F, 377, 80},
+	{396.01F, 505.01F, 93.02F, 368, 80},
+	{402.17F, 513.62F, 93.41F, 378, 80},
+	{411.37F, 529.75F, 93.38F, 386, 80},
+	{410.36F, 526.00F, 93.06F, 385, 80},
+	{405.14F, 521.35F, 93.65F, 374, 80},
+	{396.88F, 512.99F, 93.53F, 374, 80},
+	{411.69F, 524.21F, 93.90F, 380, 80},
+	{406.37F, 518.93F, 93.74F, 378, 80},
+	{405.32F, 514.84F, 93.99F, 378, 80},
+	{405.43F, 515.25F, 93.83F, 375, 81},
+	{398.41F, 512.60F, 94.01F, 372, 81},
+	{398.11F, 513.83F, 94.34F, 375, 81},
+	{394.98F, 501.89F, 93.99F, 370, 81},
+	{393.54F, 500.63F, 94.09F, 366, 81},
+	{389.47F, 503.88F, 94.18F, 368, 81},
+	{353.57F, 456.05F, 94.60F, 339, 81},
+	{341.59F, 439.95F, 94.43F, 322, 81},
+	{352.50F, 448.03F, 94.60F, 331, 81},
+	{344.90F, 439.46F, 94.20F, 327, 81},
+	{335.95F, 433.52F, 94.32F, 320, 81},
+	{349.42F, 451.98F, 94.24F, 334, 81},
+	{343.30F, 441.13F, 93.97F, 324, 81},
+	{350.37F, 453.25F, 93.88F, 335, 81},
+	{350.65F, 451.42F, 94.03F, 334, 81},
+	{345.59F, 445.61F, 93.97F, 325, 81},
+	{337.71F, 434.03F, 94.17F, 320, 81},
+	{336.34F, 434.69F, 93.93F, 321, 81},
+	{337.20F, 430.53F, 93.88F, 323, 81},
+	{339.21F, 431.49F, 93.61F, 324, 81},
+	{347.32F, 444.96F, 93.63F, 330, 81},
+	{352.92F, 449.29F, 93.95F, 336, 81},
+	{353.45F, 454.05F, 93.87F, 336, 81},
+	{342.70F, 437.11F, 93.97F, 324, 81},
+	{346.66F, 444.16F, 93.89F, 333, 81},
+	{349.54F, 449.65F, 93.73F, 329, 82},
+	{392.89F, 506.56F, 93.64F, 368, 82},
+	{383.01F, 495.73F, 93.86F, 362, 82},
+	{366.13F, 466.81F, 93.66F, 345, 82},
+	{357.99F, 459.05F, 94.06F, 338, 82},
+	{339.87F, 438.43F, 94.01F, 322, 82},
+	{327.29F, 419.03F, 93.57F, 312, 82},
+	{310.66F, 394.45F, 93.70F, 299, 82},
+	{293.28F, 374.90F, 93.28F, 283, 82},
+	{293.30F, 379.57F, 93.19F, 287, 82},
+	{277.96F, 354.29F, 92.81F, 272, 82},
+	{263.52F, 335.51F, 93.02F, 264, 82},
+	{245.37F, 317.05F, 92.56F, 250, 82},
+	{229.87F, 294.64F, 92.16F, 232, 82},
+	{217.43F, 280.70F, 91.84F, 222, 81},
+	{198.58F, 254.07F, 91.56F, 205, 81},
+	{178.60F, 231.25F, 91.21F, 190, 81},
+	{169.46F, 218.24F, 90.42F, 187, 81},
+	{151.86F, 196.43F, 90.06F, 173, 81},
+	{141.96F, 180.85F, 89.70F, 161, 81},
+	{128.14F, 163.91F, 89.09F, 150, 81},
+	{110.63F, 140.59F, 88.78F, 135, 81},
+	{114.93F, 146.94F, 87.86F, 142, 81},
+	{113.02F, 145.87F, 87.82F, 140, 80},
+	{114.72F, 148.06F, 87.13F, 136, 80},
+	{113.87F, 146.69F, 86.74F, 140, 80},
+	{109.93F, 142.24F, 85.91F, 139, 80},
+	{110.93F, 142.58F, 85.22F, 136, 80},
+	{114.27F, 146.11F, 85.15F, 140, 80},
+	{115.22F, 147.36F, 84.77F, 140, 80},
+	{113.33F, 144.72F, 84.11F, 136, 79},
+	{112.95F, 144.54F, 83.32F, 140, 79},
+	{112.49F, 145.43F, 82.98F, 137, 79},
+	{113.60F, 145.74F, 82.53F, 136, 79},
+	{110.51F, 140.70F, 82.11F, 133, 79},
+	{115.16F, 147.61F, 81.85F, 136, 79},
+	{113.39F, 145.50F, 81.07F, 137, 79},
+	{113.63F, 145.07F, 81.06F, 140, 79},
+	{113.00F, 145.11F, 80.26F, 139, 78},
+	{111.70F, 144.51F, 80.25F, 134, 78},
+	{108.89F, 138.50F, 79.94F, 130, 78},
+	{113.04F, 145.99F, 79.30F, 137, 78},
+	{115.34F, 148.18F, 78.83F, 139, 78},
+	{109.14F, 140.04F, 78.55F, 131, 78},
+	{111.94F, 143.67F, 77.98F, 138, 78},
+	{109.26F, 139.63F, 77.75F, 137, 78},
+	{113.46F, 144.71F, 77.45F, 141, 78},
+	{113.18F, 145.33F, 76.92F, 135, 77},
+	{109.82F, 141.16F, 76.69F, 132, 77},
+	{114.75F, 147.90F, 76.35F, 136, 77},
+	{114.45F, 148.10F, 75.91F, 143, 77},
+	{112.55F, 145.43F, 75.62F, 134, 77},
+	{113.01F, 145.29F, 75.39F, 138, 77},
+	{108.74F, 138.17F, 74.78F, 132, 77},
+	{111.53F, 144.16F, 74.56F, 140, 77},
+	{110.52F, 141.87F, 74.38F, 137, 77},
+	{109.74F, 140.86F, 73.96F, 137, 76},
+	{114.04F, 146.02F, 73.61F, 143, 76},
+	{111.25F, 141.83F, 73.59F, 133, 76},
+	{111.46F, 144.09F, 72.93F, 139, 76},
+	{111.79F, 143.99F, 73.05F, 134, 76},
+	{110.40F, 142.12F, 72.36F, 136, 76},
+	{113.50F, 144.43F, 72.48F, 141, 76},
+	{108.94F, 138.35F, 72.18F, 132, 76},
+	{110.26F, 142.04F, 71.73F, 132, 76},
+	{109.49F, 140.95F, 71.42F, 137, 76},
+	{111.72F, 143.84F, 71.12F, 139, 75},
+	{109.95F, 140.92F, 71.24F, 131, 75},
+	{109.79F, 141.27F, 70.94F, 135, 75},
+	{110.72F, 141.94F, 70.79F, 132, 75},
+	{113.34F, 144.07F, 70.28F, 138, 75},
+	{112.31F, 143.64F, 69.95F, 135, 75},
+	{114.11F, 146.85F, 69.84F, 141, 75},
+	{115.04F, 147.56F, 69.67F, 142, 75},
+	{112.52F, 144.67F, 69.37F, 140, 75},
+	{108.88F, 140.55F, 69.06F, 131, 75},
+	{111.26F, 142.96F, 69.01F, 133, 74},
+	{113.53F, 146.72F, 68.71F, 137, 74},
+	{114.08F, 145.99F, 68.28F, 138, 74},
+	{113.91F, 144.87F, 68.08F, 138, 74},
+	{113.10F, 144.28F, 67.86F, 139, 74},
+	{114.87F, 146.68F, 68.16F, 141, 74},
+	{111.34F, 143.94F, 67.72F, 140, 74},
+	{113.06F, 145.74F, 67.46F, 141, 74},
+	{109.90F, 140.41F, 67.52F, 136, 74},
+	{108.87F, 138.92F, 67.27F, 138, 74},
+	{110.69F, 141.47F, 67.04F, 133, 74},
+	{114.86F, 148.56F, 66.59F, 137, 74},
+	{110.10F, 142.09F, 66.50F, 134, 73},
+	{109.26F, 141.03F, 66.50F, 138, 73},
+	{110.65F, 142.43F, 66.43F, 137, 73},
+	{110.20F, 141.67F, 65.98F, 136, 73},
+	{111.50F, 142.33F, 66.15F, 135, 73},
+	{108.97F, 140.96F, 65.91F, 132, 73},
+	{109.54F, 139.96F, 65.80F, 131, 73},
+	{108.93F, 140.97F, 65.17F, 132, 73},
+	{109.29F, 140.64F, 65.29F, 131, 73},
+	{112.82F, 146.00F, 65.20F, 139, 73},
+	{109.80F, 141.13F, 64.93F, 136, 73},
+	{110.23F, 141.03F, 65.05F, 132, 73},
+	{113.49F, 144.21F, 64.67F, 142, 73},
+	{113.84F, 145.05F, 64.23F, 136, 72},
+	{112.98F, 145.42F, 64.21F, 135, 72},
+	{112.24F, 143.55F, 64.48F, 137, 72},
+	{109.12F, 138.67F, 64.14F, 136, 72},
+	{109.82F, 140.78F, 63.87F, 136, 72},
+	{111.22F, 143.86F, 63.72F, 133, 72},
+	{114.08F, 145.11F, 63.86F, 141, 72},
+	{109.84F, 139.81F, 63.28F, 137, 72},
+	{114.39F, 147.52F, 63.18F, 141, 72},
+	{114.08F, 145.47F, 63.48F, 142, 72},
+	{109.05F, 139.71F, 62.97F, 138, 72},
+	{111.15F, 142.90F, 63.27F, 139, 72},
+	{110.03F, 140.50F, 62.79F, 134, 72},
+	{113.59F, 146.45F, 62.69F, 138, 72},
+	{109.31F, 140.24F, 62.60F, 135, 72},
+	{111.00F, 142.57F, 62.37F, 137, 71},
+	{109.12F, 139.56F, 62.58F, 137, 71},
+	{113.53F, 146.64F, 62.68F, 136, 71},
+	{113.12F, 145.09F, 62.34F, 139, 71},
+	{114.55F, 145.41F, 62.13F, 138, 71},
+	{114.24F, 146.85F, 61.96F, 140, 71},
+	{110.01F, 142.34F, 61.96F, 131, 71},
+	{114.50F, 145.88F, 61.60F, 135, 71},
+	{109.31F, 139.67F, 61.80F, 131, 71},
+	{109.73F, 139.78F, 61.70F, 132, 71},
+	{114.13F, 147.29F, 61.35F, 135, 71},
+	{109.86F, 140.57F, 61.24F, 132, 71},
+	{114.95F, 147.53F, 61.25F, 140, 71},
+	{109.03F, 140.41F, 61.44F, 135, 71},
+	{113.68F, 145.09F, 61.47F, 142, 71},
+	{112.00F, 143.39F, 61.20F, 138, 71},
+	{113.02F, 144.15F, 61.17F, 135, 71},
+	{112.18F, 144.72F, 61.11F, 139, 70},
+	{111.94F, 142.88F, 61.17F, 141, 70},
+	{114.13F, 147.04F, 60.68F, 141, 70},
+	{111.45F, 143.12F, 60.71F, 135, 70},
+	{114.76F, 147.64F, 60.86F, 142, 70},
+	{112.10F, 143.36F, 60.81F, 140, 70},
+	{114.85F, 147.78F, 60.43F, 143, 70},
+	{114.72F, 147.29F, 60.27F, 141, 70},
+	{111.44F, 142.46F, 60.31F, 137, 70},
+	{108.69F, 138.48F, 60.13F, 137, 70},
+	{112.26F, 143.02F, 60.07F, 139, 70},
+	{113.96F, 145.35F, 60.05F, 139, 70},
+	{112.95F, 146.18F, 60.33F, 138, 70},
+	{114.34F, 146.01F, 60.26F, 138, 70},
+	{113.41F, 145.00F, 60.04F, 135, 70},
+	{115.08F, 148.47F, 59.66F, 142, 70},
+	{115.13F, 148.57F, 59.95F, 137, 70},
+	{110.32F, 141.78F, 59.58F, 135, 70},
+	{420.22F, 534.80F, 60.31F, 393, 70},
+	{430.37F, 550.88F, 61.01F, 398, 70},
+	{425.22F, 547.12F, 61.90F, 394, 70},
+	{419.01F, 532.91F, 62.40F, 393, 70},
+	{413.49F, 526.13F, 63.31F, 388, 70},
+	{425.06F, 542.40F, 63.66F, 394, 71},
+	{408.28F, 519.07F, 64.63F, 376, 71},
+	{412.27F, 529.16F, 65.15F, 384, 71},
+	{416.53F, 533.21F, 65.79F, 383, 71},
+	{412.62F, 527.08F, 66.11F, 385, 71},
+	{415.79F, 531.81F, 67.02F, 383, 71},
+	{421.82F, 544.09F, 67.46F, 390, 72},
+	{413.38F, 527.45F, 68.21F, 382, 72},
+	{430.00F, 548.74F, 68.65F, 398, 72},
+	{412.59F, 530.88F, 69.57F, 385, 72},
+	{410.39F, 530.35F, 70.06F, 384, 72},
+	{410.89F, 526.27F, 70.56F, 383, 72},
+	{415.20F, 529.39F, 70.70F, 384, 73},
+	{423.64F, 539.80F, 71.26F, 390, 73},
+	{427.40F, 552.90F, 71.91F, 397, 73},
+	{410.29F, 529.18F, 72.52F, 385, 73},
+	{408.45F, 526.57F, 73.10F, 384, 73},
+	{424.53F, 541.28F, 73.42F, 395, 73},
+	{408.17F, 518.14F, 74.09F, 380, 74},
+	{422.61F, 543.58F, 74.79F, 392, 74},
+	{421.53F, 544.49F, 74.97F, 387, 74},
+	{429.97F, 556.08F, 75.15F, 395, 74},
+	{429.79F, 549.62F, 76.02F, 395, 74},
+	{419.64F, 537.52F, 76.39F, 392, 74},
+	{419.97F, 543.77F, 76.98F, 386, 74},
+	{422.37F, 542.64F, 77.10F, 393, 75},
+	{427.36F, 547.67F, 77.41F, 399, 75},
+	{420.38F, 538.05F, 77.88F, 392, 75},
+	{411.89F, 533.31F, 78.23F, 381, 75},
+	{425.23F, 548.44F, 78.82F, 390, 75},
+	{412.06F, 530.92F, 79.52F, 387, 75},
+	{406.60F, 517.00F, 79.40F, 376, 75},
+	{415.87F, 536.03F, 80.18F, 387, 75},
+	{416.52F, 533.65F, 80.56F, 385, 76},
+	{422.16F, 539.52F, 80.98F, 388, 76},
+	{407.14F, 518.55F, 81.24F, 380, 76},
+	{424.01F, 542.16F, 81.71F, 392, 76},
+	{417.11F, 539.52F, 82.15F, 389, 76},
+	{415.74F, 532.81F, 82.16F, 386, 76},
+	{412.40F, 526.04F, 82.34F, 386, 76},
+	{425.13F, 545.10F, 82.97F, 392, 76},
+	{416.11F, 533.17F, 83.52F, 383, 77},
+	{417.42F, 540.45F, 83.82F, 387, 77},
+	{414.51F, 533.40F, 83.97F, 383, 77},
+	{418.47F, 541.34F, 84.13F, 389, 77},
+	{415.85F, 535.91F, 84.32F, 390, 77},
+	{406.37F, 522.87F, 84.93F, 376, 77},
+	{417.20F, 533.09F, 85.12F, 387, 77},
+	{412.49F, 526.49F, 85.31F, 387, 77},
+	{425.67F, 546.76F, 85.61F, 393, 78},
+	{408.23F, 525.52F, 85.77F, 379, 78},
+	{427.68F, 552.75F, 86.44F, 394, 78},
+	{425.40F, 548.88F, 86.67F, 393, 78},
+	{424.59F, 542.78F, 86.85F, 391, 78},
+	{416.18F, 532.98F, 87.29F, 388, 78},
+	{411.27F, 525.95F, 87.08F, 381, 78},
+	{427.31F, 551.71F, 87.80F, 393, 78},
+	{424.00F, 547.19F, 87.62F, 392, 78},
+	{407.66F, 522.81F, 87.80F, 378, 79},
+	{410.24F, 520.91F, 88.15F, 385, 79},
+	{425.29F, 539.79F, 88.68F, 396, 79},
+	{423.73F, 542.58F, 88.55F, 394, 79},
+	{408.40F, 520.12F, 89.09F, 381, 79},
+	{405.61F, 525.05F, 89.49F, 378, 79},
+	{414.45F, 533.16F, 89.55F, 384, 79},
+	{426.76F, 549.37F, 89.78F, 392, 79},
+	{410.19F, 523.07F, 89.82F, 384, 79},
+	{409.99F, 522.76F, 90.32F, 379, 79},
+	{409.67F, 530.38F, 90.42F, 380, 80},
+	{426.53F, 547.85F, 90.61F, 396, 80},
+	{416.59F, 538.84F, 90.80F, 383, 80},
+	{413.58F, 535.29F, 91.06F, 386, 80},
+	{417.21F, 529.87F, 91.24F, 388, 80},
+	{427.81F, 551.86F, 91.45F, 395, 80},
+	{406.98F, 523.60F, 91.35F, 381, 80},
+	{427.92F, 544.42F, 92.02F, 399, 80},
+	{415.33F, 532.79F, 92.07F, 384, 80},
+	{412.87F, 532.80F, 91.99F, 386, 80},
+	{410.67F, 527.58F, 92.23F, 380, 80},
+	{411.47F, 523.59F, 92.22F, 380, 81},
+	{408.11F, 525.73F, 92.90F, 381, 81},
+	{417.51F, 538.19F, 92.60F, 385, 81},
+	{415.65F, 535.86F, 93.09F, 389, 81},
+	{416.49F, 535.63F, 93.14F, 390, 81},
+	{417.91F, 538.17F, 93.19F, 386, 81},
+	{430.42F, 551.26F, 93.39F, 395, 81},
+	{421.27F, 543.47F, 93.58F, 387, 81},
+	{429.11F, 545.76F, 93.80F, 398, 81},
+	{417.26F, 536.82F, 93.90F, 389, 81},
+	{425.46F, 542.10F, 93.92F, 398, 81},
+	{417.96F, 534.47F, 94.03F, 390, 81},
+	{421.51F, 539.39F, 94.18F, 389, 82},
+	{409.94F, 522.71F, 94.58F, 379, 82},
+	{409.87F, 520.23F, 94.35F, 382, 82},
+	{427.20F, 545.51F, 94.60F, 398, 82},
+	{408.68F, 521.05F, 94.82F, 381, 82},
+	{414.95F, 528.93F, 95.06F, 386, 82},
+	{409.07F, 526.59F, 95.30F, 378, 82},
+	{408.92F, 521.52F, 95.54F, 383, 82},
+	{412.30F, 523.53F, 95.42F, 382, 82},
+	{406.28F, 522.89F, 95.78F, 381, 82},
+	{422.46F, 545.61F, 95.89F, 391, 82},
+	{409.89F, 525.49F, 95.88F, 384, 82},
+	{416.33F, 533.32F, 96.00F, 389, 82},
+	{415.69F, 531.94F, 96.02F, 388, 83},
+	{427.37F, 550.34F, 95.88F, 394, 83},
+	{415.53F, 528.40F, 96.05F, 383, 83},
+	{407.05F, 524.81F, 96.58F, 380, 83},
+	{416.91F, 537.76F, 96.54F, 388, 83},
+	{421.77F, 537.75F, 96.56F, 391, 83},
+	{422.85F, 541.06F, 96.48F, 392, 83},
+	{406.20F, 517.84F, 96.75F, 380, 83},
+	{413.06F, 534.09F, 97.05F, 380, 83},
+	{426.49F, 548.66F, 97.08F, 393, 83},
+	{420.02F, 534.47F, 96.99F, 386, 83},
+	{412.02F, 524.54F, 97.19F, 384, 83},
+	{423.80F, 542.55F, 96.97F, 392, 83},
+	{412.93F, 533.49F, 97.13F, 386, 83},
+	{419.50F, 539.16F, 97.13F, 386, 83},
+	{420.60F, 543.15F, 97.42F, 390, 84},
+	{430.41F, 550.63F, 97.54F, 401, 84},
+	{416.21F, 538.26F, 97.45F, 389, 84},
+	{415.39F, 535.82F, 97.61F, 389, 84},
+	{407.03F, 526.33F, 97.69F, 380, 84},
+	{415.33F, 533.54F, 97.64F, 387, 84},
+	{412.84F, 532.57F, 98.13F, 387, 84},
+	{421.93F, 544.25F, 97.93F, 391, 84},
+	{429.53F, 555.29F, 98.35F, 400, 84},
+	{419.43F, 536.77F, 98.25F, 390, 84},
+	{413.25F, 533.18F, 98.37F, 385, 84},
+	{419.26F, 540.58F, 98.47F, 393, 84},
+	{421.69F, 543.02F, 98.60F, 389, 84},
+	{430.45F, 552.71F, 98.56F, 400, 84},
+	{411.49F, 532.73F, 98.47F, 385, 84},
+	{422.13F, 539.81F, 98.45F, 390, 84},
+	{423.23F, 541.08F, 98.50F, 389, 84},
+	{426.69F, 546.88F, 98.76F, 396, 85},
+	{408.79F, 528.38F, 98.60F, 382, 85},
+	{429.56F, 554.18F, 99.05F, 393, 85},
+	{414.04F, 525.84F, 99.04F, 386, 85},
+	{421.10F, 542.24F, 98.97F, 391, 85},
+	{425.20F, 546.43F, 99.20F, 391, 85},
+	{406.86F, 521.38F, 99.28F, 376, 85},
+	{429.42F, 551.46F, 99.44F, 398, 85},
+	{422.24F, 536.42F, 99.25F, 388, 85},
+};
+
+#endif